@@ -2,14 +2,29 @@
  * Sample of sending big amount of delayed messages.
  * This sample can also be used as stress test for
  * SObjectizer timers implementation.
+ *
+ * The sample can also be used as a benchmark for different types
+ * of timers. There are short delayed messages which are really
+ * delivered and long timers which are only scheduled and then
+ * cancelled. Long timers imitate session timeouts which
+ * almost never fire.
  */
 
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <vector>
 
 #include <so_5/all.hpp>
 
+// Type of timer.
+enum class timer_type_t {
+	wheel,
+	hierarchical_wheel,
+	list,
+	heap
+};
+
 // Configuration for the sample.
 struct cfg_t
 {
@@ -19,12 +34,14 @@ struct cfg_t
 	// Initial delay for every message.
 	std::chrono::milliseconds m_delay = std::chrono::milliseconds{ 100 };
 
-	// Type of timer.
-	enum class timer_type_t {
-		wheel,
-		list,
-		heap
-	} m_timer_type = { timer_type_t::wheel };
+	// Count of long timers to be scheduled and then cancelled.
+	unsigned long long m_long_timers = 0;
+
+	// Delay for long timers.
+	std::chrono::seconds m_long_delay = std::chrono::seconds{ 1800 };
+
+	// Types of timers to be tested.
+	std::vector< timer_type_t > m_timer_types{ timer_type_t::wheel };
 };
 
 // Integer argument parsing helper.
@@ -60,7 +77,12 @@ cfg_t parse_args( int argc, char ** argv )
 				"Where options are:\n"
 				"-m <count>       count of delayed messages to be sent\n"
 				"-d <millisecons> pause for delayed messages\n"
-				"-t <type>        timer type (wheel, list, heap)\n"
+				"-l <count>       count of long timers to be scheduled "
+						"and cancelled\n"
+				"-L <seconds>     pause for long timers\n"
+				"                 (NOTE: list timer is very slow when there are\n"
+				"                 many long timers)\n"
+				"-t <type>        timer type (wheel, hwheel, list, heap, all)\n"
 				"-h               show this help\n"
 				<< std::flush;
 			std::exit( 1 );
@@ -82,17 +104,42 @@ cfg_t parse_args( int argc, char ** argv )
 
 			result.m_messages = str_to_value< unsigned long long >( *current );
 		}
+		else if( 0 == std::strcmp( *current, "-l" ) )
+		{
+			++current;
+			if( current == last )
+				throw std::invalid_argument( "-l requires value (timer count)" );
+
+			result.m_long_timers = str_to_value< unsigned long long >( *current );
+		}
+		else if( 0 == std::strcmp( *current, "-L" ) )
+		{
+			++current;
+			if( current == last )
+				throw std::invalid_argument( "-L requires value (seconds)" );
+
+			result.m_long_delay = std::chrono::seconds(
+					str_to_value< unsigned int >( *current ) );
+		}
 		else if( 0 == std::strcmp( *current, "-t" ) )
 		{
 			++current;
 			if( current == last )
 				throw std::invalid_argument( "-t requires value (timer type)" );
 			if( 0 == std::strcmp( *current, "wheel" ) )
-				result.m_timer_type = cfg_t::timer_type_t::wheel;
+				result.m_timer_types = { timer_type_t::wheel };
+			else if( 0 == std::strcmp( *current, "hwheel" ) )
+				result.m_timer_types = { timer_type_t::hierarchical_wheel };
 			else if( 0 == std::strcmp( *current, "list" ) )
-				result.m_timer_type = cfg_t::timer_type_t::list;
+				result.m_timer_types = { timer_type_t::list };
 			else if( 0 == std::strcmp( *current, "heap" ) )
-				result.m_timer_type = cfg_t::timer_type_t::heap;
+				result.m_timer_types = { timer_type_t::heap };
+			else if( 0 == std::strcmp( *current, "all" ) )
+				result.m_timer_types = {
+						timer_type_t::wheel,
+						timer_type_t::hierarchical_wheel,
+						timer_type_t::list,
+						timer_type_t::heap };
 			else
 				throw std::invalid_argument( "unknown type of timer" );
 		}
@@ -104,20 +151,35 @@ cfg_t parse_args( int argc, char ** argv )
 	return result;
 }
 
+const char * timer_type_name( timer_type_t type )
+{
+	switch( type )
+	{
+	case timer_type_t::wheel : return "wheel";
+	case timer_type_t::hierarchical_wheel : return "hwheel";
+	case timer_type_t::list : return "list";
+	case timer_type_t::heap : return "heap";
+	}
+
+	return "unknown";
+}
+
 void show_cfg( const cfg_t & cfg )
 {
-	std::string timer_type = "wheel";
-	if( cfg.m_timer_type == cfg_t::timer_type_t::list )
-		timer_type = "list";
-	else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
-		timer_type = "heap";
-
-	std::cout << "timer: " << timer_type
-			<< ", messages: " << cfg.m_messages
+	std::cout << "messages: " << cfg.m_messages
 			<< ", delay: " << cfg.m_delay.count() << "ms"
+			<< ", long timers: " << cfg.m_long_timers
+			<< ", long delay: " << cfg.m_long_delay.count() << "s"
 			<< std::endl;
 }
 
+// Helper for calculation of time spent.
+double ms_since( std::chrono::steady_clock::time_point started_at )
+{
+	return std::chrono::duration< double, std::milli >(
+			std::chrono::steady_clock::now() - started_at ).count();
+}
+
 // Timer message.
 struct msg_timer final : public so_5::signal_t {};
 
@@ -156,30 +218,70 @@ public :
 	a_sender_t(
 		context_t ctx,
 		so_5::mbox_t dest_mbox,
-		unsigned long long messages_to_send,
-		std::chrono::milliseconds delay )
+		const cfg_t & cfg )
 		:	so_5::agent_t( ctx )
 		,	m_dest_mbox( std::move( dest_mbox ) )
-		,	m_messages_to_send( messages_to_send )
-		,	m_delay( delay )
+		,	m_cfg( cfg )
 	{}
 
 	void so_evt_start() override
 	{
-		for( unsigned long long i = 0; i != m_messages_to_send; ++i )
-			so_5::send_delayed< msg_timer >( m_dest_mbox, m_delay );
+		const auto started_at = std::chrono::steady_clock::now();
+
+		m_long_timers.reserve( m_cfg.m_long_timers );
+		for( unsigned long long i = 0; i != m_cfg.m_long_timers; ++i )
+			m_long_timers.push_back(
+					so_5::send_periodic< msg_timer >(
+							m_dest_mbox,
+							m_cfg.m_long_delay,
+							std::chrono::seconds::zero() ) );
+
+		for( unsigned long long i = 0; i != m_cfg.m_messages; ++i )
+			so_5::send_delayed< msg_timer >( m_dest_mbox, m_cfg.m_delay );
+
+		std::cout << "  scheduling: " << ms_since( started_at ) << "ms"
+				<< std::endl;
+	}
+
+	void so_evt_finish() override
+	{
+		const auto started_at = std::chrono::steady_clock::now();
+
+		for( auto & id : m_long_timers )
+			id.release();
+
+		std::cout << "  cancellation: " << ms_since( started_at ) << "ms"
+				<< std::endl;
 	}
 
 private :
 	const so_5::mbox_t m_dest_mbox;
 
-	const unsigned long long m_messages_to_send;
+	const cfg_t & m_cfg;
 
-	const std::chrono::milliseconds m_delay;
+	std::vector< so_5::timer_id_t > m_long_timers;
 };
 
-void run_sobjectizer( const cfg_t & cfg )
+so_5::timer_thread_factory_t make_timer_factory( timer_type_t type )
+{
+	switch( type )
+	{
+	case timer_type_t::hierarchical_wheel :
+		return so_5::timer_hierarchical_wheel_factory();
+	case timer_type_t::list : return so_5::timer_list_factory();
+	case timer_type_t::heap : return so_5::timer_heap_factory();
+	default : ;
+	}
+
+	return so_5::timer_wheel_factory();
+}
+
+void run_sobjectizer( const cfg_t & cfg, timer_type_t timer_type )
 {
+	std::cout << "timer: " << timer_type_name( timer_type ) << std::endl;
+
+	const auto started_at = std::chrono::steady_clock::now();
+
 	so_5::launch(
 		// Initialization actions.
 		[&cfg]( so_5::environment_t & env )
@@ -191,21 +293,22 @@ void run_sobjectizer( const cfg_t & cfg )
 					auto a_receiver = coop.make_agent< a_receiver_t >( cfg.m_messages );
 
 					coop.make_agent< a_sender_t >(
-							a_receiver->so_direct_mbox(), cfg.m_messages, cfg.m_delay );
+							a_receiver->so_direct_mbox(), cfg );
 				});
 		},
 		// Parameter tuning actions.
-		[&cfg]( so_5::environment_params_t & params )
+		[timer_type]( so_5::environment_params_t & params )
 		{
 			// Appropriate timer thread must be used.
-			so_5::timer_thread_factory_t timer = so_5::timer_wheel_factory();
-			if( cfg.m_timer_type == cfg_t::timer_type_t::list )
-				timer = so_5::timer_list_factory();
-			else if( cfg.m_timer_type == cfg_t::timer_type_t::heap )
-				timer = so_5::timer_heap_factory();
-
-			params.timer_thread( timer );
+			params.timer_thread( make_timer_factory( timer_type ) );
 		} );
+
+	const auto total = ms_since( started_at );
+	const auto timers = cfg.m_messages + cfg.m_long_timers;
+	std::cout << "  total: " << total << "ms, timers/sec: "
+			<< static_cast< unsigned long long >(
+					total > 0.0 ? static_cast< double >( timers ) / total * 1000.0 : 0.0 )
+			<< std::endl;
 }
 
 int main( int argc, char ** argv )
@@ -215,7 +318,8 @@ int main( int argc, char ** argv )
 		const auto cfg = parse_args( argc, argv );
 		show_cfg( cfg );
 
-		run_sobjectizer( cfg );
+		for( auto t : cfg.m_timer_types )
+			run_sobjectizer( cfg, t );
 
 		return 0;
 	}
@@ -226,4 +330,3 @@ int main( int argc, char ** argv )
 
 	return 2;
 }
-
@@ -65,7 +65,7 @@
  * \since
  * v.1.2.1
  */
-#define TIMERTT_VERSION 1002002u
+#define TIMERTT_VERSION 1002003u
 
 /*!
  * \brief Top-level project's namespace.
@@ -497,6 +497,52 @@ struct timer_quantities
 	std::size_t m_periodic_count = { 0 };
 };
 
+//
+// exec_observer
+//
+/*!
+ * \brief An interface of observer for execution of timer actions.
+ *
+ * Can be used for collecting stats about lateness of timers and
+ * about load of a timer thread.
+ *
+ * All methods are called on the context of the thread which processes
+ * expired timers. Methods on_processing_started() and
+ * on_processing_finished() are called when the object's lock is
+ * acquired. Method on_action_exec() is called when the object's lock
+ * is released.
+ *
+ * \since
+ * v.1.2.3
+ */
+class exec_observer
+{
+public :
+	virtual ~exec_observer() = default;
+
+	//! Processing of expired timers is started.
+	virtual void
+	on_processing_started() noexcept = 0;
+
+	//! A timer action is going to be executed.
+	/*!
+	 * \note For timer_wheel and timer_hierarchical_wheel engines
+	 * \a expected_time is the border of the tick in which the timer
+	 * is expired. Rounding of timer's pause to the tick border isn't
+	 * taken into account.
+	 */
+	virtual void
+	on_action_exec(
+		//! Time point at which the timer had to be expired.
+		monotonic_clock::time_point expected_time ) noexcept = 0;
+
+	//! Processing of expired timers is finished.
+	virtual void
+	on_processing_finished(
+		//! Count of timer actions executed during the processing.
+		std::size_t executed_actions ) noexcept = 0;
+};
+
 /*!
  * \brief An internal namespace with implementation details.
  */
@@ -721,6 +767,46 @@ public :
 		return this->m_timer_quantities;
 	}
 
+	/*!
+	 * \brief Set an observer for execution of timer actions.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	void
+	set_exec_observer(
+		//! Observer. Can be nullptr.
+		exec_observer * observer )
+	{
+		m_exec_observer = observer;
+	}
+
+	/*!
+	 * \brief Get the observer for execution of timer actions.
+	 *
+	 * \return nullptr if there is no observer.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	exec_observer *
+	query_exec_observer() const
+	{
+		return m_exec_observer;
+	}
+
+	/*!
+	 * \brief Get the total count of executed timer actions.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	std::size_t
+	executed_actions() const
+	{
+		return m_executed_actions;
+	}
+
 protected :
 	//! Error logger.
 	Error_Logger m_error_logger;
@@ -779,6 +865,39 @@ protected :
 	{
 		m_timer_quantities = timer_quantities{};
 	}
+
+	/*!
+	 * \brief Observer for execution of timer actions.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	exec_observer * m_exec_observer = nullptr;
+
+	/*!
+	 * \brief Total count of executed timer actions.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	std::size_t m_executed_actions = 0;
+
+	/*!
+	 * \brief Helper method to be called just before execution
+	 * of a timer action.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	void
+	notify_action_exec(
+		//! Time point at which the timer had to be expired.
+		monotonic_clock::time_point expected_time )
+	{
+		++m_executed_actions;
+		if( m_exec_observer )
+			m_exec_observer->on_action_exec( expected_time );
+	}
 };
 
 //
@@ -948,6 +1067,24 @@ public :
 				this->m_timer_quantities.m_periodic_count;
 	}
 
+	/*!
+	 * \brief Is the timer in processing right now?
+	 *
+	 * A timer in processing can't be rescheduled.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	bool
+	is_in_processing(
+		//! Timer to be checked.
+		timer_object_holder< Thread_Safety > & timer )
+	{
+		const timer_status status = timer.template cast_to< timer_type >()->m_status;
+		return timer_status::deactivated != status &&
+				timer_status::active != status;
+	}
+
 	/*!
 	 * \brief Perform an attempt to reschedule a timer.
 	 *
@@ -1426,24 +1563,844 @@ private :
 			}
 			else
 			{
-				timer_type * t = timer;
-				timer = timer->m_next;
-
-				remove_timer_from_wheel( t );
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				remove_timer_from_wheel( t );
+				t->m_status = timer_status::wait_for_execution;
+
+				if( head )
+				{
+					tail->m_next = t;
+					t->m_prev = tail;
+					t->m_next = nullptr;
+					tail = t;
+				}
+				else
+				{
+					head = tail = t;
+					t->m_prev = t->m_next = nullptr;
+				}
+			}
+		}
+
+		return head;
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class Unique_Lock >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		Unique_Lock & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head )
+	{
+		// The border of the current tick must be got before unlocking.
+		const auto expected_time = m_current_tick_border - m_granularity;
+
+		lock.unlock();
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+				{
+					this->notify_action_exec( expected_time );
+					head->m_action.exec();
+				}
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__ 
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				set_position_in_the_wheel( t, t->m_period );
+
+				insert_demand_to_wheel( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+	}
+};
+
+//
+// timer_hierarchical_wheel_engine_defaults
+//
+/*!
+ * \brief Container for static method with default values for
+ * timer_hierarchical_wheel engine.
+ *
+ * \since
+ * v.1.2.3
+ */
+struct timer_hierarchical_wheel_engine_defaults
+{
+	//! Default count of slots on every level of the wheel.
+	inline static unsigned int
+	default_wheel_size() { return 256; }
+
+	//! Default count of levels of the wheel.
+	inline static unsigned int
+	default_levels() { return 4; }
+
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
+};
+
+//
+// timer_hierarchical_wheel_engine
+//
+
+/*!
+ * \brief A engine for hierarchical (multi-level) timer wheel mechanism.
+ *
+ * Unlike timer_wheel_engine this engine has several wheels (levels).
+ * Every level has the same count of slots. A slot of the level 0 is one
+ * time step. A slot of the level N is the whole revolution of the
+ * level N-1. A timer is stored on the lowest level which can hold its
+ * expiration time.
+ *
+ * When the level N-1 finishes its revolution the timers from the
+ * current slot of the level N are moved (cascaded) to lower levels.
+ * Every timer is cascaded at most once per level. So the cost of insertion,
+ * deactivation and processing of a timer doesn't depend on its pause.
+ * Timers with long pauses are not rescanned on every revolution of
+ * the wheel like in timer_wheel_engine.
+ *
+ * Timers with pauses longer than <tt>pow(wheel_size, levels)</tt> time
+ * steps are stored on the last slot of the highest level and are
+ * rescheduled when that slot is processed.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_engine
+	:	public engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >;
+
+	struct timer_type;
+
+public :
+	//! Type with default parameters for this engine.
+	using defaults_type = timer_hierarchical_wheel_engine_defaults;
+
+	//! Alias for timer_action type.
+	using timer_action = typename base_type::timer_action;
+
+	//! Alias for scoped timer object.
+	using scoped_timer_object =
+			scoped_timer_object_holder< timer_type >;
+
+	//! Constructor with all parameters.
+	/*!
+	 * \throw std::invalid_argument if \a wheel_size is less than 2,
+	 * \a levels is 0 or <tt>pow(wheel_size, levels)</tt> doesn't fit
+	 * into 64 bits.
+	 */
+	timer_hierarchical_wheel_engine(
+		//! Count of slots on every level of the wheel.
+		unsigned int wheel_size,
+		//! Count of levels of the wheel.
+		unsigned int levels,
+		//! Size of time step for the wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_wheel_size( wheel_size )
+		,	m_granularity( granularity )
+	{
+		if( wheel_size < 2 || !levels )
+			throw std::invalid_argument( "invalid size of hierarchical wheel" );
+
+		std::uint64_t span = 1;
+		for( unsigned int i = 0; i != levels; ++i )
+		{
+			if( span > UINT64_MAX / wheel_size )
+				throw std::invalid_argument( "too many levels for "
+						"hierarchical wheel" );
+
+			m_level_spans.push_back( span );
+			span *= wheel_size;
+		}
+		m_max_distance = span - 1;
+
+		m_slots.resize( static_cast< std::size_t >( wheel_size ) * levels );
+
+		m_current_tick_border = monotonic_clock::now() + m_granularity;
+	}
+
+	//! Destructor.
+	~timer_hierarchical_wheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< Thread_Safety >
+	allocate()
+	{
+		return timer_object_holder< Thread_Safety >( new timer_type() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned only when the first timer is added to
+	 * the empty wheel.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		wheel_timer->m_action.assign( std::move(action) );
+
+		// Timer must be taken under control.
+		timer_object< Thread_Safety >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		// If wheel was empty and this is the first timer added
+		// the value of timer_count must be exactly 1.
+		return 1 == this->m_timer_quantities.m_single_shot_count +
+				this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Is the timer in processing right now?
+	 *
+	 * A timer in processing can't be rescheduled.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	bool
+	is_in_processing(
+		//! Timer to be checked.
+		timer_object_holder< Thread_Safety > & timer )
+	{
+		const timer_status status = timer.template cast_to< timer_type >()->m_status;
+		return timer_status::deactivated != status &&
+				timer_status::active != status;
+	}
+
+	/*!
+	 * \brief Perform an attempt to reschedule a timer.
+	 *
+	 * \note
+	 * This operation can fail if the timer to be rescheduled is in processing.
+	 *
+	 * \attention
+	 * It move operator for a timer_action throws then timer will be
+	 * deactivated. The state for a timer_action itself will be unknown.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is in processing right now.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	reschedule(
+		//! Timer to be rescheduled. Must be in activated or deactivated state.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		// If timer is deactivated the usual activation logic can be used.
+		if( timer_status::deactivated == wheel_timer->m_status )
+			return this->activate(
+					std::move(timer), pause, period, std::move(action) );
+		else if( timer_status::active != wheel_timer->m_status )
+		{
+			// Timer which is in processing now can't be reactivated.
+			throw std::runtime_error( "timer is in processing now, "
+					"it can't be rescheduled" );
+		}
+
+		// Timer must be removed from the wheel first.
+		this->remove_timer_from_wheel( wheel_timer );
+		this->dec_timer_count( wheel_timer->kind() );
+
+		// If this assigment throws then we must deactivate the timer.
+		try
+		{
+			wheel_timer->m_action.assign( std::move(action) );
+		}
+		catch(...)
+		{
+			wheel_timer->m_status = timer_status::deactivated;
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+			// Exception must be rethrown;
+			throw;
+		}
+
+		this->perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		return false;
+	}
+
+	//! Deactivate timer and remove it from the wheel.
+	void
+	deactivate( timer_object_holder< Thread_Safety > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_wheel( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Build sublist of elapsed timers and process them all.
+	 */
+	template< typename Unique_Lock >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		Unique_Lock & lock )
+	{
+		// Several time steps can be processed at once if there was
+		// a long pause between calls to process_expired_timers.
+		const auto now = monotonic_clock::now();
+		for(;;)
+		{
+			if( !m_current_tick_processed )
+			{
+				process_current_tick( lock );
+
+				m_current_tick += 1;
+				m_current_tick_processed = true;
+			}
+
+			if( now >= m_current_tick_border )
+			{
+				// A switch to next tick is necessary.
+				m_current_tick_border += m_granularity;
+				m_current_tick_processed = false;
+			}
+			else
+				break;
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next timer.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		if( !m_current_tick_processed )
+			return monotonic_clock::now();
+		else
+			return m_current_tick_border;
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & item : m_slots )
+		{
+			timer_type * timer = item.m_head;
+			item = wheel_item();
+
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				t->m_status = timer_status::deactivated;
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_current_tick_border = monotonic_clock::now() + m_granularity;
+		this->m_current_tick = 0;
+	}
+
+private :
+	//! Type of wheel timer.
+	struct timer_type : public timer_object< Thread_Safety >
+	{
+		//! Status of the timer.
+		typename threading_traits< Thread_Safety >::status_holder_type m_status;
+
+		//! Time step at which the timer must be executed.
+		std::uint64_t m_expiration_tick = 0;
+
+		//! Index of the slot in which the timer is stored.
+		std::size_t m_slot = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		std::uint64_t m_period = 0;
+
+		//! Timer action.
+		timer_action_holder< timer_action > m_action;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		//! Detect type of the timer (single-shot or periodic).
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's slot.
+	struct wheel_item
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Count of slots on every level.
+	const unsigned int m_wheel_size;
+
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! Count of time steps in one slot for every level.
+	/*!
+	 * It is <tt>pow(m_wheel_size, level)</tt>.
+	 */
+	std::vector< std::uint64_t > m_level_spans;
+
+	//! Max distance in time steps which can be held by the wheel.
+	std::uint64_t m_max_distance;
+
+	//! Index of the current time step.
+	std::uint64_t m_current_tick = 0;
+
+	//! Right border of the current tick.
+	/*!
+	 * This is the time point at which new tick must be started.
+	 */
+	monotonic_clock::time_point m_current_tick_border;
+
+	//! Has the current tick been processed?
+	bool m_current_tick_processed = false;
+
+	//! Slots of all levels.
+	/*!
+	 * Slots of the level N are started from index N*m_wheel_size.
+	 */
+	std::vector< wheel_item > m_slots;
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	/*!
+	 * \brief Move the current tick to the current time.
+	 *
+	 * Ticks aren't processed while there are no timers. Without this
+	 * the first timer added after an idle period is counted from the
+	 * stale tick and is expired too early.
+	 *
+	 * \attention Must be called only for an empty wheel.
+	 */
+	void
+	catch_up_idle_ticks()
+	{
+		const auto now = monotonic_clock::now();
+		if( now >= m_current_tick_border )
+		{
+			const auto missed = ( now - m_current_tick_border ) / m_granularity + 1;
+
+			m_current_tick += static_cast< std::uint64_t >( missed );
+			m_current_tick_border += m_granularity * missed;
+			m_current_tick_processed = true;
+		}
+	}
+
+	/*!
+	 * \brief Perform insertion of a timer into wheel data structure.
+	 *
+	 * \note
+	 * This method doesn't change reference count to timer object.
+	 */
+	template< class Duration_1, class Duration_2 >
+	void
+	perform_insertion_into_wheel(
+		//! Timer to be inserted.
+		timer_type * wheel_timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period )
+	{
+		if( empty() )
+			catch_up_idle_ticks();
+
+		wheel_timer->m_expiration_tick =
+				m_current_tick + duration_to_ticks( pause );
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		this->insert_timer_to_wheel( wheel_timer );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note Performs rounding up like timer_wheel_engine does.
+	 * Never return 0.
+	 *
+	 * \tparam Duration actual type for duration representation.
+	 */
+	template< class Duration >
+	std::uint64_t
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		Duration d ) const
+	{
+		auto d_units =
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		auto r = static_cast< std::uint64_t >(
+				(d_units + g_units/2) / g_units );
+		if( !r )
+			r = 1;
+		return r;
+	}
+
+	/*!
+	 * \brief Insert timer to the appropriate slot of the wheel.
+	 *
+	 * The level is detected by the distance to the expiration of
+	 * the timer. The slot on that level is detected by the expiration
+	 * time itself.
+	 */
+	void
+	insert_timer_to_wheel( timer_type * wheel_timer )
+	{
+		std::uint64_t distance =
+				wheel_timer->m_expiration_tick - m_current_tick;
+		std::uint64_t expiration_tick = wheel_timer->m_expiration_tick;
+		if( distance > m_max_distance )
+		{
+			// The timer will be rescheduled when the farthest
+			// slot will be processed.
+			distance = m_max_distance;
+			expiration_tick = m_current_tick + m_max_distance;
+		}
+
+		std::size_t level = 0;
+		while( level + 1 < m_level_spans.size() &&
+				distance >= m_level_spans[ level + 1 ] )
+			++level;
+
+		wheel_timer->m_slot = level * m_wheel_size +
+				static_cast< std::size_t >(
+						( expiration_tick / m_level_spans[ level ] ) %
+						m_wheel_size );
+
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
+		wheel_timer->m_prev = item.m_tail;
+		wheel_timer->m_next = nullptr;
+		if( item.m_tail )
+			item.m_tail->m_next = wheel_timer;
+		else
+			item.m_head = wheel_timer;
+		item.m_tail = wheel_timer;
+	}
+
+	/*!
+	 * \brief Remove timer from the wheel.
+	 */
+	void
+	remove_timer_from_wheel( timer_type * wheel_timer )
+	{
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
+
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			item.m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			item.m_tail = wheel_timer->m_prev;
+	}
+
+	/*!
+	 * \brief Take the whole content of the slot.
+	 *
+	 * \return head of the list of timers from the slot.
+	 */
+	timer_type *
+	detach_slot( std::size_t slot )
+	{
+		timer_type * head = m_slots[ slot ].m_head;
+		m_slots[ slot ] = wheel_item();
+		return head;
+	}
+
+	/*!
+	 * \brief Move timers from higher levels to lower ones if
+	 * the current time step starts a new revolution of a level.
+	 */
+	void
+	cascade_timers()
+	{
+		for( std::size_t level = 1; level < m_level_spans.size(); ++level )
+		{
+			const auto span = m_level_spans[ level ];
+			if( 0 != m_current_tick % span )
+				break;
+
+			timer_type * timer = detach_slot(
+					level * m_wheel_size +
+					static_cast< std::size_t >(
+							( m_current_tick / span ) % m_wheel_size ) );
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				insert_timer_to_wheel( t );
+			}
+		}
+	}
+
+	/*!
+	 * \brief Detect elapsed timers for the current time step and
+	 * process them all.
+	 *
+	 * Object \a lock will be unlocked and then locked back.
+	 */
+	template< class Unique_Lock >
+	void
+	process_current_tick(
+		Unique_Lock & lock )
+	{
+		cascade_timers();
+
+		timer_type * exec_list_head = make_exec_list();
+
+		if( exec_list_head )
+		{
+			exec_actions( lock, exec_list_head );
+
+			utilize_exec_list( exec_list_head );
+		}
+	}
+
+	/*!
+	 * \brief Make list of elapsed timers to be executed.
+	 */
+	timer_type *
+	make_exec_list()
+	{
+		timer_type * head = nullptr;
+		timer_type * tail = nullptr;
+
+		timer_type * timer = detach_slot( static_cast< std::size_t >(
+				m_current_tick % m_wheel_size ) );
+		while( timer )
+		{
+			timer_type * t = timer;
+			timer = timer->m_next;
+
+			if( t->m_expiration_tick > m_current_tick )
+				// It is possible only for a wheel with one level and
+				// a timer with a very long pause.
+				insert_timer_to_wheel( t );
+			else
+			{
 				t->m_status = timer_status::wait_for_execution;
 
-				if( head )
-				{
+				t->m_next = nullptr;
+				t->m_prev = tail;
+				if( tail )
 					tail->m_next = t;
-					t->m_prev = tail;
-					t->m_next = nullptr;
-					tail = t;
-				}
 				else
-				{
-					head = tail = t;
-					t->m_prev = t->m_next = nullptr;
-				}
+					head = t;
+				tail = t;
 			}
 		}
 
@@ -1464,6 +2421,9 @@ private :
 		//! Cannot be nullptr.
 		timer_type * head )
 	{
+		// The border of the current tick must be got before unlocking.
+		const auto expected_time = m_current_tick_border - m_granularity;
+
 		lock.unlock();
 
 		while( head )
@@ -1474,7 +2434,10 @@ private :
 				// just before execution. If timer is waiting for
 				// deregistration it must not be executed.
 				if( timer_status::wait_for_execution == head->m_status )
+				{
+					this->notify_action_exec( expected_time );
 					head->m_action.exec();
+				}
 			}
 			catch( const std::exception & x )
 			{
@@ -1483,7 +2446,7 @@ private :
 			catch( ... )
 			{
 				std::ostringstream ss;
-				ss << __FILE__ << "(" << __LINE__ 
+				ss << __FILE__ << "(" << __LINE__
 					<< "): an unknown exception from timer action";
 				this->m_error_logger( ss.str() );
 				std::abort();
@@ -1520,9 +2483,9 @@ private :
 				// Timer is active again.
 				t->m_status = timer_status::active;
 
-				set_position_in_the_wheel( t, t->m_period );
+				t->m_expiration_tick = m_current_tick + t->m_period;
 
-				insert_demand_to_wheel( t );
+				insert_timer_to_wheel( t );
 			}
 			else
 			{
@@ -1703,6 +2666,24 @@ public :
 		return list_timer == m_head;
 	}
 
+	/*!
+	 * \brief Is the timer in processing right now?
+	 *
+	 * A timer in processing can't be rescheduled.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	bool
+	is_in_processing(
+		//! Timer to be checked.
+		timer_object_holder< Thread_Safety > & timer )
+	{
+		const timer_status status = timer.template cast_to< timer_type >()->m_status;
+		return timer_status::deactivated != status &&
+				timer_status::active != status;
+	}
+
 	/*!
 	 * \brief Perform an attempt to reschedule a timer.
 	 *
@@ -2092,7 +3073,10 @@ private :
 				// just before execution. If timer is waiting for
 				// deregistration it must not be executed.
 				if( timer_status::wait_for_execution == head->m_status )
+				{
+					this->notify_action_exec( head->m_when );
 					head->m_action.exec();
+				}
 			}
 			catch( const std::exception & x )
 			{
@@ -2308,6 +3292,22 @@ public :
 		return heap_timer == heap_head();
 	}
 
+	/*!
+	 * \brief Is the timer in processing right now?
+	 *
+	 * A timer in processing can't be rescheduled.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	bool
+	is_in_processing(
+		//! Timer to be checked.
+		timer_object_holder< Thread_Safety > & timer )
+	{
+		return timer.template cast_to< timer_type >() == m_timer_in_processing;
+	}
+
 	/*!
 	 * \brief Perform an attempt to reschedule a timer.
 	 *
@@ -2617,6 +3617,7 @@ private :
 
 		try
 		{
+			this->notify_action_exec( m_timer_in_processing->m_when );
 			m_timer_in_processing->m_action.exec();
 		}
 		catch( const std::exception & x )
@@ -3232,6 +4233,50 @@ public :
 			this->notify();
 	}
 
+	/*!
+	 * \brief Try to reschedule a timer.
+	 *
+	 * Unlike reschedule() this method doesn't throw if the timer is
+	 * in processing right now.
+	 *
+	 * \retval false if the timer is in processing and isn't rescheduled.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	try_reschedule(
+		//! Timer to be rescheduled.
+		timer_holder timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		typename mixin_type::lock_guard locker{ *this };
+
+		this->ensure_started();
+
+		if( m_engine.is_in_processing( timer ) )
+			return false;
+
+		if( m_engine.reschedule(
+				std::move( timer ), pause, period, std::move( action ) ) )
+			this->notify();
+
+		return true;
+	}
+
 	//! Activate a scoped timer and schedule it for execution.
 	/*!
 	 *
@@ -3344,9 +4389,56 @@ public :
 		return m_engine.empty();
 	}
 
+	/*!
+	 * \brief Set an observer for execution of timer actions.
+	 *
+	 * \attention The observer must be set before the start of timer
+	 * thread (or before the first call to process_expired_timers() for
+	 * timer manager). The observer must outlive the timer thread (manager).
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	void
+	set_exec_observer(
+		//! Observer. Can be nullptr.
+		exec_observer * observer )
+	{
+		typename mixin_type::lock_guard locker{ *this };
+
+		m_engine.set_exec_observer( observer );
+	}
+
 protected :
 	//! Actual timer engine instance.
 	Engine m_engine;
+
+	/*!
+	 * \brief Process expired timers and notify exec_observer (if any).
+	 *
+	 * \since
+	 * v.1.2.3
+	 */
+	template< typename Lock >
+	void
+	process_expired_timers_and_notify(
+		//! Object's lock.
+		Lock & lock )
+	{
+		auto observer = m_engine.query_exec_observer();
+		if( observer )
+		{
+			observer->on_processing_started();
+
+			const auto executed_before = m_engine.executed_actions();
+			m_engine.process_expired_timers( lock );
+
+			observer->on_processing_finished(
+					m_engine.executed_actions() - executed_before );
+		}
+		else
+			m_engine.process_expired_timers( lock );
+	}
 };
 
 //
@@ -3393,7 +4485,7 @@ public :
 	{
 		typename manager_impl_template::lock_guard locker{ *this };
 
-		this->m_engine.process_expired_timers( locker );
+		this->process_expired_timers_and_notify( locker );
 	}
 
 	//! Get the time for next process_expired_timers invocation.
@@ -3558,7 +4650,7 @@ protected :
 
 		while( !this->m_shutdown )
 		{
-			this->m_engine.process_expired_timers( locker );
+			this->process_expired_timers_and_notify( locker );
 
 			sleep_for_next_event( locker );
 		}
@@ -3785,6 +4877,215 @@ using default_timer_wheel_thread =
 				default_error_logger,
 				default_actor_exception_handler >;
 
+//
+// timer_hierarchical_wheel_thread_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * Please see description of details::timer_hierarchical_wheel_engine for
+ * the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class timer_hierarchical_wheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						::timertt::thread_safety::safe,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	using base_type =
+			details::thread_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							::timertt::thread_safety::safe,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_thread_template()
+		:	timer_hierarchical_wheel_thread_template(
+				base_type::default_wheel_size(),
+				base_type::default_levels(),
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with wheel size, levels and granularity parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Count of slots on every level of the wheel.
+		unsigned int wheel_size,
+		//! Count of levels of the wheel.
+		unsigned int levels,
+		//! Size of time step for the wheel.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_thread_template(
+				wheel_size,
+				levels,
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Count of slots on every level of the wheel.
+		unsigned int wheel_size,
+		//! Count of levels of the wheel.
+		unsigned int levels,
+		//! Size of time step for the wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				wheel_size,
+				levels,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// timer_hierarchical_wheel_manager_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of the hierarchical timer wheel mechanism.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action = default_timer_action_type,
+	typename Error_Logger = default_error_logger,
+	typename Actor_Exception_Handler = default_actor_exception_handler >
+class timer_hierarchical_wheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						Thread_Safety,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::manager_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							Thread_Safety,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_manager_template()
+		:	timer_hierarchical_wheel_manager_template(
+				base_type::default_wheel_size(),
+				base_type::default_levels(),
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with wheel size, levels and granularity parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Count of slots on every level of the wheel.
+		unsigned int wheel_size,
+		//! Count of levels of the wheel.
+		unsigned int levels,
+		//! Size of time step for the wheel.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_manager_template(
+				wheel_size,
+				levels,
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Count of slots on every level of the wheel.
+		unsigned int wheel_size,
+		//! Count of levels of the wheel.
+		unsigned int levels,
+		//! Size of time step for the wheel.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				wheel_size,
+				levels,
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// default_timer_hierarchical_wheel_thread
+//
+/*!
+ * \brief Alias for timer_hierarchical_wheel_thread_template with
+ * the default parameters.
+ *
+ * \since
+ * v.1.2.3
+ */
+using default_timer_hierarchical_wheel_thread =
+		timer_hierarchical_wheel_thread_template<
+				default_timer_action_type,
+				default_error_logger,
+				default_actor_exception_handler >;
+
 //
 // timer_list_thread_template
 //
@@ -15,6 +15,7 @@
 #include <so_5/impl/process_unhandled_exception.hpp>
 #include <so_5/impl/message_limit_internals.hpp>
 #include <so_5/impl/delivery_filter_storage.hpp>
+#include <so_5/impl/event_handler_cache.hpp>
 #include <so_5/impl/msg_tracing_helpers.hpp>
 
 #include <so_5/impl/enveloped_msg_details.hpp>
@@ -26,6 +27,7 @@
 #include <algorithm>
 #include <sstream>
 #include <cstdlib>
+#include <new>
 
 namespace so_5
 {
@@ -75,6 +77,28 @@ create_anonymous_state_name( const agent_t * agent, const state_t * st )
 		return ss.str();
 	}
 
+/*!
+ * \brief Descriptor for demands for so_evt_start() calls.
+ *
+ * \since
+ * v.5.6.2
+ */
+constexpr demand_descriptor_t start_demand_descriptor{
+		&agent_t::demand_handler_on_start,
+		nullptr,
+		null_message_type_id };
+
+/*!
+ * \brief Descriptor for demands for so_evt_finish() calls.
+ *
+ * \since
+ * v.5.6.2
+ */
+constexpr demand_descriptor_t finish_demand_descriptor{
+		&agent_t::demand_handler_on_finish,
+		nullptr,
+		null_message_type_id };
+
 } /* namespace anonymous */
 
 // NOTE: Implementation of state_t is moved to that file in v.5.4.0.
@@ -722,11 +746,9 @@ agent_t::so_bind_to_dispatcher(
 	actual_queue->push(
 			execution_demand_t(
 					this,
-					message_limit::control_block_t::none(),
+					&start_demand_descriptor,
 					0,
-					typeid(void),
-					message_ref_t(),
-					&agent_t::demand_handler_on_start ) );
+					message_ref_t() ) );
 	
 	// Only then pointer to the queue could be stored.
 	m_event_queue = actual_queue;
@@ -744,9 +766,9 @@ agent_t::so_create_execution_hint(
 	// demands like demands for so_evt_start/so_evt_finish.
 	// Because of that a pointer to demand handler will be analyzed.
 	const auto demand_type =
-			(d.m_demand_handler == &agent_t::demand_handler_on_message ?
+			(d.demand_handler() == &agent_t::demand_handler_on_message ?
 				demand_type_t::message :
-				(d.m_demand_handler == &agent_t::demand_handler_on_enveloped_msg ?
+				(d.demand_handler() == &agent_t::demand_handler_on_enveloped_msg ?
 					demand_type_t::enveloped_msg : demand_type_t::other));
 
 	if( demand_type_t::other != demand_type )
@@ -759,14 +781,16 @@ agent_t::so_create_execution_hint(
 					if( handler )
 						return execution_hint_t(
 								d,
-								[handler](
+								[](
 										execution_demand_t & demand,
-										current_thread_id_t thread_id ) {
+										current_thread_id_t thread_id,
+										const impl::event_handler_data_t * h ) {
 									process_message(
 											thread_id,
 											demand,
-											handler->m_method );
+											h->m_method );
 								},
+								handler,
 								handler->m_thread_safety );
 					else
 						// Handler not found.
@@ -778,14 +802,16 @@ agent_t::so_create_execution_hint(
 					// very similar to hint for service request.
 					return execution_hint_t(
 							d,
-							[handler](
+							[](
 									execution_demand_t & demand,
-									current_thread_id_t thread_id ) {
+									current_thread_id_t thread_id,
+									const impl::event_handler_data_t * h ) {
 								process_enveloped_msg(
 										thread_id,
 										demand,
-										handler );
+										h );
 							},
+							handler,
 							handler ? handler->m_thread_safety :
 								// If there is no real handler then
 								// there will only be actions from
@@ -799,9 +825,11 @@ agent_t::so_create_execution_hint(
 		return execution_hint_t(
 				d,
 				[]( execution_demand_t & demand,
-					current_thread_id_t thread_id ) {
+					current_thread_id_t thread_id,
+					const impl::event_handler_data_t * ) {
 					demand.call_handler( thread_id );
 				},
+				nullptr,
 				not_thread_safe );
 }
 
@@ -855,11 +883,9 @@ agent_t::shutdown_agent() noexcept
 					m_event_queue->push(
 							execution_demand_t(
 									this,
-									message_limit::control_block_t::none(),
+									&finish_demand_descriptor,
 									0,
-									typeid(void),
-									message_ref_t(),
-									&agent_t::demand_handler_on_finish ) );
+									message_ref_t() ) );
 
 					// No more events will be stored to the queue.
 					m_event_queue = nullptr;
@@ -899,10 +925,9 @@ agent_t::so_create_event_subscription(
 
 	ensure_operation_is_on_working_thread( "so_create_event_subscription" );
 
-	m_subscriptions->create_event_subscription(
+	do_create_event_subscription(
 			mbox_ref,
 			msg_type,
-			detect_limit_for_message_type( msg_type ),
 			target_state,
 			method,
 			thread_safety );
@@ -917,10 +942,9 @@ agent_t::so_create_deadletter_subscription(
 {
 	ensure_operation_is_on_working_thread( "so_create_deadletter_subscription" );
 
-	m_subscriptions->create_event_subscription(
+	do_create_event_subscription(
 			mbox,
 			msg_type,
-			detect_limit_for_message_type( msg_type ),
 			deadletter_state,
 			method,
 			thread_safety );
@@ -937,9 +961,71 @@ agent_t::so_destroy_deadletter_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_deadletter_handler" );
 
+	drop_event_handler_cache();
+
 	m_subscriptions->drop_subscription( mbox, msg_type, deadletter_state );
 }
 
+void
+agent_t::do_create_event_subscription(
+	const mbox_t & mbox_ref,
+	const std::type_index & msg_type,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety )
+{
+	const auto limit = detect_limit_for_message_type( msg_type );
+
+	if( m_pending_subscriptions )
+		// Subscription will be created at the end of so_bulk_subscribe().
+		m_pending_subscriptions->m_items.push_back(
+				impl::subscription_storage_common::pending_subscription_t{
+						impl::subscription_storage_common::subscr_info_t{
+								mbox_ref,
+								msg_type,
+								target_state,
+								method,
+								thread_safety },
+						limit } );
+	else
+	{
+		drop_event_handler_cache();
+
+		m_subscriptions->create_event_subscription(
+				mbox_ref,
+				msg_type,
+				limit,
+				target_state,
+				method,
+				thread_safety );
+	}
+}
+
+void
+agent_t::start_bulk_subscription()
+{
+	ensure_operation_is_on_working_thread( "so_bulk_subscribe" );
+
+	m_pending_subscriptions.reset( new impl::pending_subscriptions_t{} );
+}
+
+void
+agent_t::cancel_bulk_subscription() noexcept
+{
+	m_pending_subscriptions.reset();
+}
+
+void
+agent_t::finish_bulk_subscription()
+{
+	auto items = std::move( m_pending_subscriptions->m_items );
+	m_pending_subscriptions.reset();
+
+	drop_event_handler_cache();
+
+	m_subscriptions->create_event_subscriptions( std::move( items ) );
+}
+
 const message_limit::control_block_t *
 agent_t::detect_limit_for_message_type(
 	const std::type_index & msg_type ) const
@@ -972,6 +1058,8 @@ agent_t::do_drop_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_subscription" );
 
+	drop_event_handler_cache();
+
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
 }
 
@@ -987,6 +1075,8 @@ agent_t::do_drop_subscription_for_all_states(
 	ensure_operation_is_on_working_thread(
 			"do_drop_subscription_for_all_states" );
 
+	drop_event_handler_cache();
+
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
 }
 
@@ -996,8 +1086,13 @@ agent_t::do_check_subscription_presence(
 	const std::type_index & msg_type,
 	const state_t & target_state ) const noexcept
 {
+	// There can't be a subscription for a type without an identifier.
+	message_type_id_t msg_type_id;
+	if( !find_message_type_id( msg_type, msg_type_id ) )
+		return false;
+
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, target_state );
+			mbox->id(), msg_type_id, target_state );
 }
 
 bool
@@ -1005,25 +1100,29 @@ agent_t::do_check_deadletter_presence(
 	const mbox_t & mbox,
 	const std::type_index & msg_type ) const noexcept
 {
+	message_type_id_t msg_type_id;
+	if( !find_message_type_id( msg_type, msg_type_id ) )
+		return false;
+
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, deadletter_state );
+			mbox->id(), msg_type_id, deadletter_state );
 }
 
 namespace {
 
 /*!
- * \brief A helper function to select actual demand handler in
+ * \brief A helper function to select actual kind of demand in
  * dependency of message kind.
  *
  * \since
  * v.5.5.23
  */
-inline demand_handler_pfn_t
-select_demand_handler_for_message(
+inline impl::message_demand_kind_t
+select_demand_kind_for_message(
 	const agent_t & agent,
 	const message_ref_t & msg )
 {
-	demand_handler_pfn_t result = &agent_t::demand_handler_on_message;
+	auto result = impl::message_demand_kind_t::message;
 	if( msg )
 	{
 		switch( message_kind( *msg ) )
@@ -1035,7 +1134,7 @@ select_demand_handler_for_message(
 		break;
 
 		case message_t::kind_t::enveloped_msg :
-			result = &agent_t::demand_handler_on_enveloped_msg;
+			result = impl::message_demand_kind_t::enveloped_msg;
 		break;
 
 		case message_t::kind_t::signal :
@@ -1060,10 +1159,13 @@ void
 agent_t::push_event(
 	const message_limit::control_block_t * limit,
 	mbox_id_t mbox_id,
-	std::type_index msg_type,
+	message_type_id_t msg_type_id,
 	const message_ref_t & message )
 {
-	const auto handler = select_demand_handler_for_message( *this, message );
+	const auto * descriptor = impl::message_demand_descriptor(
+			limit,
+			msg_type_id,
+			select_demand_kind_for_message( *this, message ) );
 
 	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
 
@@ -1071,11 +1173,55 @@ agent_t::push_event(
 		m_event_queue->push(
 				execution_demand_t(
 					this,
-					limit,
+					descriptor,
 					mbox_id,
-					msg_type,
-					message,
-					handler ) );
+					message ) );
+}
+
+void
+agent_t::push_events_batch(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	message_type_id_t msg_type_id,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	// Descriptors are obtained only once for every kind of demand.
+	const demand_descriptor_t *
+			descriptors[ impl::message_demand_kinds_count ]{};
+	const auto descriptor_for = [&]( const message_ref_t & message ) {
+		const auto kind = select_demand_kind_for_message( *this, message );
+		auto & d = descriptors[ static_cast< std::size_t >( kind ) ];
+		if( !d )
+			d = impl::message_demand_descriptor( limit, msg_type_id, kind );
+		return d;
+	};
+
+	std::vector< execution_demand_t > demands;
+	so_5::details::do_with_rollback_on_exception(
+		[&] {
+			demands.reserve( count );
+			for( std::size_t i = 0u; i != count; ++i )
+				demands.emplace_back(
+						this,
+						descriptor_for( messages[ i ] ),
+						mbox_id,
+						messages[ i ] );
+		},
+		[&] {
+			for( std::size_t i = 0u; i != count; ++i )
+				message_limit::control_block_t::decrement( limit );
+		} );
+
+	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+
+	if( m_event_queue )
+		so_5::details::do_with_rollback_on_exception(
+			[&] { m_event_queue->push_batch( demands.data(), demands.size() ); },
+			[&] {
+				for( const auto & d : demands )
+					message_limit::control_block_t::decrement( d.limit() );
+			} );
 }
 
 void
@@ -1092,6 +1238,9 @@ agent_t::demand_handler_on_start(
 	try
 	{
 		d.m_receiver->so_evt_start();
+
+		// Subscription storage can prepare itself for the normal work.
+		d.m_receiver->m_subscriptions->on_agent_started();
 	}
 	catch( const std::exception & x )
 	{
@@ -1167,7 +1316,7 @@ agent_t::demand_handler_on_message(
 	current_thread_id_t working_thread_id,
 	execution_demand_t & d )
 {
-	message_limit::control_block_t::decrement( d.m_limit );
+	message_limit::control_block_t::decrement( d.limit() );
 
 	auto handler = d.m_receiver->m_handler_finder(
 			d, "demand_handler_on_message" );
@@ -1186,7 +1335,7 @@ agent_t::demand_handler_on_enveloped_msg(
 	current_thread_id_t working_thread_id,
 	execution_demand_t & d )
 {
-	message_limit::control_block_t::decrement( d.m_limit );
+	message_limit::control_block_t::decrement( d.limit() );
 
 	auto handler = d.m_receiver->m_handler_finder(
 			d, "demand_handler_on_enveloped_msg" );
@@ -1320,12 +1469,8 @@ agent_t::handler_finder_msg_tracing_disabled(
 	execution_demand_t & d,
 	const char * /*context_marker*/ )
 {
-	auto search_result = find_event_handler_for_current_state( d );
-	if( !search_result )
-		// Since v.5.5.21 we should check for deadletter handler for that demand.
-		search_result = find_deadletter_handler( d );
-
-	return search_result;
+	bool is_deadletter;
+	return find_event_handler( d, is_deadletter );
 }
 
 const impl::event_handler_data_t *
@@ -1333,23 +1478,18 @@ agent_t::handler_finder_msg_tracing_enabled(
 	execution_demand_t & d,
 	const char * context_marker )
 {
-	auto search_result = find_event_handler_for_current_state( d );
+	bool is_deadletter;
+	auto search_result = find_event_handler( d, is_deadletter );
 
-	if( !search_result )
+	if( is_deadletter )
 	{
-		// Since v.5.5.21 we should check for deadletter handler for that demand.
-		search_result = find_deadletter_handler( d );
-
-		if( search_result )
-		{
-			// Deadletter handler found. This must be reflected in trace.
-			impl::msg_tracing_helpers::trace_deadletter_handler_search_result(
-					d,
-					context_marker,
-					search_result );
+		// Deadletter handler found. This must be reflected in trace.
+		impl::msg_tracing_helpers::trace_deadletter_handler_search_result(
+				d,
+				context_marker,
+				search_result );
 
-			return search_result;
-		}
+		return search_result;
 	}
 
 	// This trace will be made if an event_handler is found for the
@@ -1362,6 +1502,61 @@ agent_t::handler_finder_msg_tracing_enabled(
 	return search_result;
 }
 
+const impl::event_handler_data_t *
+agent_t::find_event_handler(
+	execution_demand_t & d,
+	bool & is_deadletter )
+{
+	agent_t & receiver = *(d.m_receiver);
+	const state_t * current_state = receiver.m_current_state_ptr;
+
+	if( receiver.m_handler_cache )
+	{
+		const auto * cached = receiver.m_handler_cache->find(
+				d.m_mbox_id, d.msg_type_id(), current_state );
+		if( cached )
+		{
+			is_deadletter = cached->m_is_deadletter;
+			return cached->m_handler;
+		}
+	}
+
+	is_deadletter = false;
+	auto search_result = find_event_handler_for_current_state( d );
+	if( !search_result )
+	{
+		// Since v.5.5.21 we should check for deadletter handler for that demand.
+		search_result = find_deadletter_handler( d );
+		is_deadletter = nullptr != search_result;
+	}
+
+	// The cache is necessary only if the search could require
+	// more than one lookup in the subscription storage.
+	if( !receiver.m_handler_cache &&
+			( !search_result || is_deadletter ||
+				nullptr != current_state->parent_state() ) )
+		// The lack of the cache isn't an error.
+		receiver.m_handler_cache.reset(
+				new( std::nothrow ) impl::event_handler_cache_t{} );
+
+	if( receiver.m_handler_cache )
+		receiver.m_handler_cache->store(
+				d.m_mbox_id,
+				d.msg_type_id(),
+				current_state,
+				search_result,
+				is_deadletter );
+
+	return search_result;
+}
+
+void
+agent_t::drop_event_handler_cache() noexcept
+{
+	if( m_handler_cache )
+		m_handler_cache->clear();
+}
+
 const impl::event_handler_data_t *
 agent_t::find_event_handler_for_current_state(
 	execution_demand_t & d )
@@ -1372,7 +1567,7 @@ agent_t::find_event_handler_for_current_state(
 	do {
 		search_result = d.m_receiver->m_subscriptions->find_handler(
 				d.m_mbox_id,
-				d.m_msg_type, 
+				d.msg_type_id(),
 				*s );
 
 		if( !search_result )
@@ -1389,7 +1584,7 @@ agent_t::find_deadletter_handler(
 {
 	return demand.m_receiver->m_subscriptions->find_handler(
 			demand.m_mbox_id,
-			demand.m_msg_type,
+			demand.msg_type_id(),
 			deadletter_state );
 }
 
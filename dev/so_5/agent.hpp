@@ -36,6 +36,8 @@
 #include <so_5/message_handler_format_detector.hpp>
 #include <so_5/coop_handle.hpp>
 
+#include <so_5/impl/demand_descriptors.hpp>
+
 #include <atomic>
 #include <map>
 #include <memory>
@@ -993,7 +995,77 @@ class SO_5_TYPE agent_t
 			std::type_index msg_type,
 			const message_ref_t & message )
 		{
-			agent.push_event( limit, mbox_id, msg_type, message );
+			agent.push_event(
+					limit, mbox_id, message_type_id( msg_type ), message );
+		}
+
+		//! Push an event to the agent's event queue.
+		/*!
+		 * This version is intended to be used by mboxes those already
+		 * know the identifier of the message type.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		static inline void
+		call_push_event(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index /*msg_type*/,
+			message_type_id_t msg_type_id,
+			const message_ref_t & message )
+		{
+			agent.push_event( limit, mbox_id, msg_type_id, message );
+		}
+
+		//! Push several events to the agent's event queue at once.
+		/*!
+		 * This method is used by SObjectizer for delivery of a batch
+		 * of messages of the same type.
+		 *
+		 * \note
+		 * Message limit counters must be incremented for every message
+		 * of the batch before this call. If an exception is thrown then
+		 * counters for messages which weren't stored into the event
+		 * queue are decremented.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		static inline void
+		call_push_events_batch(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t * messages,
+			std::size_t count )
+		{
+			agent.push_events_batch(
+					limit, mbox_id, message_type_id( msg_type ), messages, count );
+		}
+
+		//! Push several events to the agent's event queue at once.
+		/*!
+		 * This version is intended to be used by mboxes those already
+		 * know the identifier of the message type.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		static inline void
+		call_push_events_batch(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index /*msg_type*/,
+			message_type_id_t msg_type_id,
+			const message_ref_t * messages,
+			std::size_t count )
+		{
+			agent.push_events_batch(
+					limit, mbox_id, msg_type_id, messages, count );
 		}
 
 		/*!
@@ -1202,6 +1274,52 @@ class SO_5_TYPE agent_t
 			return so_subscribe( so_direct_mbox() );
 		}
 
+		/*!
+		 * \brief Create many subscriptions at once.
+		 *
+		 * All subscriptions made inside \a lambda (by so_subscribe(),
+		 * so_subscribe_self(), state_t::event() and so on) are collected
+		 * and then created together after the return from \a lambda.
+		 * Every mbox is informed about new subscriptions by one call and
+		 * the subscription storage is rebuilt only once. It makes the
+		 * creation of a big number of subscriptions much cheaper.
+		 *
+		 * Either all collected subscriptions are created or none of them.
+		 * If \a lambda throws then no subscriptions are created.
+		 *
+		 * \par Usage sample:
+			\code
+			void a_sample_t::so_define_agent()
+			{
+				so_bulk_subscribe( [&] {
+					so_subscribe( mbox_target )
+						.in( state_one )
+						.event( &a_sample_t::evt_sample_handler )
+						.event( &a_sample_t::evt_another_handler );
+
+					state_two
+						.event( &a_sample_t::evt_yet_another_handler )
+						.event( mbox_target, &a_sample_t::evt_sample_handler );
+				} );
+			}
+			\endcode
+		 *
+		 * \note
+		 * Only creation of subscriptions is delayed. Other actions like
+		 * removal of subscriptions or so_has_subscription() are performed
+		 * immediately and don't see subscriptions collected so far.
+		 *
+		 * \note
+		 * A nested call to so_bulk_subscribe() just calls \a lambda.
+		 * Subscriptions will be created by the outer call.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		template< typename Lambda >
+		void
+		so_bulk_subscribe( Lambda && lambda );
+
 		/*!
 		 * \brief Create a subscription for an event.
 		 *
@@ -2351,6 +2469,28 @@ class SO_5_TYPE agent_t
 		 */
 		impl::subscription_storage_unique_ptr_t m_subscriptions;
 
+		/*!
+		 * \brief Cache for results of event handler searches.
+		 *
+		 * \note The cache is created only when necessary: if a search
+		 * of event handler requires more than one lookup in
+		 * the subscription storage.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::unique_ptr< impl::event_handler_cache_t > m_handler_cache;
+
+		/*!
+		 * \brief Subscriptions collected by so_bulk_subscribe().
+		 *
+		 * \note It isn't nullptr only inside so_bulk_subscribe().
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::unique_ptr< impl::pending_subscriptions_t > m_pending_subscriptions;
+
 		/*!
 		 * \since
 		 * v.5.5.4
@@ -2580,10 +2720,28 @@ class SO_5_TYPE agent_t
 			const message_limit::control_block_t * limit,
 			//! ID of mbox for this event.
 			mbox_id_t mbox_id,
-			//! Message type for event.
-			std::type_index msg_type,
+			//! Identifier of the message type.
+			message_type_id_t msg_type_id,
 			//! Event message.
 			const message_ref_t & message );
+
+		//! Push several events into the event queue.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		push_events_batch(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for those events.
+			mbox_id_t mbox_id,
+			//! Identifier of the message type.
+			message_type_id_t msg_type_id,
+			//! Event messages.
+			const message_ref_t * messages,
+			//! Count of event messages.
+			std::size_t count );
 		/*!
 		 * \}
 		 */
@@ -2794,6 +2952,64 @@ class SO_5_TYPE agent_t
 			execution_demand_t & demand,
 			const char * context_marker );
 
+		/*!
+		 * \brief Search for event handler with the usage of
+		 * the cache of search results.
+		 *
+		 * \return nullptr if event handler is not found.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		static const impl::event_handler_data_t *
+		find_event_handler(
+			execution_demand_t & demand,
+			//! Receives true if a deadletter handler is found.
+			bool & is_deadletter );
+
+		/*!
+		 * \brief Create a subscription or add it to the list of
+		 * pending subscriptions inside so_bulk_subscribe().
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		do_create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & msg_type,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety );
+
+		/*!
+		 * \name Helpers for so_bulk_subscribe().
+		 * \{
+		 */
+		void
+		start_bulk_subscription();
+
+		void
+		cancel_bulk_subscription() noexcept;
+
+		void
+		finish_bulk_subscription();
+		/*!
+		 * \}
+		 */
+
+		/*!
+		 * \brief Remove all results from the cache of event handler
+		 * searches.
+		 *
+		 * Must be called on every change of subscriptions.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		drop_event_handler_cache() noexcept;
+
 		/*!
 		 * \since
 		 * v.5.5.15
@@ -2908,6 +3124,26 @@ agent_t::so_set_delivery_filter(
 				} );
 	}
 
+template< typename Lambda >
+void
+agent_t::so_bulk_subscribe( Lambda && lambda )
+{
+	if( m_pending_subscriptions )
+		// It is a nested call.
+		// All subscriptions will be created by the outer call.
+		lambda();
+	else
+	{
+		start_bulk_subscription();
+
+		so_5::details::do_with_rollback_on_exception(
+				[&] { lambda(); },
+				[this] { cancel_bulk_subscription(); } );
+
+		finish_bulk_subscription();
+	}
+}
+
 //
 // subscription_bind_t implementation
 //
@@ -3065,7 +3301,29 @@ subscription_bind_t::transfer_to_state(
 	auto op_state = std::make_shared< transfer_op_state_t >(
 			m_agent, m_mbox_ref->id(), outliving_const(target_state) );
 
-	auto method = [op_state]( message_ref_t & msg )
+	// Message limit is not actual here.
+	const demand_descriptor_t * descriptor =
+			so_5::impl::unlimited_message_demand_descriptor(
+					message_type_id( typeid( Msg ) ),
+//FIXME: there can't be enveloped_msg so we can safely use
+//message_demand_kind_t::message.
+//
+//It is because `transfer_to_state` is handled as a normal event handler.
+//It means that during delivery of an enveloped_msg the payload will be
+//extracted and passed to `transfer_to_state` handler. And in the target
+//state a handler for the payload will be looked. Not for the initial
+//enveloped_msg.
+//
+//It is not good because in the target state hander can be missed and in
+//that case envelope will think that payload is delivered and that is not
+//true.
+//
+//This issue has been found too late and it is present in SO-5.6.0.
+//We hope it will be (somehow) fixed in the updates for SO-5.6.0.
+//
+					so_5::impl::message_demand_kind_t::message );
+
+	auto method = [op_state, descriptor]( message_ref_t & msg )
 		{
 			// The current transfer_to_state operation should be inactive.
 			if( op_state->m_in_progress )
@@ -3089,27 +3347,9 @@ subscription_bind_t::transfer_to_state(
 
 			execution_demand_t demand{
 					op_state->m_agent,
-					nullptr, // Message limit is not actual here.
+					descriptor,
 					op_state->m_mbox_id,
-					typeid( Msg ),
-					msg,
-//FIXME: there can't be enveloped_msg so we can safely use
-//get_demand_handler_on_message_ptr().
-//
-//It is because `transfer_to_state` is handled as a normal event handler.
-//It means that during delivery of an enveloped_msg the payload will be
-//extracted and passed to `transfer_to_state` handler. And in the target
-//state a handler for the payload will be looked. Not for the initial
-//enveloped_msg.
-//
-//It is not good because in the target state hander can be missed and in
-//that case envelope will think that payload is delivered and that is not
-//true.
-//
-//This issue has been found too late and it is present in SO-5.6.0.
-//We hope it will be (somehow) fixed in the updates for SO-5.6.0.
-//
-					agent_t::get_demand_handler_on_message_ptr()
+					msg
 			};
 
 			demand.call_handler( query_current_thread_id() );
@@ -30,6 +30,9 @@
 #include <so_5/disp/prio_one_thread/strictly_ordered/pub.hpp>
 #include <so_5/disp/prio_one_thread/quoted_round_robin/pub.hpp>
 #include <so_5/disp/prio_dedicated_threads/one_per_prio/pub.hpp>
+#include <so_5/disp/reactor/pub.hpp>
+#include <so_5/disp/edf/pub.hpp>
+#include <so_5/disp/prio_thread_pool/pub.hpp>
 
 #include <so_5/version.hpp>
 
@@ -290,6 +290,13 @@ class intrusive_ptr_t
 		}
 
 		//! Decrement reference count to object and delete it if needed.
+		/*!
+		 * \note
+		 * Since v.5.6.2 a message with pooled allocation has class-specific
+		 * operator delete (see so_5::pooled_message_allocation).
+		 * Because of that the memory of such message goes back to
+		 * so_5::message_pool here.
+		 */
 		void
 		dismiss_object() noexcept
 		{
@@ -9,6 +9,7 @@
 #include <so_5/details/rollback_on_exception.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
 
 #include <so_5/disp/reuse/work_thread/work_thread.hpp>
@@ -242,7 +243,12 @@ class dispatcher_template_t final : public actual_dispatcher_iface_t
 						auto thread = std::make_shared< Work_Thread >(
 								m_params.queue_params().lock_factory() );
 
-						thread->start();
+						thread->start(
+								so_5::disp::reuse::cpus_for_work_thread(
+										m_params.thread_affinity(),
+										m_threads_created ),
+								m_params.local_timers() );
+						++m_threads_created;
 
 						so_5::details::do_with_rollback_on_exception(
 								[&] {
@@ -372,6 +378,11 @@ class dispatcher_template_t final : public actual_dispatcher_iface_t
 								stats::suffixes::work_thread_queue_size(),
 								wt.m_thread->demands_count() );
 
+						so_5::disp::reuse::send_lock_stats(
+								mbox,
+								prefix,
+								*(wt.m_thread) );
+
 						send_thread_activity_stats(
 								mbox,
 								prefix,
@@ -388,6 +399,16 @@ class dispatcher_template_t final : public actual_dispatcher_iface_t
 		//! This object lock.
 		std::mutex m_lock;
 
+		/*!
+		 * \brief Count of threads created by the dispatcher.
+		 *
+		 * It is used as index of a new thread for CPU affinity.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::size_t m_threads_created{ 0u };
+
 		/*!
 		 * \brief Data source for run-time monitoring.
 		 *
@@ -455,6 +476,10 @@ make_dispatcher(
 	{
 		using namespace so_5::disp::reuse;
 
+		// Work threads are created later, when agents are bound.
+		// So an invalid affinity must be detected right now.
+		ensure_valid_thread_affinity( params.thread_affinity() );
+
 		using dispatcher_no_activity_tracking_t =
 				impl::dispatcher_template_t<
 						work_thread::work_thread_no_activity_tracking_t >;
@@ -10,6 +10,7 @@
 #include <so_5/details/rollback_on_exception.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
 
 #include <so_5/disp/reuse/work_thread/work_thread.hpp>
@@ -144,7 +145,12 @@ class dispatcher_template_t final : public disp_binder_t
 				auto thread = std::make_shared< Work_Thread >(
 						std::move(lock_factory) );
 
-				thread->start();
+				thread->start(
+						so_5::disp::reuse::cpus_for_work_thread(
+								m_params.thread_affinity(), m_threads_created ),
+						m_params.local_timers() );
+				++m_threads_created;
+
 				so_5::details::do_with_rollback_on_exception(
 						[&] { m_agent_threads[ &agent ] = thread; },
 						[&thread] { shutdown_and_wait( *thread ); } );
@@ -255,6 +261,7 @@ class dispatcher_template_t final : public disp_binder_t
 						const stats::prefix_t wt_prefix{ ss.str() };
 
 						send_demands_count_stats( mbox, wt_prefix, wt );
+						so_5::disp::reuse::send_lock_stats( mbox, wt_prefix, wt );
 						send_thread_activity_stats( mbox, wt_prefix, wt );
 					}
 			};
@@ -273,6 +280,16 @@ class dispatcher_template_t final : public disp_binder_t
 		//! A map from agents to single thread dispatchers.
 		agent_thread_map_t m_agent_threads;
 
+		/*!
+		 * \brief Count of threads created by the dispatcher.
+		 *
+		 * It is used as index of a new thread for CPU affinity.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::size_t m_threads_created{ 0u };
+
 		/*!
 		 * \brief Data source for run-time monitoring.
 		 *
@@ -310,6 +327,10 @@ make_dispatcher(
 	{
 		using namespace so_5::disp::reuse;
 
+		// Work threads are created later, when agents are bound.
+		// So an invalid affinity must be detected right now.
+		ensure_valid_thread_affinity( params.thread_affinity() );
+
 		using dispatcher_no_activity_tracking_t =
 				impl::dispatcher_template_t<
 						work_thread::work_thread_no_activity_tracking_t >;
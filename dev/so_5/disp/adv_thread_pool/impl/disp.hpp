@@ -20,12 +20,16 @@
 #include <so_5/stats/impl/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/work_stealing_ptr_queue.hpp>
 
 #include <so_5/disp/thread_pool/impl/common_implementation.hpp>
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 #include <forward_list>
+#include <memory>
 
 #if 0
 	#define SO_5_CHECK_INVARIANT_IMPL(what, data, file, line) \
@@ -53,30 +57,34 @@ namespace impl
 
 using spinlock_t = so_5::default_spinlock_t;
 
-class agent_queue_t;
-
 namespace stats = so_5::stats;
 namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
 
 //
-// dispatcher_queue_t
-//
-using dispatcher_queue_t = so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
-
-//
-// agent_queue_t
+// agent_queue_template_t
 //
 /*!
  * \brief Event queue for the agent (or cooperation).
  *
+ * \note Since v.5.6.2 it is a template. Type of dispatcher queue
+ * is specified by \a Dispatcher_Queue template.
+ *
+ * \tparam Dispatcher_Queue so_5::disp::reuse::mpmc_ptr_queue_t or
+ * so_5::disp::reuse::work_stealing_ptr_queue_t.
+ *
  * \since
  * v.5.4.0
  */
-class agent_queue_t final
+template< template< class > class Dispatcher_Queue >
+class agent_queue_template_t final
 	:	public event_queue_t
 	,	private so_5::atomic_refcounted_t
 	{
-		friend class so_5::intrusive_ptr_t< agent_queue_t >;
+		friend class so_5::intrusive_ptr_t< agent_queue_template_t >;
+
+	public :
+		//! Type of dispatcher queue to be used with that agent queue.
+		using dispatcher_queue_t = Dispatcher_Queue< agent_queue_template_t >;
 
 	private :
 		//! Actual demand in event queue.
@@ -102,20 +110,24 @@ class agent_queue_t final
 		static constexpr const unsigned int not_thread_safe_worker = 1;
 
 		//! Constructor.
-		agent_queue_t(
+		agent_queue_template_t(
 			//! Dispatcher queue to work with.
 			dispatcher_queue_t & disp_queue,
 			//! Dummy argument. It is necessary here because of
 			//! common implementation for thread-pool and
 			//! adv-thread-pool dispatchers.
-			const bind_params_t & )
+			const bind_params_t &,
+			//! Dummy argument. It is necessary here because of
+			//! common implementation for thread-pool and
+			//! adv-thread-pool dispatchers.
+			priority_t )
 			:	m_disp_queue( disp_queue )
 			,	m_tail( &m_head )
 			,	m_active( false )
 			,	m_workers( 0 )
 			{}
 
-		~agent_queue_t()
+		~agent_queue_template_t()
 			{
 				while( m_head.m_next )
 					delete_head();
@@ -165,6 +177,79 @@ class agent_queue_t final
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue at once.
+		/*!
+		 * Items for all demands are allocated before acquiring the lock.
+		 * Then the whole chain is appended to the queue under one
+		 * acquisition of the lock.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				demand_t * chain_head = nullptr;
+				demand_t * chain_tail = nullptr;
+
+				// Do memory allocation before spinlock locking.
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for( std::size_t i = 0u; i != count; ++i )
+							{
+								auto * d = new demand_t( std::move( demands[ i ] ) );
+								if( chain_tail )
+									chain_tail->m_next = d;
+								else
+									chain_head = d;
+								chain_tail = d;
+							}
+					},
+					[&] {
+						while( chain_head )
+							{
+								std::unique_ptr< demand_t > d{ chain_head };
+								chain_head = chain_head->m_next;
+							}
+					} );
+
+				bool need_schedule = false;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool was_empty = empty();
+
+					m_tail->m_next = chain_head;
+					m_tail = chain_tail;
+
+					m_size += count;
+
+					if( was_empty )
+						{
+							// Queue was empty. Need to detect
+							// necessity of queue activation.
+							if( !m_active )
+								if( !is_there_not_thread_safe_worker() )
+								{
+									need_schedule = true;
+									m_active = true;
+								}
+						}
+
+					SO_5_CHECK_INVARIANT( !empty(), this )
+					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
+					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
+				}
+
+				if( need_schedule )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the information about the front demand.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -316,27 +401,22 @@ class agent_queue_t final
 			}
 	};
 
-//
-// agent_queue_ref_t
-//
-/*!
- * \brief A typedef of smart pointer for agent_queue.
- *
- * \since
- * v.5.4.0
- */
-using agent_queue_ref_t = so_5::intrusive_ptr_t< agent_queue_t >;
-
 namespace work_thread_details {
 
 /*!
  * \brief Main data for work_thread.
  *
+ * \tparam Agent_Queue type of agent queue.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 struct common_data_t
 	{
+		using agent_queue_t = Agent_Queue;
+		using dispatcher_queue_t = typename Agent_Queue::dispatcher_queue_t;
+
 		//! Dispatcher's queue.
 		dispatcher_queue_t * m_disp_queue;
 
@@ -364,13 +444,17 @@ struct common_data_t
  * \since
  * v.5.5.18
  */
-class no_activity_tracking_impl_t : protected common_data_t
+template< typename Agent_Queue >
+class no_activity_tracking_impl_t : protected common_data_t< Agent_Queue >
 	{
 	public :
+		using typename common_data_t< Agent_Queue >::agent_queue_t;
+		using typename common_data_t< Agent_Queue >::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		no_activity_tracking_impl_t(
 			dispatcher_queue_t & queue )
-			:	common_data_t( queue )
+			:	common_data_t< Agent_Queue >( queue )
 			{}
 
 		template< typename L >
@@ -397,15 +481,19 @@ class no_activity_tracking_impl_t : protected common_data_t
  * \since
  * v.5.5.18
  */
-class with_activity_tracking_impl_t : protected common_data_t
+template< typename Agent_Queue >
+class with_activity_tracking_impl_t : protected common_data_t< Agent_Queue >
 	{
 		using activity_tracking_traits = so_5::stats::activity_tracking_stuff::traits;
 
 	public :
+		using typename common_data_t< Agent_Queue >::agent_queue_t;
+		using typename common_data_t< Agent_Queue >::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		with_activity_tracking_impl_t(
 			dispatcher_queue_t & queue )
-			:	common_data_t( queue )
+			:	common_data_t< Agent_Queue >( queue )
 			{}
 
 		template< typename L >
@@ -416,6 +504,7 @@ class with_activity_tracking_impl_t : protected common_data_t
 
 				result.m_working_stats = m_work_activity_collector.take_stats();
 				result.m_waiting_stats = m_waiting_stats_collector.take_stats();
+				result.m_cpu = m_cpu.load( std::memory_order_relaxed );
 
 				lambda( result );
 			}
@@ -434,6 +523,14 @@ class with_activity_tracking_impl_t : protected common_data_t
 					so_5::stats::activity_tracking_stuff::external_lock<> >
 				m_waiting_stats_collector{ m_stats_lock };
 
+		/*!
+		 * \brief CPU on which the thread was woken up last time.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::atomic< int > m_cpu{ -1 };
+
 		void
 		work_started()
 			{
@@ -456,6 +553,9 @@ class with_activity_tracking_impl_t : protected common_data_t
 		wait_finished()
 			{
 				m_waiting_stats_collector.stop();
+				m_cpu.store(
+						so_5::disp::reuse::current_cpu(),
+						std::memory_order_relaxed );
 			}
 	};
 
@@ -474,6 +574,9 @@ template< typename Impl >
 class work_thread_template_t final : public Impl
 	{
 	public :
+		using typename Impl::agent_queue_t;
+		using typename Impl::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		work_thread_template_t( dispatcher_queue_t & queue )
 			:	Impl( queue )
@@ -488,9 +591,14 @@ class work_thread_template_t final : public Impl
 
 		//! Launch work thread.
 		void
-		start()
+		start(
+			//! CPUs on which the thread is allowed to run.
+			so_5::disp::reuse::cpu_list_t cpus )
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				this->m_thread = std::thread( [this, cpus = std::move(cpus)]() {
+						so_5::disp::reuse::bind_current_thread( cpus );
+						body();
+					} );
 			}
 
 		/*!
@@ -508,6 +616,18 @@ class work_thread_template_t final : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Get the condition object of work thread.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const so_5::disp::mpmc_queue_traits::condition_t *
+		condition() const noexcept
+			{
+				return this->m_condition.get();
+			}
+
 	private :
 		//! Thread body method.
 		void
@@ -520,7 +640,8 @@ class work_thread_template_t final : public Impl
 					{
 						// This guard is necessary to ensure that queue
 						// will exist until processing of queue finished.
-						agent_queue_ref_t agent_queue_guard( agent_queue );
+						so_5::intrusive_ptr_t< agent_queue_t > agent_queue_guard(
+								agent_queue );
 
 						process_queue( *agent_queue );
 					}
@@ -618,18 +739,45 @@ class work_thread_template_t final : public Impl
 
 } /* namespace work_thread_details */
 
+//
+// central_agent_queue_t
+//
+/*!
+ * \brief Type of agent queue for dispatcher with the central queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+using central_agent_queue_t =
+		agent_queue_template_t< so_5::disp::reuse::mpmc_ptr_queue_t >;
+
+//
+// work_stealing_agent_queue_t
+//
+/*!
+ * \brief Type of agent queue for dispatcher with work stealing.
+ *
+ * \since
+ * v.5.6.2
+ */
+using work_stealing_agent_queue_t =
+		agent_queue_template_t< so_5::disp::reuse::work_stealing_ptr_queue_t >;
+
 //
 // work_thread_no_activity_tracking_t
 //
 /*!
  * \brief Type of work thread without activity tracking.
  *
+ * \note Since v.5.6.2 it is a template.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 using work_thread_no_activity_tracking_t =
 		work_thread_details::work_thread_template_t<
-				work_thread_details::no_activity_tracking_impl_t >;
+				work_thread_details::no_activity_tracking_impl_t< Agent_Queue > >;
 
 //
 // work_thread_with_activity_tracking_t
@@ -637,12 +785,15 @@ using work_thread_no_activity_tracking_t =
 /*!
  * \brief Type of work thread without activity tracking.
  *
+ * \note Since v.5.6.2 it is a template.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 using work_thread_with_activity_tracking_t =
 		work_thread_details::work_thread_template_t<
-				work_thread_details::with_activity_tracking_impl_t >;
+				work_thread_details::with_activity_tracking_impl_t< Agent_Queue > >;
 
 //
 // adaptation_t
@@ -670,8 +821,9 @@ struct adaptation_t
 				return fifo_t::individual == params.query_fifo();
 			}
 
+		template< typename Agent_Queue >
 		static void
-		wait_for_queue_emptyness( agent_queue_t & /*queue*/ ) noexcept
+		wait_for_queue_emptyness( Agent_Queue & /*queue*/ ) noexcept
 			{
 				// This type of agent_queue doesn't require waiting for emptyness.
 			}
@@ -693,8 +845,8 @@ template< typename Work_Thread >
 using dispatcher_template_t =
 		so_5::disp::thread_pool::common_implementation::dispatcher_t<
 				Work_Thread,
-				dispatcher_queue_t,
-				agent_queue_t,
+				typename Work_Thread::dispatcher_queue_t,
+				typename Work_Thread::agent_queue_t,
 				bind_params_t,
 				adaptation_t >;
 
@@ -152,7 +152,7 @@ class actual_dispatcher_implementation_t final
 			disp_params_t params )
 			:	m_impl{ name_base, params.thread_count(), params.queue_params() }
 			{
-				m_impl.start( env.get() );
+				m_impl.start( env.get(), params.thread_affinity() );
 			}
 
 		~actual_dispatcher_implementation_t() noexcept override
@@ -228,36 +228,55 @@ adjust_thread_count( disp_params_t & params )
 			params.thread_count( default_thread_pool_size() );
 	}
 
-} /* namespace anonymous */
-
-//
-// make_dispatcher
-//
-SO_5_FUNC dispatcher_handle_t
-make_dispatcher(
+/*!
+ * \brief Creation of dispatcher instance for the specified type
+ * of agent queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Agent_Queue >
+std::unique_ptr< impl::actual_dispatcher_iface_t >
+make_actual_dispatcher_for(
 	environment_t & env,
 	const std::string_view data_sources_name_base,
 	disp_params_t params )
 	{
-		using namespace so_5::disp::reuse;
-
-		adjust_thread_count( params );
-
 		using dispatcher_no_activity_tracking_t =
 				impl::actual_dispatcher_implementation_t<
-						impl::work_thread_no_activity_tracking_t >;
+						impl::work_thread_no_activity_tracking_t< Agent_Queue > >;
 
 		using dispatcher_with_activity_tracking_t =
 				impl::actual_dispatcher_implementation_t<
-						impl::work_thread_with_activity_tracking_t >;
+						impl::work_thread_with_activity_tracking_t< Agent_Queue > >;
 
-		auto binder = so_5::disp::reuse::make_actual_dispatcher<
+		return so_5::disp::reuse::make_actual_dispatcher<
 						impl::actual_dispatcher_iface_t,
 						dispatcher_no_activity_tracking_t,
 						dispatcher_with_activity_tracking_t >(
 				outliving_reference_t(env),
 				data_sources_name_base,
 				std::move(params) );
+	}
+
+} /* namespace anonymous */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+		adjust_thread_count( params );
+
+		auto binder = scheduling_t::work_stealing == params.scheduling() ?
+				make_actual_dispatcher_for< impl::work_stealing_agent_queue_t >(
+						env, data_sources_name_base, std::move(params) ) :
+				make_actual_dispatcher_for< impl::central_agent_queue_t >(
+						env, data_sources_name_base, std::move(params) );
 
 		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
 	}
@@ -19,9 +19,12 @@
 #include <so_5/disp/mpmc_queue_traits/pub.hpp>
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+#include <so_5/disp/reuse/thread_pool_scheduling.hpp>
 
 #include <utility>
 #include <thread>
+#include <string_view>
 
 namespace so_5
 {
@@ -40,6 +43,14 @@ namespace adv_thread_pool
  */
 namespace queue_traits = so_5::disp::mpmc_queue_traits;
 
+/*!
+ * \brief Alias for type of scheduling of agent queues.
+ *
+ * \since
+ * v.5.6.2
+ */
+using scheduling_t = so_5::disp::thread_pool_scheduling_t;
+
 //
 // disp_params_t
 //
@@ -51,9 +62,15 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
  */
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_pool_scheduling_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+		using scheduling_mixin_t = so_5::disp::reuse::
+				thread_pool_scheduling_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -66,6 +83,12 @@ class disp_params_t
 				swap(
 						static_cast< activity_tracking_mixin_t & >(a),
 						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+				swap(
+						static_cast< scheduling_mixin_t & >(a),
+						static_cast< scheduling_mixin_t & >(b) );
 
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
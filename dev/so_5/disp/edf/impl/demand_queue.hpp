@@ -0,0 +1,400 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A demand queue for %edf dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/disp/edf/pub.hpp>
+
+#include <so_5/execution_demand.hpp>
+#include <so_5/event_queue.hpp>
+#include <so_5/agent.hpp>
+#include <so_5/message_limit.hpp>
+#include <so_5/optional.hpp>
+
+#include <so_5/disp/reuse/intrusive_free_list.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace edf {
+
+namespace impl {
+
+//
+// demand_t
+//
+/*!
+ * \brief A single execution demand with its deadline.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct demand_t final : public execution_demand_t
+	{
+		//! Next demand in the free-list.
+		demand_t * m_next = nullptr;
+
+		//! Position of the demand in the queue.
+		/*!
+		 * It is the effective deadline of the demand. It can differ
+		 * from the deadline of the message.
+		 */
+		deadline_t m_key;
+
+		//! Serial number of the demand.
+		/*!
+		 * It preserves FIFO order for demands with the same key.
+		 */
+		std::uint_fast64_t m_serial{ 0u };
+
+		//! Deadline of the message.
+		/*!
+		 * Has the value only for messages sent by send_with_deadline().
+		 */
+		optional< deadline_t > m_deadline;
+
+		//! Initializing constructor.
+		demand_t( execution_demand_t && source )
+			:	execution_demand_t( std::move( source ) )
+			{}
+
+		//! Replace the content of the demand.
+		void
+		assign( execution_demand_t && source ) noexcept
+			{
+				static_cast< execution_demand_t & >(*this) = std::move( source );
+				m_deadline.reset();
+			}
+	};
+
+//
+// demand_unique_ptr_t
+//
+/*!
+ * \brief An alias for unique_ptr to demand.
+ *
+ * \since
+ * v.5.6.2
+ */
+using demand_unique_ptr_t = std::unique_ptr< demand_t >;
+
+//
+// demand_queue_t
+//
+/*!
+ * \brief A demand queue which orders demands by their deadlines.
+ *
+ * Demands are stored in a binary heap. Push and pop have
+ * O(log n) complexity.
+ *
+ * \since
+ * v.5.6.2
+ */
+class demand_queue_t final : public event_queue_t
+	{
+	public :
+		//! Type of pointer to a demand extracted from the queue.
+		using demand_ptr_t = demand_unique_ptr_t;
+
+		//! This exception is thrown when pop is called after stop.
+		class shutdown_ex_t : public std::exception
+			{};
+
+		demand_queue_t(
+			//! Lock to be used for queue protection.
+			queue_traits::lock_unique_ptr_t lock,
+			//! Deadline for messages without a deadline.
+			std::chrono::steady_clock::duration default_timeout,
+			//! Should expired demands be dropped?
+			bool drop_expired )
+			:	m_lock{ std::move(lock) }
+			,	m_default_timeout{ default_timeout }
+			,	m_drop_expired{ drop_expired }
+			{}
+
+		~demand_queue_t() override
+			{
+				for( auto * d : m_heap )
+					delete d;
+			}
+
+		void
+		push( execution_demand_t demand ) override
+			{
+				const auto now = std::chrono::steady_clock::now();
+				const auto deadline = deadline_of( demand );
+
+				{
+					queue_traits::lock_guard_t lock{ *m_lock };
+
+					demand_t * item = m_free_demands.try_take();
+					if( item )
+						{
+							item->assign( std::move( demand ) );
+							push_under_lock(
+									lock, now, deadline, demand_unique_ptr_t{ item } );
+							return;
+						}
+				}
+
+				// There is no free item. A new one must be created
+				// when the lock is released.
+				demand_unique_ptr_t what{ new demand_t{ std::move( demand ) } };
+
+				queue_traits::lock_guard_t lock{ *m_lock };
+				push_under_lock( lock, now, deadline, std::move( what ) );
+			}
+
+		//! Set the shutdown signal.
+		void
+		stop()
+			{
+				queue_traits::lock_guard_t lock{ *m_lock };
+
+				m_shutdown = true;
+
+				if( m_heap.empty() )
+					// There could be a sleeping working thread.
+					// It must be notified.
+					lock.notify_one();
+			}
+
+		//! Pop the demand with the earliest deadline from the queue.
+		/*!
+		 * Expired demands are dropped here if it is necessary.
+		 *
+		 * \throw shutdown_ex_t in the case when queue is shut down.
+		 */
+		demand_unique_ptr_t
+		pop(
+			//! The previously extracted demand. Can be nullptr.
+			demand_unique_ptr_t processed )
+			{
+				for(;;)
+					{
+						// The processed demand must be destroyed when the lock
+						// is released.
+						if( processed )
+							processed->assign( execution_demand_t{} );
+
+						queue_traits::unique_lock_t lock{ *m_lock };
+
+						if( processed && m_free_demands.try_put( processed.get() ) )
+							processed.release();
+
+						while( !m_shutdown && m_heap.empty() )
+							lock.wait_for_notify();
+
+						if( m_shutdown )
+							throw shutdown_ex_t();
+
+						std::pop_heap( m_heap.begin(), m_heap.end(), later_than );
+						demand_unique_ptr_t result{ m_heap.back() };
+						m_heap.pop_back();
+						--m_demands_count;
+
+						if( !result->m_deadline ||
+								std::chrono::steady_clock::now() <= *(result->m_deadline) )
+							return result;
+
+						m_misses.fetch_add( 1u, std::memory_order_relaxed );
+						if( !m_drop_expired )
+							return result;
+
+						m_drops.fetch_add( 1u, std::memory_order_relaxed );
+
+						// The message won't be handled, but it has to be
+						// taken into account by message limits.
+						message_limit::control_block_t::decrement( result->limit() );
+
+						processed = std::move( result );
+					}
+			}
+
+		//! Notification about attachment of yet another agent to the queue.
+		void
+		agent_bound() noexcept
+			{
+				++m_agents_count;
+			}
+
+		//! Notification about detachment of an agent from the queue.
+		void
+		agent_unbound() noexcept
+			{
+				--m_agents_count;
+			}
+
+		//! Count of agents bound to the queue.
+		std::size_t
+		agents_count() const noexcept
+			{
+				return m_agents_count.load( std::memory_order_relaxed );
+			}
+
+		//! Count of demands in the queue.
+		std::size_t
+		demands_count() const noexcept
+			{
+				return m_demands_count.load( std::memory_order_relaxed );
+			}
+
+		//! Count of demands started (or dropped) after their deadlines.
+		std::size_t
+		misses_count() const noexcept
+			{
+				return m_misses.load( std::memory_order_relaxed );
+			}
+
+		//! Count of demands dropped because of expired deadlines.
+		std::size_t
+		drops_count() const noexcept
+			{
+				return m_drops.load( std::memory_order_relaxed );
+			}
+
+		/*!
+		 * \brief Get stats of waiting on the queue lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 */
+		bool
+		query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+			{
+				return m_lock->query_stats( to );
+			}
+
+	private :
+		//! Queue lock.
+		queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Deadline for messages without a deadline.
+		const std::chrono::steady_clock::duration m_default_timeout;
+
+		//! Should expired demands be dropped?
+		const bool m_drop_expired;
+
+		//! Items which can be reused for new demands.
+		so_5::disp::reuse::intrusive_free_list_t< demand_t > m_free_demands;
+
+		//! Shutdown flag.
+		bool m_shutdown = false;
+
+		//! Demands in the form of binary heap.
+		/*!
+		 * The demand with the earliest key is at the front.
+		 */
+		std::vector< demand_t * > m_heap;
+
+		//! Serial number for the next demand.
+		std::uint_fast64_t m_serial{ 0u };
+
+		//! The greatest key which was assigned to a demand.
+		deadline_t m_max_key{};
+
+		/*!
+		 * \name Information for run-time monitoring.
+		 * \{
+		 */
+		std::atomic< std::size_t > m_agents_count{ 0u };
+		std::atomic< std::size_t > m_demands_count{ 0u };
+		std::atomic< std::size_t > m_misses{ 0u };
+		std::atomic< std::size_t > m_drops{ 0u };
+		/*!
+		 * \}
+		 */
+
+		//! Comparator for the heap.
+		static bool
+		later_than( const demand_t * a, const demand_t * b ) noexcept
+			{
+				if( a->m_key != b->m_key )
+					return a->m_key > b->m_key;
+				return a->m_serial > b->m_serial;
+			}
+
+		//! Get the deadline of a message if it is present.
+		static optional< deadline_t >
+		deadline_of( const execution_demand_t & demand ) noexcept
+			{
+				if( message_t::kind_t::enveloped_msg ==
+						message_kind( demand.m_message_ref ) )
+					{
+						const auto * envelope = dynamic_cast< const deadline_envelope_t * >(
+								demand.m_message_ref.get() );
+						if( envelope )
+							return envelope->deadline();
+					}
+
+				return {};
+			}
+
+		//! Push a new demand to the queue when the lock is acquired.
+		void
+		push_under_lock(
+			//! Acquired lock.
+			queue_traits::lock_guard_t & lock,
+			//! Time of the demand's arrival.
+			deadline_t now,
+			//! Deadline of the message.
+			optional< deadline_t > deadline,
+			//! Demand to be pushed.
+			demand_unique_ptr_t demand )
+			{
+				if( agent_t::get_demand_handler_on_finish_ptr() ==
+						demand->m_descriptor->m_demand_handler )
+					// Finish of an agent must be handled after all demands
+					// of that agent already in the queue.
+					demand->m_key = std::max( now, m_max_key );
+				else if( agent_t::get_demand_handler_on_start_ptr() ==
+						demand->m_descriptor->m_demand_handler )
+					// Start of an agent must be handled before
+					// all subsequent demands for that agent.
+					demand->m_key = now;
+				else
+					{
+						demand->m_deadline = deadline;
+						demand->m_key = std::max( now,
+								demand->m_deadline ? *(demand->m_deadline)
+										: now + m_default_timeout );
+					}
+
+				demand->m_serial = ++m_serial;
+				m_max_key = std::max( m_max_key, demand->m_key );
+
+				m_heap.push_back( demand.get() );
+				std::push_heap( m_heap.begin(), m_heap.end(), later_than );
+				demand.release();
+
+				++m_demands_count;
+
+				if( 1u == m_heap.size() )
+					// Queue was empty. A sleeping working thread must
+					// be notified.
+					lock.notify_one();
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace edf */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,280 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A dispatcher with one work thread which handles demands
+ * in the order of their deadlines (earliest deadline first).
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/disp/edf/pub.hpp>
+
+#include <so_5/disp/edf/impl/demand_queue.hpp>
+#include <so_5/disp/prio_one_thread/reuse/work_thread.hpp>
+
+#include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
+#include <so_5/disp/reuse/make_actual_dispatcher.hpp>
+
+#include <so_5/stats/repository.hpp>
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
+
+#include <so_5/send_functions.hpp>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace edf {
+
+//
+// deadline_envelope_t
+//
+void
+deadline_envelope_t::access_hook(
+	access_context_t /*context*/,
+	handler_invoker_t & invoker ) noexcept
+	{
+		// The payload is always available. The deadline is checked
+		// only by the dispatcher.
+		invoker.invoke( payload_info_t{ m_payload } );
+	}
+
+namespace impl {
+
+namespace stats = so_5::stats;
+
+namespace work_thread = so_5::disp::prio_one_thread::reuse;
+
+namespace {
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t &,
+	const stats::prefix_t &,
+	work_thread::work_thread_no_activity_tracking_t< demand_queue_t > & )
+	{
+		/* Nothing to do */
+	}
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	work_thread::work_thread_with_activity_tracking_t< demand_queue_t > & wt )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.thread_id(),
+				wt.take_activity_stats() );
+	}
+
+} /* namespace anonymous */
+
+//
+// dispatcher_template_t
+//
+/*!
+ * \brief An implementation of %edf dispatcher in form of template class.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Work_Thread >
+class dispatcher_template_t final : public disp_binder_t
+	{
+		friend class disp_data_source_t;
+
+	public:
+		dispatcher_template_t(
+			outliving_reference_t< environment_t > env,
+			const std::string_view name_base,
+			disp_params_t params )
+			:	m_demand_queue{
+					params.queue_params().lock_factory()(),
+					params.default_timeout(),
+					params.drop_expired()
+				}
+			,	m_work_thread{ m_demand_queue }
+			,	m_data_source{
+					outliving_mutable(env.get().stats_repository()),
+					name_base,
+					outliving_mutable(*this)
+				}
+			{
+				m_work_thread.start(
+						so_5::disp::reuse::cpus_for_work_thread(
+								params.thread_affinity(), 0u ) );
+			}
+
+		~dispatcher_template_t() noexcept override
+			{
+				m_demand_queue.stop();
+				m_work_thread.join();
+			}
+
+		void
+		preallocate_resources(
+			agent_t & /*agent*/ ) override
+			{
+				// Nothing to do.
+			}
+
+		void
+		undo_preallocation(
+			agent_t & /*agent*/ ) noexcept override
+			{
+				// Nothing to do.
+			}
+
+		void
+		bind(
+			agent_t & agent ) noexcept override
+			{
+				agent.so_bind_to_dispatcher( m_demand_queue );
+
+				m_demand_queue.agent_bound();
+			}
+
+		void
+		unbind(
+			agent_t & /*agent*/ ) noexcept override
+			{
+				m_demand_queue.agent_unbound();
+			}
+
+	private:
+
+		/*!
+		 * \brief Data source for run-time monitoring of whole dispatcher.
+		 */
+		class disp_data_source_t : public stats::source_t
+			{
+				//! Dispatcher to work with.
+				outliving_reference_t< dispatcher_template_t > m_dispatcher;
+
+				//! Basic prefix for data sources.
+				stats::prefix_t m_base_prefix;
+
+			public :
+				disp_data_source_t(
+					const std::string_view name_base,
+					outliving_reference_t< dispatcher_template_t > disp )
+					:	m_dispatcher{ disp }
+					,	m_base_prefix{ so_5::disp::reuse::make_disp_prefix(
+								"edf",
+								name_base,
+								&(disp.get()) )
+						}
+					{}
+
+				void
+				distribute( const mbox_t & mbox ) override
+					{
+						auto & disp = m_dispatcher.get();
+						const auto & queue = disp.m_demand_queue;
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								queue.agents_count() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::work_thread_queue_size(),
+								queue.demands_count() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::deadline_miss_count(),
+								queue.misses_count() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::expired_demand_drop_count(),
+								queue.drops_count() );
+
+						so_5::disp::reuse::send_lock_stats(
+								mbox,
+								m_base_prefix,
+								queue );
+
+						send_thread_activity_stats(
+								mbox,
+								m_base_prefix,
+								disp.m_work_thread );
+					}
+			};
+
+		//! Demand queue for the dispatcher.
+		demand_queue_t m_demand_queue;
+
+		//! Working thread for the dispatcher.
+		Work_Thread m_work_thread;
+
+		//! Data source for run-time monitoring.
+		stats::auto_registered_source_holder_t< disp_data_source_t >
+				m_data_source;
+	};
+
+//
+// dispatcher_handle_maker_t
+//
+class dispatcher_handle_maker_t
+	{
+	public :
+		static dispatcher_handle_t
+		make( disp_binder_shptr_t binder ) noexcept
+			{
+				return { std::move( binder ) };
+			}
+	};
+
+} /* namespace impl */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+		using namespace so_5::disp::prio_one_thread::reuse;
+
+		using dispatcher_no_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread_no_activity_tracking_t< impl::demand_queue_t > >;
+
+		using dispatcher_with_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread_with_activity_tracking_t< impl::demand_queue_t > >;
+
+		disp_binder_shptr_t binder = so_5::disp::reuse::make_actual_dispatcher<
+						disp_binder_t,
+						dispatcher_no_activity_tracking_t,
+						dispatcher_with_activity_tracking_t >(
+				outliving_reference_t(env),
+				data_sources_name_base,
+				std::move(params) );
+
+		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
+	}
+
+} /* namespace edf */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
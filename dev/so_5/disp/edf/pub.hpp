@@ -0,0 +1,437 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A dispatcher with one work thread which handles demands
+ * in the order of their deadlines (earliest deadline first).
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp_binder.hpp>
+#include <so_5/enveloped_msg.hpp>
+#include <so_5/send_functions.hpp>
+
+#include <so_5/disp/mpsc_queue_traits/pub.hpp>
+
+#include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+
+#include <chrono>
+#include <string_view>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace edf {
+
+/*!
+ * \brief Alias for namespace with traits of event queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+namespace queue_traits = so_5::disp::mpsc_queue_traits;
+
+//
+// deadline_t
+//
+/*!
+ * \brief Type of deadline for a message.
+ *
+ * \since
+ * v.5.6.2
+ */
+using deadline_t = std::chrono::steady_clock::time_point;
+
+//
+// deadline_envelope_t
+//
+/*!
+ * \brief An envelope which holds a message with a deadline.
+ *
+ * The deadline is used by %edf dispatcher for ordering of demands.
+ * For other dispatchers this envelope is transparent: the payload
+ * is always delivered to a receiver.
+ *
+ * Usually this envelope is not used directly but via
+ * send_with_deadline() function.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_TYPE deadline_envelope_t final
+	:	public so_5::enveloped_msg::envelope_t
+	{
+	public :
+		deadline_envelope_t(
+			deadline_t deadline,
+			message_ref_t payload ) noexcept
+			:	m_deadline{ deadline }
+			,	m_payload{ std::move(payload) }
+			{}
+
+		void
+		access_hook(
+			access_context_t context,
+			handler_invoker_t & invoker ) noexcept override;
+
+		//! Deadline for the payload.
+		deadline_t
+		deadline() const noexcept
+			{
+				return m_deadline;
+			}
+
+	private :
+		//! Deadline for the payload.
+		const deadline_t m_deadline;
+
+		//! Message to be delivered.
+		const message_ref_t m_payload;
+	};
+
+//
+// send_with_deadline
+//
+/*!
+ * \brief Send a message which should be handled before the deadline.
+ *
+ * If the receiver is bound to %edf dispatcher then demands are
+ * handled in the order of their deadlines. For receivers on other
+ * dispatchers it is an ordinary send().
+ *
+ * Usage example:
+ * \code
+	// A control message overtakes bulk traffic.
+	so_5::disp::edf::send_with_deadline< change_mode >(
+			processor,
+			std::chrono::steady_clock::now() + std::chrono::milliseconds(5),
+			mode::standby );
+ * \endcode
+ *
+ * \tparam Message type of message to be sent (it can be in form of
+ * Msg, so_5::immutable_msg<Msg> or so_5::mutable_msg<Msg>). Signals
+ * are supported too.
+ * \tparam Target can be so_5::mbox_t, so_5::agent_t or so_5::mchain_t.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename Target, typename... Args >
+void
+send_with_deadline(
+	//! Destination for the message.
+	Target && to,
+	//! Deadline for the message.
+	deadline_t deadline,
+	//! Message constructor parameters.
+	Args &&... args )
+	{
+		auto payload = so_5::details::make_message_instance< Message >(
+				std::forward< Args >(args)... );
+		if( payload )
+			so_5::details::mark_as_mutable_if_necessary< Message >( *payload );
+
+		so_5::low_level_api::deliver_message(
+				*send_functions_details::arg_to_mbox( std::forward<Target>(to) ),
+				message_payload_type< Message >::subscription_type_index(),
+				message_ref_t{ std::make_unique< deadline_envelope_t >(
+						deadline,
+						message_ref_t{ std::move(payload) } ) } );
+	}
+
+/*!
+ * \brief Send a message which should be handled within the
+ * specified time.
+ *
+ * Usage example:
+ * \code
+	so_5::disp::edf::send_with_deadline< change_mode >(
+			processor, std::chrono::milliseconds(5), mode::standby );
+ * \endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename Target, typename... Args >
+void
+send_with_deadline(
+	//! Destination for the message.
+	Target && to,
+	//! Time for handling of the message.
+	std::chrono::steady_clock::duration timeout,
+	//! Message constructor parameters.
+	Args &&... args )
+	{
+		send_with_deadline< Message >(
+				std::forward< Target >(to),
+				std::chrono::steady_clock::now() + timeout,
+				std::forward< Args >(args)... );
+	}
+
+//
+// disp_params_t
+//
+/*!
+ * \brief Parameters for %edf dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class disp_params_t
+	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	{
+		using activity_tracking_mixin_t = so_5::disp::reuse::
+				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+
+	public :
+		//! Default constructor.
+		disp_params_t() = default;
+
+		friend inline void
+		swap( disp_params_t & a, disp_params_t & b ) noexcept
+			{
+				swap(
+						static_cast< activity_tracking_mixin_t & >(a),
+						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+
+				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_default_timeout, b.m_default_timeout );
+				std::swap( a.m_drop_expired, b.m_drop_expired );
+			}
+
+		//! Setter for queue parameters.
+		disp_params_t &
+		set_queue_params( queue_traits::queue_params_t p )
+			{
+				m_queue_params = std::move(p);
+				return *this;
+			}
+
+		//! Tuner for queue parameters.
+		/*!
+		 * Accepts lambda-function or functional object which tunes
+		 * queue parameters.
+			\code
+			auto disp = so_5::disp::edf::make_dispatcher( env,
+				"my_edf_disp",
+				so_5::disp::edf::disp_params_t{}.tune_queue_params(
+					[]( so_5::disp::edf::queue_traits::queue_params_t & p ) {
+						p.lock_factory( so_5::disp::edf::queue_traits::simple_lock_factory() );
+					} ) );
+			\endcode
+		 */
+		template< typename L >
+		disp_params_t &
+		tune_queue_params( L tunner )
+			{
+				tunner( m_queue_params );
+				return *this;
+			}
+
+		//! Getter for queue parameters.
+		const queue_traits::queue_params_t &
+		queue_params() const noexcept
+			{
+				return m_queue_params;
+			}
+
+		//! Setter for deadline of messages sent without a deadline.
+		/*!
+		 * Such messages receive deadline `arrival_time + v`.
+		 * The default value is zero: they are ordered by the time of
+		 * their arrival. A greater value allows messages with deadlines
+		 * to overtake ordinary messages.
+		 */
+		disp_params_t &
+		default_timeout( std::chrono::steady_clock::duration v )
+			{
+				m_default_timeout = v;
+				return *this;
+			}
+
+		//! Getter for deadline of messages sent without a deadline.
+		std::chrono::steady_clock::duration
+		default_timeout() const noexcept
+			{
+				return m_default_timeout;
+			}
+
+		//! Setter for dropping of expired demands.
+		/*!
+		 * If \a v is true then a message with expired deadline is
+		 * thrown out instead of being handled. Only messages sent
+		 * by send_with_deadline() can be thrown out.
+		 */
+		disp_params_t &
+		drop_expired( bool v )
+			{
+				m_drop_expired = v;
+				return *this;
+			}
+
+		//! Getter for dropping of expired demands.
+		bool
+		drop_expired() const noexcept
+			{
+				return m_drop_expired;
+			}
+
+	private :
+		//! Queue parameters.
+		queue_traits::queue_params_t m_queue_params;
+
+		//! Deadline for messages sent without a deadline.
+		std::chrono::steady_clock::duration m_default_timeout{
+				std::chrono::steady_clock::duration::zero() };
+
+		//! Should expired demands be dropped?
+		bool m_drop_expired{ false };
+	};
+
+namespace impl
+{
+
+class dispatcher_handle_maker_t;
+
+} /* namespace impl */
+
+//
+// dispatcher_handle_t
+//
+
+/*!
+ * \brief A handle for %edf dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_NODISCARD dispatcher_handle_t
+	{
+		friend class impl::dispatcher_handle_maker_t;
+
+		//! Binder for the dispatcher.
+		disp_binder_shptr_t m_binder;
+
+		dispatcher_handle_t( disp_binder_shptr_t binder ) noexcept
+			:	m_binder{ std::move(binder) }
+			{}
+
+		//! Is this handle empty?
+		bool
+		empty() const noexcept { return !m_binder; }
+
+	public :
+		dispatcher_handle_t() noexcept = default;
+
+		//! Get a binder for that dispatcher.
+		SO_5_NODISCARD
+		disp_binder_shptr_t
+		binder() const noexcept
+			{
+				return m_binder;
+			}
+
+		//! Is this handle empty?
+		operator bool() const noexcept { return empty(); }
+
+		//! Does this handle contain a reference to dispatcher?
+		bool
+		operator!() const noexcept { return !empty(); }
+
+		//! Drop the content of handle.
+		void
+		reset() noexcept { m_binder.reset(); }
+	};
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %edf dispatcher.
+ *
+ * All agents bound to the dispatcher work on one work thread.
+ * Demands are handled in the order of deadlines of their messages.
+ * Deadlines are set by send_with_deadline(). Other demands receive
+ * deadline `arrival_time + disp_params_t::default_timeout()`.
+ *
+ * A deadline earlier than the arrival time is treated as the arrival
+ * time for ordering. Because of that so_evt_start() is always the first
+ * event of an agent. The so_evt_finish() is handled after all demands
+ * already in the queue.
+ *
+ * \par Usage sample
+\code
+auto disp = so_5::disp::edf::make_dispatcher(
+	env,
+	"control",
+	so_5::disp::edf::disp_params_t{}
+		.default_timeout( std::chrono::seconds(1) )
+		.drop_expired( true ) );
+env.introduce_coop( disp.binder(), []( so_5::coop_t & coop ) {...} );
+\endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Parameters for the dispatcher.
+	disp_params_t params );
+
+/*!
+ * \brief Create an instance of %edf dispatcher with the default
+ * parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base )
+	{
+		return make_dispatcher( env, data_sources_name_base, disp_params_t{} );
+	}
+
+/*!
+ * \brief Create an instance of %edf dispatcher with the default
+ * parameters and without a name.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher( environment_t & env )
+	{
+		return make_dispatcher( env, std::string_view{} );
+	}
+
+} /* namespace edf */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
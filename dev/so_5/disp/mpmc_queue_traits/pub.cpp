@@ -14,6 +14,8 @@
 
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/disp/reuse/spin_budget.hpp>
+
 #include <mutex>
 #include <condition_variable>
 
@@ -36,13 +38,17 @@ using spinlock_t = so_5::default_spinlock_t;
  * v.5.5.11
  *
  * \brief Impementation of condition object for the case of combined lock.
+ *
+ * \tparam Spin_Budget policy for the time of busy waiting stage
+ * (since v.5.6.2).
  */
+template< typename Spin_Budget >
 class actual_cond_t : public condition_t
 	{
 		//! Spinlock from parent lock object.
 		spinlock_t & m_spinlock;
-		//! Max waiting time for busy waiting stage.
-		const std::chrono::high_resolution_clock::duration m_waiting_time;
+		//! Policy for the time of busy waiting stage from parent lock object.
+		Spin_Budget & m_spin_budget;
 
 		//! An indicator of notification for condition object.
 		bool m_signaled = { false };
@@ -57,10 +63,10 @@ class actual_cond_t : public condition_t
 		actual_cond_t(
 			//! Spinlock from parent lock object.
 			spinlock_t & spinlock,
-			//! Max waiting time for busy waiting stage.
-			std::chrono::high_resolution_clock::duration waiting_time )
+			//! Policy for the time of busy waiting stage.
+			Spin_Budget & spin_budget )
 			:	m_spinlock( spinlock )
-			,	m_waiting_time( std::move(waiting_time) )
+			,	m_spin_budget( spin_budget )
 			{}
 
 		virtual void
@@ -79,7 +85,8 @@ class actual_cond_t : public condition_t
 				//
 
 				// Limitation for busy waiting stage.
-				const auto stop_point = hrc::now() + m_waiting_time;
+				const auto started_at = hrc::now();
+				const auto stop_point = started_at + m_spin_budget.budget();
 
 				do
 					{
@@ -90,7 +97,10 @@ class actual_cond_t : public condition_t
 						m_spinlock.lock();
 
 						if( m_signaled )
-							return;
+							{
+								m_spin_budget.spin_succeeded( hrc::now() - started_at );
+								return;
+							}
 					}
 				while( stop_point > hrc::now() );
 
@@ -115,6 +125,8 @@ class actual_cond_t : public condition_t
 				// Spinlock must be reacquired to return the parent lock
 				// in the state at the call to wait().
 				m_spinlock.lock();
+
+				m_spin_budget.park_finished( hrc::now() - started_at );
 			}
 
 		virtual void
@@ -136,20 +148,29 @@ class actual_cond_t : public condition_t
  * v.5.5.11
  *
  * \brief Actual implementation of combined lock object.
+ *
+ * \tparam Spin_Budget policy for the time of busy waiting stage
+ * (since v.5.6.2).
  */
+template< typename Spin_Budget >
 class actual_lock_t : public lock_t
 	{
 		//! Common spinlock for locking of producers and consumers.
 		spinlock_t m_spinlock;
-		//! Max waiting time for busy waiting stage.
-		const std::chrono::high_resolution_clock::duration m_waiting_time;
+
+	protected :
+		//! Policy for the time of busy waiting stage.
+		/*!
+		 * It is shared by all condition objects of the lock.
+		 */
+		Spin_Budget m_spin_budget;
 
 	public :
 		//! Initializing constructor.
 		actual_lock_t(
 			//! Max waiting time for busy waiting stage.
 			std::chrono::high_resolution_clock::duration waiting_time )
-			:	m_waiting_time{ std::move(waiting_time) }
+			:	m_spin_budget{ waiting_time }
 			{}
 
 		virtual void
@@ -168,7 +189,30 @@ class actual_lock_t : public lock_t
 		allocate_condition() override
 			{
 				return condition_unique_ptr_t{
-					new actual_cond_t{ m_spinlock, m_waiting_time } };
+					new actual_cond_t< Spin_Budget >{ m_spinlock, m_spin_budget } };
+			}
+	};
+
+//
+// adaptive_lock_t
+//
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A combined lock which learns its spin budget.
+ */
+class adaptive_lock_t final
+	:	public actual_lock_t< so_5::disp::reuse::adaptive_spin_budget_t >
+	{
+	public :
+		using actual_lock_t::actual_lock_t;
+
+		virtual bool
+		query_stats( so_5::stats::lock_stats_t & to ) const noexcept override
+			{
+				to = m_spin_budget.query_stats();
+				return true;
 			}
 	};
 
@@ -275,11 +319,25 @@ combined_lock_factory(
 	std::chrono::high_resolution_clock::duration waiting_time )
 	{
 		return [waiting_time] {
-				return lock_unique_ptr_t{ new combined_lock::actual_lock_t{
+				return lock_unique_ptr_t{ new combined_lock::actual_lock_t<
+						so_5::disp::reuse::fixed_spin_budget_t >{
 					std::move(waiting_time) } };
 			};
 	}
 
+//
+// adaptive_lock_factory
+//
+SO_5_FUNC lock_factory_t
+adaptive_lock_factory(
+	std::chrono::high_resolution_clock::duration max_waiting_time )
+	{
+		return [max_waiting_time] {
+				return lock_unique_ptr_t{ new combined_lock::adaptive_lock_t{
+					max_waiting_time } };
+			};
+	}
+
 //
 // simple_lock_factory
 //
@@ -14,6 +14,8 @@
 #include <so_5/declspec.hpp>
 #include <so_5/compiler_features.hpp>
 
+#include <so_5/stats/lock_stats.hpp>
+
 #include <functional>
 #include <memory>
 #include <chrono>
@@ -105,6 +107,22 @@ class SO_5_TYPE lock_t
 		//! Create condition object for another MPMC queue's customer.
 		virtual condition_unique_ptr_t
 		allocate_condition() = 0;
+
+		/*!
+		 * \brief Get stats of waiting on the lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 *
+		 * \note Can be called without acquiring the lock.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual bool
+		query_stats( so_5::stats::lock_stats_t & /*to*/ ) const noexcept
+			{
+				return false;
+			}
 	};
 
 //
@@ -230,6 +248,63 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// adaptive_lock_factory
+//
+/*!
+ * \brief Factory for creation of combined queue lock which learns
+ * its spin budget.
+ *
+ * A combined lock created by combined_lock_factory() always spins
+ * for the specified waiting time before parking of a customer.
+ * It wastes CPU for lightly loaded queues and can still park
+ * customers too early for hot queues.
+ *
+ * The adaptive lock tunes the time of the spinning stage for
+ * every queue from wakeup latencies of recent waits. The time is
+ * limited by \a max_waiting_time.
+ *
+ * Counts of waits finished during the spinning stage and waits with
+ * parking, as well as the current spin budget, are distributed via
+ * run-time monitoring (see so_5::stats::suffixes::lock_spin_wakeup_count(),
+ * so_5::stats::suffixes::lock_park_count() and
+ * so_5::stats::suffixes::lock_spin_budget()).
+ *
+ * \par Usage example:
+	\code
+	using namespace so_5::disp::thread_pool;
+	auto disp = make_dispatcher( env, "workers",
+		disp_params_t{}
+			.thread_count( 8 )
+			.tune_queue_params( []( queue_traits::queue_params_t & params ) {
+				params.lock_factory( queue_traits::adaptive_lock_factory() );
+			} ) );
+	\endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC lock_factory_t
+adaptive_lock_factory(
+	//! Max waiting time for waiting on spinlock before switching to mutex.
+	std::chrono::high_resolution_clock::duration max_waiting_time );
+
+//
+// adaptive_lock_factory
+//
+/*!
+ * \brief Factory for creation of combined queue lock which learns
+ * its spin budget, with default max waiting time.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline lock_factory_t
+adaptive_lock_factory()
+	{
+		return adaptive_lock_factory( default_combined_lock_waiting_time() );
+	}
+
 //
 // queue_params_t
 //
@@ -14,6 +14,8 @@
 
 #include <so_5/spinlocks.hpp>
 
+#include <so_5/disp/reuse/spin_budget.hpp>
+
 #include <so_5/details/invoke_noexcept_code.hpp>
 
 #include <mutex>
@@ -29,7 +31,7 @@ namespace mpsc_queue_traits {
 namespace impl {
 
 //
-// combined_lock_t
+// combined_lock_template_t
 //
 /*!
  * \since
@@ -43,15 +45,19 @@ namespace impl {
  * \attention This lock can be used only for single-consumer queues!
  * It is because there is no way found to implement notify_all on
  * just two int variables (m_waiting and m_signaled). 
+ *
+ * \tparam Spin_Budget policy for the time of spinning stage
+ * (since v.5.6.2).
  */
-class combined_lock_t : public lock_t
+template< typename Spin_Budget >
+class combined_lock_template_t : public lock_t
 	{
 	public :
 		inline
-		combined_lock_t(
+		combined_lock_template_t(
 			//! Max waiting time for waiting on spinlock before switching to mutex.
 			std::chrono::high_resolution_clock::duration waiting_time )
-			:	m_waiting_time{ waiting_time }
+			:	m_spin_budget{ waiting_time }
 			,	m_waiting( false )
 			,	m_signaled( false )
 			{}
@@ -68,6 +74,12 @@ class combined_lock_t : public lock_t
 				m_spinlock.unlock();
 			}
 
+		virtual bool
+		timed_wait_supported() const noexcept override
+			{
+				return true;
+			}
+
 	protected :
 		virtual void
 		wait_for_notify() noexcept override
@@ -75,7 +87,8 @@ class combined_lock_t : public lock_t
 				using clock = std::chrono::high_resolution_clock;
 
 				m_waiting = true;
-				auto stop_point = clock::now() + m_waiting_time;
+				const auto started_at = clock::now();
+				const auto stop_point = started_at + m_spin_budget.budget();
 
 				do
 					{
@@ -87,6 +100,7 @@ class combined_lock_t : public lock_t
 
 						if( m_signaled )
 							{
+								m_spin_budget.spin_succeeded( clock::now() - started_at );
 								m_waiting = false;
 								m_signaled = false;
 								return;
@@ -109,10 +123,42 @@ class combined_lock_t : public lock_t
 
 				m_spinlock.lock();
 
+				m_spin_budget.park_finished( clock::now() - started_at );
 				m_waiting = false;
 				m_signaled = false;
 			}
 
+		/*!
+		 * There is no busy waiting stage: the deadline is usually
+		 * close and the thread goes to sleep at once.
+		 */
+		virtual bool
+		wait_for_notify_until(
+			std::chrono::steady_clock::time_point deadline ) noexcept override
+			{
+				m_waiting = true;
+
+				{
+					std::unique_lock< std::mutex > mlock( m_mutex );
+
+					m_spinlock.unlock();
+
+					m_condition.wait_until( mlock, deadline,
+							[this]{ return m_signaled; } );
+				}
+
+				// m_mutex must be released before acquiring m_spinlock
+				// because a notifier can hold m_spinlock and wait for m_mutex
+				// if the deadline has been reached.
+				m_spinlock.lock();
+
+				const bool signaled = m_signaled;
+				m_waiting = false;
+				m_signaled = false;
+
+				return signaled;
+			}
+
 		//! Notify one waiting thread if it exists.
 		/*!
 		 * \attention Must be called only when object is locked.
@@ -130,9 +176,11 @@ class combined_lock_t : public lock_t
 					}
 			}
 
-	private :
-		const std::chrono::high_resolution_clock::duration m_waiting_time;
+	protected :
+		//! Policy for the time of spinning stage.
+		Spin_Budget m_spin_budget;
 
+	private :
 		default_spinlock_t m_spinlock;
 
 		std::mutex m_mutex;
@@ -142,6 +190,41 @@ class combined_lock_t : public lock_t
 		bool m_signaled;
 	};
 
+//
+// combined_lock_t
+//
+/*!
+ * \since
+ * v.5.5.10
+ *
+ * \brief A combined lock with the fixed waiting time.
+ */
+using combined_lock_t = combined_lock_template_t<
+		so_5::disp::reuse::fixed_spin_budget_t >;
+
+//
+// adaptive_lock_t
+//
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A combined lock which learns its spin budget.
+ */
+class adaptive_lock_t final
+	:	public combined_lock_template_t< so_5::disp::reuse::adaptive_spin_budget_t >
+	{
+	public :
+		using combined_lock_template_t::combined_lock_template_t;
+
+		virtual bool
+		query_stats( so_5::stats::lock_stats_t & to ) const noexcept override
+			{
+				to = m_spin_budget.query_stats();
+				return true;
+			}
+	};
+
 //
 // simple_lock_t
 //
@@ -167,6 +250,12 @@ class simple_lock_t : public lock_t
 				m_mutex.unlock();
 			}
 
+		virtual bool
+		timed_wait_supported() const noexcept override
+			{
+				return true;
+			}
+
 	protected :
 		virtual void
 		wait_for_notify() noexcept override
@@ -182,6 +271,24 @@ class simple_lock_t : public lock_t
 				m_signaled = false;
 			}
 
+		virtual bool
+		wait_for_notify_until(
+			std::chrono::steady_clock::time_point deadline ) noexcept override
+			{
+				so_5::details::invoke_noexcept_code( [&] {
+					// Mutex already locked. We must not try to reacquire it.
+					std::unique_lock< std::mutex > mlock{ m_mutex, std::adopt_lock };
+					m_condition.wait_until( mlock, deadline,
+							[this]{ return m_signaled; } );
+					mlock.release();
+				} );
+
+				const bool signaled = m_signaled;
+				m_signaled = false;
+
+				return signaled;
+			}
+
 		virtual void
 		notify_one() noexcept override
 			{
@@ -196,6 +303,30 @@ class simple_lock_t : public lock_t
 		bool m_signaled = { false };
 	};
 
+//
+// lock_free_queue_lock_t
+//
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A lock for work threads which store demands in
+ * a lock-free queue.
+ *
+ * It is the combined lock which allows usage of lock-free queue.
+ */
+class lock_free_queue_lock_t final : public combined_lock_t
+	{
+	public :
+		using combined_lock_t::combined_lock_t;
+
+		virtual bool
+		lock_free_queue_allowed() const noexcept override
+			{
+				return true;
+			}
+	};
+
 } /* namespace impl */
 
 //
@@ -219,6 +350,31 @@ simple_lock_factory()
 		return [] { return lock_unique_ptr_t{ new impl::simple_lock_t{} }; };
 	}
 
+//
+// adaptive_lock_factory
+//
+SO_5_FUNC lock_factory_t
+adaptive_lock_factory(
+	std::chrono::high_resolution_clock::duration max_waiting_time )
+	{
+		return [max_waiting_time] {
+			return lock_unique_ptr_t{ new impl::adaptive_lock_t{ max_waiting_time } };
+		};
+	}
+
+//
+// lock_free_queue_factory
+//
+SO_5_FUNC lock_factory_t
+lock_free_queue_factory(
+	std::chrono::high_resolution_clock::duration waiting_time )
+	{
+		return [waiting_time] {
+			return lock_unique_ptr_t{
+					new impl::lock_free_queue_lock_t{ waiting_time } };
+		};
+	}
+
 } /* namespace mpsc_queue_traits */
 
 } /* namespace disp */
@@ -15,6 +15,8 @@
 #include <so_5/declspec.hpp>
 #include <so_5/compiler_features.hpp>
 
+#include <so_5/stats/lock_stats.hpp>
+
 #include <functional>
 #include <memory>
 #include <chrono>
@@ -55,6 +57,57 @@ class SO_5_TYPE lock_t
 		virtual void
 		unlock() noexcept = 0;
 
+		/*!
+		 * \brief Can demands be stored in a lock-free queue?
+		 *
+		 * If this method returns true then a work thread of
+		 * one_thread-like dispatchers stores demands in a lock-free
+		 * MPSC queue. The lock is used only for parking of the idle
+		 * consumer and for service operations in that case.
+		 *
+		 * Other dispatchers use the lock as usual.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual bool
+		lock_free_queue_allowed() const noexcept
+			{
+				return false;
+			}
+
+		/*!
+		 * \brief Get stats of waiting on the lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 *
+		 * \note Can be called without acquiring the lock.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual bool
+		query_stats( so_5::stats::lock_stats_t & /*to*/ ) const noexcept
+			{
+				return false;
+			}
+
+		/*!
+		 * \brief Is waiting with a deadline supported?
+		 *
+		 * If this method returns false then wait_for_notify_until()
+		 * is never called and a work thread doesn't handle short
+		 * delayed messages by itself.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual bool
+		timed_wait_supported() const noexcept
+			{
+				return false;
+			}
+
 	protected :
 		//! Waiting for nofication.
 		/*!
@@ -63,6 +116,27 @@ class SO_5_TYPE lock_t
 		virtual void
 		wait_for_notify() noexcept = 0;
 
+		//! Waiting for nofication or for the deadline.
+		/*!
+		 * \attention Must be called only when object is locked!
+		 *
+		 * \note Is called only if timed_wait_supported() returns true.
+		 * The default implementation ignores the deadline.
+		 *
+		 * \retval true if the notification has been received.
+		 * \retval false if the deadline has been reached.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual bool
+		wait_for_notify_until(
+			std::chrono::steady_clock::time_point /*deadline*/ ) noexcept
+			{
+				wait_for_notify();
+				return true;
+			}
+
 		//! Notify one waiting thread if it exists.
 		/*!
 		 * \attention Must be called only when object is locked.
@@ -196,6 +270,130 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// lock_free_queue_factory
+//
+/*!
+ * \brief Factory for creation of lock which allows usage of lock-free
+ * MPSC queue for demands.
+ *
+ * Work threads of one_thread, active_obj, active_group and
+ * prio_dedicated_threads::one_per_prio dispatchers will store demands
+ * in an intrusive lock-free queue (Vyukov's MPSC queue). A sender
+ * doesn't acquire any lock. The lock (the combined lock with the
+ * specified waiting time) is used only when the work thread has no
+ * demands and should be parked.
+ *
+ * Other dispatchers treat the created lock as the combined lock.
+ *
+ * \note A demand sent from a thread other than the work thread
+ * requires an allocation of a queue node.
+ *
+ * \note The count of demands for run-time monitoring includes only
+ * demands which are already extracted by the work thread.
+ *
+ * \since
+ * v.5.6.2
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			using namespace so_5::disp::one_thread;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory(
+								queue_traits::lock_free_queue_factory(
+										std::chrono::microseconds(500) ) );
+					} ) ) );
+		} );
+	\endcode
+ */
+SO_5_FUNC lock_factory_t
+lock_free_queue_factory(
+	//! Max waiting time for the idle consumer before parking on mutex.
+	std::chrono::high_resolution_clock::duration waiting_time );
+
+//
+// lock_free_queue_factory
+//
+/*!
+ * \brief Factory for creation of lock which allows usage of lock-free
+ * MPSC queue for demands with default waiting time.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline lock_factory_t
+lock_free_queue_factory()
+	{
+		return lock_free_queue_factory( default_combined_lock_waiting_time() );
+	}
+
+//
+// adaptive_lock_factory
+//
+/*!
+ * \brief Factory for creation of combined queue lock which learns
+ * its spin budget.
+ *
+ * A combined lock created by combined_lock_factory() always spins
+ * for the specified waiting time before parking of the consumer.
+ * It wastes CPU for lightly loaded queues and can still park the
+ * consumer too early for hot queues.
+ *
+ * The adaptive lock tunes the time of the spinning stage for
+ * every queue from wakeup latencies of recent waits. The time is
+ * limited by \a max_waiting_time.
+ *
+ * Counts of waits finished during the spinning stage and waits with
+ * parking, as well as the current spin budget, are distributed via
+ * run-time monitoring (see so_5::stats::suffixes::lock_spin_wakeup_count(),
+ * so_5::stats::suffixes::lock_park_count() and
+ * so_5::stats::suffixes::lock_spin_budget()).
+ *
+ * \since
+ * v.5.6.2
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			using namespace so_5::disp::one_thread;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory(
+								queue_traits::adaptive_lock_factory(
+										std::chrono::milliseconds(2) ) );
+					} ) ) );
+		} );
+	\endcode
+ */
+SO_5_FUNC lock_factory_t
+adaptive_lock_factory(
+	//! Max waiting time for waiting on spinlock before switching to mutex.
+	std::chrono::high_resolution_clock::duration max_waiting_time );
+
+//
+// adaptive_lock_factory
+//
+/*!
+ * \brief Factory for creation of combined queue lock which learns
+ * its spin budget, with default max waiting time.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline lock_factory_t
+adaptive_lock_factory()
+	{
+		return adaptive_lock_factory( default_combined_lock_waiting_time() );
+	}
+
 //
 // unique_lock_t
 //
@@ -230,6 +428,18 @@ class unique_lock_t
 				m_lock.wait_for_notify();
 			}
 
+		/*!
+		 * \retval false if the deadline has been reached.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		inline bool
+		wait_for_notify_until( std::chrono::steady_clock::time_point deadline )
+			{
+				return m_lock.wait_for_notify_until( deadline );
+			}
+
 	private :
 		lock_t & m_lock;
 	};
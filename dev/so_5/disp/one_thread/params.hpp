@@ -19,6 +19,8 @@
 #include <so_5/disp/mpsc_queue_traits/pub.hpp>
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+#include <so_5/disp/reuse/local_timers_mixin.hpp>
 
 namespace so_5
 {
@@ -48,9 +50,15 @@ namespace queue_traits = so_5::disp::mpsc_queue_traits;
  */
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::local_timers_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+		using local_timers_mixin_t = so_5::disp::reuse::
+				local_timers_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -62,6 +70,12 @@ class disp_params_t
 				swap(
 						static_cast< activity_tracking_mixin_t & >(a),
 						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+				swap(
+						static_cast< local_timers_mixin_t & >(a),
+						static_cast< local_timers_mixin_t & >(b) );
 				swap( a.m_queue_params, b.m_queue_params );
 			}
 
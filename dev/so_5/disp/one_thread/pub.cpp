@@ -16,6 +16,7 @@
 #include <so_5/disp/reuse/work_thread/work_thread.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
 
 #include <so_5/details/rollback_on_exception.hpp>
@@ -130,6 +131,11 @@ class data_source_t final
 						stats::suffixes::work_thread_queue_size(),
 						this->m_work_thread.demands_count() );
 
+				so_5::disp::reuse::send_lock_stats(
+						mbox,
+						this->m_work_thread_prefix,
+						this->m_work_thread );
+
 				data_source_details::track_activity( mbox, *this );
 			}
 	};
@@ -165,7 +171,10 @@ class actual_dispatcher_t final : public disp_binder_t
 					name_base,
 					this }
 			{
-				m_work_thread.start();
+				m_work_thread.start(
+						so_5::disp::reuse::cpus_for_work_thread(
+								params.thread_affinity(), 0u ),
+						params.local_timers() );
 			}
 
 		~actual_dispatcher_t() noexcept override
@@ -16,6 +16,7 @@
 #include <so_5/disp/reuse/work_thread/work_thread.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
 
 #include <so_5/stats/repository.hpp>
@@ -92,7 +93,7 @@ class dispatcher_template_t final : public disp_binder_t
 				}
 			{
 				allocate_work_threads( params );
-				launch_work_threads();
+				launch_work_threads( params.thread_affinity() );
 			}
 
 		~dispatcher_template_t() noexcept override
@@ -220,6 +221,8 @@ class dispatcher_template_t final : public disp_binder_t
 								stats::suffixes::agent_count(),
 								agents_count );
 
+						so_5::disp::reuse::send_lock_stats( mbox, prefix, wt );
+
 						send_thread_activity_stats( mbox, prefix, wt );
 					}
 			};
@@ -251,7 +254,9 @@ class dispatcher_template_t final : public disp_binder_t
 
 		//! Start all working threads.
 		void
-		launch_work_threads()
+		launch_work_threads(
+			//! CPU affinity for working threads.
+			const so_5::disp::thread_affinity_t & affinity )
 			{
 				using namespace std;
 				using namespace so_5::details;
@@ -269,7 +274,9 @@ class dispatcher_template_t final : public disp_binder_t
 								m_agents_per_priority[ i ].store( 0,
 										std::memory_order_release );
 
-								m_threads[ i ]->start();
+								m_threads[ i ]->start(
+										so_5::disp::reuse::cpus_for_work_thread(
+												affinity, i ) );
 
 								// Thread successfully started. Pointer to it
 								// must be used on rollback.
@@ -17,6 +17,7 @@
 #include <so_5/disp/prio_one_thread/reuse/work_thread.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 #include <so_5/disp/reuse/make_actual_dispatcher.hpp>
 
 #include <so_5/stats/repository.hpp>
@@ -97,7 +98,9 @@ class dispatcher_template_t final : public disp_binder_t
 					outliving_mutable(*this)
 				}
 			{
-				m_work_thread.start();
+				m_work_thread.start(
+						so_5::disp::reuse::cpus_for_work_thread(
+								params.thread_affinity(), 0u ) );
 			}
 
 		~dispatcher_template_t() noexcept override
@@ -193,6 +196,11 @@ class dispatcher_template_t final : public disp_binder_t
 								stats::suffixes::agent_count(),
 								agents_count );
 
+						so_5::disp::reuse::send_lock_stats(
+								mbox,
+								m_base_prefix,
+								disp.m_demand_queue );
+
 						send_thread_activity_stats(
 								mbox,
 								m_base_prefix,
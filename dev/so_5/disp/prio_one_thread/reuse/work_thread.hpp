@@ -18,10 +18,13 @@
 #include <so_5/stats/work_thread_activity.hpp>
 #include <so_5/stats/impl/activity_tracking.hpp>
 
+#include <so_5/disp/reuse/thread_affinity.hpp>
+
 #include <so_5/details/at_scope_exit.hpp>
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <atomic>
 #include <thread>
 
 namespace so_5 {
@@ -121,6 +124,7 @@ class with_activity_tracking_impl_t : protected common_data_t< Demand_Queue >
 
 				result.m_working_stats = m_working_stats.take_stats();
 				result.m_waiting_stats = m_waiting_stats.take_stats();
+				result.m_cpu = m_cpu.load( std::memory_order_relaxed );
 
 				return result;
 			}
@@ -136,6 +140,14 @@ class with_activity_tracking_impl_t : protected common_data_t< Demand_Queue >
 				so_5::stats::activity_tracking_stuff::internal_lock >
 			m_waiting_stats;
 
+		/*!
+		 * \brief CPU on which the thread was woken up last time.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::atomic< int > m_cpu{ -1 };
+
 		void
 		work_started() { m_working_stats.start(); }
 
@@ -146,7 +158,13 @@ class with_activity_tracking_impl_t : protected common_data_t< Demand_Queue >
 		wait_started() { m_waiting_stats.start(); }
 
 		void
-		wait_finished() { m_waiting_stats.stop(); }
+		wait_finished()
+			{
+				m_waiting_stats.stop();
+				m_cpu.store(
+						so_5::disp::reuse::current_cpu(),
+						std::memory_order_relaxed );
+			}
 	};
 
 } /* namespace work_thread_details */
@@ -175,9 +193,14 @@ class work_thread_template_t : public Work_Thread< Demand_Queue >
 			{}
 
 		void
-		start()
+		start(
+			//! CPUs on which the thread is allowed to run.
+			so_5::disp::reuse::cpu_list_t cpus = {} )
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				this->m_thread = std::thread( [this, cpus = std::move(cpus)]() {
+						so_5::disp::reuse::bind_current_thread( cpus );
+						body();
+					} );
 			}
 
 		void
@@ -201,9 +224,12 @@ class work_thread_template_t : public Work_Thread< Demand_Queue >
 
 				try
 					{
+						// The processed demand is passed back to the queue.
+						// It allows to reuse its item for new demands.
+						typename Demand_Queue::demand_ptr_t d;
 						for(;;)
 							{
-								auto d = this->pop_demand();
+								d = this->pop_demand( std::move( d ) );
 								this->call_handler( *d );
 							}
 					}
@@ -211,14 +237,14 @@ class work_thread_template_t : public Work_Thread< Demand_Queue >
 					{}
 			}
 
-		auto
-		pop_demand() -> decltype(std::declval<Demand_Queue>().pop())
+		typename Demand_Queue::demand_ptr_t
+		pop_demand( typename Demand_Queue::demand_ptr_t processed )
 			{
 				this->wait_started();
 				auto wait_meter_stopper = so_5::details::at_scope_exit(
 						[this] { this->wait_finished(); } );
 
-				return this->m_queue.pop();
+				return this->m_queue.pop( std::move( processed ) );
 			}
 
 		void
@@ -23,6 +23,8 @@
 
 #include <so_5/disp/mpsc_queue_traits/pub.hpp>
 
+#include <so_5/disp/reuse/intrusive_free_list.hpp>
+
 namespace so_5 {
 
 namespace disp {
@@ -53,6 +55,17 @@ struct demand_t final : public execution_demand_t
 		demand_t( execution_demand_t && source )
 			:	execution_demand_t( std::move( source ) )
 			{}
+
+		//! Replace the content of the demand.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		assign( execution_demand_t && source ) noexcept
+			{
+				static_cast< execution_demand_t & >(*this) = std::move( source );
+			}
 	};
 
 //
@@ -108,14 +121,18 @@ class demand_queue_t
 				virtual void
 				push( execution_demand_t exec_demand ) override
 					{
-						demand_unique_ptr_t what{ new demand_t{
-								std::move( exec_demand ) } };
-
-						m_demand_queue->push( this, std::move( what ) );
+						m_demand_queue->push( this, std::move( exec_demand ) );
 					}
 			};
 
 	public :
+		//! Type of pointer to a demand extracted from the queue.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		using demand_ptr_t = demand_unique_ptr_t;
+
 		//! This exception is thrown when pop is called after stop.
 		class shutdown_ex_t : public std::exception
 			{};
@@ -159,13 +176,26 @@ class demand_queue_t
 
 		//! Pop demand from the queue.
 		/*!
+		 * \note Since v.5.6.2 the previously extracted demand is passed
+		 * back to the queue. Its item is reused for new demands.
+		 *
 		 * \throw shutdown_ex_t in the case when queue is shut down.
 		 */
 		demand_unique_ptr_t
-		pop()
+		pop(
+			//! The previously extracted demand. Can be nullptr.
+			demand_unique_ptr_t processed )
 			{
+				// The processed demand must be destroyed when the lock
+				// is released.
+				if( processed )
+					processed->assign( execution_demand_t{} );
+
 				queue_traits::unique_lock_t lock{ *m_lock };
 
+				if( processed && m_free_demands.try_put( processed.get() ) )
+					processed.release();
+
 				while( !m_shutdown && !m_current_priority )
 					lock.wait_for_notify();
 
@@ -232,10 +262,31 @@ class demand_queue_t
 					} );
 			}
 
+		/*!
+		 * \brief Get stats of waiting on the queue lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+			{
+				return m_lock->query_stats( to );
+			}
+
 	private :
 		//! Queue lock.
 		queue_traits::lock_unique_ptr_t m_lock;
 
+		//! Items which can be reused for new demands.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		so_5::disp::reuse::intrusive_free_list_t< demand_t > m_free_demands;
+
 		//! Shutdown flag.
 		bool m_shutdown = false;
 
@@ -263,15 +314,51 @@ class demand_queue_t
 			}
 
 		//! Push a new demand to the queue.
+		/*!
+		 * \note Since v.5.6.2 an item from the free-list is used for
+		 * the demand if it is possible.
+		 */
 		void
 		push(
 			//! Subqueue for the demand.
 			queue_for_one_priority_t * subqueue,
 			//! Demand to be pushed.
-			demand_unique_ptr_t demand )
+			execution_demand_t && demand )
 			{
+				{
+					queue_traits::lock_guard_t lock{ *m_lock };
+
+					demand_t * item = m_free_demands.try_take();
+					if( item )
+						{
+							item->assign( std::move( demand ) );
+							push_under_lock( lock, subqueue, demand_unique_ptr_t{ item } );
+							return;
+						}
+				}
+
+				// There is no free item. A new one must be created
+				// when the lock is released.
+				demand_unique_ptr_t what{ new demand_t{ std::move( demand ) } };
+
 				queue_traits::lock_guard_t lock{ *m_lock };
+				push_under_lock( lock, subqueue, std::move( what ) );
+			}
 
+		//! Push a new demand to the queue when the lock is acquired.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		push_under_lock(
+			//! Acquired lock.
+			queue_traits::lock_guard_t & lock,
+			//! Subqueue for the demand.
+			queue_for_one_priority_t * subqueue,
+			//! Demand to be pushed.
+			demand_unique_ptr_t demand )
+			{
 				add_demand_to_queue( *subqueue, std::move( demand ) );
 
 				if( !m_current_priority )
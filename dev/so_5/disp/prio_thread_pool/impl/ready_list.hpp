@@ -0,0 +1,201 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A list of non-empty agent queues partitioned by priorities.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/disp/prio_thread_pool/pub.hpp>
+
+#include <so_5/disp/reuse/mpmc_ptr_queue.hpp>
+
+#include <so_5/priority.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_thread_pool {
+
+namespace impl {
+
+//
+// prio_ready_list_t
+//
+/*!
+ * \brief A list of non-empty agent queues partitioned by priorities.
+ *
+ * Every priority has its own FIFO list of agent queues. A queue
+ * with the highest priority is extracted first.
+ *
+ * If quotes are specified then a priority can be selected only
+ * a limited number of times while there are queues of lower priorities.
+ * When all non-empty priorities have exhausted their quotes the quotes
+ * are restored. It means that queues of low priorities aren't starved
+ * by a stream of queues of high priorities.
+ *
+ * Every extraction of an agent queue is counted as one use of the quote.
+ * The extracted queue can process up to max_demands_at_once demands.
+ *
+ * Has the same interface as std::deque for the usage in
+ * so_5::disp::reuse::basic_mpmc_ptr_queue_t.
+ *
+ * \tparam T type of agent queue. Must have priority() method.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< class T >
+class prio_ready_list_t
+	{
+	public :
+		//! Initializing constructor.
+		prio_ready_list_t(
+			//! Quotes for priorities.
+			//! Priorities are strictly ordered if there are no quotes.
+			const optional< quotes_t > & quotes )
+			{
+				so_5::prio::for_each_priority( [&]( priority_t p ) {
+						m_quotes[ to_size_t( p ) ] =
+								quotes ? quotes->query( p ) : 0u;
+					} );
+				restore_quotes();
+			}
+
+		//! Is the list empty?
+		bool
+		empty() const noexcept
+			{
+				return 0u == m_size;
+			}
+
+		//! Count of agent queues in the list.
+		std::size_t
+		size() const noexcept
+			{
+				return m_size;
+			}
+
+		//! Store an agent queue at the end of the list for its priority.
+		void
+		push_back( T * queue )
+			{
+				m_lists[ to_size_t( queue->priority() ) ].push_back( queue );
+				++m_size;
+			}
+
+		//! Get the agent queue to be processed next.
+		/*!
+		 * \attention Must be called only for non-empty list.
+		 */
+		T *
+		front() noexcept
+			{
+				return m_lists[ select() ].front();
+			}
+
+		//! Remove the agent queue returned by front().
+		/*!
+		 * \attention Must be called only for non-empty list.
+		 */
+		void
+		pop_front() noexcept
+			{
+				const auto index = select();
+
+				m_lists[ index ].pop_front();
+				--m_size;
+
+				if( m_remaining[ index ] )
+					--m_remaining[ index ];
+			}
+
+	private :
+		//! Lists of agent queues for every priority.
+		std::array< std::deque< T * >, so_5::prio::total_priorities_count >
+				m_lists;
+
+		//! Quotes for every priority.
+		/*!
+		 * Value 0 means that there is no quote.
+		 */
+		std::array< std::size_t, so_5::prio::total_priorities_count >
+				m_quotes;
+
+		//! Remaining parts of quotes for every priority.
+		std::array< std::size_t, so_5::prio::total_priorities_count >
+				m_remaining;
+
+		//! Total count of agent queues in all lists.
+		std::size_t m_size{ 0u };
+
+		//! Does the priority have a part of its quote?
+		bool
+		has_quote( std::size_t index ) const noexcept
+			{
+				return !m_quotes[ index ] || m_remaining[ index ];
+			}
+
+		void
+		restore_quotes() noexcept
+			{
+				m_remaining = m_quotes;
+			}
+
+		//! Detect the index of the list to be used for extraction.
+		/*!
+		 * \note Calls to select() without modification of the list
+		 * return the same value.
+		 */
+		std::size_t
+		select() noexcept
+			{
+				// Lists are checked from the highest priority.
+				for( std::size_t i = m_lists.size(); i; --i )
+					if( !m_lists[ i - 1 ].empty() && has_quote( i - 1 ) )
+						return i - 1;
+
+				// All non-empty priorities have exhausted their quotes.
+				// A new round must be started.
+				restore_quotes();
+
+				std::size_t i = m_lists.size() - 1u;
+				while( m_lists[ i ].empty() )
+					--i;
+
+				return i;
+			}
+	};
+
+//
+// prio_mpmc_ptr_queue_t
+//
+/*!
+ * \brief A dispatcher queue which extracts agent queues by
+ * their priorities.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< class T >
+using prio_mpmc_ptr_queue_t =
+		so_5::disp::reuse::basic_mpmc_ptr_queue_t< T, prio_ready_list_t< T > >;
+
+} /* namespace impl */
+
+} /* namespace prio_thread_pool */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
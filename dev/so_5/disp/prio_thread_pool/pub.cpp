@@ -0,0 +1,307 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A thread pool dispatcher which takes priorities of agents
+ * into account.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/disp/prio_thread_pool/pub.hpp>
+
+#include <so_5/disp/prio_thread_pool/impl/ready_list.hpp>
+
+#include <so_5/disp/thread_pool/impl/disp.hpp>
+
+#include <so_5/disp/reuse/make_actual_dispatcher.hpp>
+
+#include <so_5/disp_binder.hpp>
+#include <so_5/environment.hpp>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_thread_pool {
+
+namespace impl {
+
+namespace tp_impl = so_5::disp::thread_pool::impl;
+
+//
+// agent_queue_t
+//
+/*!
+ * \brief Type of agent queue for %prio_thread_pool dispatcher.
+ */
+using agent_queue_t = tp_impl::agent_queue_template_t< prio_mpmc_ptr_queue_t >;
+
+//
+// adaptation_t
+//
+/*!
+ * \brief Adaptation of common implementation of thread-pool-like dispatcher
+ * to the specific of %prio_thread_pool dispatcher.
+ */
+struct adaptation_t
+	{
+		SO_5_NODISCARD
+		static constexpr std::string_view
+		dispatcher_type_name() noexcept
+			{
+				return { "ptp" }; // prio_thread_pool.
+			}
+
+		SO_5_NODISCARD
+		static bool
+		is_individual_fifo( const bind_params_t & params ) noexcept
+			{
+				return fifo_t::individual == params.query_fifo();
+			}
+
+		template< typename Agent_Queue >
+		static void
+		wait_for_queue_emptyness( Agent_Queue & queue ) noexcept
+			{
+				queue.wait_for_emptyness();
+			}
+	};
+
+//
+// dispatcher_template_t
+//
+/*!
+ * \brief Template for dispatcher.
+ *
+ * This template depends on work_thread type (with or without activity
+ * tracking).
+ */
+template< typename Work_Thread >
+using dispatcher_template_t =
+		so_5::disp::thread_pool::common_implementation::dispatcher_t<
+				Work_Thread,
+				typename Work_Thread::dispatcher_queue_t,
+				typename Work_Thread::agent_queue_t,
+				bind_params_t,
+				adaptation_t >;
+
+//
+// actual_dispatcher_iface_t
+//
+/*!
+ * \brief An actual interface of %prio_thread_pool dispatcher.
+ *
+ * This interface defines a set of methods necessary for binder.
+ */
+class actual_dispatcher_iface_t : public basic_dispatcher_iface_t
+	{
+	public :
+		//! Preallocate all necessary resources for a new agent.
+		virtual void
+		preallocate_resources_for_agent(
+			agent_t & agent,
+			const bind_params_t & params ) = 0;
+
+		//! Undo preallocation of resources for a new agent.
+		virtual void
+		undo_preallocation_for_agent(
+			agent_t & agent ) noexcept = 0;
+
+		//! Get resources allocated for an agent.
+		virtual event_queue_t *
+		query_resources_for_agent( agent_t & agent ) noexcept = 0;
+
+		//! Unbind agent from the dispatcher.
+		virtual void
+		unbind_agent( agent_t & agent ) noexcept = 0;
+	};
+
+//
+// actual_dispatcher_iface_shptr_t
+//
+using actual_dispatcher_iface_shptr_t =
+		std::shared_ptr< actual_dispatcher_iface_t >;
+
+//
+// actual_binder_t
+//
+/*!
+ * \brief Actual implementation of dispatcher binder for
+ * %prio_thread_pool dispatcher.
+ */
+class actual_binder_t final : public disp_binder_t
+	{
+		//! Dispatcher to be used.
+		actual_dispatcher_iface_shptr_t m_disp;
+		//! Binding parameters.
+		const bind_params_t m_params;
+
+	public :
+		actual_binder_t(
+			actual_dispatcher_iface_shptr_t disp,
+			bind_params_t params ) noexcept
+			:	m_disp{ std::move(disp) }
+			,	m_params{ params }
+			{}
+
+		void
+		preallocate_resources(
+			agent_t & agent ) override
+			{
+				m_disp->preallocate_resources_for_agent( agent, m_params );
+			}
+
+		void
+		undo_preallocation(
+			agent_t & agent ) noexcept override
+			{
+				m_disp->undo_preallocation_for_agent( agent );
+			}
+
+		void
+		bind(
+			agent_t & agent ) noexcept override
+			{
+				auto queue = m_disp->query_resources_for_agent( agent );
+				agent.so_bind_to_dispatcher( *queue );
+			}
+
+		void
+		unbind(
+			agent_t & agent ) noexcept override
+			{
+				m_disp->unbind_agent( agent );
+			}
+	};
+
+//
+// actual_dispatcher_implementation_t
+//
+/*!
+ * \brief Actual implementation of %prio_thread_pool dispatcher.
+ */
+template< typename Work_Thread >
+class actual_dispatcher_implementation_t final
+	:	public actual_dispatcher_iface_t
+	{
+		//! Real dispatcher.
+		dispatcher_template_t< Work_Thread > m_impl;
+
+	public :
+		actual_dispatcher_implementation_t(
+			//! SObjectizer Environment to work in.
+			outliving_reference_t< environment_t > env,
+			//! Base part of data sources names.
+			const std::string_view name_base,
+			//! Dispatcher's parameters.
+			disp_params_t params )
+			:	m_impl{
+					name_base,
+					params.thread_count(),
+					params.queue_params(),
+					params.quotes() }
+			{
+				m_impl.start( env.get(), params.thread_affinity() );
+			}
+
+		~actual_dispatcher_implementation_t() noexcept override
+			{
+				m_impl.shutdown_then_wait();
+			}
+
+		SO_5_NODISCARD
+		disp_binder_shptr_t
+		binder( bind_params_t params ) override
+			{
+				return std::make_shared< actual_binder_t >(
+						this->shared_from_this(),
+						params );
+			}
+
+		void
+		preallocate_resources_for_agent(
+			agent_t & agent,
+			const bind_params_t & params ) override
+			{
+				m_impl.preallocate_resources_for_agent( agent, params );
+			}
+
+		void
+		undo_preallocation_for_agent(
+			agent_t & agent ) noexcept override
+			{
+				m_impl.undo_preallocation_for_agent( agent );
+			}
+
+		event_queue_t *
+		query_resources_for_agent( agent_t & agent ) noexcept override
+			{
+				return m_impl.query_resources_for_agent( agent );
+			}
+
+		void
+		unbind_agent( agent_t & agent ) noexcept override
+			{
+				m_impl.unbind_agent( agent );
+			}
+	};
+
+//
+// dispatcher_handle_maker_t
+//
+class dispatcher_handle_maker_t
+	{
+	public :
+		static dispatcher_handle_t
+		make( actual_dispatcher_iface_shptr_t disp ) noexcept
+			{
+				return { std::move( disp ) };
+			}
+	};
+
+} /* namespace impl */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+		using namespace so_5::disp::thread_pool::impl;
+
+		if( !params.thread_count() )
+			params.thread_count(
+					so_5::disp::thread_pool::default_thread_pool_size() );
+
+		using dispatcher_no_activity_tracking_t =
+				impl::actual_dispatcher_implementation_t<
+						work_thread_no_activity_tracking_t< impl::agent_queue_t > >;
+
+		using dispatcher_with_activity_tracking_t =
+				impl::actual_dispatcher_implementation_t<
+						work_thread_with_activity_tracking_t< impl::agent_queue_t > >;
+
+		std::shared_ptr< impl::actual_dispatcher_iface_t > disp =
+				so_5::disp::reuse::make_actual_dispatcher<
+								impl::actual_dispatcher_iface_t,
+								dispatcher_no_activity_tracking_t,
+								dispatcher_with_activity_tracking_t >(
+						outliving_reference_t(env),
+						data_sources_name_base,
+						std::move(params) );
+
+		return impl::dispatcher_handle_maker_t::make( std::move(disp) );
+	}
+
+} /* namespace prio_thread_pool */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
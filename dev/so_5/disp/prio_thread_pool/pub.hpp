@@ -0,0 +1,428 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A thread pool dispatcher which takes priorities of agents
+ * into account.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp_binder.hpp>
+#include <so_5/priority.hpp>
+
+#include <so_5/disp/mpmc_queue_traits/pub.hpp>
+
+#include <so_5/disp/thread_pool/pub.hpp>
+#include <so_5/disp/prio_one_thread/quoted_round_robin/quotes.hpp>
+
+#include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+
+#include <so_5/optional.hpp>
+
+#include <string_view>
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_thread_pool {
+
+/*!
+ * \brief Alias for namespace with traits of event queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+namespace queue_traits = so_5::disp::mpmc_queue_traits;
+
+/*!
+ * \brief Alias for quotes for priorities.
+ *
+ * \since
+ * v.5.6.2
+ */
+using quotes_t = so_5::disp::prio_one_thread::quoted_round_robin::quotes_t;
+
+/*!
+ * \brief Alias for type of FIFO mechanism for agent's demands.
+ *
+ * \since
+ * v.5.6.2
+ */
+using fifo_t = so_5::disp::thread_pool::fifo_t;
+
+/*!
+ * \brief Alias for parameters for binding agents.
+ *
+ * \since
+ * v.5.6.2
+ */
+using bind_params_t = so_5::disp::thread_pool::bind_params_t;
+
+//
+// disp_params_t
+//
+/*!
+ * \brief Parameters for %prio_thread_pool dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class disp_params_t
+	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	{
+		using activity_tracking_mixin_t = so_5::disp::reuse::
+				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+
+	public :
+		//! Default constructor.
+		disp_params_t() = default;
+
+		friend inline void
+		swap(
+			disp_params_t & a, disp_params_t & b ) noexcept
+			{
+				using std::swap;
+
+				swap(
+						static_cast< activity_tracking_mixin_t & >(a),
+						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+
+				swap( a.m_thread_count, b.m_thread_count );
+				swap( a.m_queue_params, b.m_queue_params );
+				swap( a.m_quotes, b.m_quotes );
+			}
+
+		//! Setter for thread count.
+		disp_params_t &
+		thread_count( std::size_t count )
+			{
+				m_thread_count = count;
+				return *this;
+			}
+
+		//! Getter for thread count.
+		std::size_t
+		thread_count() const
+			{
+				return m_thread_count;
+			}
+
+		//! Setter for queue parameters.
+		disp_params_t &
+		set_queue_params( queue_traits::queue_params_t p )
+			{
+				m_queue_params = std::move(p);
+				return *this;
+			}
+
+		//! Tuner for queue parameters.
+		/*!
+		 * Accepts lambda-function or functional object which tunes
+		 * queue parameters.
+			\code
+			using namespace so_5::disp::prio_thread_pool;
+			auto disp = make_dispatcher( env,
+				"workers_disp",
+				disp_params_t{}
+					.thread_count( 10 )
+					.tune_queue_params(
+						[]( queue_traits::queue_params_t & p ) {
+							p.lock_factory( queue_traits::simple_lock_factory() );
+						} ) );
+			\endcode
+		 */
+		template< typename L >
+		disp_params_t &
+		tune_queue_params( L tunner )
+			{
+				tunner( m_queue_params );
+				return *this;
+			}
+
+		//! Getter for queue parameters.
+		const queue_traits::queue_params_t &
+		queue_params() const
+			{
+				return m_queue_params;
+			}
+
+		//! Setter for quotes for priorities.
+		/*!
+		 * A quote is the count of agent queues of a priority which
+		 * can be taken for processing while agent queues of lower
+		 * priorities are waiting.
+		 *
+		 * If quotes are not set then priorities are strictly ordered:
+		 * agent queues of low priorities are processed only if there
+		 * are no agent queues of higher priorities.
+		 */
+		disp_params_t &
+		quotes( quotes_t v )
+			{
+				m_quotes = v;
+				return *this;
+			}
+
+		//! Getter for quotes for priorities.
+		const so_5::optional< quotes_t > &
+		quotes() const noexcept
+			{
+				return m_quotes;
+			}
+
+	private :
+		//! Count of working threads.
+		/*!
+		 * Value 0 means that actual thread will be detected automatically.
+		 */
+		std::size_t m_thread_count = { 0 };
+
+		//! Queue parameters.
+		queue_traits::queue_params_t m_queue_params;
+
+		//! Quotes for priorities.
+		/*!
+		 * Priorities are strictly ordered if there is no value.
+		 */
+		so_5::optional< quotes_t > m_quotes;
+	};
+
+namespace impl {
+
+class actual_dispatcher_iface_t;
+
+//
+// basic_dispatcher_iface_t
+//
+/*!
+ * \brief The very basic interface of %prio_thread_pool dispatcher.
+ *
+ * This class contains a minimum that is necessary for implementation
+ * of dispatcher_handle class.
+ *
+ * \since
+ * v.5.6.2
+ */
+class basic_dispatcher_iface_t
+	:	public std::enable_shared_from_this<actual_dispatcher_iface_t>
+	{
+	public :
+		virtual ~basic_dispatcher_iface_t() noexcept = default;
+
+		SO_5_NODISCARD
+		virtual disp_binder_shptr_t
+		binder( bind_params_t params ) = 0;
+	};
+
+using basic_dispatcher_iface_shptr_t =
+		std::shared_ptr< basic_dispatcher_iface_t >;
+
+class dispatcher_handle_maker_t;
+
+} /* namespace impl */
+
+//
+// dispatcher_handle_t
+//
+
+/*!
+ * \brief A handle for %prio_thread_pool dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_NODISCARD dispatcher_handle_t
+	{
+		friend class impl::dispatcher_handle_maker_t;
+
+		//! A reference to actual implementation of a dispatcher.
+		impl::basic_dispatcher_iface_shptr_t m_dispatcher;
+
+		dispatcher_handle_t(
+			impl::basic_dispatcher_iface_shptr_t dispatcher ) noexcept
+			:	m_dispatcher{ std::move(dispatcher) }
+			{}
+
+		//! Is this handle empty?
+		bool
+		empty() const noexcept { return !m_dispatcher; }
+
+	public :
+		dispatcher_handle_t() noexcept = default;
+
+		//! Get a binder for that dispatcher.
+		/*!
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		SO_5_NODISCARD
+		disp_binder_shptr_t
+		binder(
+			bind_params_t params ) const
+			{
+				return m_dispatcher->binder( params );
+			}
+
+		//! Create a binder for that dispatcher.
+		/*!
+		 * This method allows parameters tuning via lambda-function
+		 * or other functional objects.
+		 *
+		 * Usage example:
+		 * \code
+		 * using namespace so_5::disp::prio_thread_pool;
+		 *
+		 * coop.make_agent_with_binder< some_agent_type >(
+		 * 	make_dispatcher( env ).binder( []( auto & params ) {
+		 * 		params.fifo( fifo_t::individual );
+		 * 	} ),
+		 * 	... );
+		 * \endcode
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		template< typename Setter >
+		SO_5_NODISCARD
+		std::enable_if_t<
+				std::is_invocable_v< Setter, bind_params_t& >,
+				disp_binder_shptr_t >
+		binder(
+			//! Function for the parameters tuning.
+			Setter && params_setter ) const
+			{
+				bind_params_t p;
+				params_setter( p );
+
+				return this->binder( p );
+			}
+
+		//! Get a binder for that dispatcher with default binding params.
+		/*!
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		SO_5_NODISCARD
+		disp_binder_shptr_t
+		binder() const
+			{
+				return this->binder( bind_params_t{} );
+			}
+
+		//! Is this handle empty?
+		operator bool() const noexcept { return empty(); }
+
+		//! Does this handle contain a reference to dispatcher?
+		bool
+		operator!() const noexcept { return !empty(); }
+
+		//! Drop the content of handle.
+		void
+		reset() noexcept { m_dispatcher.reset(); }
+	};
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %prio_thread_pool dispatcher.
+ *
+ * The dispatcher works like %thread_pool dispatcher: agents (or
+ * cooperations) have their own FIFO queues of demands and those queues
+ * are processed by a pool of working threads. But non-empty agent
+ * queues are taken for processing in the order of priorities of agents.
+ * Agent queues of the same priority are processed in FIFO order.
+ *
+ * Starvation of agents with low priorities can be prevented by
+ * quotes for priorities (see disp_params_t::quotes()).
+ *
+ * \note A queue for cooperation FIFO receives the priority of the first
+ * agent of the cooperation bound to the dispatcher. So it is recommended
+ * that all agents of such cooperation have the same priority.
+ *
+ * \par Usage sample
+\code
+using namespace so_5::disp::prio_thread_pool;
+auto disp = make_dispatcher(
+	env,
+	"workers",
+	disp_params_t{}
+		.thread_count( 32 )
+		.quotes( quotes_t{ 1 }.set( so_5::prio::p7, 20 ) ) );
+env.introduce_coop( disp.binder(), []( so_5::coop_t & coop ) {...} );
+\endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Parameters for the dispatcher.
+	disp_params_t disp_params );
+
+/*!
+ * \brief Create an instance of %prio_thread_pool dispatcher with
+ * strictly ordered priorities.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Count of working threads.
+	std::size_t thread_count )
+	{
+		return make_dispatcher(
+				env,
+				data_sources_name_base,
+				disp_params_t{}.thread_count( thread_count ) );
+	}
+
+/*!
+ * \brief Create an instance of %prio_thread_pool dispatcher with
+ * the default count of working threads and strictly ordered priorities.
+ *
+ * Count of work threads will be detected by
+ * so_5::disp::thread_pool::default_thread_pool_size() function.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher( environment_t & env )
+	{
+		return make_dispatcher( env, std::string_view{}, disp_params_t{} );
+	}
+
+} /* namespace prio_thread_pool */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,822 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Reactor dispatcher which delivers readiness of file descriptors
+ * as messages to agents.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/disp/reactor/pub.hpp>
+
+#include <so_5/environment.hpp>
+#include <so_5/send_functions.hpp>
+#include <so_5/current_thread_id.hpp>
+#include <so_5/error_logger.hpp>
+
+#include <so_5/stats/repository.hpp>
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
+
+#include <so_5/disp/reuse/work_thread/work_thread.hpp>
+#include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+
+#include <so_5/details/invoke_noexcept_code.hpp>
+#include <so_5/details/rollback_on_exception.hpp>
+
+#if defined(__linux__)
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+	#include <unistd.h>
+
+	#include <so_5/stats/impl/activity_tracking.hpp>
+
+	#include <algorithm>
+	#include <array>
+	#include <atomic>
+	#include <cerrno>
+	#include <chrono>
+	#include <cstring>
+	#include <map>
+	#include <mutex>
+	#include <thread>
+	#include <vector>
+#endif
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reactor {
+
+namespace impl {
+
+#if defined(__linux__)
+
+namespace work_thread = so_5::disp::reuse::work_thread;
+namespace queue_traits = so_5::disp::mpsc_queue_traits;
+namespace stats = so_5::stats;
+
+namespace
+{
+
+std::string
+errno_description( const char * what, int errno_value )
+	{
+		return std::string{ what } + ": " + std::strerror( errno_value );
+	}
+
+} /* namespace anonymous */
+
+//
+// reactor_lock_t
+//
+/*!
+ * \brief A lock for demand queue of a reactor work thread.
+ *
+ * This lock allows to use the ordinary work thread from
+ * so_5::disp::reuse::work_thread. The work thread is parked in
+ * epoll_wait() instead of a condition variable. So it can be woken up
+ * by a new demand (via eventfd) or by readiness of a watched file
+ * descriptor.
+ *
+ * Readiness of file descriptors is delivered by sending msg_fd_ready
+ * to owners of file descriptors. It is done without holding the lock,
+ * so notifications are simply added to the demand queue of the same
+ * work thread.
+ *
+ * Readiness is also checked (without blocking) when the work thread
+ * acquires the lock and the previous check was performed more than
+ * busy_poll_period ago. It prevents starvation of file descriptors
+ * when there are always demands in the queue. Readiness is checked only
+ * by the work thread. Producers from other threads just store demands.
+ */
+class reactor_lock_t final : public queue_traits::lock_t
+	{
+	public :
+		reactor_lock_t()
+			:	m_epoll_fd{ ::epoll_create1( EPOLL_CLOEXEC ) }
+			{
+				if( -1 == m_epoll_fd )
+					SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+							errno_description( "epoll_create1 failed", errno ) );
+
+				m_wakeup_fd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+				if( -1 == m_wakeup_fd )
+					{
+						const auto error = errno;
+						::close( m_epoll_fd );
+						SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+								errno_description( "eventfd failed", error ) );
+					}
+
+				::epoll_event ev{};
+				ev.events = EPOLLIN;
+				ev.data.fd = m_wakeup_fd;
+				if( -1 == ::epoll_ctl( m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &ev ) )
+					{
+						const auto error = errno;
+						::close( m_wakeup_fd );
+						::close( m_epoll_fd );
+						SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+								errno_description( "unable to watch eventfd", error ) );
+					}
+			}
+
+		~reactor_lock_t() noexcept override
+			{
+				::close( m_wakeup_fd );
+				::close( m_epoll_fd );
+			}
+
+		virtual void
+		lock() noexcept override
+			{
+				if( so_5::query_current_thread_id() ==
+						m_consumer_id.load( std::memory_order_relaxed ) )
+					poll_if_busy();
+
+				m_mutex.lock();
+			}
+
+		virtual void
+		unlock() noexcept override
+			{
+				m_mutex.unlock();
+			}
+
+		//! Start watching of a file descriptor.
+		void
+		watch(
+			const agent_t & owner,
+			int fd,
+			watch_mode_t mode )
+			{
+				::epoll_event ev{};
+				ev.events = EPOLLET;
+				if( watch_mode_t::write != mode )
+					ev.events |= EPOLLIN | EPOLLRDHUP;
+				if( watch_mode_t::read != mode )
+					ev.events |= EPOLLOUT;
+				ev.data.fd = fd;
+
+				std::lock_guard< std::mutex > lock{ m_registry_lock };
+
+				if( m_registry.end() != m_registry.find( fd ) )
+					SO_5_THROW_EXCEPTION( rc_fd_watching_failed,
+							"file descriptor is already watched: " +
+							std::to_string( fd ) );
+
+				if( -1 == ::epoll_ctl( m_epoll_fd, EPOLL_CTL_ADD, fd, &ev ) )
+					SO_5_THROW_EXCEPTION( rc_fd_watching_failed,
+							errno_description( "epoll_ctl failed", errno ) );
+
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						m_registry.emplace( fd,
+								registration_t{ &owner, owner.so_direct_mbox() } );
+					},
+					[&] {
+						::epoll_ctl( m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr );
+					} );
+			}
+
+		//! Stop watching of a file descriptor.
+		void
+		unwatch(
+			const agent_t & owner,
+			int fd )
+			{
+				std::lock_guard< std::mutex > lock{ m_registry_lock };
+
+				auto it = m_registry.find( fd );
+				if( m_registry.end() == it || &owner != it->second.m_owner )
+					SO_5_THROW_EXCEPTION( rc_fd_watching_failed,
+							"file descriptor isn't watched by the agent: " +
+							std::to_string( fd ) );
+
+				remove_registration( it );
+			}
+
+		//! Set ID of the work thread.
+		/*!
+		 * Readiness isn't checked at the acquisition of the lock
+		 * until the ID is set.
+		 */
+		void
+		set_consumer( so_5::current_thread_id_t id ) noexcept
+			{
+				m_consumer_id.store( id, std::memory_order_relaxed );
+			}
+
+		//! Stop watching of all file descriptors of an agent.
+		void
+		unwatch_all( const agent_t & owner ) noexcept
+			{
+				std::lock_guard< std::mutex > lock{ m_registry_lock };
+
+				for( auto it = m_registry.begin(); it != m_registry.end(); )
+					if( &owner == it->second.m_owner )
+						it = remove_registration( it );
+					else
+						++it;
+			}
+
+		//! Count of watched file descriptors.
+		std::size_t
+		watched_count()
+			{
+				std::lock_guard< std::mutex > lock{ m_registry_lock };
+				return m_registry.size();
+			}
+
+	protected :
+		virtual void
+		wait_for_notify() noexcept override
+			{
+				// NOTE: m_mutex is acquired.
+				m_waiting = true;
+
+				m_mutex.unlock();
+
+				if( poll( -1 ) )
+					// Notifications will be pushed to the demand queue.
+					// So it is done without holding the lock.
+					deliver();
+
+				m_mutex.lock();
+				m_waiting = false;
+			}
+
+		virtual void
+		notify_one() noexcept override
+			{
+				// NOTE: m_mutex is acquired.
+				if( m_waiting )
+					{
+						m_waiting = false;
+
+						const std::uint64_t value = 1u;
+						// A failure can only mean that the counter is already
+						// non-zero. The consumer will be woken up anyway.
+						[[maybe_unused]] const auto r =
+								::write( m_wakeup_fd, &value, sizeof(value) );
+					}
+			}
+
+	private :
+		//! How often the readiness is checked if there are demands to process.
+		static constexpr std::chrono::milliseconds busy_poll_period{ 1 };
+
+		//! Owner of a watched file descriptor.
+		struct registration_t
+			{
+				const agent_t * m_owner;
+				mbox_t m_mbox;
+			};
+
+		//! Info about a ready file descriptor.
+		struct ready_fd_t
+			{
+				int m_fd;
+				std::uint32_t m_events;
+				//! Receiver of notification. Can be null if fd is unwatched.
+				mbox_t m_mbox;
+			};
+
+		using registry_t = std::map< int, registration_t >;
+
+		//! Lock for the demand queue.
+		std::mutex m_mutex;
+
+		//! Is the consumer waiting in epoll_wait()?
+		/*!
+		 * \note Protected by m_mutex.
+		 */
+		bool m_waiting{ false };
+
+		//! Epoll instance.
+		const int m_epoll_fd;
+
+		//! Eventfd for waking up the consumer.
+		int m_wakeup_fd{ -1 };
+
+		//! ID of the work thread.
+		/*!
+		 * Readiness is checked only by that thread. So m_events and
+		 * m_ready are used without any synchronization.
+		 */
+		std::atomic< so_5::current_thread_id_t > m_consumer_id{};
+
+		//! Is the work thread checking readiness now?
+		/*!
+		 * Prevents a recursive check when a notification is being sent
+		 * to an agent bound to the same work thread.
+		 */
+		bool m_polling{ false };
+
+		//! Time of the last check of readiness.
+		std::chrono::steady_clock::rep m_last_poll{ 0 };
+
+		//! Lock for m_registry.
+		std::mutex m_registry_lock;
+
+		//! Watched file descriptors.
+		registry_t m_registry;
+
+		//! Buffer for epoll_wait().
+		/*!
+		 * \note Used only by the work thread.
+		 */
+		std::array< ::epoll_event, 64 > m_events;
+
+		//! Ready file descriptors found by the last poll().
+		/*!
+		 * \note Used only by the work thread.
+		 */
+		std::vector< ready_fd_t > m_ready;
+
+		static std::chrono::steady_clock::rep
+		now() noexcept
+			{
+				return std::chrono::steady_clock::now().time_since_epoch().count();
+			}
+
+		registry_t::iterator
+		remove_registration( registry_t::iterator it ) noexcept
+			{
+				::epoll_ctl( m_epoll_fd, EPOLL_CTL_DEL, it->first, nullptr );
+				return m_registry.erase( it );
+			}
+
+		//! Wait for readiness of file descriptors.
+		/*!
+		 * The wakeup eventfd is drained only by the blocking wait.
+		 * Otherwise a notification for the consumer could be lost.
+		 *
+		 * \retval true if there are ready file descriptors
+		 * (excluding the wakeup eventfd).
+		 *
+		 * \note Must be called only by the work thread.
+		 */
+		bool
+		poll( int timeout ) noexcept
+			{
+				const int count = ::epoll_wait( m_epoll_fd,
+						m_events.data(), static_cast< int >( m_events.size() ),
+						timeout );
+				m_last_poll = now();
+
+				for( int i = 0; i < count; ++i )
+					{
+						const auto & ev = m_events[ static_cast< std::size_t >(i) ];
+						if( m_wakeup_fd == ev.data.fd )
+							{
+								if( 0 == timeout )
+									continue;
+
+								std::uint64_t value;
+								[[maybe_unused]] const auto r =
+										::read( m_wakeup_fd, &value, sizeof(value) );
+							}
+						else
+							so_5::details::invoke_noexcept_code( [&] {
+									m_ready.push_back( ready_fd_t{ ev.data.fd, ev.events, {} } );
+								} );
+					}
+
+				return !m_ready.empty();
+			}
+
+		//! Send notifications about ready file descriptors.
+		/*!
+		 * A failure of sending a notification is logged. Notifications
+		 * for other file descriptors are sent anyway.
+		 *
+		 * \note Must be called only by the work thread.
+		 */
+		void
+		deliver() noexcept
+			{
+				m_polling = true;
+
+				{
+					std::lock_guard< std::mutex > lock{ m_registry_lock };
+					for( auto & r : m_ready )
+						{
+							auto it = m_registry.find( r.m_fd );
+							if( m_registry.end() != it )
+								r.m_mbox = it->second.m_mbox;
+						}
+				}
+
+				for( const auto & r : m_ready )
+					if( r.m_mbox )
+						try
+							{
+								so_5::send< msg_fd_ready >(
+										r.m_mbox,
+										r.m_fd,
+										0 != (r.m_events & EPOLLIN),
+										0 != (r.m_events & EPOLLOUT),
+										0 != (r.m_events & (EPOLLHUP | EPOLLRDHUP)),
+										0 != (r.m_events & EPOLLERR) );
+							}
+						catch( const std::exception & x )
+							{
+								so_5::details::invoke_noexcept_code( [&] {
+									SO_5_LOG_ERROR(
+											r.m_mbox->environment().error_logger(),
+											stream ) {
+										stream << "unable to deliver readiness of "
+												"file descriptor " << r.m_fd
+												<< ", exception: " << x.what();
+									}
+								} );
+							}
+
+				m_ready.clear();
+
+				m_polling = false;
+			}
+
+		//! Check readiness if it wasn't checked for a long time.
+		void
+		poll_if_busy() noexcept
+			{
+				const std::chrono::steady_clock::rep period =
+						std::chrono::duration_cast< std::chrono::steady_clock::duration >(
+								busy_poll_period ).count();
+				if( m_polling ||
+						now() - m_last_poll < period )
+					return;
+
+				if( poll( 0 ) )
+					deliver();
+			}
+	};
+
+namespace
+{
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t &,
+	const stats::prefix_t &,
+	work_thread::work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	work_thread::work_thread_with_activity_tracking_t & wt )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.thread_id(),
+				wt.take_activity_stats() );
+	}
+
+} /* namespace anonymous */
+
+//
+// dispatcher_template_t
+//
+/*!
+ * \brief Implementation of reactor dispatcher in form of template class.
+ */
+template< typename Work_Thread >
+class dispatcher_template_t final : public basic_dispatcher_iface_t
+	{
+	public :
+		dispatcher_template_t(
+			//! SObjectizer Environment to work in.
+			outliving_reference_t< environment_t > env,
+			//! Base part of data sources names.
+			const std::string_view name_base,
+			//! Dispatcher's parameters.
+			disp_params_t params )
+			:	m_threads{ make_threads( params ) }
+			,	m_data_source{
+					outliving_mutable(env.get().stats_repository()),
+					name_base,
+					outliving_mutable( *this )
+				}
+			{
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
+					{
+						auto & t = m_threads[ i ];
+						t.m_thread->start(
+								so_5::disp::reuse::cpus_for_work_thread(
+										params.thread_affinity(), i ) );
+						t.m_reactor->set_consumer( t.m_thread->started_thread_id() );
+					}
+			}
+
+		~dispatcher_template_t() noexcept override
+			{
+				for( auto & t : m_threads )
+					t.m_thread->shutdown();
+
+				for( auto & t : m_threads )
+					t.m_thread->wait();
+			}
+
+		void
+		preallocate_resources(
+			agent_t & agent ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( m_agents.end() != m_agents.find( &agent ) )
+					SO_5_THROW_EXCEPTION(
+							rc_disp_create_failed,
+							"agent is already bound to the dispatcher" );
+
+				const auto it = std::min_element(
+						m_threads.begin(), m_threads.end(),
+						[]( const thread_info_t & a, const thread_info_t & b ) {
+							return a.m_agents < b.m_agents;
+						} );
+
+				m_agents.emplace( &agent,
+						static_cast< std::size_t >( it - m_threads.begin() ) );
+				++(it->m_agents);
+			}
+
+		void
+		undo_preallocation(
+			agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto it = m_agents.find( &agent );
+				auto & thread = m_threads[ it->second ];
+				m_agents.erase( it );
+				--(thread.m_agents);
+
+				// Agent could start watching in so_define_agent().
+				thread.m_reactor->unwatch_all( agent );
+			}
+
+		void
+		bind(
+			agent_t & agent ) noexcept override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				agent.so_bind_to_dispatcher(
+						*(m_threads[ m_agents.find( &agent )->second ]
+								.m_thread->get_agent_binding()) );
+			}
+
+		void
+		unbind(
+			agent_t & agent ) noexcept override
+			{
+				// We should perform the same actions as for undo_preallocation.
+				undo_preallocation( agent );
+			}
+
+		void
+		watch(
+			const agent_t & owner,
+			int fd,
+			watch_mode_t mode ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				thread_for( owner ).m_reactor->watch( owner, fd, mode );
+			}
+
+		void
+		unwatch(
+			const agent_t & owner,
+			int fd ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				thread_for( owner ).m_reactor->unwatch( owner, fd );
+			}
+
+	private :
+		friend class disp_data_source_t;
+
+		//! Info about one work thread.
+		struct thread_info_t
+			{
+				//! Lock of the demand queue of the thread.
+				/*!
+				 * \note This object is owned by m_thread.
+				 */
+				reactor_lock_t * m_reactor;
+
+				//! Work thread.
+				std::unique_ptr< Work_Thread > m_thread;
+
+				//! Count of agents bound to the thread.
+				std::size_t m_agents{ 0u };
+			};
+
+		/*!
+		 * \brief Data source for run-time monitoring of whole dispatcher.
+		 */
+		class disp_data_source_t final : public stats::source_t
+			{
+				//! Dispatcher to work with.
+				outliving_reference_t< dispatcher_template_t > m_dispatcher;
+
+				//! Basic prefix for data source names.
+				stats::prefix_t m_base_prefix;
+
+			public :
+				disp_data_source_t(
+					const std::string_view name_base,
+					outliving_reference_t< dispatcher_template_t > disp )
+					:	m_dispatcher{ disp }
+					{
+						using namespace so_5::disp::reuse;
+
+						m_base_prefix = make_disp_prefix(
+								"rt", // rt -- reactor
+								name_base,
+								&(m_dispatcher.get()) );
+					}
+
+				void
+				distribute( const mbox_t & mbox ) override
+					{
+						auto & disp = m_dispatcher.get();
+
+						std::lock_guard< std::mutex > lock{ disp.m_lock };
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::disp_thread_count(),
+								disp.m_threads.size() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_base_prefix,
+								stats::suffixes::agent_count(),
+								disp.m_agents.size() );
+
+						for( std::size_t i = 0; i != disp.m_threads.size(); ++i )
+							distribute_value_for_work_thread(
+									mbox, i, disp.m_threads[ i ] );
+					}
+
+			private :
+				void
+				distribute_value_for_work_thread(
+					const mbox_t & mbox,
+					std::size_t index,
+					thread_info_t & info )
+					{
+						const auto prefix =
+								so_5::disp::reuse::make_disp_working_thread_prefix(
+										m_base_prefix, index );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								prefix,
+								stats::suffixes::agent_count(),
+								info.m_agents );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								prefix,
+								stats::suffixes::work_thread_queue_size(),
+								info.m_thread->demands_count() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								prefix,
+								stats::suffixes::watched_fd_count(),
+								info.m_reactor->watched_count() );
+
+						send_thread_activity_stats( mbox, prefix, *(info.m_thread) );
+					}
+			};
+
+		//! Work threads.
+		std::vector< thread_info_t > m_threads;
+
+		//! This object lock.
+		std::mutex m_lock;
+
+		//! Indexes of work threads for agents.
+		std::map< const agent_t *, std::size_t > m_agents;
+
+		//! Data source for run-time monitoring.
+		stats::auto_registered_source_holder_t< disp_data_source_t >
+				m_data_source;
+
+		static std::vector< thread_info_t >
+		make_threads( const disp_params_t & params )
+			{
+				std::vector< thread_info_t > threads;
+				threads.reserve( std::max< std::size_t >( 1u, params.thread_count() ) );
+
+				while( threads.size() != threads.capacity() )
+					{
+						reactor_lock_t * reactor = nullptr;
+						auto thread = std::make_unique< Work_Thread >(
+								[&reactor] {
+									auto lock = std::make_unique< reactor_lock_t >();
+									reactor = lock.get();
+									return queue_traits::lock_unique_ptr_t{ std::move(lock) };
+								} );
+
+						threads.push_back( thread_info_t{ reactor, std::move(thread) } );
+					}
+
+				return threads;
+			}
+
+		//! Get the work thread of an agent.
+		/*!
+		 * \note Must be called when m_lock is acquired.
+		 */
+		thread_info_t &
+		thread_for( const agent_t & owner )
+			{
+				const auto it = m_agents.find( &owner );
+				if( m_agents.end() == it )
+					SO_5_THROW_EXCEPTION( rc_fd_watching_failed,
+							"agent isn't bound to the reactor dispatcher" );
+
+				return m_threads[ it->second ];
+			}
+	};
+
+#endif
+
+//
+// dispatcher_handle_maker_t
+//
+class dispatcher_handle_maker_t
+	{
+	public :
+		static dispatcher_handle_t
+		make( basic_dispatcher_iface_shptr_t disp ) noexcept
+			{
+				return { std::move( disp ) };
+			}
+	};
+
+} /* namespace impl */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+#if defined(__linux__)
+		using namespace so_5::disp::reuse;
+
+		using dispatcher_no_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::work_thread_no_activity_tracking_t >;
+
+		using dispatcher_with_activity_tracking_t =
+				impl::dispatcher_template_t<
+						work_thread::work_thread_with_activity_tracking_t >;
+
+		using so_5::stats::activity_tracking_stuff::create_appropriate_disp;
+		impl::basic_dispatcher_iface_shptr_t disp = create_appropriate_disp<
+						impl::basic_dispatcher_iface_t,
+						dispatcher_no_activity_tracking_t,
+						dispatcher_with_activity_tracking_t >(
+				outliving_reference_t(env),
+				data_sources_name_base,
+				std::move(params) );
+
+		return impl::dispatcher_handle_maker_t::make( std::move(disp) );
+#else
+		(void)env;
+		(void)data_sources_name_base;
+		(void)params;
+
+		SO_5_THROW_EXCEPTION( rc_not_implemented,
+				"reactor dispatcher requires epoll" );
+#endif
+	}
+
+} /* namespace reactor */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,397 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Reactor dispatcher which delivers readiness of file descriptors
+ * as messages to agents.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <so_5/disp_binder.hpp>
+#include <so_5/message.hpp>
+
+#include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+
+#include <memory>
+#include <string_view>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reactor {
+
+//
+// watch_mode_t
+//
+/*!
+ * \brief Kind of readiness to be watched for a file descriptor.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class watch_mode_t
+	{
+		//! File descriptor is ready for reading.
+		read,
+		//! File descriptor is ready for writing.
+		write,
+		//! File descriptor is ready for reading or for writing.
+		read_write
+	};
+
+//
+// msg_fd_ready
+//
+/*!
+ * \brief Notification about readiness of a file descriptor.
+ *
+ * It is sent to the direct mbox of the agent which watches the
+ * file descriptor. The message is handled on the same work thread
+ * which has detected the readiness.
+ *
+ * \attention Readiness is detected in edge-triggered mode. It means
+ * that the file descriptor should be non-blocking and the agent should
+ * read (or write) until EAGAIN. Otherwise the next notification will
+ * be sent only after the next change of the state of file descriptor.
+ *
+ * \since
+ * v.5.6.2
+ */
+class msg_fd_ready final : public message_t
+	{
+	public :
+		msg_fd_ready(
+			int fd,
+			bool readable,
+			bool writable,
+			bool hangup,
+			bool error ) noexcept
+			:	m_fd{ fd }
+			,	m_readable{ readable }
+			,	m_writable{ writable }
+			,	m_hangup{ hangup }
+			,	m_error{ error }
+			{}
+
+		//! File descriptor.
+		const int m_fd;
+		//! Data can be read from the file descriptor.
+		const bool m_readable;
+		//! Data can be written to the file descriptor.
+		const bool m_writable;
+		//! The other side of the file descriptor is closed.
+		const bool m_hangup;
+		//! An error condition on the file descriptor.
+		const bool m_error;
+	};
+
+//
+// disp_params_t
+//
+/*!
+ * \brief Parameters for %reactor dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class disp_params_t
+	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	{
+		using activity_tracking_mixin_t = so_5::disp::reuse::
+				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+
+	public :
+		//! Default constructor.
+		disp_params_t() = default;
+
+		friend inline void
+		swap( disp_params_t & a, disp_params_t & b ) noexcept
+			{
+				swap(
+						static_cast< activity_tracking_mixin_t & >(a),
+						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+				std::swap( a.m_thread_count, b.m_thread_count );
+			}
+
+		//! Setter for thread count.
+		/*!
+		 * Every work thread has its own demand queue and its own set
+		 * of watched file descriptors. An agent is bound to the work
+		 * thread with the smallest count of agents.
+		 */
+		disp_params_t &
+		thread_count( std::size_t count )
+			{
+				m_thread_count = count;
+				return *this;
+			}
+
+		//! Getter for thread count.
+		std::size_t
+		thread_count() const
+			{
+				return m_thread_count;
+			}
+
+	private :
+		//! Count of working threads.
+		std::size_t m_thread_count = { 1 };
+	};
+
+namespace impl {
+
+//
+// basic_dispatcher_iface_t
+//
+/*!
+ * \brief The very basic interface of %reactor dispatcher.
+ *
+ * This class contains a minimum that is necessary for implementation
+ * of dispatcher_handle class.
+ *
+ * \since
+ * v.5.6.2
+ */
+class basic_dispatcher_iface_t : public disp_binder_t
+	{
+	public :
+		//! Start watching of a file descriptor.
+		virtual void
+		watch(
+			const agent_t & owner,
+			int fd,
+			watch_mode_t mode ) = 0;
+
+		//! Stop watching of a file descriptor.
+		virtual void
+		unwatch(
+			const agent_t & owner,
+			int fd ) = 0;
+	};
+
+using basic_dispatcher_iface_shptr_t =
+		std::shared_ptr< basic_dispatcher_iface_t >;
+
+class dispatcher_handle_maker_t;
+
+} /* namespace impl */
+
+//
+// dispatcher_handle_t
+//
+/*!
+ * \brief A handle for %reactor dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_NODISCARD dispatcher_handle_t
+	{
+		friend class impl::dispatcher_handle_maker_t;
+
+		//! A reference to actual implementation of a dispatcher.
+		impl::basic_dispatcher_iface_shptr_t m_dispatcher;
+
+		dispatcher_handle_t(
+			impl::basic_dispatcher_iface_shptr_t dispatcher ) noexcept
+			:	m_dispatcher{ std::move(dispatcher) }
+			{}
+
+		//! Is this handle empty?
+		bool
+		empty() const noexcept { return !m_dispatcher; }
+
+	public :
+		dispatcher_handle_t() noexcept = default;
+
+		//! Get a binder for that dispatcher.
+		/*!
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		SO_5_NODISCARD
+		disp_binder_shptr_t
+		binder() const noexcept
+			{
+				return m_dispatcher;
+			}
+
+		//! Start watching of a file descriptor.
+		/*!
+		 * Readiness of \a fd will be delivered to \a owner as
+		 * msg_fd_ready messages.
+		 *
+		 * Usage example:
+		 * \code
+		 * class reader final : public so_5::agent_t
+		 * {
+		 * 	so_5::disp::reactor::dispatcher_handle_t m_disp;
+		 * 	const int m_fd;
+		 * 	...
+		 * 	void so_define_agent() override
+		 * 	{
+		 * 		using namespace so_5::disp::reactor;
+		 * 		so_subscribe_self().event( &reader::on_ready );
+		 * 		m_disp.watch( *this, m_fd, watch_mode_t::read );
+		 * 	}
+		 *
+		 * 	void on_ready( mhood_t< so_5::disp::reactor::msg_fd_ready > cmd )
+		 * 	{
+		 * 		// Read from cmd->m_fd until EAGAIN.
+		 * 		...
+		 * 	}
+		 * };
+		 * \endcode
+		 *
+		 * \note File descriptors of an agent are unwatched automatically
+		 * when the agent is unbound from the dispatcher. But the
+		 * file descriptors are not closed by the dispatcher.
+		 *
+		 * \throw so_5::exception_t with rc_fd_watching_failed if \a owner
+		 * isn't bound to this dispatcher or if \a fd can't be watched.
+		 *
+		 * \attention \a owner must be bound to this dispatcher. It can be
+		 * done in so_define_agent() and later.
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		void
+		watch(
+			//! Agent to receive notifications.
+			const agent_t & owner,
+			//! File descriptor to be watched.
+			int fd,
+			//! Kind of readiness to be watched.
+			watch_mode_t mode ) const
+			{
+				m_dispatcher->watch( owner, fd, mode );
+			}
+
+		//! Stop watching of a file descriptor.
+		/*!
+		 * \note Some notifications for \a fd can be still in the queue
+		 * of \a owner after return from this method.
+		 *
+		 * \throw so_5::exception_t with rc_fd_watching_failed if \a fd
+		 * isn't watched by \a owner.
+		 *
+		 * \attention
+		 * An attempt to call this method on empty handle is UB.
+		 */
+		void
+		unwatch(
+			//! Agent which watches the file descriptor.
+			const agent_t & owner,
+			//! File descriptor.
+			int fd ) const
+			{
+				m_dispatcher->unwatch( owner, fd );
+			}
+
+		//! Is this handle empty?
+		operator bool() const noexcept { return empty(); }
+
+		//! Does this handle contain a reference to dispatcher?
+		bool
+		operator!() const noexcept { return !empty(); }
+
+		//! Drop the content of handle.
+		void
+		reset() noexcept { m_dispatcher.reset(); }
+	};
+
+//
+// make_dispatcher
+//
+/*!
+ * \brief Create an instance of %reactor dispatcher.
+ *
+ * Work threads of the dispatcher wait for new demands and for
+ * readiness of watched file descriptors at the same time (by using
+ * epoll). Readiness of file descriptors is delivered to agents as
+ * msg_fd_ready messages without an additional thread.
+ *
+ * Readiness of file descriptors is checked when a work thread has no
+ * demands to process and, at least once in a millisecond, while the
+ * work thread is busy.
+ *
+ * \par Usage sample
+\code
+auto disp = so_5::disp::reactor::make_dispatcher(
+	env,
+	"sockets",
+	so_5::disp::reactor::disp_params_t{}.thread_count( 2 ) );
+env.introduce_coop( disp.binder(), [&]( so_5::coop_t & coop ) {
+	coop.make_agent< connection_handler >( disp, socket );
+} );
+\endcode
+ *
+ * \throw so_5::exception_t with rc_not_implemented on platforms
+ * without epoll.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base,
+	//! Parameters for the dispatcher.
+	disp_params_t params );
+
+/*!
+ * \brief Create an instance of %reactor dispatcher with the default
+ * parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher(
+	//! SObjectizer Environment to work in.
+	environment_t & env,
+	//! Value for creating names of data sources for
+	//! run-time monitoring.
+	const std::string_view data_sources_name_base )
+	{
+		return make_dispatcher( env, data_sources_name_base, disp_params_t{} );
+	}
+
+/*!
+ * \brief Create an instance of %reactor dispatcher with the default
+ * parameters and without a name.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline dispatcher_handle_t
+make_dispatcher( environment_t & env )
+	{
+		return make_dispatcher( env, std::string_view{}, disp_params_t{} );
+	}
+
+} /* namespace reactor */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,138 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A free-list for items of intrusive demand queues.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// default_free_list_capacity
+//
+/*!
+ * \brief Default max count of items kept in a free-list.
+ *
+ * \since
+ * v.5.6.2
+ */
+constexpr std::size_t default_free_list_capacity = 64u;
+
+//
+// intrusive_free_list_t
+//
+/*!
+ * \brief A free-list for items of intrusive demand queues.
+ *
+ * Items removed from a demand queue are stored in that list and then
+ * reused for new demands. It allows to avoid an allocation and
+ * a deallocation for every demand in the steady state.
+ *
+ * The count of items in the list is limited. If the list is full
+ * then an item should be deleted by the caller.
+ *
+ * \attention This class is not thread safe. It is intended to be
+ * protected by the lock of the demand queue.
+ *
+ * \tparam Item type of item. It must have a public field `m_next`
+ * of type `Item *` (or `std::atomic<Item *>`) and must be allocated
+ * by `new`.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Item >
+class intrusive_free_list_t
+	{
+	public :
+		intrusive_free_list_t(
+			std::size_t capacity = default_free_list_capacity ) noexcept
+			:	m_capacity{ capacity }
+			{}
+
+		intrusive_free_list_t( const intrusive_free_list_t & ) = delete;
+		intrusive_free_list_t &
+		operator=( const intrusive_free_list_t & ) = delete;
+
+		~intrusive_free_list_t() noexcept
+			{
+				while( m_head )
+					{
+						Item * item = m_head;
+						m_head = item->m_next;
+						delete item;
+					}
+			}
+
+		//! Take an item from the list.
+		/*!
+		 * \return nullptr if the list is empty.
+		 */
+		Item *
+		try_take() noexcept
+			{
+				Item * item = m_head;
+				if( item )
+					{
+						m_head = item->m_next;
+						item->m_next = nullptr;
+						--m_size;
+					}
+
+				return item;
+			}
+
+		//! Return an item to the list.
+		/*!
+		 * \return false if the list is full. The item must be deleted
+		 * by the caller in that case.
+		 */
+		bool
+		try_put( Item * item ) noexcept
+			{
+				if( m_size == m_capacity )
+					return false;
+
+				item->m_next = m_head;
+				m_head = item;
+				++m_size;
+
+				return true;
+			}
+
+		//! Count of items in the list.
+		std::size_t
+		size() const noexcept
+			{
+				return m_size;
+			}
+
+	private :
+		//! Max count of items in the list.
+		const std::size_t m_capacity;
+
+		//! The first item in the list.
+		Item * m_head{ nullptr };
+
+		//! Count of items in the list.
+		std::size_t m_size{ 0u };
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
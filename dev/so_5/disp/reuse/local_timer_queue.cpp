@@ -0,0 +1,167 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A queue of short delayed messages handled by a work thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/disp/reuse/local_timer_queue.hpp>
+
+#include <so_5/agent.hpp>
+#include <so_5/environment.hpp>
+
+#include <so_5/impl/mbox_iface_for_timers.hpp>
+
+#include <so_5/details/invoke_noexcept_code.hpp>
+
+#include <algorithm>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+namespace {
+
+//! The queue bound to the current thread.
+thread_local local_timer_queue_t * g_current_queue = nullptr;
+
+//! Comparator for a heap with the nearest deadline at the front.
+template< typename T >
+bool
+later_than( const T & a, const T & b ) noexcept
+	{
+		return a.m_deadline > b.m_deadline ||
+				( a.m_deadline == b.m_deadline && a.m_seq > b.m_seq );
+	}
+
+} /* namespace anonymous */
+
+//
+// local_timer_queue_t
+//
+bool
+local_timer_queue_t::try_schedule(
+	const std::type_index & msg_type,
+	const message_ref_t & msg,
+	const mbox_t & mbox,
+	clock::duration pause )
+	{
+		auto * queue = g_current_queue;
+		if( !queue || !queue->m_current_agent || pause >= max_pause() ||
+				queue->m_current_agent->so_direct_mbox()->id() != mbox->id() )
+			return false;
+
+		auto & timers = queue->m_timers;
+		timers.push_back( pending_msg_t{
+				clock::now() + pause,
+				++(queue->m_last_seq),
+				msg_type,
+				msg,
+				mbox } );
+		std::push_heap( timers.begin(), timers.end(),
+				later_than< pending_msg_t > );
+
+		return true;
+	}
+
+void
+local_timer_queue_t::do_deliver_elapsed() noexcept
+	{
+		// The agent can be already destroyed and there is no event
+		// handler running now.
+		m_current_agent = nullptr;
+
+		const auto now = clock::now();
+		while( !m_timers.empty() && m_timers.front().m_deadline <= now )
+			{
+				std::pop_heap( m_timers.begin(), m_timers.end(),
+						later_than< pending_msg_t > );
+				const pending_msg_t timer = std::move( m_timers.back() );
+				m_timers.pop_back();
+
+				try
+					{
+						so_5::impl::mbox_iface_for_timers_t{ timer.m_mbox }
+								.deliver_message_from_timer(
+										timer.m_msg_type, timer.m_msg );
+					}
+				catch( const std::exception & x )
+					{
+						// The work thread must continue its work. So the error
+						// is only logged.
+						so_5::details::invoke_noexcept_code( [&] {
+							SO_5_LOG_ERROR(
+									timer.m_mbox->environment().error_logger(),
+									stream ) {
+								stream << "exception has been thrown and caught "
+										"during delivery of a delayed message from "
+										"a work thread, the message is lost. "
+										"Exception: " << x.what();
+							}
+						} );
+					}
+			}
+	}
+
+void
+local_timer_queue_t::hand_over_to_timer_thread() noexcept
+	{
+		const auto now = clock::now();
+		for( const auto & timer : m_timers )
+			{
+				try
+					{
+						so_5::low_level_api::single_timer(
+								timer.m_msg_type,
+								timer.m_msg,
+								timer.m_mbox,
+								timer.m_deadline > now ?
+										timer.m_deadline - now : clock::duration::zero() );
+					}
+				catch( ... )
+					{
+						// The timer thread can be already stopped during
+						// the shutdown of the environment. Pending delayed
+						// messages are lost in that case as they are lost
+						// in the timer thread.
+					}
+			}
+
+		m_timers.clear();
+	}
+
+//
+// local_timer_queue_binding_t
+//
+local_timer_queue_binding_t::local_timer_queue_binding_t(
+	local_timer_queue_t & queue,
+	bool enabled ) noexcept
+	:	m_queue( queue )
+	,	m_enabled( enabled )
+	{
+		if( m_enabled )
+			g_current_queue = &m_queue;
+	}
+
+local_timer_queue_binding_t::~local_timer_queue_binding_t() noexcept
+	{
+		if( m_enabled )
+			{
+				// Messages must go to the timer thread from that point.
+				g_current_queue = nullptr;
+				m_queue.hand_over_to_timer_thread();
+			}
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
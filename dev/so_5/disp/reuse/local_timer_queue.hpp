@@ -0,0 +1,208 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A queue of short delayed messages handled by a work thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+#include <so_5/fwd.hpp>
+#include <so_5/mbox.hpp>
+#include <so_5/message.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <typeindex>
+#include <vector>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// local_timer_queue_t
+//
+/*!
+ * \brief A queue of short delayed messages handled by a work thread.
+ *
+ * A work thread binds this queue to itself by local_timer_queue_binding_t.
+ * After that a delayed message with the pause less than max_pause()
+ * which is sent by an agent to its own direct mbox from that work thread
+ * is stored in the queue instead of the timer thread. The work thread
+ * delivers elapsed messages between processing of demands and waits
+ * for the nearest deadline when there are no demands. So there is no
+ * locking of the timer thread and no switching between threads for
+ * such messages.
+ *
+ * Periodic messages and delayed messages with timer_id are always
+ * handled by the timer thread.
+ *
+ * The queue is used only by dispatchers with dedicated work threads
+ * and only if it is turned on in the dispatcher's parameters
+ * (see local_timers_mixin_t).
+ *
+ * \attention The object isn't thread safe. It must be used only by
+ * the owning work thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_TYPE local_timer_queue_t
+	{
+		friend class local_timer_queue_binding_t;
+
+	public :
+		using clock = std::chrono::steady_clock;
+
+		local_timer_queue_t( const local_timer_queue_t & ) = delete;
+		local_timer_queue_t( local_timer_queue_t && ) = delete;
+		local_timer_queue_t & operator=( const local_timer_queue_t & ) = delete;
+		local_timer_queue_t & operator=( local_timer_queue_t && ) = delete;
+
+		local_timer_queue_t() = default;
+		~local_timer_queue_t() noexcept = default;
+
+		//! Max pause for a delayed message to be stored in the queue.
+		static clock::duration
+		max_pause() noexcept
+			{
+				return std::chrono::milliseconds{ 10 };
+			}
+
+		//! Set the agent whose event is being handled by the work thread.
+		/*!
+		 * Only delayed messages sent to the direct mbox of that agent
+		 * can be stored in the queue.
+		 */
+		void
+		set_current_agent( const agent_t * agent ) noexcept
+			{
+				m_current_agent = agent;
+			}
+
+		//! Are there pending messages?
+		bool
+		empty() const noexcept
+			{
+				return m_timers.empty();
+			}
+
+		//! Get the nearest deadline.
+		/*!
+		 * \attention The queue must not be empty.
+		 */
+		clock::time_point
+		next_deadline() const noexcept
+			{
+				return m_timers.front().m_deadline;
+			}
+
+		//! Deliver all messages whose deadline has been reached.
+		/*!
+		 * \note If the delivery of a message throws then the exception
+		 * is logged and the message is lost.
+		 */
+		void
+		deliver_elapsed() noexcept
+			{
+				if( !m_timers.empty() )
+					do_deliver_elapsed();
+			}
+
+		//! Try to store a delayed message in the queue of the current thread.
+		/*!
+		 * \retval false if the message must be handled by the timer thread.
+		 */
+		static bool
+		try_schedule(
+			//! Message type for searching subscribers.
+			const std::type_index & msg_type,
+			//! Message to be sent after timeout.
+			const message_ref_t & msg,
+			//! Mbox to which message will be delivered.
+			const mbox_t & mbox,
+			//! Timeout before the delivery.
+			clock::duration pause );
+
+	private :
+		//! Description of one pending message.
+		struct pending_msg_t
+			{
+				clock::time_point m_deadline;
+				//! Sequence number for FIFO order of the same deadlines.
+				std::uint64_t m_seq;
+				std::type_index m_msg_type;
+				message_ref_t m_msg;
+				mbox_t m_mbox;
+			};
+
+		//! Pending messages.
+		/*!
+		 * It is a binary heap with the nearest deadline at the front.
+		 */
+		std::vector< pending_msg_t > m_timers;
+
+		//! Sequence number of the last stored message.
+		std::uint64_t m_last_seq{ 0u };
+
+		//! The agent whose event is being handled.
+		const agent_t * m_current_agent{ nullptr };
+
+		void
+		do_deliver_elapsed() noexcept;
+
+		//! Pass all pending messages to the timer thread.
+		/*!
+		 * Is called when the work thread finishes its work.
+		 */
+		void
+		hand_over_to_timer_thread() noexcept;
+	};
+
+//
+// local_timer_queue_binding_t
+//
+/*!
+ * \brief Binding of local_timer_queue to the current work thread.
+ *
+ * The queue isn't bound if the work thread can't wait for the nearest
+ * deadline. Pending messages are passed to the timer thread when the
+ * binding is destroyed.
+ *
+ * \since
+ * v.5.6.2
+ */
+class SO_5_TYPE local_timer_queue_binding_t
+	{
+	public :
+		local_timer_queue_binding_t(
+			//! Queue to be bound.
+			local_timer_queue_t & queue,
+			//! Can the work thread wait for the nearest deadline?
+			bool enabled ) noexcept;
+		~local_timer_queue_binding_t() noexcept;
+
+		local_timer_queue_binding_t(
+			const local_timer_queue_binding_t & ) = delete;
+		local_timer_queue_binding_t &
+		operator=( const local_timer_queue_binding_t & ) = delete;
+
+	private :
+		local_timer_queue_t & m_queue;
+		const bool m_enabled;
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
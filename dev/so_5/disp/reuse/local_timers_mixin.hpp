@@ -0,0 +1,82 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A mixin for dispatcher parameters with local timers flag.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// local_timers_mixin_t
+//
+/*!
+ * \brief A mixin with the flag for handling short delayed messages
+ * by work threads of a dispatcher.
+ *
+ * If the flag is set then a delayed message with a pause less than
+ * local_timer_queue_t::max_pause() which is sent by an agent to its own
+ * direct mbox is handled by the agent's work thread instead of
+ * the timer thread. See local_timer_queue_t for the details.
+ *
+ * Only such self-sends are handled by the work thread. Delayed messages
+ * to other agents go through the timer thread even if those agents are
+ * bound to the same work thread.
+ *
+ * The flag is off by default. It should be turned on with care:
+ * - such messages are handled regardless of the timer thread chosen
+ *   for the environment;
+ * - such messages are not counted in the stats of the timer thread;
+ * - a long event handler delays such messages for all agents on the
+ *   same work thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Params >
+class local_timers_mixin_t
+	{
+		bool m_local_timers{ false };
+
+	public :
+		//! Getter for local timers flag.
+		bool
+		local_timers() const noexcept
+			{
+				return m_local_timers;
+			}
+
+		friend inline void swap(
+				local_timers_mixin_t & a,
+				local_timers_mixin_t & b ) noexcept
+			{
+				std::swap( a.m_local_timers, b.m_local_timers );
+			}
+
+		//! Setter for local timers flag.
+		Params &
+		local_timers( bool v ) noexcept
+			{
+				m_local_timers = v;
+				return static_cast< Params & >(*this);
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,79 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Helpers for distribution of stats of dispatcher queue locks.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/send_functions.hpp>
+
+#include <so_5/stats/lock_stats.hpp>
+#include <so_5/stats/messages.hpp>
+#include <so_5/stats/std_names.hpp>
+
+#include <chrono>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// send_lock_stats
+//
+/*!
+ * \brief Send stats of a queue lock to run-time monitoring.
+ *
+ * Nothing is sent if \a lock_owner doesn't collect lock stats.
+ *
+ * \tparam Lock_Owner type of object with a method
+ * `bool query_lock_stats(so_5::stats::lock_stats_t &) const`.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Lock_Owner >
+void
+send_lock_stats(
+	const mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	const Lock_Owner & lock_owner )
+	{
+		stats::lock_stats_t lock_stats;
+		if( !lock_owner.query_lock_stats( lock_stats ) )
+			return;
+
+		so_5::send< stats::messages::quantity< std::size_t > >(
+				mbox,
+				prefix,
+				stats::suffixes::lock_spin_wakeup_count(),
+				static_cast< std::size_t >( lock_stats.m_spin_wakeups ) );
+
+		so_5::send< stats::messages::quantity< std::size_t > >(
+				mbox,
+				prefix,
+				stats::suffixes::lock_park_count(),
+				static_cast< std::size_t >( lock_stats.m_parks ) );
+
+		so_5::send< stats::messages::quantity< std::size_t > >(
+				mbox,
+				prefix,
+				stats::suffixes::lock_spin_budget(),
+				static_cast< std::size_t >(
+						std::chrono::duration_cast< std::chrono::microseconds >(
+								lock_stats.m_spin_budget ).count() ) );
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -13,7 +13,11 @@
 
 #include <so_5/disp/mpmc_queue_traits/pub.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace so_5
@@ -26,7 +30,33 @@ namespace reuse
 {
 
 //
-// mpmc_ptr_queue_t
+// elastic_pool_listener_t
+//
+/*!
+ * \brief An interface of listener for requests for new working threads.
+ *
+ * Is used by a queue in elastic mode.
+ *
+ * \since
+ * v.5.6.2
+ */
+class elastic_pool_listener_t
+	{
+	protected :
+		~elastic_pool_listener_t() = default;
+
+	public :
+		//! A new working thread is necessary.
+		/*!
+		 * \note This method is called when the queue is locked. So it
+		 * must not call the queue's methods.
+		 */
+		virtual void
+		on_growth_required() noexcept = 0;
+	};
+
+//
+// basic_mpmc_ptr_queue_t
 //
 /*!
  * \brief Multi-producer/Multi-consumer queue of pointers.
@@ -35,20 +65,33 @@ namespace reuse
  * - waiting on spinlock for the limited period of time;
  * - then waiting on heavy synchronization object.
  *
+ * \note Since v.5.6.2 the container for pointers is specified by
+ * \a Ready_List template parameter. It must provide empty(), size(),
+ * front(), pop_front() and push_back() like std::deque. It allows
+ * to change the order in which pointers are extracted from the queue.
+ *
  * \tparam T type of object.
+ * \tparam Ready_List type of container for pointers.
  *
  * \since
  * v.5.4.0
  */
-template< class T >
-class mpmc_ptr_queue_t
+template< class T, class Ready_List >
+class basic_mpmc_ptr_queue_t
 	{
 	public :
-		mpmc_ptr_queue_t(
+		/*!
+		 * \note Since v.5.6.2 additional arguments are passed to
+		 * the constructor of \a Ready_List.
+		 */
+		template< typename... Ready_List_Args >
+		basic_mpmc_ptr_queue_t(
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
-			std::size_t thread_count )
+			std::size_t thread_count,
+			Ready_List_Args &&... ready_list_args )
 			:	m_lock{ queue_params.lock_factory()() }
-			,	m_max_thread_count{ thread_count }
+			,	m_queue{ std::forward< Ready_List_Args >( ready_list_args )... }
+			,	m_thread_count{ thread_count }
 			,	m_next_thread_wakeup_threshold{
 					queue_params.next_thread_wakeup_threshold() }
 			{
@@ -69,6 +112,92 @@ class mpmc_ptr_queue_t
 					pop_and_notify_one_waiting_customer();
 			}
 
+		//! Turn elastic mode on.
+		/*!
+		 * In that mode \a listener is informed when there are no idle
+		 * working threads and there are at least \a growth_threshold
+		 * non-empty queues waiting for processing.
+		 *
+		 * Every request must be completed by a call to growth_completed().
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		set_elasticity(
+			//! Max count of working threads.
+			std::size_t max_thread_count,
+			//! Min count of waiting queues for a request for new thread.
+			std::size_t growth_threshold,
+			//! Receiver of requests for new threads.
+			elastic_pool_listener_t & listener )
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_waiting_customers.reserve( max_thread_count );
+				m_elastic_max_thread_count = max_thread_count;
+				m_growth_threshold = growth_threshold ? growth_threshold : 1u;
+				m_elastic_listener = &listener;
+			}
+
+		//! Completion of a request for new working thread.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		growth_completed(
+			//! Has a new working thread been started?
+			bool thread_started ) noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_growth_in_progress = false;
+				if( !thread_started )
+					--m_thread_count;
+				else
+					// The load can still be too high.
+					try_request_growth();
+			}
+
+		//! An attempt to retire a working thread which is idle for too long.
+		/*!
+		 * The retired thread receives nullptr from pop().
+		 *
+		 * \return condition object of the retired thread or nullptr if
+		 * there is no thread to be retired.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		so_5::disp::mpmc_queue_traits::condition_t *
+		try_retire_idle_thread(
+			//! Min count of working threads.
+			std::size_t min_thread_count,
+			//! Max time of waiting for the work.
+			std::chrono::steady_clock::duration idle_timeout ) noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				// The first customer waits for the longest time because
+				// customers are woken up in LIFO order.
+				if( m_shutdown ||
+						m_thread_count <= min_thread_count ||
+						m_waiting_customers.empty() ||
+						std::chrono::steady_clock::now() -
+								m_waiting_customers.front().m_since < idle_timeout )
+					return nullptr;
+
+				auto * condition = m_waiting_customers.front().m_condition;
+				m_waiting_customers.erase( m_waiting_customers.begin() );
+				--m_thread_count;
+
+				m_retired_customers.push_back( condition );
+				condition->notify();
+
+				return condition;
+			}
+
 		//! Get next active queue.
 		/*!
 		 * \retval nullptr is the case of dispatcher shutdown.
@@ -94,9 +223,18 @@ class mpmc_ptr_queue_t
 								return r;
 							}
 
-						m_waiting_customers.push_back( &condition );
+						m_waiting_customers.push_back( waiting_customer_t{
+								&condition,
+								m_elastic_listener ?
+										std::chrono::steady_clock::now() :
+										std::chrono::steady_clock::time_point{} } );
 
 						condition.wait();
+
+						if( !m_retired_customers.empty() &&
+								try_remove_retired_customer( condition ) )
+							break;
+
 						// If we are here then the current wakeup procedure is
 						// finished.
 						m_wakeup_in_progress = false;
@@ -123,14 +261,18 @@ class mpmc_ptr_queue_t
 
 				if( !m_queue.empty() )
 					{
-						auto r = m_queue.front();
-						m_queue.pop_front();
-
 						// Old non-empty queue must be stored for further processing.
 						// No need to wakup someone because the length of m_queue
-						// didn't changed.
+						// won't be changed.
+						//
+						// NOTE: since v.5.6.2 the current queue is stored before
+						// the extraction. It allows Ready_List to return the
+						// current queue back if it should be processed first.
 						m_queue.push_back( current );
 
+						auto r = m_queue.front();
+						m_queue.pop_front();
+
 						return r;
 					}
 
@@ -146,6 +288,9 @@ class mpmc_ptr_queue_t
 				m_queue.push_back( queue );
 
 				try_wakeup_someone_if_possible();
+
+				if( m_elastic_listener )
+					try_request_growth();
 			}
 
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
@@ -154,6 +299,20 @@ class mpmc_ptr_queue_t
 				return m_lock->allocate_condition();
 			}
 
+		/*!
+		 * \brief Get stats of waiting on the queue lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+			{
+				return m_lock->query_stats( to );
+			}
+
 	private :
 		//! Object's lock.
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
@@ -162,7 +321,10 @@ class mpmc_ptr_queue_t
 		bool	m_shutdown{ false };
 
 		//! Queue object.
-		std::deque< T * > m_queue;
+		/*!
+		 * \note Since v.5.6.2 it has type \a Ready_List.
+		 */
+		Ready_List m_queue;
 
 		/*!
 		 * \since
@@ -173,13 +335,15 @@ class mpmc_ptr_queue_t
 		bool	m_wakeup_in_progress{ false };
 
 		/*!
-		 * \brief Maximum count of working threads to be used with
+		 * \brief Count of working threads to be used with
 		 * that mpmc_queue.
 		 *
+		 * \note It is changed in elastic mode.
+		 *
 		 * \since
 		 * v.5.5.16
 		 */
-		const std::size_t m_max_thread_count;
+		std::size_t m_thread_count;
 
 		/*!
 		 * \brief Threshold for wake up next working thread if there are
@@ -190,13 +354,74 @@ class mpmc_ptr_queue_t
 		 */
 		const std::size_t m_next_thread_wakeup_threshold;
 
+		//! Description of a waiting thread.
+		struct waiting_customer_t
+			{
+				//! Condition object of the thread.
+				so_5::disp::mpmc_queue_traits::condition_t * m_condition;
+
+				/*!
+				 * \brief Time when the thread started to wait.
+				 *
+				 * Is set only in elastic mode.
+				 *
+				 * \since
+				 * v.5.6.2
+				 */
+				std::chrono::steady_clock::time_point m_since;
+			};
+
 		//! Waiting threads.
-		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+		std::vector< waiting_customer_t > m_waiting_customers;
+
+		/*!
+		 * \brief Listener for requests for new threads.
+		 *
+		 * Is not nullptr only in elastic mode.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		elastic_pool_listener_t * m_elastic_listener{ nullptr };
+
+		/*!
+		 * \brief Max count of working threads in elastic mode.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::size_t m_elastic_max_thread_count{ 0u };
+
+		/*!
+		 * \brief Min count of waiting non-empty queues for a request
+		 * for new thread.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::size_t m_growth_threshold{ 1u };
+
+		/*!
+		 * \brief Is there a request for new thread in processing?
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool m_growth_in_progress{ false };
+
+		/*!
+		 * \brief Threads which are retired but are not woken up yet.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * >
+				m_retired_customers;
 
 		void
 		pop_and_notify_one_waiting_customer()
 			{
-				auto & condition = *m_waiting_customers.back();
+				auto & condition = *(m_waiting_customers.back().m_condition);
 				m_waiting_customers.pop_back();
 
 				m_wakeup_in_progress = true;
@@ -225,11 +450,69 @@ class mpmc_ptr_queue_t
 						!m_waiting_customers.empty() &&
 						!m_wakeup_in_progress &&
 						( m_queue.size() > m_next_thread_wakeup_threshold ||
-						m_max_thread_count == m_waiting_customers.size() ) )
+						m_thread_count == m_waiting_customers.size() ) )
 					pop_and_notify_one_waiting_customer();
 			}
+
+		/*!
+		 * \brief An attempt to request a new working thread if
+		 * it is necessary and possible.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		try_request_growth() noexcept
+			{
+				if( !m_growth_in_progress &&
+						m_waiting_customers.empty() &&
+						m_queue.size() >= m_growth_threshold &&
+						m_thread_count < m_elastic_max_thread_count )
+					{
+						m_growth_in_progress = true;
+						++m_thread_count;
+						m_elastic_listener->on_growth_required();
+					}
+			}
+
+		/*!
+		 * \brief Remove the condition from the list of retired threads.
+		 *
+		 * \return true if the condition belongs to a retired thread.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		try_remove_retired_customer(
+			so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				const auto it = std::find(
+						m_retired_customers.begin(),
+						m_retired_customers.end(),
+						&condition );
+				if( it == m_retired_customers.end() )
+					return false;
+
+				m_retired_customers.erase( it );
+				return true;
+			}
 	};
 
+//
+// mpmc_ptr_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of pointers in FIFO order.
+ *
+ * \note Since v.5.6.2 it is an alias for basic_mpmc_ptr_queue_t.
+ *
+ * \since
+ * v.5.4.0
+ */
+template< class T >
+using mpmc_ptr_queue_t = basic_mpmc_ptr_queue_t< T, std::deque< T * > >;
+
 } /* namespace reuse */
 
 } /* namespace disp */
@@ -0,0 +1,198 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Policies for the spinning stage of combined queue locks.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/stats/lock_stats.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// fixed_spin_budget_t
+//
+/*!
+ * \brief A policy with the spin budget which never changes.
+ *
+ * It is the traditional behaviour of combined locks.
+ *
+ * \since
+ * v.5.6.2
+ */
+class fixed_spin_budget_t
+	{
+	public :
+		fixed_spin_budget_t(
+			std::chrono::high_resolution_clock::duration budget )
+			:	m_budget{ budget }
+			{}
+
+		//! Max time for the spinning stage of the next wait.
+		std::chrono::high_resolution_clock::duration
+		budget() const noexcept
+			{
+				return m_budget;
+			}
+
+		//! A wait has been finished during the spinning stage.
+		void
+		spin_succeeded( std::chrono::high_resolution_clock::duration ) noexcept
+			{}
+
+		//! A wait has been finished after parking of a thread.
+		void
+		park_finished( std::chrono::high_resolution_clock::duration ) noexcept
+			{}
+
+	private :
+		const std::chrono::high_resolution_clock::duration m_budget;
+	};
+
+//
+// adaptive_spin_budget_t
+//
+/*!
+ * \brief A policy which learns the spin budget from recent waits.
+ *
+ * The budget is moved towards doubled wakeup latency of recent waits
+ * (by 1/8 of the difference on every wait, like adaptive mutexes do):
+ *
+ * - if a wait has been finished during the spinning stage, the budget
+ *   is tuned to the observed latency. It becomes shorter if
+ *   notifications come quickly;
+ * - if a thread has been parked but the notification came before
+ *   \a max_budget, the budget grows: a longer spinning would have
+ *   avoided the parking;
+ * - if a thread has been parked for longer than \a max_budget, the
+ *   spinning was a waste of CPU and the budget shrinks.
+ *
+ * So a lightly loaded queue spins only for a short time while a hot
+ * queue spins long enough to avoid expensive parking.
+ *
+ * \attention Methods budget(), spin_succeeded() and park_finished()
+ * must be called under the lock of the owner. Stats can be read
+ * without that lock.
+ *
+ * \since
+ * v.5.6.2
+ */
+class adaptive_spin_budget_t
+	{
+	public :
+		adaptive_spin_budget_t(
+			//! Max allowed spin budget.
+			std::chrono::high_resolution_clock::duration max_budget )
+			:	m_max_budget{ std::max< std::int64_t >(
+					std::chrono::duration_cast< std::chrono::nanoseconds >(
+							max_budget ).count(),
+					min_budget ) }
+			,	m_budget{ std::max( min_budget, m_max_budget / 8 ) }
+			{}
+
+		//! Max time for the spinning stage of the next wait.
+		std::chrono::high_resolution_clock::duration
+		budget() const noexcept
+			{
+				return std::chrono::duration_cast<
+								std::chrono::high_resolution_clock::duration >(
+						std::chrono::nanoseconds{
+								m_budget.load( std::memory_order_relaxed ) } );
+			}
+
+		//! A wait has been finished during the spinning stage.
+		void
+		spin_succeeded(
+			std::chrono::high_resolution_clock::duration latency ) noexcept
+			{
+				m_spin_wakeups.fetch_add( 1u, std::memory_order_relaxed );
+				adjust_towards( 2 * to_ns( latency ) );
+			}
+
+		//! A wait has been finished after parking of a thread.
+		void
+		park_finished(
+			std::chrono::high_resolution_clock::duration latency ) noexcept
+			{
+				m_parks.fetch_add( 1u, std::memory_order_relaxed );
+
+				const auto ns = to_ns( latency );
+				if( ns < m_max_budget )
+					adjust_towards( 2 * ns );
+				else
+					adjust_towards( min_budget );
+			}
+
+		//! Get the current stats.
+		stats::lock_stats_t
+		query_stats() const noexcept
+			{
+				stats::lock_stats_t result;
+				result.m_spin_wakeups =
+						m_spin_wakeups.load( std::memory_order_relaxed );
+				result.m_parks = m_parks.load( std::memory_order_relaxed );
+				result.m_spin_budget = std::chrono::nanoseconds{
+						m_budget.load( std::memory_order_relaxed ) };
+
+				return result;
+			}
+
+	private :
+		//! The lowest spin budget (in nanoseconds).
+		static constexpr std::int64_t min_budget = 1000;
+
+		//! Max spin budget (in nanoseconds).
+		const std::int64_t m_max_budget;
+
+		//! The current spin budget (in nanoseconds).
+		/*!
+		 * It is atomic only because it can be read by query_stats().
+		 */
+		std::atomic< std::int64_t > m_budget;
+
+		//! Count of waits finished during the spinning stage.
+		std::atomic< std::uint_fast64_t > m_spin_wakeups{ 0u };
+
+		//! Count of waits with parking.
+		std::atomic< std::uint_fast64_t > m_parks{ 0u };
+
+		static std::int64_t
+		to_ns( std::chrono::high_resolution_clock::duration d ) noexcept
+			{
+				return std::chrono::duration_cast< std::chrono::nanoseconds >( d )
+						.count();
+			}
+
+		void
+		adjust_towards( std::int64_t target ) noexcept
+			{
+				target = std::min( std::max( target, min_budget ), m_max_budget );
+
+				const auto current = m_budget.load( std::memory_order_relaxed );
+				m_budget.store(
+						current + (target - current) / 8,
+						std::memory_order_relaxed );
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
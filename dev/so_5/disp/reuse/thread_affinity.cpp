@@ -0,0 +1,335 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief CPU affinity policies for work threads of dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/disp/reuse/thread_affinity.hpp>
+
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+	#include <sched.h>
+	#include <pthread.h>
+	#include <unistd.h>
+#elif defined(_WIN32)
+	#if !defined(WIN32_LEAN_AND_MEAN)
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#if !defined(NOMINMAX)
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#endif
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+namespace {
+
+//
+// topology_t
+//
+/*!
+ * \brief CPUs available for the process grouped by NUMA nodes.
+ */
+struct topology_t
+	{
+		//! Index of NUMA node and its CPUs.
+		struct node_t
+			{
+				unsigned int m_index;
+				cpu_list_t m_cpus;
+			};
+
+		//! Nodes which have at least one available CPU.
+		std::vector< node_t > m_nodes;
+
+		//! All CPUs available for the process in ascending order.
+		cpu_list_t m_allowed;
+	};
+
+/*!
+ * \brief Max CPU index which can be used for binding a thread.
+ */
+#if defined(__linux__)
+constexpr unsigned int max_bindable_cpu = CPU_SETSIZE - 1u;
+#elif defined(_WIN32)
+constexpr unsigned int max_bindable_cpu = sizeof(DWORD_PTR) * 8u - 1u;
+#else
+constexpr unsigned int max_bindable_cpu = ~0u;
+#endif
+
+#if defined(__linux__)
+
+/*!
+ * \brief Parse a list in form "0-3,8,10-11".
+ */
+cpu_list_t
+parse_list( const std::string & what )
+	{
+		cpu_list_t result;
+
+		std::istringstream ss{ what };
+		std::string range;
+		while( std::getline( ss, range, ',' ) )
+			{
+				if( range.empty() || '\n' == range[ 0 ] )
+					continue;
+
+				unsigned long first = 0, last = 0;
+				const auto dash = range.find( '-' );
+				try
+					{
+						first = std::stoul( range.substr( 0, dash ) );
+						last = std::string::npos == dash ?
+								first : std::stoul( range.substr( dash + 1 ) );
+					}
+				catch( const std::exception & )
+					{
+						// Ill-formed item is just ignored.
+						continue;
+					}
+
+				for( ; first <= last; ++first )
+					result.push_back( static_cast< unsigned int >(first) );
+			}
+
+		return result;
+	}
+
+/*!
+ * \brief Read a list from a file in sysfs.
+ */
+cpu_list_t
+read_list( const std::string & file_name )
+	{
+		std::ifstream file{ file_name };
+		std::string content;
+		if( file )
+			std::getline( file, content );
+
+		return parse_list( content );
+	}
+
+topology_t
+detect_topology()
+	{
+		cpu_list_t allowed;
+		{
+			// The mask of the process is used, not the mask of the calling
+			// thread. The calling thread can be a work thread which is
+			// already bound to some CPUs.
+			::cpu_set_t set;
+			CPU_ZERO( &set );
+			if( 0 == ::sched_getaffinity( ::getpid(), sizeof(set), &set ) )
+				for( unsigned int i = 0; i != CPU_SETSIZE; ++i )
+					if( CPU_ISSET( i, &set ) )
+						allowed.push_back( i );
+		}
+		if( allowed.empty() )
+			for( unsigned int i = 0; i != std::thread::hardware_concurrency(); ++i )
+				allowed.push_back( i );
+
+		topology_t result;
+		result.m_allowed = allowed;
+
+		for( const auto node : read_list( "/sys/devices/system/node/online" ) )
+			{
+				topology_t::node_t info{ node, {} };
+				for( const auto cpu : read_list(
+						"/sys/devices/system/node/node" + std::to_string( node ) +
+						"/cpulist" ) )
+					if( std::binary_search( allowed.begin(), allowed.end(), cpu ) )
+						info.m_cpus.push_back( cpu );
+
+				if( !info.m_cpus.empty() )
+					result.m_nodes.push_back( std::move(info) );
+			}
+
+		// NUMA information can be unavailable. All allowed CPUs are
+		// treated as belonging to one node in that case.
+		if( result.m_nodes.empty() )
+			result.m_nodes.push_back( topology_t::node_t{ 0u, std::move(allowed) } );
+
+		return result;
+	}
+
+#else
+
+topology_t
+detect_topology()
+	{
+		unsigned int cpus = std::thread::hardware_concurrency();
+#if defined(_WIN32)
+		// Only the first processor group is supported.
+		cpus = std::min( cpus, 64u );
+#endif
+		if( !cpus )
+			cpus = 1u;
+
+		topology_t result;
+		result.m_nodes.push_back( topology_t::node_t{ 0u, {} } );
+		for( unsigned int i = 0; i != cpus; ++i )
+			result.m_nodes.back().m_cpus.push_back( i );
+		result.m_allowed = result.m_nodes.back().m_cpus;
+
+		return result;
+	}
+
+#endif
+
+const topology_t &
+topology()
+	{
+		static const topology_t instance = detect_topology();
+		return instance;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void
+ensure_valid_thread_affinity( const thread_affinity_t & affinity )
+	{
+		if( thread_affinity_policy_t::cpu_set != affinity.policy() )
+			return;
+
+		const auto & cpus = affinity.cpus();
+		if( cpus.empty() )
+			SO_5_THROW_EXCEPTION( rc_invalid_thread_affinity,
+					"list of CPUs for work threads is empty" );
+
+		const auto & allowed = topology().m_allowed;
+		for( const auto cpu : cpus )
+			{
+				if( cpu > max_bindable_cpu )
+					SO_5_THROW_EXCEPTION( rc_invalid_thread_affinity,
+							"CPU " + std::to_string( cpu ) +
+							" can't be used for binding a thread" );
+
+				if( !std::binary_search( allowed.begin(), allowed.end(), cpu ) )
+					SO_5_THROW_EXCEPTION( rc_invalid_thread_affinity,
+							"CPU " + std::to_string( cpu ) +
+							" isn't available for the process" );
+			}
+	}
+
+SO_5_FUNC cpu_list_t
+cpus_for_work_thread(
+	const thread_affinity_t & affinity,
+	std::size_t thread_index )
+	{
+		const auto & nodes = topology().m_nodes;
+
+		switch( affinity.policy() )
+			{
+			case thread_affinity_policy_t::none :
+			break;
+
+			case thread_affinity_policy_t::cpu_set :
+				{
+					ensure_valid_thread_affinity( affinity );
+
+					const auto & cpus = affinity.cpus();
+					return { cpus[ thread_index % cpus.size() ] };
+				}
+
+			case thread_affinity_policy_t::compact :
+				{
+					std::size_t total = 0u;
+					for( const auto & n : nodes )
+						total += n.m_cpus.size();
+
+					std::size_t index = thread_index % total;
+					for( const auto & n : nodes )
+						{
+							if( index < n.m_cpus.size() )
+								return { n.m_cpus[ index ] };
+							index -= n.m_cpus.size();
+						}
+				}
+			break;
+
+			case thread_affinity_policy_t::scatter :
+				{
+					const auto & n = nodes[ thread_index % nodes.size() ];
+					return { n.m_cpus[ (thread_index / nodes.size()) %
+							n.m_cpus.size() ] };
+				}
+
+			case thread_affinity_policy_t::numa_node :
+				{
+					const auto it = std::find_if( nodes.begin(), nodes.end(),
+							[&affinity]( const topology_t::node_t & n ) {
+								return n.m_index == affinity.node();
+							} );
+					if( it == nodes.end() )
+						SO_5_THROW_EXCEPTION( rc_invalid_thread_affinity,
+								"there is no available CPUs on NUMA node " +
+								std::to_string( affinity.node() ) );
+
+					return it->m_cpus;
+				}
+			}
+
+		return {};
+	}
+
+SO_5_FUNC void
+bind_current_thread( const cpu_list_t & cpus ) noexcept
+	{
+		if( cpus.empty() )
+			return;
+
+#if defined(__linux__)
+		::cpu_set_t set;
+		CPU_ZERO( &set );
+		for( const auto cpu : cpus )
+			if( cpu <= max_bindable_cpu )
+				CPU_SET( cpu, &set );
+
+		::pthread_setaffinity_np( ::pthread_self(), sizeof(set), &set );
+#elif defined(_WIN32)
+		DWORD_PTR mask = 0;
+		for( const auto cpu : cpus )
+			if( cpu <= max_bindable_cpu )
+				mask |= DWORD_PTR{ 1u } << cpu;
+
+		if( mask )
+			::SetThreadAffinityMask( ::GetCurrentThread(), mask );
+#endif
+	}
+
+SO_5_FUNC int
+current_cpu() noexcept
+	{
+#if defined(__linux__)
+		return ::sched_getcpu();
+#elif defined(_WIN32)
+		return static_cast< int >( ::GetCurrentProcessorNumber() );
+#else
+		return -1;
+#endif
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,292 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief CPU affinity policies for work threads of dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace so_5 {
+
+namespace disp {
+
+//
+// thread_affinity_policy_t
+//
+/*!
+ * \brief Type of CPU affinity policy for work threads of a dispatcher.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class thread_affinity_policy_t
+	{
+		//! Work threads are not bound to any CPU.
+		/*!
+		 * It is the default mode.
+		 */
+		none,
+		//! Work threads are bound to CPUs from an explicit list.
+		/*!
+		 * The i-th work thread is bound to the CPU with index
+		 * `i % cpus.size()` in the list.
+		 */
+		cpu_set,
+		//! Work threads are bound to CPUs one after another.
+		/*!
+		 * All CPUs of the first NUMA node are used at first, then CPUs
+		 * of the second node and so on. It keeps threads of a dispatcher
+		 * as close to each other as possible.
+		 */
+		compact,
+		//! Work threads are spread over NUMA nodes.
+		/*!
+		 * The i-th work thread is bound to a CPU from the NUMA node with
+		 * index `i % nodes_count`.
+		 */
+		scatter,
+		//! Work threads can run on any CPU of the specified NUMA node.
+		numa_node
+	};
+
+//
+// thread_affinity_t
+//
+/*!
+ * \brief Description of CPU affinity for work threads of a dispatcher.
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp::thread_pool;
+ * auto disp = make_dispatcher( env, "workers",
+ * 	disp_params_t{}
+ * 		.thread_count( 8 )
+ * 		.thread_affinity( so_5::disp::thread_affinity_t::numa_node( 1 ) ) );
+ * \endcode
+ *
+ * \note On Linux the thread is bound to CPUs before the start of
+ * its main loop. Because of the "first touch" policy of the OS, the
+ * memory allocated by the work thread itself (its stack and
+ * items of demand queues reused by the work thread) is placed to
+ * the NUMA node of the thread.
+ *
+ * \note CPU affinity is not supported on all platforms. If it is not
+ * supported then work threads are not bound to CPUs.
+ *
+ * \since
+ * v.5.6.2
+ */
+class thread_affinity_t
+	{
+	public :
+		//! Default constructor creates the description for `none` policy.
+		thread_affinity_t() = default;
+
+		//! Work threads are not bound to any CPU.
+		static thread_affinity_t
+		none()
+			{
+				return {};
+			}
+
+		//! Work threads are bound to CPUs from the list.
+		/*!
+		 * \note The list must not be empty.
+		 */
+		static thread_affinity_t
+		cpu_set( std::vector< unsigned int > cpus )
+			{
+				return { thread_affinity_policy_t::cpu_set, std::move(cpus), 0u };
+			}
+
+		//! Work threads are bound to CPUs one after another.
+		static thread_affinity_t
+		compact()
+			{
+				return { thread_affinity_policy_t::compact, {}, 0u };
+			}
+
+		//! Work threads are spread over NUMA nodes.
+		static thread_affinity_t
+		scatter()
+			{
+				return { thread_affinity_policy_t::scatter, {}, 0u };
+			}
+
+		//! Work threads can run on any CPU of NUMA node \a node.
+		static thread_affinity_t
+		numa_node( unsigned int node )
+			{
+				return { thread_affinity_policy_t::numa_node, {}, node };
+			}
+
+		//! Type of the policy.
+		thread_affinity_policy_t
+		policy() const noexcept
+			{
+				return m_policy;
+			}
+
+		//! List of CPUs for `cpu_set` policy.
+		const std::vector< unsigned int > &
+		cpus() const noexcept
+			{
+				return m_cpus;
+			}
+
+		//! Index of NUMA node for `numa_node` policy.
+		unsigned int
+		node() const noexcept
+			{
+				return m_node;
+			}
+
+		friend inline void
+		swap( thread_affinity_t & a, thread_affinity_t & b ) noexcept
+			{
+				using std::swap;
+				swap( a.m_policy, b.m_policy );
+				swap( a.m_cpus, b.m_cpus );
+				swap( a.m_node, b.m_node );
+			}
+
+	private :
+		thread_affinity_t(
+			thread_affinity_policy_t policy,
+			std::vector< unsigned int > cpus,
+			unsigned int node )
+			:	m_policy{ policy }
+			,	m_cpus{ std::move(cpus) }
+			,	m_node{ node }
+			{}
+
+		thread_affinity_policy_t m_policy{ thread_affinity_policy_t::none };
+		std::vector< unsigned int > m_cpus;
+		unsigned int m_node{ 0u };
+	};
+
+namespace reuse {
+
+/*!
+ * \brief Type of list of CPUs on which a work thread is allowed to run.
+ *
+ * An empty list means that the work thread is not bound to any CPU.
+ *
+ * \since
+ * v.5.6.2
+ */
+using cpu_list_t = std::vector< unsigned int >;
+
+/*!
+ * \brief Check that explicitly specified CPUs can be used.
+ *
+ * Every CPU from the `cpu_set` policy must be available for
+ * the process and must be suitable for binding a thread
+ * (less than `CPU_SETSIZE` on Linux, for example).
+ *
+ * Dispatchers call this function at the creation. So an invalid
+ * affinity is detected before the start of any work thread.
+ *
+ * \throw so_5::exception_t with rc_invalid_thread_affinity error
+ * code if \a affinity is invalid.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC void
+ensure_valid_thread_affinity( const thread_affinity_t & affinity );
+
+/*!
+ * \brief Calculate the list of CPUs for a work thread.
+ *
+ * \throw so_5::exception_t with rc_invalid_thread_affinity error
+ * code if \a affinity can't be applied (an empty CPU list or
+ * an unknown NUMA node, for example).
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC cpu_list_t
+cpus_for_work_thread(
+	//! Affinity for the dispatcher.
+	const thread_affinity_t & affinity,
+	//! Index of work thread inside the dispatcher.
+	std::size_t thread_index );
+
+/*!
+ * \brief Bind the current thread to CPUs from the list.
+ *
+ * Does nothing if the list is empty or if CPU affinity is not supported
+ * on the platform. Errors are ignored.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC void
+bind_current_thread( const cpu_list_t & cpus ) noexcept;
+
+/*!
+ * \brief Number of CPU on which the current thread is running.
+ *
+ * \return -1 if it can't be detected on the platform.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC int
+current_cpu() noexcept;
+
+/*!
+ * \brief Mixin with CPU affinity for work threads.
+ *
+ * Indended to be used as mixin for various disp_params_t classes.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Params >
+class thread_affinity_mixin_t
+	{
+		thread_affinity_t m_affinity;
+
+	public :
+		//! Getter for CPU affinity.
+		const thread_affinity_t &
+		thread_affinity() const
+			{
+				return m_affinity;
+			}
+
+		friend inline void swap(
+				thread_affinity_mixin_t & a,
+				thread_affinity_mixin_t & b ) noexcept
+			{
+				swap( a.m_affinity, b.m_affinity );
+			}
+
+		//! Setter for CPU affinity.
+		Params &
+		thread_affinity( thread_affinity_t v )
+			{
+				m_affinity = std::move(v);
+				return static_cast< Params & >(*this);
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,102 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Selection of scheduling algorithm for thread-pool-like dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <utility>
+
+namespace so_5 {
+
+namespace disp {
+
+//
+// thread_pool_scheduling_t
+//
+/*!
+ * \brief Type of scheduling of agent queues in thread-pool-like dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class thread_pool_scheduling_t
+	{
+		//! All non-empty agent queues are stored in one common queue.
+		/*!
+		 * It is the default mode. The common queue is protected by
+		 * a lock from the queue parameters.
+		 */
+		central_queue,
+		//! Every working thread has its own queue of non-empty agent queues.
+		/*!
+		 * An agent queue activated from a working thread is stored in the
+		 * local queue of that thread. Idle threads steal agent queues from
+		 * the local queues of other threads.
+		 *
+		 * This mode reduces contention on the common lock when
+		 * there are many working threads.
+		 */
+		work_stealing
+	};
+
+namespace reuse {
+
+/*!
+ * \brief Mixin with type of scheduling of agent queues.
+ *
+ * Indended to be used as mixin for disp_params_t classes of
+ * thread-pool-like dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Params >
+class thread_pool_scheduling_mixin_t
+	{
+		thread_pool_scheduling_t m_scheduling{
+				thread_pool_scheduling_t::central_queue };
+
+	public :
+		//! Getter for type of scheduling.
+		thread_pool_scheduling_t
+		scheduling() const
+			{
+				return m_scheduling;
+			}
+
+		friend inline void swap(
+				thread_pool_scheduling_mixin_t & a,
+				thread_pool_scheduling_mixin_t & b )
+			{
+				std::swap( a.m_scheduling, b.m_scheduling );
+			}
+
+		//! Setter for type of scheduling.
+		Params &
+		scheduling( thread_pool_scheduling_t v )
+			{
+				m_scheduling = v;
+				return static_cast< Params & >(*this);
+			}
+
+		//! Helper for turning work-stealing scheduling on.
+		Params &
+		use_work_stealing()
+			{
+				return scheduling( thread_pool_scheduling_t::work_stealing );
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -21,6 +21,7 @@
 #include <so_5/stats/std_names.hpp>
 
 #include <so_5/disp/reuse/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/lock_stats_helpers.hpp>
 
 namespace so_5 {
 
@@ -182,6 +183,19 @@ class stats_consumer_t
 			const so_5::current_thread_id_t & thread_id,
 			//! Statistics of working thread.
 			const so_5::stats::work_thread_activity_stats_t & stats ) = 0;
+
+		/*!
+		 * \brief Informs consumer about stats of the lock of
+		 * dispatcher's queue.
+		 *
+		 * \note This method is called only if the lock collects
+		 * such stats.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		set_lock_stats( const so_5::stats::lock_stats_t & stats ) = 0;
 	};
 
 /*!
@@ -258,6 +272,8 @@ class data_source_t : public stats::source_t
 						stats::suffixes::agent_count(),
 						collector.agent_count() );
 
+				send_lock_stats( mbox, m_prefix, collector );
+
 				collector.for_each_thread_activity(
 					[this, &mbox]( const so_5::current_thread_id_t & thread_id,
 						const so_5::stats::work_thread_activity_stats_t & stats ) {
@@ -405,6 +421,21 @@ class data_source_t : public stats::source_t
 						m_wt_activity.emplace_back( thread_id, stats );
 					}
 
+				virtual void
+				set_lock_stats( const so_5::stats::lock_stats_t & stats ) override
+					{
+						m_lock_stats = stats;
+						m_has_lock_stats = true;
+					}
+
+				bool
+				query_lock_stats( so_5::stats::lock_stats_t & to ) const
+					{
+						if( m_has_lock_stats )
+							to = m_lock_stats;
+						return m_has_lock_stats;
+					}
+
 				std::size_t
 				thread_count() const
 					{
@@ -444,6 +475,9 @@ class data_source_t : public stats::source_t
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
 
+				bool m_has_lock_stats = { false };
+				so_5::stats::lock_stats_t m_lock_stats;
+
 				wt_activity_info_container_t & m_wt_activity;
 
 				intrusive_ptr_t< queue_description_holder_t > m_queue_desc_head;
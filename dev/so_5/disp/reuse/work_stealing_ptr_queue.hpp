@@ -0,0 +1,755 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Work-stealing queue of pointers for thread-pool-like dispatchers.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/pub.hpp>
+
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+namespace work_stealing_details
+{
+
+//
+// chase_lev_deque_t
+//
+/*!
+ * \brief Chase-Lev work-stealing deque of pointers.
+ *
+ * The owner of the deque pushes and takes items at the bottom.
+ * Other threads steal items from the top.
+ *
+ * It is an implementation from "Correct and Efficient Work-Stealing
+ * for Weak Memory Models" by N.M. Le, A. Pop, A. Cohen and
+ * F. Zappa Nardelli.
+ *
+ * Buffers replaced by bigger ones are not deallocated until the
+ * destruction of the deque because thieves can still read them.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< class T >
+class chase_lev_deque_t
+	{
+		//! Ring buffer with items.
+		struct buffer_t
+			{
+				//! Capacity minus one. Capacity is always a power of two.
+				const std::int64_t m_mask;
+				std::unique_ptr< std::atomic< T * >[] > m_items;
+
+				buffer_t( std::int64_t capacity )
+					:	m_mask{ capacity - 1 }
+					,	m_items{ new std::atomic< T * >[
+							static_cast< std::size_t >( capacity ) ] }
+					{}
+
+				std::int64_t
+				capacity() const noexcept { return m_mask + 1; }
+
+				T *
+				get( std::int64_t index ) const noexcept
+					{
+						return m_items[ static_cast< std::size_t >( index & m_mask ) ]
+								.load( std::memory_order_relaxed );
+					}
+
+				void
+				put( std::int64_t index, T * item ) noexcept
+					{
+						m_items[ static_cast< std::size_t >( index & m_mask ) ]
+								.store( item, std::memory_order_relaxed );
+					}
+			};
+
+	public :
+		chase_lev_deque_t( const chase_lev_deque_t & ) = delete;
+		chase_lev_deque_t & operator=( const chase_lev_deque_t & ) = delete;
+
+		chase_lev_deque_t()
+			{
+				m_buffers.emplace_back( new buffer_t( initial_capacity ) );
+				m_buffer.store( m_buffers.back().get(), std::memory_order_relaxed );
+			}
+
+		//! Add an item to the bottom of the deque.
+		/*!
+		 * \attention Must be called only by the owner of the deque.
+		 */
+		void
+		push( T * item )
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed );
+				const auto t = m_top.load( std::memory_order_acquire );
+				auto * buffer = m_buffer.load( std::memory_order_relaxed );
+				if( b - t >= buffer->capacity() )
+					buffer = grow( *buffer, t, b );
+
+				buffer->put( b, item );
+				std::atomic_thread_fence( std::memory_order_release );
+				m_bottom.store( b + 1, std::memory_order_relaxed );
+			}
+
+		//! Can an item be added without reallocation of the buffer?
+		/*!
+		 * \attention Must be called only by the owner of the deque.
+		 */
+		bool
+		has_free_space() const noexcept
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed );
+				const auto t = m_top.load( std::memory_order_acquire );
+				return b - t < m_buffer.load( std::memory_order_relaxed )->capacity();
+			}
+
+		//! Take the item from the bottom of the deque.
+		/*!
+		 * \attention Must be called only by the owner of the deque.
+		 *
+		 * \return nullptr if the deque is empty.
+		 */
+		T *
+		take() noexcept
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed ) - 1;
+				auto * buffer = m_buffer.load( std::memory_order_relaxed );
+				m_bottom.store( b, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				auto t = m_top.load( std::memory_order_relaxed );
+
+				T * result = nullptr;
+				if( t <= b )
+					{
+						result = buffer->get( b );
+						if( t == b )
+							{
+								// It is the last item. There could be a race
+								// with a thief.
+								if( !m_top.compare_exchange_strong(
+										t, t + 1,
+										std::memory_order_seq_cst,
+										std::memory_order_relaxed ) )
+									result = nullptr;
+								m_bottom.store( b + 1, std::memory_order_relaxed );
+							}
+					}
+				else
+					m_bottom.store( b + 1, std::memory_order_relaxed );
+
+				return result;
+			}
+
+		//! Take the item from the top of the deque.
+		/*!
+		 * Can be called by any thread.
+		 *
+		 * \return nullptr if the deque is empty or if there was a race
+		 * with another thread.
+		 */
+		T *
+		steal() noexcept
+			{
+				auto t = m_top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_acquire );
+
+				if( t < b )
+					{
+						auto * buffer = m_buffer.load( std::memory_order_acquire );
+						T * result = buffer->get( t );
+						if( m_top.compare_exchange_strong(
+								t, t + 1,
+								std::memory_order_seq_cst,
+								std::memory_order_relaxed ) )
+							return result;
+					}
+
+				return nullptr;
+			}
+
+		//! Approximate count of items in the deque.
+		std::size_t
+		size() const noexcept
+			{
+				const auto b = m_bottom.load( std::memory_order_acquire );
+				const auto t = m_top.load( std::memory_order_acquire );
+				return b > t ? static_cast< std::size_t >( b - t ) : 0u;
+			}
+
+	private :
+		static constexpr std::int64_t initial_capacity = 256;
+
+		alignas( 64 ) std::atomic< std::int64_t > m_top{ 0 };
+		alignas( 64 ) std::atomic< std::int64_t > m_bottom{ 0 };
+		std::atomic< buffer_t * > m_buffer{ nullptr };
+
+		//! All allocated buffers. The last one is the current one.
+		std::vector< std::unique_ptr< buffer_t > > m_buffers;
+
+		buffer_t *
+		grow( const buffer_t & old, std::int64_t t, std::int64_t b )
+			{
+				m_buffers.reserve( m_buffers.size() + 1u );
+
+				std::unique_ptr< buffer_t > buffer{
+						new buffer_t( old.capacity() * 2 ) };
+				for( auto i = t; i != b; ++i )
+					buffer->put( i, old.get( i ) );
+
+				auto * result = buffer.get();
+				m_buffers.push_back( std::move( buffer ) );
+				m_buffer.store( result, std::memory_order_release );
+
+				return result;
+			}
+	};
+
+} /* namespace work_stealing_details */
+
+//
+// work_stealing_ptr_queue_t
+//
+/*!
+ * \brief Work-stealing queue of pointers.
+ *
+ * A replacement for mpmc_ptr_queue_t with the same interface.
+ *
+ * Every working thread has its own Chase-Lev deque. An item scheduled
+ * by a working thread is stored in the deque of that thread and will
+ * be processed by the same thread if nobody steals it. It preserves
+ * locality: an agent's queue activated by a message from an agent
+ * running on that thread will be handled while message data is in the
+ * thread's cache. Items scheduled by other threads go to the common
+ * injection queue protected by a lock.
+ *
+ * A working thread without local work checks the injection queue and
+ * then tries to steal from deques of other threads (victims are
+ * selected randomly). Only a half of working threads can search for work
+ * at the same time. If the search fails the thread sleeps on its
+ * condition object.
+ *
+ * A sleeping thread is woken up only if there is no searching thread.
+ * Threshold from queue parameters is used for items scheduled by
+ * working threads: a sleeping thread is woken up only if the size of
+ * the local deque exceeds that threshold.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< class T >
+class work_stealing_ptr_queue_t
+	{
+		//! Data for one working thread.
+		struct worker_t
+			{
+				//! The queue to which this worker belongs.
+				const work_stealing_ptr_queue_t * const m_owner;
+
+				//! Waiting object of the working thread.
+				so_5::disp::mpmc_queue_traits::condition_t * const m_condition;
+
+				//! Local items of the working thread.
+				work_stealing_details::chase_lev_deque_t< T > m_deque;
+
+				//! Is this worker searching for work now?
+				/*!
+				 * Modified by the owner thread or by a thread which
+				 * wakes up the worker.
+				 */
+				bool m_searching{ false };
+
+				//! Counter of attempts to find local work.
+				unsigned int m_ticks{ 0u };
+
+				//! State of random generator for selection of victims.
+				std::uint32_t m_random;
+
+				worker_t(
+					const work_stealing_ptr_queue_t * owner,
+					so_5::disp::mpmc_queue_traits::condition_t * condition,
+					std::uint32_t seed )
+					:	m_owner{ owner }
+					,	m_condition{ condition }
+					,	m_random{ seed }
+					{}
+
+				std::uint32_t
+				next_random() noexcept
+					{
+						// xorshift32.
+						m_random ^= m_random << 13;
+						m_random ^= m_random >> 17;
+						m_random ^= m_random << 5;
+						return m_random;
+					}
+			};
+
+	public :
+		work_stealing_ptr_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_max_thread_count{ thread_count }
+			,	m_next_thread_wakeup_threshold{
+					queue_params.next_thread_wakeup_threshold() }
+			{
+				m_workers.reserve( thread_count );
+				m_sleepers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		inline void
+		shutdown()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_sleepers.empty() )
+					pop_and_notify_one_sleeper();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \attention Must be called only by a working thread with the
+		 * condition object allocated by allocate_condition().
+		 *
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				auto & w = worker_for( condition );
+
+				while( !m_shutdown.load( std::memory_order_acquire ) )
+					{
+						if( auto * r = find_local_work( w ) )
+							return work_found( w, r );
+
+						if( !w.m_searching )
+							try_start_searching( w );
+
+						if( w.m_searching )
+							for( unsigned int i = 0u; i != steal_rounds; ++i )
+								{
+									if( auto * r = try_steal( w ) )
+										return work_found( w, r );
+
+									std::this_thread::yield();
+								}
+
+						park( w );
+					}
+
+				return nullptr;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * \attention Must be called only by a working thread.
+		 *
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		try_switch_to_another( T * current ) noexcept
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				auto * w = current_worker();
+				// The current queue can't be stored without a memory
+				// allocation. Continue to work with it.
+				if( !w || !w->m_deque.has_free_space() )
+					return current;
+
+				T * r = w->m_deque.take();
+				if( !r )
+					r = pop_injected();
+
+				if( r )
+					{
+						// Old non-empty queue must be stored for further processing.
+						// It can be stolen by another thread.
+						w->m_deque.push( current );
+						return r;
+					}
+
+				return current;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue )
+			{
+				if( auto * w = current_worker() )
+					{
+						w->m_deque.push( queue );
+
+						if( w->m_deque.size() > m_next_thread_wakeup_threshold )
+							wakeup_someone_if_necessary();
+					}
+				else
+					{
+						{
+							std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+									lock{ *m_lock };
+
+							m_injected.push_back( queue );
+							m_injected_size.store(
+									m_injected.size(), std::memory_order_release );
+						}
+
+						wakeup_someone_if_necessary();
+					}
+			}
+
+		//! Allocate a condition object for a new working thread.
+		/*!
+		 * Creates a worker's data for that thread.
+		 *
+		 * \attention Must be called before the start of working threads.
+		 */
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				auto condition = m_lock->allocate_condition();
+
+				m_workers.emplace_back( std::make_unique< worker_t >(
+						this,
+						condition.get(),
+						// Seed for xorshift must not be zero.
+						static_cast< std::uint32_t >( m_workers.size() ) * 2654435761u
+								+ 1u ) );
+
+				return condition;
+			}
+
+		//! Elastic mode is not supported for work-stealing scheduling.
+		/*!
+		 * \throw so_5::exception_t with rc_disp_create_failed.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		template< typename Listener >
+		void
+		set_elasticity( std::size_t, std::size_t, Listener & )
+			{
+				SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+						"elastic mode isn't supported for work-stealing "
+						"scheduling" );
+			}
+
+		//! Elastic mode is not supported for work-stealing scheduling.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		growth_completed( bool ) noexcept {}
+
+		//! Elastic mode is not supported for work-stealing scheduling.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		so_5::disp::mpmc_queue_traits::condition_t *
+		try_retire_idle_thread(
+			std::size_t,
+			std::chrono::steady_clock::duration ) noexcept
+			{
+				return nullptr;
+			}
+
+		/*!
+		 * \brief Get stats of waiting on the queue lock.
+		 *
+		 * \return false if the lock doesn't collect such stats.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+			{
+				return m_lock->query_stats( to );
+			}
+
+	private :
+		//! Count of attempts to steal before sleeping.
+		static constexpr unsigned int steal_rounds = 4u;
+
+		//! How often the injection queue is checked before the local deque.
+		/*!
+		 * The top of the local deque is used at the same time. It prevents
+		 * starvation of old items when the owner of the deque takes
+		 * new items from the bottom.
+		 */
+		static constexpr unsigned int fairness_interval = 61u;
+
+		//! Worker for the current thread.
+		/*!
+		 * It is nullptr for threads which aren't working threads of
+		 * any queue of that type.
+		 */
+		static inline thread_local worker_t * tls_current_worker = nullptr;
+
+		//! Object's lock.
+		/*!
+		 * Protects the injection queue and the list of sleeping workers.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Maximum count of working threads.
+		const std::size_t m_max_thread_count;
+
+		//! Threshold for wake up next working thread.
+		const std::size_t m_next_thread_wakeup_threshold;
+
+		//! Data of all working threads.
+		/*!
+		 * Isn't changed after the start of working threads.
+		 */
+		std::vector< std::unique_ptr< worker_t > > m_workers;
+
+		//! Items scheduled by threads which aren't working threads.
+		std::deque< T * > m_injected;
+
+		//! Size of m_injected for checks without acquiring the lock.
+		std::atomic< std::size_t > m_injected_size{ 0u };
+
+		//! Sleeping workers.
+		std::vector< worker_t * > m_sleepers;
+
+		//! Count of sleeping workers.
+		std::atomic< std::size_t > m_sleeping{ 0u };
+
+		//! Count of workers searching for work.
+		std::atomic< std::size_t > m_searching{ 0u };
+
+		worker_t *
+		current_worker() const noexcept
+			{
+				auto * w = tls_current_worker;
+				return ( w && this == w->m_owner ) ? w : nullptr;
+			}
+
+		worker_t &
+		worker_for( so_5::disp::mpmc_queue_traits::condition_t & condition ) noexcept
+			{
+				if( auto * w = current_worker() )
+					return *w;
+
+				for( auto & w : m_workers )
+					if( &condition == w->m_condition )
+						{
+							tls_current_worker = w.get();
+							break;
+						}
+
+				return *tls_current_worker;
+			}
+
+		T *
+		pop_injected() noexcept
+			{
+				if( !m_injected_size.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( m_injected.empty() )
+					return nullptr;
+
+				auto * r = m_injected.front();
+				m_injected.pop_front();
+				m_injected_size.store( m_injected.size(), std::memory_order_release );
+
+				return r;
+			}
+
+		T *
+		find_local_work( worker_t & w ) noexcept
+			{
+				if( 0u == ( ++w.m_ticks % fairness_interval ) )
+					{
+						if( auto * r = pop_injected() )
+							return r;
+						if( auto * r = w.m_deque.steal() )
+							return r;
+					}
+
+				if( auto * r = w.m_deque.take() )
+					return r;
+
+				return pop_injected();
+			}
+
+		T *
+		try_steal( worker_t & w ) noexcept
+			{
+				const auto count = m_workers.size();
+				const auto start = w.next_random() % count;
+				for( std::size_t i = 0u; i != count; ++i )
+					{
+						auto & victim = *m_workers[ ( start + i ) % count ];
+						if( &victim != &w )
+							if( auto * r = victim.m_deque.steal() )
+								return r;
+					}
+
+				return pop_injected();
+			}
+
+		//! Is there any work which can be seen by a worker?
+		bool
+		has_visible_work() const noexcept
+			{
+				if( m_injected_size.load( std::memory_order_acquire ) )
+					return true;
+
+				for( const auto & w : m_workers )
+					if( w->m_deque.size() )
+						return true;
+
+				return false;
+			}
+
+		void
+		try_start_searching( worker_t & w ) noexcept
+			{
+				// No more than a half of workers can search at the same time.
+				if( 2u * m_searching.load( std::memory_order_relaxed ) <
+						m_max_thread_count )
+					{
+						m_searching.fetch_add( 1u, std::memory_order_seq_cst );
+						w.m_searching = true;
+					}
+			}
+
+		T *
+		work_found( worker_t & w, T * item ) noexcept
+			{
+				if( w.m_searching )
+					{
+						w.m_searching = false;
+
+						// The last searching worker should wake up another one
+						// if there is some work for it.
+						if( 1u == m_searching.fetch_sub( 1u, std::memory_order_seq_cst ) &&
+								has_visible_work() )
+							wakeup_someone_if_necessary();
+					}
+
+				return item;
+			}
+
+		void
+		park( worker_t & w ) noexcept
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( w.m_searching )
+					{
+						w.m_searching = false;
+						m_searching.fetch_sub( 1u, std::memory_order_seq_cst );
+					}
+
+				m_sleepers.push_back( &w );
+				m_sleeping.fetch_add( 1u, std::memory_order_seq_cst );
+
+				// Some work could be scheduled while this worker wasn't
+				// searching. A wakeup can be skipped in that case.
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_shutdown.load( std::memory_order_acquire ) ||
+						has_visible_work() )
+					{
+						m_sleepers.pop_back();
+						m_sleeping.fetch_sub( 1u, std::memory_order_relaxed );
+
+						m_searching.fetch_add( 1u, std::memory_order_seq_cst );
+						w.m_searching = true;
+						return;
+					}
+
+				// The worker will be marked as searching by
+				// pop_and_notify_one_sleeper().
+				w.m_condition->wait();
+			}
+
+		void
+		wakeup_someone_if_necessary() noexcept
+			{
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				if( m_searching.load( std::memory_order_relaxed ) ||
+						!m_sleeping.load( std::memory_order_relaxed ) )
+					return;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( !m_sleepers.empty() &&
+						!m_searching.load( std::memory_order_relaxed ) )
+					pop_and_notify_one_sleeper();
+			}
+
+		//! Wake up the last sleeping worker.
+		/*!
+		 * \attention Must be called with m_lock acquired.
+		 */
+		void
+		pop_and_notify_one_sleeper() noexcept
+			{
+				auto & w = *m_sleepers.back();
+				m_sleepers.pop_back();
+				m_sleeping.fetch_sub( 1u, std::memory_order_relaxed );
+
+				// The woken worker starts as a searching one. It prevents
+				// waking up of other workers until that worker finds work.
+				m_searching.fetch_add( 1u, std::memory_order_seq_cst );
+				w.m_searching = true;
+
+				w.m_condition->notify();
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
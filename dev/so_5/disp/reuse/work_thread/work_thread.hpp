@@ -23,12 +23,17 @@
 #include <so_5/event_queue.hpp>
 
 #include <so_5/disp/mpsc_queue_traits/pub.hpp>
+#include <so_5/disp/reuse/intrusive_free_list.hpp>
+#include <so_5/disp/reuse/local_timer_queue.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
 
 #include <so_5/stats/work_thread_activity.hpp>
 #include <so_5/stats/impl/activity_tracking.hpp>
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 namespace so_5
 {
 
@@ -69,6 +74,242 @@ enum class extraction_result_t
 namespace demand_queue_details
 {
 
+/*!
+ * \brief Intrusive lock-free MPSC queue of demands.
+ *
+ * It is an implementation of the MPSC queue by Dmitry Vyukov.
+ * A producer makes just one atomic exchange for storing a new demand.
+ * The consumer doesn't use atomic read-modify-write operations at all.
+ *
+ * There is always a node in the queue: the last extracted node
+ * (or the initial stub). Demands are stored in the subsequent nodes.
+ *
+ * Extracted nodes are kept in a small free-list of the consumer.
+ * They are reused for demands pushed from the consumer's thread
+ * (for example, when an agent sends a message to itself or to another
+ * agent on the same work thread). Such demands don't require an
+ * allocation.
+ *
+ * \since
+ * v.5.6.2
+ */
+class lock_free_demand_queue_t
+{
+	struct node_t
+	{
+		//! Next node in the queue or in the free-list.
+		std::atomic< node_t * > m_next{ nullptr };
+		execution_demand_t m_demand;
+
+		node_t() = default;
+
+		node_t( execution_demand_t && demand )
+			:	m_demand( std::move(demand) )
+		{}
+	};
+
+	//! ID of the consumer's thread.
+	/*!
+	 * Set by the consumer only. Producers compare it with
+	 * the ID of their thread.
+	 */
+	alignas(64) std::atomic< so_5::current_thread_id_t > m_consumer_id{};
+
+	//! The last pushed node.
+	/*!
+	 * Modified by producers only.
+	 */
+	alignas(64) std::atomic< node_t * > m_head;
+
+	//! The last extracted node.
+	/*!
+	 * Used by the consumer only.
+	 */
+	alignas(64) node_t * m_tail;
+
+	//! Free-list of nodes.
+	/*!
+	 * Used by the consumer only.
+	 */
+	intrusive_free_list_t< node_t > m_free_nodes;
+
+	//! Create a node for a new demand.
+	/*!
+	 * A node from the free-list is used if it is called from
+	 * the consumer's thread.
+	 */
+	node_t *
+	make_node( execution_demand_t && demand )
+	{
+		if( so_5::query_current_thread_id() ==
+				m_consumer_id.load( std::memory_order_relaxed ) )
+		{
+			if( node_t * n = m_free_nodes.try_take() )
+			{
+				n->m_demand = std::move(demand);
+				return n;
+			}
+		}
+
+		return new node_t{ std::move(demand) };
+	}
+
+	//! Release a node which is not used anymore.
+	/*!
+	 * Can be called by the consumer only.
+	 */
+	void
+	release_node( node_t * n ) noexcept
+	{
+		if( !m_free_nodes.try_put( n ) )
+			delete n;
+	}
+
+	//! Link a chain of new nodes to the end of the queue.
+	void
+	link( node_t * first, node_t * last ) noexcept
+	{
+		node_t * prev = m_head.exchange( last, std::memory_order_seq_cst );
+		prev->m_next.store( first, std::memory_order_release );
+	}
+
+public :
+	lock_free_demand_queue_t()
+		:	m_head( new node_t{} )
+		,	m_tail( m_head.load( std::memory_order_relaxed ) )
+	{}
+
+	lock_free_demand_queue_t( const lock_free_demand_queue_t & ) = delete;
+	lock_free_demand_queue_t &
+	operator=( const lock_free_demand_queue_t & ) = delete;
+
+	~lock_free_demand_queue_t()
+	{
+		clear();
+		delete m_tail;
+	}
+
+	//! Remember the current thread as the consumer's thread.
+	/*!
+	 * Must be called by the consumer before extraction of demands.
+	 */
+	void
+	attach_consumer() noexcept
+	{
+		const auto id = so_5::query_current_thread_id();
+		if( id != m_consumer_id.load( std::memory_order_relaxed ) )
+			m_consumer_id.store( id, std::memory_order_relaxed );
+	}
+
+	//! Store a new demand.
+	/*!
+	 * Can be called by several producers at the same time.
+	 */
+	void
+	push( execution_demand_t && demand )
+	{
+		node_t * n = make_node( std::move(demand) );
+		link( n, n );
+	}
+
+	//! Store a batch of demands.
+	/*!
+	 * Can be called by several producers at the same time.
+	 *
+	 * All demands are linked to the queue by one atomic operation.
+	 * The batch is stored entirely or not stored at all.
+	 */
+	void
+	push_batch( execution_demand_t * demands, std::size_t count )
+	{
+		if( !count )
+			return;
+
+		node_t * first = nullptr;
+		node_t * last = nullptr;
+
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				for( std::size_t i = 0u; i != count; ++i )
+				{
+					node_t * n = make_node( std::move( demands[ i ] ) );
+					if( last )
+						last->m_next.store( n, std::memory_order_relaxed );
+					else
+						first = n;
+					last = n;
+				}
+			},
+			[&] {
+				while( first )
+				{
+					node_t * n = first;
+					first = n->m_next.load( std::memory_order_relaxed );
+					delete n;
+				}
+			} );
+
+		link( first, last );
+	}
+
+	//! Is the queue empty?
+	/*!
+	 * Can be called by the consumer only.
+	 *
+	 * \note The queue can be non-empty while try_extract() returns 0.
+	 * It means that a producer is in the middle of push operation.
+	 */
+	bool
+	empty() const noexcept
+	{
+		return m_head.load( std::memory_order_seq_cst ) == m_tail;
+	}
+
+	//! Move all available demands to \a to.
+	/*!
+	 * Can be called by the consumer only.
+	 *
+	 * \return count of extracted demands.
+	 */
+	std::size_t
+	try_extract( demand_container_t & to )
+	{
+		std::size_t extracted = 0u;
+
+		node_t * next = m_tail->m_next.load( std::memory_order_acquire );
+		while( next )
+		{
+			to.push_back( std::move( next->m_demand ) );
+
+			release_node( m_tail );
+			m_tail = next;
+			++extracted;
+
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+
+		return extracted;
+	}
+
+	//! Destroy all demands from the queue.
+	/*!
+	 * Can be called only when there is no producers.
+	 */
+	void
+	clear() noexcept
+	{
+		node_t * next = m_tail->m_next.load( std::memory_order_acquire );
+		while( next )
+		{
+			delete m_tail;
+			m_tail = next;
+			m_tail->m_demand = execution_demand_t{};
+
+			next = next->m_next.load( std::memory_order_acquire );
+		}
+	}
+};
+
 /*!
  * \brief Common data for all implementations of demand_queue.
  *
@@ -85,24 +326,73 @@ struct common_data_t
 	queue_traits::lock_unique_ptr_t m_lock;
 	//! \}
 
+	//! Should m_lock_free_demands be used instead of m_demands?
+	/*!
+	 * \since
+	 * v.5.6.2
+	 */
+	const bool m_lock_free;
+
+	//! Demand queue for the case when lock is not used for demands.
+	/*!
+	 * \since
+	 * v.5.6.2
+	 */
+	lock_free_demand_queue_t m_lock_free_demands;
+
+	//! Is the consumer going to sleep on m_lock?
+	/*!
+	 * Used only with m_lock_free_demands. Producers notify the consumer
+	 * only when this flag is set.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	std::atomic< bool > m_consumer_sleeping{ false };
+
 	//! Service flag.
 	/*!
 		true -- shall do the service, methods push/pop must work.
 		false -- the service is stopped or will be stopped.
+
+		\note Since v.5.6.2 it is atomic because it is checked
+		without the lock when m_lock_free_demands is used.
 	*/
-	bool m_in_service{ false };
+	std::atomic< bool > m_in_service{ false };
 
 	//! Initializing constructor.
 	common_data_t(
 		//! Lock object to be used by queue.
 		queue_traits::lock_unique_ptr_t lock )
 		:	m_lock( std::move(lock) )
+		,	m_lock_free( m_lock->lock_free_queue_allowed() )
 	{}
 
 	~common_data_t()
 	{
 		m_demands.clear();
 	}
+
+	//! Wake up the consumer if it is sleeping on m_lock.
+	/*!
+	 * Used only with m_lock_free_demands.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	void
+	wakeup_sleeping_consumer()
+	{
+		if( m_consumer_sleeping.load( std::memory_order_seq_cst ) )
+		{
+			queue_traits::lock_guard_t guard{ *m_lock };
+			if( m_consumer_sleeping.load( std::memory_order_relaxed ) )
+			{
+				m_consumer_sleeping.store( false, std::memory_order_relaxed );
+				guard.notify_one();
+			}
+		}
+	}
 };
 
 /*!
@@ -195,6 +485,18 @@ public:
 	virtual void
 	push( execution_demand_t demand ) override
 	{
+		if( this->m_lock_free )
+		{
+			// A demand pushed after stop_service() is dropped here
+			// as it is done by the locked queue.
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return;
+
+			this->m_lock_free_demands.push( std::move(demand) );
+			this->wakeup_sleeping_consumer();
+			return;
+		}
+
 		queue_traits::lock_guard_t guard{ *(this->m_lock) };
 
 		if( this->m_in_service )
@@ -211,6 +513,53 @@ public:
 			}
 		}
 	}
+
+	/*!
+	 * The whole batch is stored under one acquisition of the lock.
+	 * The batch is stored entirely or not stored at all.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	virtual void
+	push_batch(
+		execution_demand_t * demands,
+		std::size_t count ) override
+	{
+		if( this->m_lock_free )
+		{
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return;
+
+			this->m_lock_free_demands.push_batch( demands, count );
+			this->wakeup_sleeping_consumer();
+			return;
+		}
+
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service )
+		{
+			const auto size_before = this->m_demands.size();
+
+			so_5::details::do_with_rollback_on_exception(
+				[&] {
+					for( std::size_t i = 0u; i != count; ++i )
+						this->m_demands.push_back( std::move( demands[ i ] ) );
+				},
+				[&] {
+					// Demands which were already stored must be removed.
+					this->m_demands.resize( size_before );
+				} );
+
+			if( !size_before )
+			{
+				// May be someone is waiting...
+				// It should be informed about new demands.
+				guard.notify_one();
+			}
+		}
+	}
 	/*!
 	 * \}
 	 */
@@ -220,20 +569,29 @@ public:
 		If there is no demands in queue then current thread
 		will sleep until:
 		- the new demand is put in the queue;
-		- a shutdown signal.
+		- a shutdown signal;
+		- the \a deadline is reached (since v.5.6.2).
 
 		\note Since v.5.5.7 this method also updates external demands
 		counter. This update is performed under queue's lock.
 		It should prevent errors when run-time monitor can get wrong
 		quantity of demands.
+
+		\retval extraction_result_t::no_demands if the deadline is reached.
 	*/
 	extraction_result_t
 	pop(
 		/*! Receiver for extracted demands. */
 		demand_container_t & demands,
 		/*! External demands counter to be updated. */
-		demands_counter_t & external_counter )
+		demands_counter_t & external_counter,
+		/*! Time point for the end of waiting. Waiting isn't limited
+		 * if it is nullptr. */
+		const std::chrono::steady_clock::time_point * deadline = nullptr )
 	{
+		if( this->m_lock_free )
+			return pop_lock_free( demands, external_counter, deadline );
+
 		queue_traits::unique_lock_t lock{ *(this->m_lock) };
 		while( true )
 		{
@@ -252,13 +610,8 @@ public:
 			{
 				// Queue is empty. We should wait for a demand or
 				// a shutdown signal.
-
-				// Since v.5.5.18 we must take care about activity tracking.
-				this->wait_started();
-
-				lock.wait_for_notify();
-
-				this->wait_finished();
+				if( !wait_for_notify( lock, deadline ) )
+					return extraction_result_t::no_demands;
 			}
 		}
 
@@ -283,7 +636,15 @@ public:
 		this->m_in_service = false;
 		// If the demands queue is empty then someone is waiting
 		// for new demands inside pop().
-		if( this->m_demands.empty() )
+		if( this->m_lock_free )
+		{
+			if( this->m_consumer_sleeping.load( std::memory_order_relaxed ) )
+			{
+				this->m_consumer_sleeping.store( false, std::memory_order_relaxed );
+				lock.notify_one();
+			}
+		}
+		else if( this->m_demands.empty() )
 			lock.notify_one();
 	}
 
@@ -294,6 +655,7 @@ public:
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		this->m_demands.clear();
+		this->m_lock_free_demands.clear();
 	}
 
 	/*!
@@ -309,11 +671,132 @@ public:
 	std::size_t
 	demands_count( const demands_counter_t & external_counter )
 	{
+		if( this->m_lock_free )
+			// The size of lock-free queue is not tracked because it
+			// requires an additional atomic operation for every demand.
+			// Only demands extracted by the work thread are counted.
+			return external_counter.load( std::memory_order_acquire );
+
 		queue_traits::lock_guard_t lock{ *(this->m_lock) };
 
 		return this->m_demands.size()
 				+ external_counter.load( std::memory_order_acquire );
 	}
+
+	/*!
+	 * \brief Get stats of waiting on the queue lock.
+	 *
+	 * \return false if the lock doesn't collect such stats.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	bool
+	query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+	{
+		return this->m_lock->query_stats( to );
+	}
+
+	/*!
+	 * \brief Can pop() wait for a deadline?
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	bool
+	timed_wait_supported() const noexcept
+	{
+		return this->m_lock->timed_wait_supported();
+	}
+
+private :
+	//! Wait for a notification or for the deadline.
+	/*!
+	 * Since v.5.5.18 we must take care about activity tracking.
+	 *
+	 * \retval false if the deadline is reached.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	bool
+	wait_for_notify(
+		queue_traits::unique_lock_t & lock,
+		const std::chrono::steady_clock::time_point * deadline )
+	{
+		bool notified = true;
+
+		this->wait_started();
+
+		if( deadline )
+			notified = lock.wait_for_notify_until( *deadline );
+		else
+			lock.wait_for_notify();
+
+		this->wait_finished();
+
+		return notified;
+	}
+
+	//! Implementation of pop() for lock-free demand queue.
+	/*!
+	 * The lock is acquired only if there are no demands and
+	 * the consumer should be parked.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	extraction_result_t
+	pop_lock_free(
+		demand_container_t & demands,
+		demands_counter_t & external_counter,
+		const std::chrono::steady_clock::time_point * deadline )
+	{
+		auto & queue = this->m_lock_free_demands;
+		queue.attach_consumer();
+
+		while( true )
+		{
+			// Demands aren't extracted after stop_service() as it is done
+			// by the locked queue. Remaining demands are destroyed by clear().
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return extraction_result_t::shutting_down;
+
+			if( queue.try_extract( demands ) )
+			{
+				external_counter.store( demands.size(), std::memory_order_release );
+				return extraction_result_t::demand_extracted;
+			}
+
+			if( !queue.empty() )
+			{
+				// A producer is in the middle of push operation.
+				std::this_thread::yield();
+				continue;
+			}
+
+			queue_traits::unique_lock_t lock{ *(this->m_lock) };
+			if( !this->m_in_service )
+				return extraction_result_t::shutting_down;
+
+			// Producers must see that flag before the final check of
+			// the queue. Otherwise a notification can be lost.
+			this->m_consumer_sleeping.store( true, std::memory_order_seq_cst );
+			if( !queue.empty() )
+			{
+				this->m_consumer_sleeping.store( false, std::memory_order_relaxed );
+				continue;
+			}
+
+			if( !wait_for_notify( lock, deadline ) )
+			{
+				// Nobody has reset that flag because there was
+				// no notification.
+				this->m_consumer_sleeping.store( false, std::memory_order_relaxed );
+				return extraction_result_t::no_demands;
+			}
+		}
+	}
 };
 
 } /* namespace demand_queue_details */
@@ -383,6 +866,22 @@ struct common_data_t
 	 */
 	demands_counter_t m_demands_count = { 0 };
 
+	/*!
+	 * \brief Short delayed messages handled by the work thread itself.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	local_timer_queue_t m_local_timers;
+
+	/*!
+	 * \brief Should m_local_timers be used?
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	bool m_local_timers_enabled{ false };
+
 	common_data_t(
 		queue_traits::lock_factory_t queue_lock_factory )
 		:	m_queue( queue_lock_factory() )
@@ -415,6 +914,7 @@ protected :
 		{
 			auto & demand = demands.front();
 
+			this->m_local_timers.set_current_agent( demand.m_receiver );
 			demand.call_handler( this->m_thread_id );
 
 			demands.pop_front();
@@ -455,6 +955,7 @@ public :
 		{
 			std::lock_guard< activity_tracking_traits::lock_t > lock{ m_stats_lock };
 			result.m_working_stats = m_activity_stats;
+			result.m_cpu = m_cpu;
 
 			// Special care to the current activity (if exists).
 			if( m_activity_started_at )
@@ -484,17 +985,20 @@ protected :
 		demand_container_t & demands )
 	{
 		auto activity_started_at = so_5::stats::clock_type_t::now();
+		const int cpu = so_5::disp::reuse::current_cpu();
 
 		{
 			std::lock_guard< activity_tracking_traits::lock_t > lock{ m_stats_lock };
 			m_activity_started_at = &activity_started_at;
 			m_activity_stats.m_count += 1;
+			m_cpu = cpu;
 		}
 
 		while( !demands.empty() )
 		{
 			auto & demand = demands.front();
 
+			m_local_timers.set_current_agent( demand.m_receiver );
 			demand.call_handler( m_thread_id );
 
 			const auto activity_finished_at = so_5::stats::clock_type_t::now();
@@ -537,6 +1041,14 @@ private :
 	 * \brief Activity statistics.
 	 */
 	so_5::stats::activity_stats_t m_activity_stats{};
+
+	/*!
+	 * \brief CPU on which the last block of demands was started.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	int m_cpu{ -1 };
 };
 
 /*!
@@ -557,12 +1069,20 @@ public :
 
 	//! Start the working thread.
 	void
-	start()
+	start(
+		//! CPUs on which the thread is allowed to run.
+		cpu_list_t cpus = {},
+		//! Should short delayed messages be handled by the thread itself?
+		bool local_timers = false )
 	{
+		this->m_local_timers_enabled = local_timers;
 		this->m_queue.start_service();
 		this->m_status = status_t::working;
 
-		this->m_thread = std::thread( [this]() { this->body(); } );
+		this->m_thread = std::thread( [this, cpus = std::move(cpus)]() {
+				bind_current_thread( cpus );
+				this->body();
+			} );
 	}
 
 	//! Send the shutdown signal to the working thread.
@@ -613,6 +1133,20 @@ public :
 		return this->m_queue.demands_count( this->m_demands_count );
 	}
 
+	/*!
+	 * \brief Get stats of waiting on the lock of demands queue.
+	 *
+	 * \return false if the lock doesn't collect such stats.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	bool
+	query_lock_stats( so_5::stats::lock_stats_t & to ) const noexcept
+	{
+		return this->m_queue.query_lock_stats( to );
+	}
+
 	/*!
 	 * \brief Get ID of work thread.
 	 *
@@ -628,6 +1162,21 @@ public :
 		return this->m_thread_id;
 	}
 
+	/*!
+	 * \brief Get ID of work thread as it is known to the starter.
+	 *
+	 * \note Unlike thread_id() this method returns correct value
+	 * right after the return from start().
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	so_5::current_thread_id_t
+	started_thread_id() const noexcept
+	{
+		return this->m_thread.get_id();
+	}
+
 private :
 	//! Main thread body.
 	void
@@ -640,6 +1189,13 @@ private :
 		// Local demands queue.
 		demand_container_t demands;
 
+		// Since v.5.6.2 short delayed messages sent by agents to
+		// themselves can be handled by the work thread.
+		local_timer_queue_binding_t local_timers_binding{
+				this->m_local_timers,
+				this->m_local_timers_enabled &&
+						this->m_queue.timed_wait_supported() };
+
 		auto result = extraction_result_t::no_demands;
 
 		while( status_t::working == this->m_status )
@@ -647,7 +1203,19 @@ private :
 			// If the local queue is empty then we should try
 			// to get new demands.
 			if( demands.empty() )
-				result = this->m_queue.pop( demands, this->m_demands_count );
+			{
+				auto & local_timers = this->m_local_timers;
+				local_timers.deliver_elapsed();
+
+				if( local_timers.empty() )
+					result = this->m_queue.pop( demands, this->m_demands_count );
+				else
+				{
+					const auto deadline = local_timers.next_deadline();
+					result = this->m_queue.pop(
+							demands, this->m_demands_count, &deadline );
+				}
+			}
 
 			// Serve demands if any.
 			if( extraction_result_t::demand_extracted == result )
@@ -16,10 +16,15 @@
 
 #include <so_5/disp/reuse/mpmc_ptr_queue.hpp>
 #include <so_5/disp/reuse/thread_pool_stats.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
 
 #include <so_5/details/rollback_on_exception.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 namespace so_5 {
 
@@ -48,6 +53,7 @@ template<
 	typename Adaptations >
 class dispatcher_t final
 	:	public tp_stats::stats_supplier_t
+	,	private so_5::disp::reuse::elastic_pool_listener_t
 	{
 	private :
 		using agent_queue_ref_t = so_5::intrusive_ptr_t< Agent_Queue >;
@@ -181,11 +187,20 @@ class dispatcher_t final
 		dispatcher_t & operator=( const dispatcher_t & ) = delete;
 
 		//! Constructor.
+		/*!
+		 * \note Since v.5.6.2 additional arguments are passed to
+		 * the constructor of \a Dispatcher_Queue.
+		 */
+		template< typename... Queue_Args >
 		dispatcher_t(
 			const std::string_view name_base,
 			std::size_t thread_count,
-			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params )
-			:	m_queue{ queue_params, thread_count }
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			Queue_Args &&... queue_args )
+			:	m_queue{
+					queue_params,
+					thread_count,
+					std::forward< Queue_Args >( queue_args )... }
 			,	m_thread_count( thread_count )
 			,	m_data_source( stats_supplier() )
 			{
@@ -201,14 +216,64 @@ class dispatcher_t final
 						this );
 			}
 
+		/*!
+		 * \brief Turn elastic mode on.
+		 *
+		 * The count of threads specified in the constructor is used as
+		 * the min count of threads. Additional threads are started when
+		 * there are no idle threads and there are at least
+		 * \a growth_threshold agent queues waiting for processing.
+		 * A thread is stopped if it has no work for \a idle_timeout.
+		 *
+		 * \attention Must be called before start().
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
 		void
-		start( environment_t & env )
+		set_elasticity(
+			std::size_t max_thread_count,
+			std::size_t growth_threshold,
+			std::chrono::steady_clock::duration idle_timeout )
 			{
+				m_queue.set_elasticity(
+						max_thread_count, growth_threshold, *this );
+
+				// Pointers to threads must not be reallocated when a new
+				// thread is being added.
+				m_threads.reserve( max_thread_count );
+
+				m_elastic_mode = true;
+				m_idle_timeout = idle_timeout;
+			}
+
+		void
+		start(
+			environment_t & env,
+			const so_5::disp::thread_affinity_t & affinity )
+			{
+				// CPUs for all threads must be known before the start
+				// of the first thread because the calculation can throw.
+				std::vector< so_5::disp::reuse::cpu_list_t > cpus;
+				cpus.reserve( m_threads.size() );
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
+					cpus.push_back(
+							so_5::disp::reuse::cpus_for_work_thread( affinity, i ) );
+
+				// It will be used for threads started in elastic mode.
+				m_affinity = affinity;
+
 				m_data_source.start(
 						outliving_mutable(env.stats_repository()) );
 
-				for( auto & t : m_threads )
-					t->start();
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
+					m_threads[ i ]->start( std::move(cpus[ i ]) );
+				m_threads_started = m_threads.size();
+
+				if( m_elastic_mode )
+					m_elastic_manager = std::thread{ [this] {
+							elastic_manager_body();
+						} };
 			}
 
 		void
@@ -216,6 +281,16 @@ class dispatcher_t final
 			{
 				m_queue.shutdown();
 
+				if( m_elastic_manager.joinable() )
+					{
+						{
+							std::lock_guard lock{ m_elastic_lock };
+							m_elastic_shutdown = true;
+						}
+						m_elastic_wakeup.notify_one();
+						m_elastic_manager.join();
+					}
+
 				for( auto & t : m_threads )
 					t->join();
 
@@ -299,6 +374,9 @@ class dispatcher_t final
 		Dispatcher_Queue m_queue;
 
 		//! Count of working threads.
+		/*!
+		 * It is the min count of working threads in elastic mode.
+		 */
 		const std::size_t m_thread_count;
 
 		//! Pool of work threads.
@@ -326,13 +404,61 @@ class dispatcher_t final
 		stats::manually_registered_source_holder_t< tp_stats::data_source_t >
 				m_data_source;
 
+		/*!
+		 * \brief CPU affinity for working threads.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		so_5::disp::thread_affinity_t m_affinity;
+
+		/*!
+		 * \brief Count of started threads.
+		 *
+		 * It is used as index of a new thread for CPU affinity.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::size_t m_threads_started{ 0u };
+
+		/*!
+		 * \name Stuff for elastic mode.
+		 * \since
+		 * v.5.6.2
+		 * \{
+		 */
+		//! Is elastic mode turned on?
+		bool m_elastic_mode{ false };
+
+		//! Max time of waiting for work before the stop of a thread.
+		std::chrono::steady_clock::duration m_idle_timeout{};
+
+		//! Thread which starts and stops working threads.
+		std::thread m_elastic_manager;
+
+		//! Lock for the manager's data.
+		std::mutex m_elastic_lock;
+
+		//! Notification for the manager.
+		std::condition_variable m_elastic_wakeup;
+
+		//! Has a new thread been requested?
+		bool m_growth_requested{ false };
+
+		//! Should the manager finish its work?
+		bool m_elastic_shutdown{ false };
+		/*!
+		 * \}
+		 */
+
 		//! Creation event queue for an agent with individual FIFO.
 		void
 		bind_agent_with_inidividual_fifo(
 			agent_ref_t agent,
 			const Params & params )
 			{
-				auto queue = make_new_agent_queue( params );
+				auto queue = make_new_agent_queue( *agent, params );
 
 				m_agents.emplace(
 						agent.get(),
@@ -359,7 +485,7 @@ class dispatcher_t final
 					it = m_cooperations.emplace(
 							id,
 							cooperation_data_t(
-									make_new_agent_queue( params ),
+									make_new_agent_queue( *agent, params ),
 									1,
 									m_data_source.get().prefix(),
 									id ) )
@@ -380,13 +506,132 @@ class dispatcher_t final
 						} );
 			}
 
+		void
+		on_growth_required() noexcept override
+			{
+				{
+					std::lock_guard lock{ m_elastic_lock };
+					m_growth_requested = true;
+				}
+				m_elastic_wakeup.notify_one();
+			}
+
+		/*!
+		 * \brief Main loop of the thread which manages working threads
+		 * in elastic mode.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		elastic_manager_body() noexcept
+			{
+				const auto check_period = std::max<
+							std::chrono::steady_clock::duration >(
+						m_idle_timeout / 2,
+						std::chrono::milliseconds( 1 ) );
+
+				std::unique_lock lock{ m_elastic_lock };
+				while( !m_elastic_shutdown )
+					{
+						m_elastic_wakeup.wait_for( lock, check_period,
+							[this] { return m_elastic_shutdown || m_growth_requested; } );
+						if( m_elastic_shutdown )
+							break;
+
+						const bool growth_requested = m_growth_requested;
+						m_growth_requested = false;
+
+						// Queue's methods must not be called when m_elastic_lock
+						// is acquired.
+						lock.unlock();
+
+						if( growth_requested )
+							add_elastic_thread();
+
+						retire_idle_threads();
+
+						lock.lock();
+					}
+			}
+
+		/*!
+		 * \brief Start a new working thread in elastic mode.
+		 *
+		 * \note If a thread can't be started then the dispatcher
+		 * continues its work with the current threads.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		add_elastic_thread() noexcept
+			{
+				bool started = false;
+				try
+					{
+						auto cpus = so_5::disp::reuse::cpus_for_work_thread(
+								m_affinity, m_threads_started );
+						std::unique_ptr< Work_Thread > thread{
+								new Work_Thread( m_queue ) };
+						thread->start( std::move(cpus) );
+						++m_threads_started;
+
+						// There is enough capacity in m_threads.
+						// So push_back doesn't throw.
+						std::lock_guard lock{ m_lock };
+						m_threads.push_back( std::move(thread) );
+						started = true;
+					}
+				catch( ... )
+					{}
+
+				m_queue.growth_completed( started );
+			}
+
+		/*!
+		 * \brief Stop working threads which are idle for too long.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		retire_idle_threads() noexcept
+			{
+				while( const auto * condition = m_queue.try_retire_idle_thread(
+						m_thread_count, m_idle_timeout ) )
+					{
+						std::unique_ptr< Work_Thread > retired;
+						{
+							std::lock_guard lock{ m_lock };
+							const auto it = std::find_if(
+									m_threads.begin(), m_threads.end(),
+									[condition]( const auto & t ) {
+										return condition == t->condition();
+									} );
+							retired = std::move( *it );
+							m_threads.erase( it );
+						}
+
+						// The thread will finish its work very soon because
+						// it gets nullptr from the queue.
+						retired->join();
+					}
+			}
+
 		//! Helper method for creating event queue for agents/cooperations.
+		/*!
+		 * \note Since v.5.6.2 the priority of \a agent is passed to
+		 * the queue. The queue for a cooperation receives the priority
+		 * of the first agent from that cooperation.
+		 */
 		agent_queue_ref_t
 		make_new_agent_queue(
+			const agent_t & agent,
 			const Params & params )
 			{
 				return agent_queue_ref_t(
-						new Agent_Queue{ m_queue, params } );
+						new Agent_Queue{ m_queue, params, agent.so_priority() } );
 			}
 
 		/*!
@@ -415,6 +660,10 @@ class dispatcher_t final
 
 				consumer.set_thread_count( m_threads.size() );
 
+				so_5::stats::lock_stats_t lock_stats;
+				if( m_queue.query_lock_stats( lock_stats ) )
+					consumer.set_lock_stats( lock_stats );
+
 				for( auto & t : m_threads )
 					{
 						using stats_t = so_5::stats::work_thread_activity_stats_t;
@@ -16,11 +16,15 @@
 #include <so_5/stats/impl/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/work_stealing_ptr_queue.hpp>
+#include <so_5/disp/reuse/intrusive_free_list.hpp>
 
 #include <so_5/disp/thread_pool/impl/common_implementation.hpp>
 
 #include <so_5/impl/thread_join_stuff.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 namespace so_5
 {
 
@@ -35,26 +39,39 @@ namespace impl
 
 using spinlock_t = so_5::default_spinlock_t;
 
-class agent_queue_t;
-
-//
-// dispatcher_queue_t
-//
-using dispatcher_queue_t = so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
-
 //
-// agent_queue_t
+// agent_queue_template_t
 //
 /*!
  * \brief Event queue for the agent (or cooperation).
+ *
+ * \note Since v.5.6.2 it is a template. Type of dispatcher queue
+ * is specified by \a Dispatcher_Queue template.
+ *
+ * \note Since v.5.6.2 items of the queue are reused for new demands
+ * (a limited count of them is kept in a free-list). So there is no
+ * allocation for every demand in the steady state.
+ *
+ * \note Since v.5.6.2 the queue knows its priority. It is used
+ * by dispatcher queues which take priorities into account.
+ *
+ * \tparam Dispatcher_Queue so_5::disp::reuse::mpmc_ptr_queue_t,
+ * so_5::disp::reuse::work_stealing_ptr_queue_t or
+ * so_5::disp::prio_thread_pool::impl::prio_mpmc_ptr_queue_t.
+ *
  * \since
  * v.5.4.0
  */
-class agent_queue_t final
+template< template< class > class Dispatcher_Queue >
+class agent_queue_template_t final
 	:	public event_queue_t
 	,	private so_5::atomic_refcounted_t
 	{
-		friend class so_5::intrusive_ptr_t< agent_queue_t >;
+		friend class so_5::intrusive_ptr_t< agent_queue_template_t >;
+
+	public :
+		//! Type of dispatcher queue to be used with that agent queue.
+		using dispatcher_queue_t = Dispatcher_Queue< agent_queue_template_t >;
 
 	private :
 		//! Actual demand in event queue.
@@ -70,21 +87,36 @@ class agent_queue_t final
 					:	execution_demand_t( std::move( original ) )
 					,	m_next( nullptr )
 					{}
+
+				//! Replace the content of the demand.
+				void
+				assign( execution_demand_t && original ) noexcept
+					{
+						static_cast< execution_demand_t & >(*this) =
+								std::move( original );
+					}
 			};
 
+		//! Type of free-list for queue items.
+		using free_list_t = so_5::disp::reuse::intrusive_free_list_t< demand_t >;
+
 	public :
 		//! Constructor.
-		agent_queue_t(
+		agent_queue_template_t(
 			//! Dispatcher queue to work with.
 			dispatcher_queue_t & disp_queue,
 			//! Parameters for the queue.
-			const bind_params_t & params )
+			const bind_params_t & params,
+			//! Priority of the queue.
+			priority_t priority )
 			:	m_disp_queue( disp_queue )
+			,	m_priority( priority )
 			,	m_max_demands_at_once( params.query_max_demands_at_once() )
+			,	m_batch_extraction( params.query_batch_extraction() )
 			,	m_tail( &m_head )
 			{}
 
-		~agent_queue_t()
+		~agent_queue_template_t()
 			{
 				while( m_head.m_next )
 					remove_head();
@@ -94,22 +126,116 @@ class agent_queue_t final
 		virtual void
 		push( execution_demand_t demand )
 			{
-				std::unique_ptr< demand_t > tail_demand{
-						new demand_t( std::move( demand ) ) };
-
 				bool was_empty;
+				bool stored = false;
 
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
-					was_empty = (nullptr == m_head.m_next);
+					demand_t * item = m_free_items.try_take();
+					if( item )
+						{
+							item->assign( std::move( demand ) );
+							was_empty = append_chain( item, item, 1u );
+							stored = true;
+						}
+				}
+
+				if( !stored )
+					{
+						// There is no free item. A new one must be created
+						// when m_lock is released.
+						std::unique_ptr< demand_t > tail_demand{
+								new demand_t( std::move( demand ) ) };
 
-					m_tail->m_next = tail_demand.release();
-					m_tail = m_tail->m_next;
+						std::lock_guard< spinlock_t > lock( m_lock );
 
-					++m_size;
+						was_empty = append_chain(
+								tail_demand.get(), tail_demand.get(), 1u );
+						tail_demand.release();
+					}
+
+				// Scheduling of the queue must be done when queue lock
+				// is unlocked.
+				if( was_empty )
+					m_disp_queue.schedule( this );
+			}
+
+		//! Push several demands to queue at once.
+		/*!
+		 * If there are enough free items then the whole batch is stored
+		 * under one acquisition of the lock without allocations.
+		 * Otherwise items for all demands are allocated before acquiring
+		 * the lock. Then the whole chain is appended to the queue under
+		 * one acquisition of the lock.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				bool was_empty;
+				bool stored = false;
+
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					if( m_free_items.size() >= count )
+						{
+							demand_t * chain_head = nullptr;
+							demand_t * chain_tail = nullptr;
+							for( std::size_t i = 0u; i != count; ++i )
+								{
+									auto * d = m_free_items.try_take();
+									d->assign( std::move( demands[ i ] ) );
+									if( chain_tail )
+										chain_tail->m_next = d;
+									else
+										chain_head = d;
+									chain_tail = d;
+								}
+
+							was_empty = append_chain( chain_head, chain_tail, count );
+							stored = true;
+						}
 				}
 
+				if( !stored )
+					{
+						demand_t * chain_head = nullptr;
+						demand_t * chain_tail = nullptr;
+
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								for( std::size_t i = 0u; i != count; ++i )
+									{
+										auto * d = new demand_t( std::move( demands[ i ] ) );
+										if( chain_tail )
+											chain_tail->m_next = d;
+										else
+											chain_head = d;
+										chain_tail = d;
+									}
+							},
+							[&] {
+								while( chain_head )
+									{
+										std::unique_ptr< demand_t > d{ chain_head };
+										chain_head = chain_head->m_next;
+									}
+							} );
+
+						std::lock_guard< spinlock_t > lock( m_lock );
+
+						was_empty = append_chain( chain_head, chain_tail, count );
+					}
+
 				// Scheduling of the queue must be done when queue lock
 				// is unlocked.
 				if( was_empty )
@@ -176,13 +302,20 @@ class agent_queue_t final
 			//! Count of consequently processed demands from that queue.
 			std::size_t demands_processed )
 			{
-				// Actual deletion of old head must be performed
-				// when m_lock will be released.
+				// The processed demand must be destroyed when m_lock
+				// is released. Only the current working thread works
+				// with the head item, so it can be done without the lock.
+				m_head.m_next->assign( execution_demand_t{} );
+
+				// Actual deletion of old head (if it can't be reused)
+				// must be performed when m_lock will be released.
 				std::unique_ptr< demand_t > old_head;
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
 					old_head = remove_head();
+					if( m_free_items.try_put( old_head.get() ) )
+						old_head.release();
 
 					const auto emptyness = m_head.m_next ?
 							emptyness_t::not_empty : emptyness_t::empty;
@@ -196,6 +329,102 @@ class agent_queue_t final
 				}
 			}
 
+		/*!
+		 * \brief Is extraction of demands by batches turned on?
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		batch_extraction() const noexcept
+			{
+				return m_batch_extraction;
+			}
+
+		/*!
+		 * \brief Process a batch of demands.
+		 *
+		 * Up to max_demands_at_once demands are extracted from the queue
+		 * under one acquisition of the lock. Then they are passed to
+		 * \a handler without the lock. The lock is acquired again only
+		 * when the whole batch is processed.
+		 *
+		 * The queue is treated as non-empty while the batch is being
+		 * processed. So it won't be scheduled again by push().
+		 *
+		 * \attention This method must be called only on non-empty queue.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		template< typename Handler >
+		emptyness_t
+		process_batch( Handler && handler )
+			{
+				demand_t * first;
+				std::size_t count = 1u;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					first = m_head.m_next;
+					demand_t * last = first;
+					while( count < m_max_demands_at_once && last->m_next )
+						{
+							last = last->m_next;
+							++count;
+						}
+
+					m_head.m_next = last->m_next;
+					if( !m_head.m_next )
+						m_tail = &m_head;
+					last->m_next = nullptr;
+
+					m_batch_in_progress = true;
+				}
+
+				for( demand_t * d = first; d; d = d->m_next )
+					{
+						handler( static_cast< execution_demand_t & >(*d) );
+
+						// The processed demand must be destroyed when m_lock
+						// is released.
+						d->assign( execution_demand_t{} );
+					}
+
+				// Items which can't be reused must be deleted when m_lock
+				// is released.
+				demand_t * to_be_deleted = nullptr;
+				emptyness_t emptyness;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					m_batch_in_progress = false;
+					m_size -= count;
+
+					while( first )
+						{
+							demand_t * d = first;
+							first = first->m_next;
+							if( !m_free_items.try_put( d ) )
+								{
+									d->m_next = to_be_deleted;
+									to_be_deleted = d;
+								}
+						}
+
+					emptyness = m_head.m_next ?
+							emptyness_t::not_empty : emptyness_t::empty;
+				}
+
+				while( to_be_deleted )
+					{
+						std::unique_ptr< demand_t > d{ to_be_deleted };
+						to_be_deleted = to_be_deleted->m_next;
+					}
+
+				return emptyness;
+			}
+
 		/*!
 		 * \brief Wait while queue becomes empty.
 		 *
@@ -215,7 +444,8 @@ class agent_queue_t final
 					{
 						{
 							std::lock_guard< spinlock_t > lock( m_lock );
-							empty = (nullptr == m_head.m_next);
+							empty = (nullptr == m_head.m_next) &&
+									!m_batch_in_progress;
 						}
 
 						if( !empty )
@@ -235,14 +465,54 @@ class agent_queue_t final
 				return m_size.load( std::memory_order_acquire );
 			}
 
+		/*!
+		 * \brief Get the priority of the queue.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		priority_t
+		priority() const noexcept
+			{
+				return m_priority;
+			}
+
 	private :
 		//! Dispatcher queue for scheduling processing of events from
 		//! this queue.
 		dispatcher_queue_t & m_disp_queue;
 
+		/*!
+		 * \brief Priority of the queue.
+		 *
+		 * It is the priority of the agent for which the queue is created.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const priority_t m_priority;
+
 		//! Maximum count of demands to be processed consequently.
 		const std::size_t m_max_demands_at_once;
 
+		/*!
+		 * \brief Should demands be extracted by batches?
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const bool m_batch_extraction;
+
+		/*!
+		 * \brief Is a batch of demands being processed now?
+		 *
+		 * Protected by m_lock.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool m_batch_in_progress{ false };
+
 		//! Object's lock.
 		spinlock_t m_lock;
 
@@ -265,6 +535,42 @@ class agent_queue_t final
 		 */
 		std::atomic< std::size_t > m_size = { 0 };
 
+		/*!
+		 * \brief Items which can be reused for new demands.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		free_list_t m_free_items;
+
+		/*!
+		 * \brief Append a chain of items to the end of the queue.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 *
+		 * \return true if the queue was empty (and there is no batch
+		 * in processing).
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		append_chain(
+			demand_t * chain_head,
+			demand_t * chain_tail,
+			std::size_t count ) noexcept
+			{
+				const bool was_empty = (nullptr == m_head.m_next) &&
+						!m_batch_in_progress;
+
+				m_tail->m_next = chain_head;
+				m_tail = chain_tail;
+
+				m_size += count;
+
+				return was_empty;
+			}
+
 		//! Helper method for deleting queue's head object.
 		inline std::unique_ptr< demand_t >
 		remove_head()
@@ -296,11 +602,17 @@ namespace work_thread_details
 /*!
  * \brief Main data for work_thread.
  *
+ * \tparam Agent_Queue type of agent queue.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 struct common_data_t
 	{
+		using agent_queue_t = Agent_Queue;
+		using dispatcher_queue_t = typename Agent_Queue::dispatcher_queue_t;
+
 		//! Dispatcher's queue.
 		dispatcher_queue_t * m_disp_queue;
 
@@ -327,13 +639,17 @@ struct common_data_t
  * \since
  * v.5.5.18
  */
-class no_activity_tracking_impl_t : protected common_data_t
+template< typename Agent_Queue >
+class no_activity_tracking_impl_t : protected common_data_t< Agent_Queue >
 	{
 	public :
+		using typename common_data_t< Agent_Queue >::agent_queue_t;
+		using typename common_data_t< Agent_Queue >::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		no_activity_tracking_impl_t(
 			dispatcher_queue_t & queue )
-			:	common_data_t( queue )
+			:	common_data_t< Agent_Queue >( queue )
 			{}
 
 		template< typename L >
@@ -359,15 +675,19 @@ class no_activity_tracking_impl_t : protected common_data_t
  * \since
  * v.5.5.18
  */
-class with_activity_tracking_impl_t : protected common_data_t
+template< typename Agent_Queue >
+class with_activity_tracking_impl_t : protected common_data_t< Agent_Queue >
 	{
 		using activity_tracking_traits = so_5::stats::activity_tracking_stuff::traits;
 
 	public :
+		using typename common_data_t< Agent_Queue >::agent_queue_t;
+		using typename common_data_t< Agent_Queue >::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		with_activity_tracking_impl_t(
 			dispatcher_queue_t & queue )
-			:	common_data_t( queue )
+			:	common_data_t< Agent_Queue >( queue )
 			{}
 
 		template< typename L >
@@ -378,6 +698,7 @@ class with_activity_tracking_impl_t : protected common_data_t
 
 				result.m_working_stats = m_work_activity_collector.take_stats();
 				result.m_waiting_stats = m_waiting_stats_collector.take_stats();
+				result.m_cpu = m_cpu.load( std::memory_order_relaxed );
 
 				lambda( result );
 			}
@@ -396,6 +717,14 @@ class with_activity_tracking_impl_t : protected common_data_t
 					so_5::stats::activity_tracking_stuff::external_lock<> >
 				m_waiting_stats_collector{ m_stats_lock };
 
+		/*!
+		 * \brief CPU on which the thread was woken up last time.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::atomic< int > m_cpu{ -1 };
+
 		void
 		work_started()
 			{
@@ -418,6 +747,9 @@ class with_activity_tracking_impl_t : protected common_data_t
 		wait_finished()
 			{
 				m_waiting_stats_collector.stop();
+				m_cpu.store(
+						so_5::disp::reuse::current_cpu(),
+						std::memory_order_relaxed );
 			}
 	};
 
@@ -433,6 +765,9 @@ template< typename Impl >
 class work_thread_template_t final : public Impl
 	{
 	public :
+		using typename Impl::agent_queue_t;
+		using typename Impl::dispatcher_queue_t;
+
 		//! Initializing constructor.
 		work_thread_template_t( dispatcher_queue_t & queue )
 			:	Impl( queue )
@@ -447,9 +782,14 @@ class work_thread_template_t final : public Impl
 
 		//! Launch work thread.
 		void
-		start()
+		start(
+			//! CPUs on which the thread is allowed to run.
+			so_5::disp::reuse::cpu_list_t cpus )
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				this->m_thread = std::thread( [this, cpus = std::move(cpus)]() {
+						so_5::disp::reuse::bind_current_thread( cpus );
+						body();
+					} );
 			}
 
 		/*!
@@ -467,6 +807,18 @@ class work_thread_template_t final : public Impl
 				return this->m_thread_id;
 			}
 
+		/*!
+		 * \brief Get the condition object of work thread.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const so_5::disp::mpmc_queue_traits::condition_t *
+		condition() const noexcept
+			{
+				return this->m_condition.get();
+			}
+
 	private :
 		//! Thread body method.
 		void
@@ -539,11 +891,21 @@ class work_thread_template_t final : public Impl
 
 
 		//! Processing of demands from agent queue.
-		agent_queue_t::emptyness_t
+		typename agent_queue_t::emptyness_t
 		process_queue( agent_queue_t & queue )
 			{
+				if( queue.batch_extraction() )
+					return queue.process_batch(
+						[this]( execution_demand_t & d ) {
+							this->work_started();
+
+							d.call_handler( this->m_thread_id );
+
+							this->work_finished();
+						} );
+
 				std::size_t demands_processed = 0;
-				agent_queue_t::pop_result_t pop_result;
+				typename agent_queue_t::pop_result_t pop_result;
 
 				do
 					{
@@ -568,29 +930,61 @@ class work_thread_template_t final : public Impl
 
 } /* namespace work_thread_details */
 
+//
+// central_agent_queue_t
+//
+/*!
+ * \brief Type of agent queue for dispatcher with the central queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+using central_agent_queue_t =
+		agent_queue_template_t< so_5::disp::reuse::mpmc_ptr_queue_t >;
+
+//
+// work_stealing_agent_queue_t
+//
+/*!
+ * \brief Type of agent queue for dispatcher with work stealing.
+ *
+ * \since
+ * v.5.6.2
+ */
+using work_stealing_agent_queue_t =
+		agent_queue_template_t< so_5::disp::reuse::work_stealing_ptr_queue_t >;
+
 //
 // work_thread_no_activity_tracking_t
 //
 /*!
  * \brief Type of work thread without activity tracking.
+ *
+ * \note Since v.5.6.2 it is a template.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 using work_thread_no_activity_tracking_t =
 		work_thread_details::work_thread_template_t<
-				work_thread_details::no_activity_tracking_impl_t >;
+				work_thread_details::no_activity_tracking_impl_t< Agent_Queue > >;
 
 //
 // work_thread_with_activity_tracking_t
 //
 /*!
  * \brief Type of work thread without activity tracking.
+ *
+ * \note Since v.5.6.2 it is a template.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Agent_Queue >
 using work_thread_with_activity_tracking_t =
 		work_thread_details::work_thread_template_t<
-				work_thread_details::with_activity_tracking_impl_t >;
+				work_thread_details::with_activity_tracking_impl_t< Agent_Queue > >;
 
 //
 // adaptation_t
@@ -617,8 +1011,9 @@ struct adaptation_t
 				return fifo_t::individual == params.query_fifo();
 			}
 
+		template< typename Agent_Queue >
 		static void
-		wait_for_queue_emptyness( agent_queue_t & queue ) noexcept
+		wait_for_queue_emptyness( Agent_Queue & queue ) noexcept
 			{
 				queue.wait_for_emptyness();
 			}
@@ -640,8 +1035,8 @@ template< typename Work_Thread >
 using dispatcher_template_t =
 		common_implementation::dispatcher_t<
 				Work_Thread,
-				dispatcher_queue_t,
-				agent_queue_t,
+				typename Work_Thread::dispatcher_queue_t,
+				typename Work_Thread::agent_queue_t,
 				bind_params_t,
 				adaptation_t >;
 
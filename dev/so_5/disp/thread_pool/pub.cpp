@@ -153,7 +153,13 @@ class actual_dispatcher_implementation_t final
 			disp_params_t params )
 			:	m_impl{ name_base, params.thread_count(), params.queue_params() }
 			{
-				m_impl.start( env.get() );
+				if( const auto & elastic = params.elastic() )
+					m_impl.set_elasticity(
+							elastic->max_threads(),
+							elastic->growth_threshold(),
+							elastic->idle_timeout() );
+
+				m_impl.start( env.get(), params.thread_affinity() );
 			}
 
 		~actual_dispatcher_implementation_t() noexcept override
@@ -222,46 +228,79 @@ using namespace so_5::disp::thread_pool::impl;
  * \brief Sets the thread count to default value if used do not
  * specify actual thread count.
  *
+ * \note Since v.5.6.2 the min count of threads is used in elastic mode.
+ *
  * \since
  * v.5.5.11
  */
 inline void
 adjust_thread_count( disp_params_t & params )
 	{
-		if( !params.thread_count() )
+		if( const auto & elastic = params.elastic() )
+			{
+				if( !elastic->min_threads() ||
+						elastic->max_threads() < elastic->min_threads() )
+					SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+							"invalid count of threads for elastic mode: min=" +
+							std::to_string( elastic->min_threads() ) + ", max=" +
+							std::to_string( elastic->max_threads() ) );
+
+				// The dispatcher starts with the min count of threads.
+				params.thread_count( elastic->min_threads() );
+			}
+		else if( !params.thread_count() )
 			params.thread_count( default_thread_pool_size() );
 	}
 
-} /* namespace anonymous */
-
-//
-// make_dispatcher
-//
-SO_5_FUNC dispatcher_handle_t
-make_dispatcher(
+/*!
+ * \brief Creation of dispatcher instance for the specified type
+ * of agent queue.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Agent_Queue >
+std::unique_ptr< impl::actual_dispatcher_iface_t >
+make_actual_dispatcher_for(
 	environment_t & env,
 	const std::string_view data_sources_name_base,
 	disp_params_t params )
 	{
-		using namespace so_5::disp::reuse;
-
-		adjust_thread_count( params );
-
 		using dispatcher_no_activity_tracking_t =
 				impl::actual_dispatcher_implementation_t<
-						impl::work_thread_no_activity_tracking_t >;
+						impl::work_thread_no_activity_tracking_t< Agent_Queue > >;
 
 		using dispatcher_with_activity_tracking_t =
 				impl::actual_dispatcher_implementation_t<
-						impl::work_thread_with_activity_tracking_t >;
+						impl::work_thread_with_activity_tracking_t< Agent_Queue > >;
 
-		auto binder = so_5::disp::reuse::make_actual_dispatcher<
+		return so_5::disp::reuse::make_actual_dispatcher<
 						impl::actual_dispatcher_iface_t,
 						dispatcher_no_activity_tracking_t,
 						dispatcher_with_activity_tracking_t >(
 				outliving_reference_t(env),
 				data_sources_name_base,
 				std::move(params) );
+	}
+
+} /* namespace anonymous */
+
+//
+// make_dispatcher
+//
+SO_5_FUNC dispatcher_handle_t
+make_dispatcher(
+	environment_t & env,
+	const std::string_view data_sources_name_base,
+	disp_params_t params )
+	{
+		adjust_thread_count( params );
+
+		auto binder = scheduling_t::work_stealing == params.scheduling() ?
+				make_actual_dispatcher_for< impl::work_stealing_agent_queue_t >(
+						env, data_sources_name_base, std::move(params) ) :
+				make_actual_dispatcher_for< impl::central_agent_queue_t >(
+						env, data_sources_name_base, std::move(params) );
 
 		return impl::dispatcher_handle_maker_t::make( std::move(binder) );
 	}
@@ -18,9 +18,15 @@
 #include <so_5/disp/mpmc_queue_traits/pub.hpp>
 
 #include <so_5/disp/reuse/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/thread_affinity.hpp>
+#include <so_5/disp/reuse/thread_pool_scheduling.hpp>
 
+#include <so_5/optional.hpp>
+
+#include <chrono>
 #include <utility>
 #include <thread>
+#include <string_view>
 
 namespace so_5
 {
@@ -38,6 +44,109 @@ namespace thread_pool
  */
 namespace queue_traits = so_5::disp::mpmc_queue_traits;
 
+/*!
+ * \brief Alias for type of scheduling of agent queues.
+ *
+ * \since
+ * v.5.6.2
+ */
+using scheduling_t = so_5::disp::thread_pool_scheduling_t;
+
+//
+// elastic_params_t
+//
+/*!
+ * \brief Parameters of elastic mode for %thread_pool dispatcher.
+ *
+ * In elastic mode the dispatcher starts with min_threads() working
+ * threads. A new thread is started when there are no idle threads and
+ * count of agent queues waiting for processing reaches
+ * growth_threshold(). A thread is stopped if it has no work for
+ * idle_timeout() and there are more than min_threads() threads.
+ *
+ * Only idle threads are stopped. So the dispatcher still guarantees
+ * that demands from an agent queue (including a cooperation FIFO queue)
+ * are never processed by two threads at the same time.
+ *
+ * Usage example:
+ * \code
+ * using namespace so_5::disp::thread_pool;
+ * auto disp = make_dispatcher( env, "workers",
+ * 	disp_params_t{}.elastic(
+ * 		elastic_params_t{ 2, 16 }
+ * 			.idle_timeout( std::chrono::seconds( 30 ) ) ) );
+ * \endcode
+ *
+ * \note Elastic mode is supported only for central_queue scheduling.
+ *
+ * \since
+ * v.5.6.2
+ */
+class elastic_params_t
+	{
+	public :
+		//! Initializing constructor.
+		elastic_params_t(
+			//! Min count of working threads.
+			std::size_t min_threads,
+			//! Max count of working threads.
+			std::size_t max_threads )
+			:	m_min_threads{ min_threads }
+			,	m_max_threads{ max_threads }
+			{}
+
+		//! Getter for min count of working threads.
+		std::size_t
+		min_threads() const noexcept
+			{
+				return m_min_threads;
+			}
+
+		//! Getter for max count of working threads.
+		std::size_t
+		max_threads() const noexcept
+			{
+				return m_max_threads;
+			}
+
+		//! Setter for count of waiting agent queues for start of new thread.
+		elastic_params_t &
+		growth_threshold( std::size_t v ) noexcept
+			{
+				m_growth_threshold = v;
+				return *this;
+			}
+
+		//! Getter for count of waiting agent queues for start of new thread.
+		std::size_t
+		growth_threshold() const noexcept
+			{
+				return m_growth_threshold;
+			}
+
+		//! Setter for max time of waiting for work before stop of thread.
+		elastic_params_t &
+		idle_timeout( std::chrono::steady_clock::duration v ) noexcept
+			{
+				m_idle_timeout = v;
+				return *this;
+			}
+
+		//! Getter for max time of waiting for work before stop of thread.
+		std::chrono::steady_clock::duration
+		idle_timeout() const noexcept
+			{
+				return m_idle_timeout;
+			}
+
+	private :
+		std::size_t m_min_threads;
+		std::size_t m_max_threads;
+		std::size_t m_growth_threshold{ 1u };
+		std::chrono::steady_clock::duration m_idle_timeout{
+				std::chrono::seconds( 10 ) };
+	};
+
 //
 // disp_params_t
 //
@@ -48,9 +157,15 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
  */
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_affinity_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_pool_scheduling_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using affinity_mixin_t = so_5::disp::reuse::
+				thread_affinity_mixin_t< disp_params_t >;
+		using scheduling_mixin_t = so_5::disp::reuse::
+				thread_pool_scheduling_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -65,9 +180,16 @@ class disp_params_t
 				swap(
 						static_cast< activity_tracking_mixin_t & >(a),
 						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< affinity_mixin_t & >(a),
+						static_cast< affinity_mixin_t & >(b) );
+				swap(
+						static_cast< scheduling_mixin_t & >(a),
+						static_cast< scheduling_mixin_t & >(b) );
 
 				swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
+				swap( a.m_elastic, b.m_elastic );
 			}
 
 		//! Setter for thread count.
@@ -124,6 +246,33 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		/*!
+		 * \brief Turn elastic mode on.
+		 *
+		 * \note Value of thread_count() is ignored in elastic mode.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		disp_params_t &
+		elastic( elastic_params_t v )
+			{
+				m_elastic = v;
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for parameters of elastic mode.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const so_5::optional< elastic_params_t > &
+		elastic() const noexcept
+			{
+				return m_elastic;
+			}
+
 	private :
 		//! Count of working threads.
 		/*!
@@ -132,6 +281,15 @@ class disp_params_t
 		std::size_t m_thread_count = { 0 };
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		/*!
+		 * \brief Parameters of elastic mode.
+		 *
+		 * Elastic mode is not used if there is no value.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		so_5::optional< elastic_params_t > m_elastic;
 	};
 
 //
@@ -200,12 +358,51 @@ class bind_params_t
 				return m_max_demands_at_once;
 			}
 
+		//! Turn extraction of demands by batches on or off.
+		/*!
+		 * If it is turned on then a working thread extracts up to
+		 * max_demands_at_once demands from the agent queue under one
+		 * acquisition of the queue lock and executes them without
+		 * touching the lock. The lock is acquired again only when
+		 * the whole batch is processed.
+		 *
+		 * It reduces the count of lock operations for agents (or
+		 * cooperations) with many demands in their queues.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bind_params_t &
+		batch_extraction( bool v )
+			{
+				m_batch_extraction = v;
+				return *this;
+			}
+
+		//! Is extraction of demands by batches turned on?
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		bool
+		query_batch_extraction() const
+			{
+				return m_batch_extraction;
+			}
+
 	private :
 		//! FIFO type.
 		fifo_t m_fifo = { fifo_t::cooperation };
 
 		//! Maximum count of demands to be processed at once.
 		std::size_t m_max_demands_at_once = { 4 };
+
+		//! Should demands be extracted by batches?
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		bool m_batch_extraction = { false };
 	};
 
 //
@@ -23,6 +23,8 @@
 
 #include <so_5/env_infrastructures.hpp>
 
+#include <so_5/disp/reuse/local_timer_queue.hpp>
+
 #include <so_5/details/rollback_on_exception.hpp>
 
 namespace so_5
@@ -41,6 +43,7 @@ environment_params_t::environment_params_t()
 			work_thread_activity_tracking_t::unspecified )
 	,	m_infrastructure_factory( env_infrastructures::default_mt::factory() )
 	,	m_event_queue_hook( make_empty_event_queue_hook_unique_ptr() )
+	,	m_default_local_mbox_kind( local_mbox_kind_t::rw_locked )
 {
 }
 
@@ -61,6 +64,7 @@ environment_params_t::environment_params_t(
 	,	m_queue_locks_defaults_manager( std::move( other.m_queue_locks_defaults_manager ) )
 	,	m_infrastructure_factory( std::move(other.m_infrastructure_factory) )
 	,	m_event_queue_hook( std::move(other.m_event_queue_hook) )
+	,	m_default_local_mbox_kind( other.m_default_local_mbox_kind )
 {}
 
 environment_params_t::~environment_params_t()
@@ -100,6 +104,8 @@ swap( environment_params_t & a, environment_params_t & b )
 	swap( a.m_infrastructure_factory, b.m_infrastructure_factory );
 
 	swap( a.m_event_queue_hook, b.m_event_queue_hook );
+
+	swap( a.m_default_local_mbox_kind, b.m_default_local_mbox_kind );
 }
 
 environment_params_t &
@@ -396,7 +402,8 @@ struct environment_t::internals_t
 				params.so5__giveout_message_delivery_tracer() }
 		,	m_mbox_core(
 				new impl::mbox_core_t{
-						outliving_mutable( m_msg_tracing_stuff ) } )
+						outliving_mutable( m_msg_tracing_stuff ),
+						params.default_local_mbox_kind() } )
 		,	m_infrastructure(
 				(params.infrastructure_factory())(
 					env,
@@ -460,6 +467,22 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( *this, std::move(nonempty_name) );
 }
 
+mbox_t
+environment_t::create_mbox(
+	local_mbox_kind_t kind )
+{
+	return m_impl->m_mbox_core->create_mbox( *this, kind );
+}
+
+mbox_t
+environment_t::create_mbox(
+	nonempty_name_t nonempty_name,
+	local_mbox_kind_t kind )
+{
+	return m_impl->m_mbox_core->create_mbox(
+			*this, std::move(nonempty_name), kind );
+}
+
 mchain_t
 environment_t::create_mchain(
 	const mchain_params_t & params )
@@ -590,6 +613,15 @@ environment_t::so_single_timer(
 				"unable to schedule single timer for mutable message and "
 				"MPMC mbox, msg_type=" + std::string(params.m_msg_type.name()) );
 
+	// Since v.5.6.2 a short delayed message sent by an agent to itself
+	// can be handled by the current work thread without the timer thread.
+	if( so_5::disp::reuse::local_timer_queue_t::try_schedule(
+			params.m_msg_type,
+			params.m_msg,
+			params.m_mbox,
+			params.m_pause ) )
+		return;
+
 	m_impl->m_infrastructure->single_timer(
 			params.m_msg_type,
 			params.m_msg,
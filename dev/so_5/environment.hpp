@@ -450,6 +450,45 @@ class SO_5_TYPE environment_params_t
 				m_event_queue_hook = std::move(hook);
 			}
 
+		/*!
+		 * \brief Set the kind of local mboxes created by default.
+		 *
+		 * This kind is used by environment_t::create_mbox() methods
+		 * those don't receive local_mbox_kind_t argument.
+		 *
+		 * Usage example:
+		 * \code
+		 * so_5::launch(
+		 * 	[](so_5::environment_t & env) {...},
+		 * 	[](so_5::environment_params_t & params) {
+		 * 		// Many threads will send messages to the same mboxes.
+		 * 		params.default_local_mbox_kind(
+		 * 				so_5::local_mbox_kind_t::copy_on_write );
+		 * 	});
+		 * \endcode
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		environment_params_t &
+		default_local_mbox_kind( local_mbox_kind_t kind )
+			{
+				m_default_local_mbox_kind = kind;
+				return *this;
+			}
+
+		/*!
+		 * \brief Get the kind of local mboxes created by default.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		local_mbox_kind_t
+		default_local_mbox_kind() const
+			{
+				return m_default_local_mbox_kind;
+			}
+
 		/*!
 		 * \name Methods for internal use only.
 		 * \{
@@ -644,6 +683,14 @@ class SO_5_TYPE environment_params_t
 		 * v.5.5.24
 		 */
 		event_queue_hook_unique_ptr_t m_event_queue_hook;
+
+		/*!
+		 * \brief The kind of local mboxes created by default.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		local_mbox_kind_t m_default_local_mbox_kind;
 };
 
 //
@@ -756,6 +803,34 @@ class SO_5_TYPE environment_t
 		create_mbox(
 			//! Mbox name.
 			nonempty_name_t mbox_name );
+
+		//! Create an anonymous mbox of the specified kind.
+		/*!
+		 * \note always creates a new mbox.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		mbox_t
+		create_mbox(
+			//! Kind of a new mbox.
+			local_mbox_kind_t kind );
+
+		//! Create named mbox of the specified kind.
+		/*!
+		 * If \a mbox_name is unique then a new mbox of \a kind will
+		 * be created. If not the reference to existing mbox will be
+		 * returned (\a kind is ignored in that case).
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		mbox_t
+		create_mbox(
+			//! Mbox name.
+			nonempty_name_t mbox_name,
+			//! Kind of a new mbox.
+			local_mbox_kind_t kind );
 		/*!
 		 * \}
 		 */
@@ -230,6 +230,17 @@ class SO_5_TYPE environment_infrastructure_t
 		virtual timer_thread_stats_t
 		query_timer_thread_stats() = 0;
 
+		//! Turn collection of lateness and load stats of timer thread
+		//! on or off.
+		/*!
+		 * \note The default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		set_timer_thread_exec_stats_collection( bool /*enabled*/ ) noexcept {}
+
 		//! Create a binder for the default dispatcher.
 		virtual disp_binder_shptr_t
 		make_default_disp_binder() = 0;
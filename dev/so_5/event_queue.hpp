@@ -14,6 +14,8 @@
 
 #include <so_5/execution_demand.hpp>
 
+#include <cstddef>
+
 namespace so_5
 {
 
@@ -38,6 +40,41 @@ class SO_5_TYPE event_queue_t
 		//! Enqueue new event to the queue.
 		virtual void
 		push( execution_demand_t demand ) = 0;
+
+		//! Enqueue several events to the queue at once.
+		/*!
+		 * Demands are moved from \a demands into the queue in the
+		 * order of their appearance in the array.
+		 *
+		 * An implementation can store the whole batch under a single
+		 * acquisition of its lock. The default implementation simply
+		 * calls push() for every demand.
+		 *
+		 * \note
+		 * If an exception is thrown then the demands which have been
+		 * stored to the queue must have a descriptor without message
+		 * limit (like null_demand_descriptor) in the source array.
+		 * All other demands are treated as not stored and the caller
+		 * decrements message limit counters for them.
+		 * It means that an implementation which stores all demands
+		 * or nothing doesn't need to modify the source array at all.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		push_batch(
+			//! Demands to be stored.
+			execution_demand_t * demands,
+			//! Count of demands.
+			std::size_t count )
+			{
+				for( std::size_t i = 0u; i != count; ++i )
+				{
+					push( std::move( demands[ i ] ) );
+					demands[ i ].m_descriptor = &null_demand_descriptor;
+				}
+			}
 	};
 
 } /* namespace so_5 */
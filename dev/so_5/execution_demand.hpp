@@ -18,6 +18,13 @@
 #include <so_5/fwd.hpp>
 
 #include <so_5/message.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace so_5
 {
@@ -30,8 +37,255 @@ namespace so_5
  * v.5.3.0
  *
  * \brief Type of event handler method.
+ *
+ * \note
+ * It was an alias for `std::function<void(message_ref_t&)>` before
+ * v.5.6.2. Since v.5.6.2 it is a callable object with a fixed-size
+ * internal buffer. Event handlers created by SObjectizer (for
+ * pointers to agent's methods and for lambdas with small captures)
+ * are stored in that buffer, so creation, copying and calling
+ * of event_handler_method_t don't allocate memory. Only callables
+ * which don't fit into the buffer are allocated dynamically.
  */
-using event_handler_method_t = std::function< void(message_ref_t &) >;
+class event_handler_method_t
+	{
+	public :
+		//! Size of the internal buffer.
+		static constexpr std::size_t buffer_size = 4u * sizeof(void *);
+
+		//! Default constructor creates an empty object.
+		event_handler_method_t() noexcept = default;
+
+		//! Constructor from an arbitrary callable.
+		template<
+			typename F,
+			typename = std::enable_if_t<
+				!std::is_same< std::decay_t< F >, event_handler_method_t >::value > >
+		event_handler_method_t( F && f )
+			:	m_ops{ &ops_for< std::decay_t< F > >::ops }
+			{
+				ops_for< std::decay_t< F > >::construct(
+						m_buffer, std::forward< F >( f ) );
+			}
+
+		event_handler_method_t( const event_handler_method_t & o )
+			:	m_ops{ o.m_ops }
+			{
+				if( m_ops )
+					m_ops->m_copy( o.m_buffer, m_buffer );
+			}
+
+		event_handler_method_t( event_handler_method_t && o ) noexcept
+			:	m_ops{ o.m_ops }
+			{
+				if( m_ops )
+					{
+						m_ops->m_move( o.m_buffer, m_buffer );
+						o.m_ops = nullptr;
+					}
+			}
+
+		~event_handler_method_t()
+			{
+				reset();
+			}
+
+		event_handler_method_t &
+		operator=( const event_handler_method_t & o )
+			{
+				event_handler_method_t tmp{ o };
+				swap( tmp );
+				return *this;
+			}
+
+		event_handler_method_t &
+		operator=( event_handler_method_t && o ) noexcept
+			{
+				event_handler_method_t tmp{ std::move( o ) };
+				swap( tmp );
+				return *this;
+			}
+
+		void
+		swap( event_handler_method_t & o ) noexcept
+			{
+				if( this == &o )
+					return;
+
+				event_handler_method_t tmp;
+				move_content( *this, tmp );
+				move_content( o, *this );
+				move_content( tmp, o );
+			}
+
+		friend void
+		swap( event_handler_method_t & a, event_handler_method_t & b ) noexcept
+			{
+				a.swap( b );
+			}
+
+		//! Is there a callable object?
+		explicit operator bool() const noexcept
+			{
+				return nullptr != m_ops;
+			}
+
+		//! Call the handler.
+		/*!
+		 * \throw std::bad_function_call if the object is empty.
+		 */
+		void
+		operator()( message_ref_t & msg ) const
+			{
+				if( !m_ops )
+					throw std::bad_function_call{};
+
+				m_ops->m_call( m_buffer, msg );
+			}
+
+	private :
+		//! Operations for the actual type of callable.
+		struct ops_t
+			{
+				void (*m_call)( void * buffer, message_ref_t & msg );
+				void (*m_copy)( const void * from, void * to );
+				void (*m_move)( void * from, void * to ) noexcept;
+				void (*m_destroy)( void * buffer ) noexcept;
+			};
+
+		//! Should an object of type F be stored in the buffer?
+		template< typename F >
+		static constexpr bool fits_into_buffer =
+				sizeof(F) <= buffer_size &&
+				alignof(F) <= alignof(std::max_align_t) &&
+				std::is_nothrow_move_constructible< F >::value;
+
+		//! Operations for a callable stored in the buffer.
+		template< typename F, bool In_Buffer = fits_into_buffer< F > >
+		struct ops_for
+			{
+				template< typename Arg >
+				static void
+				construct( void * buffer, Arg && arg )
+					{
+						new( buffer ) F( std::forward< Arg >( arg ) );
+					}
+
+				static F &
+				object( void * buffer ) noexcept
+					{
+						return *std::launder( reinterpret_cast< F * >( buffer ) );
+					}
+
+				static void
+				call( void * buffer, message_ref_t & msg )
+					{
+						object( buffer )( msg );
+					}
+
+				static void
+				copy( const void * from, void * to )
+					{
+						construct( to, object( const_cast< void * >( from ) ) );
+					}
+
+				static void
+				move( void * from, void * to ) noexcept
+					{
+						construct( to, std::move( object( from ) ) );
+						destroy( from );
+					}
+
+				static void
+				destroy( void * buffer ) noexcept
+					{
+						object( buffer ).~F();
+					}
+
+				static constexpr ops_t ops{ &call, &copy, &move, &destroy };
+			};
+
+		//! Operations for a callable allocated dynamically.
+		template< typename F >
+		struct ops_for< F, false >
+			{
+				template< typename Arg >
+				static void
+				construct( void * buffer, Arg && arg )
+					{
+						new( buffer ) F*( new F( std::forward< Arg >( arg ) ) );
+					}
+
+				static F *&
+				pointer( void * buffer ) noexcept
+					{
+						return *std::launder( reinterpret_cast< F ** >( buffer ) );
+					}
+
+				static void
+				call( void * buffer, message_ref_t & msg )
+					{
+						(*pointer( buffer ))( msg );
+					}
+
+				static void
+				copy( const void * from, void * to )
+					{
+						construct( to, *pointer( const_cast< void * >( from ) ) );
+					}
+
+				static void
+				move( void * from, void * to ) noexcept
+					{
+						new( to ) F*( pointer( from ) );
+					}
+
+				static void
+				destroy( void * buffer ) noexcept
+					{
+						delete pointer( buffer );
+					}
+
+				static constexpr ops_t ops{ &call, &copy, &move, &destroy };
+			};
+
+		//! Operations for the actual callable.
+		/*!
+		 * Value nullptr means that the object is empty.
+		 */
+		const ops_t * m_ops{ nullptr };
+
+		//! Storage for the actual callable.
+		/*!
+		 * It is mutable because a callable can have non-const
+		 * operator() (like a mutable lambda).
+		 */
+		alignas(std::max_align_t) mutable unsigned char m_buffer[ buffer_size ];
+
+		void
+		reset() noexcept
+			{
+				if( m_ops )
+					{
+						m_ops->m_destroy( m_buffer );
+						m_ops = nullptr;
+					}
+			}
+
+		static void
+		move_content(
+			event_handler_method_t & from,
+			event_handler_method_t & to ) noexcept
+			{
+				to.reset();
+				if( from.m_ops )
+					{
+						from.m_ops->m_move( from.m_buffer, to.m_buffer );
+						to.m_ops = from.m_ops;
+						from.m_ops = nullptr;
+					}
+			}
+	};
 
 struct execution_demand_t;
 
@@ -48,6 +302,46 @@ using demand_handler_pfn_t = void (*)(
 	current_thread_id_t,
 	execution_demand_t & );
 
+//
+// demand_descriptor_t
+//
+/*!
+ * \brief A description of a demand kind.
+ *
+ * Holds the information which is the same for all demands of the
+ * same kind: the demand handler, the message limit and the type of
+ * message. A demand holds just a pointer to a descriptor.
+ *
+ * A descriptor must outlive all demands which refer to it.
+ * Descriptors for ordinary demands are created and owned by
+ * SObjectizer.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct demand_descriptor_t
+{
+	//! Demand handler.
+	demand_handler_pfn_t m_demand_handler;
+
+	//! Optional message limit for that message.
+	const message_limit::control_block_t * m_limit;
+
+	//! Identifier of the message type.
+	message_type_id_t m_msg_type_id;
+};
+
+/*!
+ * \brief A descriptor for an empty demand.
+ *
+ * It is used by the default constructor of execution_demand_t.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline constexpr demand_descriptor_t null_demand_descriptor{
+		nullptr, nullptr, null_message_type_id };
+
 //
 // execution_demand_t
 //
@@ -56,46 +350,103 @@ using demand_handler_pfn_t = void (*)(
  * v.5.4.0
  *
  * \brief A description of event execution demand.
+ *
+ * \note
+ * Since v.5.6.2 the demand handler, the message limit and the type
+ * of message are stored in a shared demand_descriptor_t object.
+ * It makes the demand small (32 bytes on 64-bit platforms), so
+ * demand queues of dispatchers hold more demands per cache line.
  */
 struct execution_demand_t
 {
 	//! Receiver of demand.
 	agent_t * m_receiver;
-	//! Optional message limit for that message.
-	const message_limit::control_block_t * m_limit;
+	/*!
+	 * \brief Description of that demand.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	const demand_descriptor_t * m_descriptor;
 	//! ID of mbox.
 	mbox_id_t m_mbox_id;
-	//! Type of the message.
-	std::type_index m_msg_type;
 	//! Event incident.
 	message_ref_t m_message_ref;
-	//! Demand handler.
-	demand_handler_pfn_t m_demand_handler;
 
 	//! Default constructor.
 	execution_demand_t()
 		:	m_receiver( nullptr )
-		,	m_limit( nullptr )
+		,	m_descriptor( &null_demand_descriptor )
 		,	m_mbox_id( 0 )
-		,	m_msg_type( typeid(void) )
-		,	m_demand_handler( nullptr )
 		{}
-
+	/*!
+	 * \brief Initializing constructor.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
 	execution_demand_t(
 		agent_t * receiver,
-		const message_limit::control_block_t * limit,
+		const demand_descriptor_t * descriptor,
 		mbox_id_t mbox_id,
-		std::type_index msg_type,
-		message_ref_t message_ref,
-		demand_handler_pfn_t demand_handler )
+		message_ref_t message_ref )
 		:	m_receiver( receiver )
-		,	m_limit( limit )
+		,	m_descriptor( descriptor )
 		,	m_mbox_id( mbox_id )
-		,	m_msg_type( msg_type )
 		,	m_message_ref( std::move( message_ref ) )
-		,	m_demand_handler( demand_handler )
 		{}
 
+	/*!
+	 * \brief Optional message limit for that message.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	const message_limit::control_block_t *
+	limit() const noexcept
+		{
+			return m_descriptor->m_limit;
+		}
+
+	/*!
+	 * \brief Identifier of the message type.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	message_type_id_t
+	msg_type_id() const noexcept
+		{
+			return m_descriptor->m_msg_type_id;
+		}
+
+	/*!
+	 * \brief Type of the message.
+	 *
+	 * \note
+	 * It is intended to be used for diagnostic purposes only.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	std::type_index
+	msg_type() const
+		{
+			return message_type_by_id( msg_type_id() );
+		}
+
+	/*!
+	 * \brief Demand handler.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	demand_handler_pfn_t
+	demand_handler() const noexcept
+		{
+			return m_descriptor->m_demand_handler;
+		}
+
 	/*!
 	 * \since
 	 * v.5.5.8
@@ -105,10 +456,13 @@ struct execution_demand_t
 	inline void
 	call_handler( current_thread_id_t thread_id )
 		{
-			(*m_demand_handler)( thread_id, *this );
+			(*m_descriptor->m_demand_handler)( thread_id, *this );
 		}
 };
 
+static_assert( sizeof(void *) != 8u || sizeof(execution_demand_t) == 32u,
+		"execution_demand_t is expected to be 32 bytes long on 64-bit platforms" );
+
 //
 // execution_hint_t
 //
@@ -123,16 +477,28 @@ class execution_hint_t
 {
 public :
 	//! Type of function for calling event handler directly.
-	using direct_func_t = std::function<
-				void( execution_demand_t &, current_thread_id_t ) >;
+	/*!
+	 * \note
+	 * It was std::function before v.5.6.2. Since v.5.6.2 it is
+	 * a pointer to function and the event handler found for
+	 * the demand is passed as a separate argument. So execution_hint_t
+	 * is a trivially copyable object and its creation doesn't
+	 * allocate memory.
+	 */
+	using direct_func_t = void (*)(
+			execution_demand_t &,
+			current_thread_id_t,
+			const impl::event_handler_data_t * );
 
 	//! Initializing constructor.
 	execution_hint_t(
 		execution_demand_t & demand,
 		direct_func_t direct_func,
-		thread_safety_t thread_safety )
+		const impl::event_handler_data_t * handler,
+		thread_safety_t thread_safety ) noexcept
 		:	m_demand( demand )
-		,	m_direct_func( std::move( direct_func ) )
+		,	m_direct_func( direct_func )
+		,	m_handler( handler )
 		,	m_thread_safety( thread_safety )
 		{}
 
@@ -142,12 +508,13 @@ public :
 		{
 			// If message limit is defined then message count
 			// must be decremented.
-			message_limit::control_block_t::decrement( m_demand.m_limit );
+			message_limit::control_block_t::decrement( m_demand.limit() );
 
 			// Now demand can be handled.
 			if( m_direct_func )
 				m_direct_func( m_demand, is_thread_safe() ?
-						null_current_thread_id() : working_thread_id );
+						null_current_thread_id() : working_thread_id,
+						m_handler );
 		}
 
 	//! Is thread safe handler?
@@ -176,14 +543,25 @@ private :
 	//! Function for call event handler directly.
 	direct_func_t m_direct_func;
 
+	/*!
+	 * \brief Event handler found for the demand.
+	 *
+	 * Can be nullptr.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	const impl::event_handler_data_t * m_handler;
+
 	//! Thread safety for event handler.
 	thread_safety_t m_thread_safety;
 
 	//! A special constructor for the case when there is no
 	//! handler for message.
-	execution_hint_t( execution_demand_t & demand )
+	execution_hint_t( execution_demand_t & demand ) noexcept
 		:	m_demand( demand )
-		,	m_direct_func()
+		,	m_direct_func( nullptr )
+		,	m_handler( nullptr )
 		,	m_thread_safety( thread_safe )
 		{}
 
@@ -193,11 +571,14 @@ public :
 	//! Is event handler defined for the demand?
 	operator bool() const
 		{
-			return static_cast< bool >(m_direct_func);
+			return nullptr != m_direct_func;
 		}
 #endif
 };
 
+static_assert( std::is_trivially_copyable< execution_hint_t >::value,
+		"execution_hint_t is expected to be trivially copyable" );
+
 namespace details {
 
 //
@@ -811,7 +811,7 @@ class special_envelope_t final : public so_5::enveloped_msg::envelope_t
 			outliving_reference_t< details::abstract_scenario_t > scenario,
 			const execution_demand_t & demand )
 			:	m_scenario( scenario )
-			,	m_demand_info( demand.m_receiver, demand.m_msg_type, demand.m_mbox_id )
+			,	m_demand_info( demand.m_receiver, demand.msg_type(), demand.m_mbox_id )
 			,	m_message( demand.m_message_ref )
 			,	m_handled( false )
 			{}
@@ -938,9 +938,9 @@ class special_event_queue_t final : public event_queue_t
 		is_ordinary_demand( const execution_demand_t & demand ) noexcept
 			{
 				return agent_t::get_demand_handler_on_message_ptr() ==
-								demand.m_demand_handler ||
+								demand.demand_handler() ||
 						agent_t::get_demand_handler_on_enveloped_msg_ptr() ==
-								demand.m_demand_handler;
+								demand.demand_handler();
 			}
 
 		void
@@ -981,8 +981,11 @@ class special_event_queue_t final : public event_queue_t
 						};
 
 						demand.m_message_ref = std::move(new_env);
-						demand.m_demand_handler =
-								agent_t::get_demand_handler_on_enveloped_msg_ptr();
+						demand.m_descriptor =
+								so_5::impl::message_demand_descriptor(
+										demand.limit(),
+										demand.msg_type_id(),
+										so_5::impl::message_demand_kind_t::enveloped_msg );
 
 						push_to_queue( std::move(demand) );
 					}
@@ -19,7 +19,9 @@ namespace impl
 
 class mpsc_mbox_t;
 struct event_handler_data_t;
+struct pending_subscriptions_t;
 class delivery_filter_storage_t;
+class event_handler_cache_t;
 class agent_core_t;
 class coop_private_iface_t;
 class internal_env_iface_t;
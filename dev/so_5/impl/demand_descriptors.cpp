@@ -0,0 +1,159 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Descriptors for execution demands with messages.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/impl/demand_descriptors.hpp>
+
+#include <so_5/agent.hpp>
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace
+{
+
+//
+// unlimited_descriptors_t
+//
+/*!
+ * \brief Storage for descriptors of demands without message limits.
+ *
+ * Descriptors are stored in chunks. Every chunk contains descriptors
+ * for chunk_size message types. Chunks are created on demand and
+ * never destroyed. So a descriptor can be found by the identifier
+ * of message type without any locks.
+ */
+class unlimited_descriptors_t
+	{
+	public :
+		unlimited_descriptors_t()
+			{
+				for( auto & c : m_chunks )
+					c.store( nullptr, std::memory_order_relaxed );
+			}
+
+		const demand_descriptor_t *
+		get( message_type_id_t msg_type_id, message_demand_kind_t kind )
+			{
+				const std::size_t chunk_index = msg_type_id / chunk_size;
+				if( chunk_index >= max_chunks )
+					SO_5_THROW_EXCEPTION(
+							rc_too_many_message_types,
+							"too many message types, message type id: " +
+							std::to_string( msg_type_id ) );
+
+				const chunk_t * chunk = m_chunks[ chunk_index ].load(
+						std::memory_order_acquire );
+				if( !chunk )
+					chunk = make_chunk( chunk_index );
+
+				return &( chunk->m_items[
+						( msg_type_id % chunk_size ) * message_demand_kinds_count +
+						static_cast< std::size_t >( kind ) ] );
+			}
+
+	private :
+		static constexpr std::size_t chunk_size = 1024u;
+		static constexpr std::size_t max_chunks = 4096u;
+
+		struct chunk_t
+			{
+				demand_descriptor_t m_items[
+						chunk_size * message_demand_kinds_count ];
+			};
+
+		std::mutex m_lock;
+
+		std::atomic< const chunk_t * > m_chunks[ max_chunks ];
+
+		const chunk_t *
+		make_chunk( std::size_t chunk_index )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				// Chunk can be created by another thread already.
+				const chunk_t * result = m_chunks[ chunk_index ].load(
+						std::memory_order_acquire );
+				if( !result )
+					{
+						std::unique_ptr< chunk_t > chunk{ new chunk_t };
+
+						const auto first_id = chunk_index * chunk_size;
+						for( std::size_t i = 0u; i != chunk_size; ++i )
+							fill_message_demand_descriptors(
+									message_limit::control_block_t::none(),
+									static_cast< message_type_id_t >( first_id + i ),
+									&( chunk->m_items[ i * message_demand_kinds_count ] ) );
+
+						result = chunk.release();
+						m_chunks[ chunk_index ].store(
+								result, std::memory_order_release );
+					}
+
+				return result;
+			}
+	};
+
+//! Access to the storage.
+/*!
+ * \note
+ * The storage is never destroyed because demands can be
+ * handled by threads which are still running at the process shutdown.
+ */
+unlimited_descriptors_t &
+unlimited_descriptors()
+	{
+		static unlimited_descriptors_t * d = new unlimited_descriptors_t();
+		return *d;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void
+fill_message_demand_descriptors(
+	const message_limit::control_block_t * limit,
+	message_type_id_t msg_type_id,
+	demand_descriptor_t * to ) noexcept
+	{
+		to[ static_cast< std::size_t >( message_demand_kind_t::message ) ] =
+				demand_descriptor_t{
+						agent_t::get_demand_handler_on_message_ptr(),
+						limit,
+						msg_type_id };
+
+		to[ static_cast< std::size_t >( message_demand_kind_t::enveloped_msg ) ] =
+				demand_descriptor_t{
+						agent_t::get_demand_handler_on_enveloped_msg_ptr(),
+						limit,
+						msg_type_id };
+	}
+
+SO_5_FUNC const demand_descriptor_t *
+unlimited_message_demand_descriptor(
+	message_type_id_t msg_type_id,
+	message_demand_kind_t kind )
+	{
+		return unlimited_descriptors().get( msg_type_id, kind );
+	}
+
+} /* namespace impl */
+
+} /* namespace so_5 */
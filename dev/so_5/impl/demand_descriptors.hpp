@@ -0,0 +1,105 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Descriptors for execution demands with messages.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/execution_demand.hpp>
+
+#include <cstddef>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// message_demand_kind_t
+//
+/*!
+ * \brief Kind of demand with a message.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class message_demand_kind_t : std::size_t
+	{
+		//! Demand with an ordinary message or signal.
+		message = 0u,
+		//! Demand with an enveloped message.
+		enveloped_msg = 1u
+	};
+
+//! Count of items in message_demand_kind_t.
+/*!
+ * \since
+ * v.5.6.2
+ */
+constexpr std::size_t message_demand_kinds_count = 2u;
+
+/*!
+ * \brief Fill descriptors for all kinds of demands with a message.
+ *
+ * \a to must point to an array of message_demand_kinds_count items.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC void
+fill_message_demand_descriptors(
+	const message_limit::control_block_t * limit,
+	message_type_id_t msg_type_id,
+	demand_descriptor_t * to ) noexcept;
+
+/*!
+ * \brief Get a process-wide descriptor for a demand with a message
+ * without message limit.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC const demand_descriptor_t *
+unlimited_message_demand_descriptor(
+	message_type_id_t msg_type_id,
+	message_demand_kind_t kind );
+
+/*!
+ * \brief Get a descriptor for a demand with a message.
+ *
+ * If \a limit is not null and has descriptors then the descriptor is
+ * taken from the control block. Otherwise a process-wide descriptor for
+ * \a msg_type_id is used.
+ *
+ * \note
+ * Only agents fill descriptors in their control blocks. A control
+ * block can be without descriptors if it is created outside of an agent
+ * or is a copy of another block.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline const demand_descriptor_t *
+message_demand_descriptor(
+	const message_limit::control_block_t * limit,
+	message_type_id_t msg_type_id,
+	message_demand_kind_t kind )
+	{
+		if( limit && limit->m_demand_descriptors )
+			return &(limit->m_demand_descriptors[
+					static_cast< std::size_t >( kind ) ]);
+
+		return unlimited_message_demand_descriptor( msg_type_id, kind );
+	}
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -15,6 +15,7 @@
 #include <so_5/agent.hpp>
 
 #include <so_5/impl/subscription_storage_iface.hpp>
+#include <so_5/impl/demand_descriptors.hpp>
 
 #include <so_5/details/abort_on_fatal_error.hpp>
 
@@ -101,13 +102,14 @@ class agent_demand_handler_invoker_t : public handler_invoker_t
 
 				execution_demand_t fresh_demand{
 						m_demand.m_receiver,
-						m_demand.m_limit,
-						m_demand.m_mbox_id,
-						m_demand.m_msg_type,
-						payload.message(),
 						// May be it is not necessary at all but it
 						// is better to have properly constructed demand.
-						demand_handler_for_invocation_type( msg_kind )
+						so_5::impl::message_demand_descriptor(
+								m_demand.limit(),
+								m_demand.msg_type_id(),
+								demand_kind_for_invocation_type( msg_kind ) ),
+						m_demand.m_mbox_id,
+						payload.message()
 				};
 
 				switch( msg_kind )
@@ -132,24 +134,24 @@ class agent_demand_handler_invoker_t : public handler_invoker_t
 
 	private:
 		/*!
-		 * Returns appropriate pointer to demand handler in dependency
+		 * Returns appropriate kind of demand in dependency
 		 * on invocation type for that demand.
 		 */
-		static demand_handler_pfn_t
-		demand_handler_for_invocation_type(
+		static so_5::impl::message_demand_kind_t
+		demand_kind_for_invocation_type(
 			message_t::kind_t msg_kind ) noexcept
 			{
-				demand_handler_pfn_t result = nullptr;
+				auto result = so_5::impl::message_demand_kind_t::message;
 				switch( msg_kind )
 					{
 					case message_t::kind_t::signal : [[fallthrough]];
 					case message_t::kind_t::classical_message : [[fallthrough]];
 					case message_t::kind_t::user_type_message :
-						result = &agent_t::demand_handler_on_message;
+						result = so_5::impl::message_demand_kind_t::message;
 					break;
 
 					case message_t::kind_t::enveloped_msg :
-						result = &agent_t::demand_handler_on_enveloped_msg;
+						result = so_5::impl::message_demand_kind_t::enveloped_msg;
 					break;
 					}
 				return result;
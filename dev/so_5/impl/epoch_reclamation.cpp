@@ -0,0 +1,265 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Epoch-based reclamation of objects shared between threads.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/impl/epoch_reclamation.hpp>
+
+#include <atomic>
+#include <limits>
+#include <thread>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace epoch_reclamation
+{
+
+namespace
+{
+
+//! Value of a thread slot when the thread isn't a reader.
+constexpr epoch_t inactive = 0u;
+
+//
+// thread_record_t
+//
+/*!
+ * \brief A slot with the epoch published by a reader thread.
+ *
+ * Records are never deleted. When a thread finishes its work
+ * the record is released and can be reused by another thread.
+ */
+struct alignas(64) thread_record_t
+	{
+		//! Epoch published by the owner or inactive.
+		std::atomic< epoch_t > m_epoch{ inactive };
+
+		//! Is this record owned by some thread?
+		std::atomic< bool > m_in_use{ true };
+
+		//! Next record in the registry.
+		thread_record_t * m_next{ nullptr };
+	};
+
+//
+// registry_t
+//
+/*!
+ * \brief The global epoch and the list of all thread records.
+ */
+struct registry_t
+	{
+		//! The global epoch.
+		/*!
+		 * Starts from 1 because 0 is reserved for inactive slots.
+		 */
+		alignas(64) std::atomic< epoch_t > m_epoch{ 1u };
+
+		//! Head of append-only list of thread records.
+		alignas(64) std::atomic< thread_record_t * > m_head{ nullptr };
+
+		thread_record_t *
+		acquire_record()
+			{
+				// Try to reuse a free record first.
+				for( auto * r = m_head.load( std::memory_order_acquire );
+						r; r = r->m_next )
+					{
+						bool expected = false;
+						if( r->m_in_use.compare_exchange_strong(
+								expected, true, std::memory_order_acquire ) )
+							return r;
+					}
+
+				auto * r = new thread_record_t();
+				r->m_next = m_head.load( std::memory_order_relaxed );
+				while( !m_head.compare_exchange_weak(
+						r->m_next, r,
+						std::memory_order_release,
+						std::memory_order_relaxed ) )
+					{}
+
+				return r;
+			}
+	};
+
+//! Access to the registry.
+/*!
+ * \note
+ * The registry is never destroyed because threads which are still
+ * running at the process shutdown can use it.
+ */
+registry_t &
+registry()
+	{
+		static registry_t * r = new registry_t();
+		return *r;
+	}
+
+//! State of reader's slot for the current thread.
+enum class slot_state_t : unsigned char
+	{
+		not_created,
+		alive,
+		destroyed
+	};
+
+} /* namespace anonymous */
+
+//
+// reader_slot_t
+//
+/*!
+ * \brief Thread-local part of reader's state.
+ *
+ * It is a trivially destructible object. So access to it doesn't
+ * require any checks of thread-local object initialization and
+ * it can be safely used during the destruction of other thread-local
+ * objects.
+ */
+struct reader_slot_t
+	{
+		//! Record of the current thread in the registry.
+		thread_record_t * m_record;
+
+		//! Nesting level of enter() calls.
+		unsigned int m_nesting;
+
+		//! State of the slot.
+		slot_state_t m_state;
+	};
+
+namespace
+{
+
+thread_local reader_slot_t g_slot{
+		nullptr, 0u, slot_state_t::not_created };
+
+//
+// slot_releaser_t
+//
+/*!
+ * \brief A helper for releasing thread's record at the thread exit.
+ *
+ * It is created only once for a thread at the first call to enter().
+ */
+struct slot_releaser_t
+	{
+		slot_releaser_t() noexcept
+			{
+				g_slot.m_state = slot_state_t::alive;
+			}
+
+		~slot_releaser_t() noexcept
+			{
+				g_slot.m_state = slot_state_t::destroyed;
+
+				g_slot.m_record->m_epoch.store(
+						inactive, std::memory_order_release );
+				g_slot.m_record->m_in_use.store(
+						false, std::memory_order_release );
+			}
+	};
+
+//! Bind a record from the registry to the current thread.
+/*!
+ * \return false if the record can't be bound.
+ */
+bool
+bind_record_to_current_thread() noexcept
+	{
+		if( slot_state_t::not_created != g_slot.m_state )
+			return false;
+
+		try
+			{
+				g_slot.m_record = registry().acquire_record();
+
+				static thread_local slot_releaser_t releaser;
+				(void)releaser;
+
+				return true;
+			}
+		catch( ... )
+			{
+				return false;
+			}
+	}
+
+} /* namespace anonymous */
+
+reader_slot_t *
+enter() noexcept
+	{
+		auto & slot = g_slot;
+		if( slot_state_t::alive != slot.m_state &&
+				!bind_record_to_current_thread() )
+			return nullptr;
+
+		if( 0u == slot.m_nesting++ )
+			slot.m_record->m_epoch.store(
+					registry().m_epoch.load( std::memory_order_seq_cst ),
+					std::memory_order_seq_cst );
+
+		return &slot;
+	}
+
+void
+leave( reader_slot_t & slot ) noexcept
+	{
+		if( 0u == --slot.m_nesting )
+			slot.m_record->m_epoch.store( inactive, std::memory_order_release );
+	}
+
+bool
+is_current_thread_reader() noexcept
+	{
+		return 0u != g_slot.m_nesting;
+	}
+
+epoch_t
+retire() noexcept
+	{
+		// Readers started after that point will publish a greater epoch.
+		return registry().m_epoch.fetch_add( 1u, std::memory_order_seq_cst );
+	}
+
+epoch_t
+oldest_reader_epoch() noexcept
+	{
+		auto result = std::numeric_limits< epoch_t >::max();
+
+		for( auto * t = registry().m_head.load( std::memory_order_acquire );
+				t; t = t->m_next )
+			{
+				const auto e = t->m_epoch.load( std::memory_order_seq_cst );
+				if( inactive != e && e < result )
+					result = e;
+			}
+
+		return result;
+	}
+
+void
+wait_for_readers( epoch_t retired_at ) noexcept
+	{
+		while( oldest_reader_epoch() <= retired_at )
+			std::this_thread::yield();
+	}
+
+} /* namespace epoch_reclamation */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
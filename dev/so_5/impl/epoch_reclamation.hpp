@@ -0,0 +1,164 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Epoch-based reclamation of objects shared between threads.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace epoch_reclamation
+{
+
+/*!
+ * \brief Type of epoch counter.
+ *
+ * \since
+ * v.5.6.2
+ */
+using epoch_t = std::uint64_t;
+
+/*!
+ * \brief Reader's state of a thread.
+ *
+ * It is an opaque type. The definition isn't available for users.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct reader_slot_t;
+
+/*!
+ * \brief Mark the current thread as a reader of shared objects.
+ *
+ * The current value of the global epoch is published in a slot
+ * owned by the current thread. synchronize() will wait until leave()
+ * is called.
+ *
+ * Calls can be nested. Only the outermost call publishes the epoch.
+ *
+ * \return the slot of the current thread. It must be passed to leave().
+ * Value nullptr means that it is impossible to register the current
+ * thread (it can happen at the thread shutdown when thread-local
+ * objects are already destroyed). leave() must not be called in
+ * that case.
+ *
+ * \since
+ * v.5.6.2
+ */
+reader_slot_t *
+enter() noexcept;
+
+/*!
+ * \brief Unmark the current thread as a reader of shared objects.
+ *
+ * \since
+ * v.5.6.2
+ */
+void
+leave( reader_slot_t & slot ) noexcept;
+
+/*!
+ * \brief Is the current thread marked as a reader?
+ *
+ * \since
+ * v.5.6.2
+ */
+bool
+is_current_thread_reader() noexcept;
+
+/*!
+ * \brief Start a new epoch.
+ *
+ * Must be called after a shared object is removed from its owner.
+ * Readers which start after the call can't see the removed object.
+ *
+ * \return the epoch in which the object was retired. The object can
+ * be destroyed when oldest_reader_epoch() becomes greater than
+ * that value.
+ *
+ * \since
+ * v.5.6.2
+ */
+epoch_t
+retire() noexcept;
+
+/*!
+ * \brief Get the oldest epoch published by active readers.
+ *
+ * It doesn't block.
+ *
+ * \return std::numeric_limits<epoch_t>::max() if there are no
+ * active readers.
+ *
+ * \since
+ * v.5.6.2
+ */
+epoch_t
+oldest_reader_epoch() noexcept;
+
+/*!
+ * \brief Wait for the completion of readers which can see objects
+ * retired at \a retired_at epoch.
+ *
+ * \attention
+ * Must not be called by a thread marked as a reader. Must not be
+ * called under a lock which can be acquired by readers.
+ *
+ * \since
+ * v.5.6.2
+ */
+void
+wait_for_readers( epoch_t retired_at ) noexcept;
+
+//
+// read_guard_t
+//
+/*!
+ * \brief A helper for calling enter() and leave() in RAII style.
+ *
+ * \since
+ * v.5.6.2
+ */
+class read_guard_t
+	{
+	public :
+		read_guard_t( const read_guard_t & ) = delete;
+		read_guard_t & operator=( const read_guard_t & ) = delete;
+
+		read_guard_t() noexcept
+			:	m_slot{ enter() }
+			{}
+
+		~read_guard_t() noexcept
+			{
+				if( m_slot )
+					leave( *m_slot );
+			}
+
+		//! Is the current thread registered as a reader?
+		bool
+		entered() const noexcept { return nullptr != m_slot; }
+
+	private :
+		reader_slot_t * const m_slot;
+	};
+
+} /* namespace epoch_reclamation */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
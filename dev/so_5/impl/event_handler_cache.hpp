@@ -0,0 +1,141 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \file
+ * \brief A cache for results of event handler searches.
+ */
+
+#pragma once
+
+#include <so_5/types.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <so_5/fwd.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace so_5 {
+
+namespace impl {
+
+//
+// event_handler_cache_t
+//
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A cache for results of event handler searches.
+ *
+ * The search of an event handler for hierarchical states requires
+ * a lookup in the subscription storage for every state from the current
+ * one up to the root. And then an additional lookup for a deadletter
+ * handler if there is no handler in those states.
+ *
+ * This cache holds the final result of such search for
+ * (mbox_id, msg_type_id, current state) tuples. Negative results are
+ * stored too.
+ *
+ * It is a direct-mapped cache: a new result replaces an old one
+ * with the same position in the cache.
+ *
+ * \attention
+ * The cache must be cleared on every change of agent's subscriptions.
+ * It isn't thread safe and should be used only on agent's working thread.
+ */
+class event_handler_cache_t
+	{
+	public :
+		//! Result of a search.
+		struct entry_t
+			{
+				mbox_id_t m_mbox_id;
+				//! State for which the search was performed.
+				/*!
+				 * It is nullptr for an empty entry.
+				 */
+				const state_t * m_state;
+				//! Handler found.
+				/*!
+				 * It is nullptr if there is no handler at all.
+				 */
+				const event_handler_data_t * m_handler;
+				message_type_id_t m_msg_type_id;
+				//! Is m_handler a deadletter handler?
+				bool m_is_deadletter;
+			};
+
+		//! Find a result of a previous search.
+		/*!
+		 * \return nullptr if there is no such result in the cache.
+		 */
+		const entry_t *
+		find(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) const noexcept
+			{
+				const auto & e = m_entries[ index_of( mbox_id, msg_type_id, state ) ];
+				if( e.m_state == state &&
+						e.m_msg_type_id == msg_type_id &&
+						e.m_mbox_id == mbox_id )
+					return &e;
+				return nullptr;
+			}
+
+		//! Store a result of a search.
+		void
+		store(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			const event_handler_data_t * handler,
+			bool is_deadletter ) noexcept
+			{
+				m_entries[ index_of( mbox_id, msg_type_id, state ) ] = entry_t{
+						mbox_id, state, handler, msg_type_id, is_deadletter };
+			}
+
+		//! Remove all results.
+		void
+		clear() noexcept
+			{
+				m_entries.fill( entry_t{} );
+			}
+
+	private :
+		//! Count of entries in the cache as a power of two.
+		static constexpr unsigned int capacity_bits = 5u;
+
+		//! Count of entries in the cache.
+		static constexpr std::size_t capacity =
+				std::size_t{ 1u } << capacity_bits;
+
+		std::array< entry_t, capacity > m_entries{};
+
+		static std::size_t
+		index_of(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) noexcept
+			{
+				const std::uint64_t h =
+						( mbox_id * 0x9e3779b97f4a7c15ull ) ^
+						( static_cast< std::uint64_t >( msg_type_id ) *
+								0xc2b2ae3d27d4eb4full ) ^
+						static_cast< std::uint64_t >(
+								reinterpret_cast< std::uintptr_t >( state ) );
+				return static_cast< std::size_t >(
+						( h * 0x165667b19e3779f9ull ) >> ( 64u - capacity_bits ) );
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
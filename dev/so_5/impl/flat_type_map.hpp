@@ -0,0 +1,253 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief A flat hash table with the identifier of message type as a key.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/message_type_id.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// flat_type_map_t
+//
+/*!
+ * \brief A flat hash table with the identifier of message type as a key.
+ *
+ * It is intended to be used as a replacement for
+ * std::map<std::type_index, Value> in places where a lookup is
+ * performed much more often than a modification.
+ *
+ * Values are stored in a dense vector. An index for that vector is
+ * an open-addressing table with linear probing. Every slot of the
+ * index holds an identifier of message type and a position of the value
+ * in the dense vector. Identifiers are dense, so they are used as
+ * hash values as is and a lookup usually reads just one 8-byte slot.
+ *
+ * The load factor of the index doesn't exceed 1/2. There are no
+ * tombstones: the index is compacted by backward shifting on erase.
+ *
+ * \note
+ * The order of items isn't specified and can be changed by erase().
+ * Iterators and references are invalidated by any modification.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Value >
+class flat_type_map_t
+	{
+	public :
+		//! Type of stored item.
+		/*!
+		 * Names of fields are the same as for std::map's value_type.
+		 */
+		struct value_type
+			{
+				message_type_id_t first;
+				Value second;
+
+				value_type( message_type_id_t key, Value && value )
+					:	first{ key }
+					,	second{ std::move(value) }
+					{}
+			};
+
+		using iterator = value_type *;
+		using const_iterator = const value_type *;
+
+		iterator
+		begin() noexcept { return m_items.data(); }
+
+		iterator
+		end() noexcept { return m_items.data() + m_items.size(); }
+
+		const_iterator
+		begin() const noexcept { return m_items.data(); }
+
+		const_iterator
+		end() const noexcept { return m_items.data() + m_items.size(); }
+
+		std::size_t
+		size() const noexcept { return m_items.size(); }
+
+		bool
+		empty() const noexcept { return m_items.empty(); }
+
+		const_iterator
+		find( message_type_id_t key ) const noexcept
+			{
+				if( m_items.empty() )
+					return end();
+
+				const auto & s = m_slots[ find_slot( key ) ];
+				return empty_slot == s.m_item ? end() : &m_items[ s.m_item ];
+			}
+
+		iterator
+		find( message_type_id_t key ) noexcept
+			{
+				const auto & self = *this;
+				return const_cast< iterator >( self.find( key ) );
+			}
+
+		//! Insert a new item if there is no item with the same key.
+		/*!
+		 * \return a pair of iterator to the item with \a key and
+		 * a flag which is true if a new item has been inserted.
+		 */
+		std::pair< iterator, bool >
+		emplace( message_type_id_t key, Value && value )
+			{
+				{
+					auto it = find( key );
+					if( it != end() )
+						return { it, false };
+				}
+
+				// All actions which can throw are performed before
+				// any changes in the index.
+				if( ( m_items.size() + 1u ) * 2u > m_slots.size() )
+					rehash( m_slots.empty() ? min_capacity : m_slots.size() * 2u );
+
+				m_items.emplace_back( key, std::move(value) );
+
+				const auto position = m_items.size() - 1u;
+				m_slots[ find_slot( key ) ] = slot_t{
+						key, static_cast< std::uint32_t >( position ) };
+
+				return { &m_items[ position ], true };
+			}
+
+		//! Remove an item.
+		void
+		erase( const_iterator it ) noexcept
+			{
+				const auto position = static_cast< std::uint32_t >(
+						it - m_items.data() );
+
+				remove_slot( find_slot( it->first ) );
+
+				const auto last = static_cast< std::uint32_t >(
+						m_items.size() - 1u );
+				if( position != last )
+					{
+						// The last item is moved to the freed place.
+						auto & moved = m_items[ last ];
+						m_slots[ find_slot( moved.first ) ].m_item = position;
+
+						m_items[ position ].first = moved.first;
+						m_items[ position ].second = std::move(moved.second);
+					}
+
+				m_items.pop_back();
+			}
+
+	private :
+		//! Position of the item in a slot of the index.
+		struct slot_t
+			{
+				//! Identifier of message type.
+				message_type_id_t m_key;
+				//! Index in m_items or empty_slot.
+				std::uint32_t m_item;
+			};
+
+		//! Mark of an empty slot.
+		static constexpr std::uint32_t empty_slot =
+				std::numeric_limits< std::uint32_t >::max();
+
+		//! Minimal size of the index.
+		static constexpr std::size_t min_capacity = 8u;
+
+		//! The index.
+		/*!
+		 * Its size is always a power of two.
+		 */
+		std::vector< slot_t > m_slots;
+
+		//! Stored items.
+		std::vector< value_type > m_items;
+
+		std::size_t
+		mask() const noexcept { return m_slots.size() - 1u; }
+
+		//! Find the slot with the key or the empty slot for that key.
+		/*!
+		 * \attention
+		 * The index must not be empty.
+		 */
+		std::size_t
+		find_slot( message_type_id_t key ) const noexcept
+			{
+				for( std::size_t i = key & mask(); ; i = ( i + 1u ) & mask() )
+					{
+						const auto & s = m_slots[ i ];
+						if( empty_slot == s.m_item || key == s.m_key )
+							return i;
+					}
+			}
+
+		//! Make the slot empty and shift the following slots back.
+		void
+		remove_slot( std::size_t hole ) noexcept
+			{
+				for( auto i = ( hole + 1u ) & mask();
+						empty_slot != m_slots[ i ].m_item;
+						i = ( i + 1u ) & mask() )
+					{
+						// The item can be moved to the hole only if its
+						// preferred slot isn't between the hole and the item.
+						const std::size_t preferred = m_slots[ i ].m_key & mask();
+						if( ( ( i - preferred ) & mask() ) >= ( ( i - hole ) & mask() ) )
+							{
+								m_slots[ hole ] = m_slots[ i ];
+								hole = i;
+							}
+					}
+
+				m_slots[ hole ].m_item = empty_slot;
+			}
+
+		void
+		rehash( std::size_t capacity )
+			{
+				std::vector< slot_t > slots(
+						capacity, slot_t{ null_message_type_id, empty_slot } );
+				m_items.reserve( capacity / 2u );
+
+				const auto new_mask = capacity - 1u;
+				for( const auto & s : m_slots )
+					if( empty_slot != s.m_item )
+						{
+							std::size_t i = s.m_key & new_mask;
+							while( empty_slot != slots[ i ].m_item )
+								i = ( i + 1u ) & new_mask;
+							slots[ i ] = s;
+						}
+
+				m_slots.swap( slots );
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <so_5/types.hpp>
@@ -26,6 +30,10 @@
 #include <so_5/impl/agent_ptr_compare.hpp>
 #include <so_5/impl/message_limit_internals.hpp>
 #include <so_5/impl/msg_tracing_helpers.hpp>
+#include <so_5/impl/epoch_reclamation.hpp>
+#include <so_5/impl/flat_type_map.hpp>
+
+#include <so_5/details/rollback_on_exception.hpp>
 
 namespace so_5
 {
@@ -685,6 +693,249 @@ public :
 // data_t
 //
 
+/*!
+ * \since
+ * v.5.4.0
+ *
+ * \brief Map from message type to subscribers.
+ *
+ * \note
+ * Since v.5.6.2 it is a flat hash table instead of std::map.
+ * A broadcast mbox can have dozens of message types and the lookup
+ * is performed on every delivery.
+ */
+using messages_table_t = flat_type_map_t<
+		subscriber_adaptive_container_t >;
+
+//
+// rw_locked_subscribers_t
+//
+/*!
+ * \brief Storage of subscribers protected by a reader-writer spinlock.
+ *
+ * It is the default storage for local mboxes.
+ *
+ * \since
+ * v.5.6.2
+ */
+class rw_locked_subscribers_t
+	{
+	public :
+		//! Modify the table of subscribers.
+		/*!
+		 * \a lambda is called with an exclusive lock.
+		 */
+		template< typename Lambda >
+		void
+		modify( Lambda && lambda )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+
+				lambda( m_subscribers );
+			}
+
+		//! Access to the table of subscribers for message delivery.
+		/*!
+		 * \a lambda is called with a shared lock.
+		 */
+		template< typename Lambda >
+		void
+		read( Lambda && lambda )
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+
+				lambda( m_subscribers );
+			}
+
+	private :
+		//! Object lock.
+		default_rw_spinlock_t m_lock;
+
+		//! Map of subscribers to messages.
+		messages_table_t m_subscribers;
+	};
+
+//
+// cow_subscribers_t
+//
+/*!
+ * \brief Storage of subscribers in form of immutable snapshots.
+ *
+ * The current table of subscribers is never modified. A modification
+ * creates a copy of the current table, changes the copy and publishes
+ * it instead of the current one.
+ *
+ * A reader doesn't acquire any lock. The only write it does is
+ * the publishing of the current epoch in a slot owned by the reader's
+ * thread. So there is no contention between threads which send
+ * messages to the same mbox.
+ *
+ * A modification waits until all readers which can use the old table
+ * are finished. It guarantees that an unsubscribed agent or a dropped
+ * delivery filter won't be used after the return from the modification.
+ * The waiting is done without holding the modification lock. So a reader
+ * which modifies the same mbox (from a delivery filter, for example)
+ * can't be blocked by a modification in progress.
+ *
+ * Old tables are destroyed lazily: a table is destroyed by the next
+ * modification or delivery when there are no readers which can use it.
+ *
+ * The price is the cost of modifications: every subscription or
+ * unsubscription copies the whole table of subscribers and waits for
+ * the completion of deliveries in progress.
+ *
+ * \since
+ * v.5.6.2
+ */
+class cow_subscribers_t
+	{
+	public :
+		cow_subscribers_t()
+			:	m_current{ new messages_table_t() }
+			{}
+
+		cow_subscribers_t( const cow_subscribers_t & ) = delete;
+		cow_subscribers_t &
+		operator=( const cow_subscribers_t & ) = delete;
+
+		~cow_subscribers_t()
+			{
+				// There can't be any readers at this point.
+				delete m_current.load( std::memory_order_acquire );
+			}
+
+		//! Modify the table of subscribers.
+		/*!
+		 * \a lambda is called for a copy of the current table.
+		 * The copy becomes the current table if \a lambda doesn't throw.
+		 */
+		template< typename Lambda >
+		void
+		modify( Lambda && lambda )
+			{
+				epoch_reclamation::epoch_t retired_at;
+				{
+					std::lock_guard< std::mutex > lock( m_modification_lock );
+
+					reclaim_retired();
+
+					std::unique_ptr< messages_table_t > updated{
+							new messages_table_t(
+									*(m_current.load( std::memory_order_relaxed )) ) };
+
+					lambda( *updated );
+
+					// The place for the old table must be reserved before
+					// the replacement because the old table can't be
+					// destroyed right now.
+					m_retired.reserve( m_retired.size() + 1u );
+
+					std::unique_ptr< const messages_table_t > old{
+							m_current.exchange(
+									updated.release(), std::memory_order_seq_cst ) };
+
+					retired_at = epoch_reclamation::retire();
+					m_retired.push_back( retired_table_t{ retired_at, std::move(old) } );
+					m_has_retired.store( true, std::memory_order_relaxed );
+				}
+
+				// If the modification is initiated inside a delivery
+				// (from a delivery filter, for example) then the old table
+				// can be in use by the current thread. So there is no
+				// waiting in that case.
+				if( !epoch_reclamation::is_current_thread_reader() )
+					epoch_reclamation::wait_for_readers( retired_at );
+			}
+
+		//! Access to the table of subscribers for message delivery.
+		template< typename Lambda >
+		void
+		read( Lambda && lambda )
+			{
+				{
+					epoch_reclamation::read_guard_t guard;
+
+					if( guard.entered() )
+						lambda( *(m_current.load( std::memory_order_seq_cst )) );
+					else
+						{
+							// Epoch can't be published by the current thread.
+							// So the current table can be destroyed at any time
+							// and a copy of it is used. The lambda is called
+							// without the modification lock because it can
+							// modify the subscribers or deliver to this mbox.
+							std::unique_ptr< const messages_table_t > snapshot;
+							{
+								std::lock_guard< std::mutex > lock( m_modification_lock );
+								snapshot.reset( new messages_table_t(
+										*(m_current.load( std::memory_order_acquire )) ) );
+							}
+
+							lambda( *snapshot );
+						}
+				}
+
+				// A reader never waits for the modification lock.
+				if( m_has_retired.load( std::memory_order_relaxed ) )
+					{
+						std::unique_lock< std::mutex > lock(
+								m_modification_lock, std::try_to_lock );
+						if( lock.owns_lock() )
+							reclaim_retired();
+					}
+			}
+
+	private :
+		//! An old table with the epoch of its replacement.
+		struct retired_table_t
+			{
+				epoch_reclamation::epoch_t m_epoch;
+				std::unique_ptr< const messages_table_t > m_table;
+			};
+
+		//! The current table.
+		std::atomic< const messages_table_t * > m_current;
+
+		//! Lock for modification of the table.
+		std::mutex m_modification_lock;
+
+		//! Old tables those can still be used by some readers.
+		/*!
+		 * \note
+		 * Protected by m_modification_lock.
+		 */
+		std::vector< retired_table_t > m_retired;
+
+		//! Are there old tables to be destroyed?
+		/*!
+		 * Allows a reader to check m_retired without the lock.
+		 */
+		std::atomic< bool > m_has_retired{ false };
+
+		//! Destroy old tables which can't be used by readers anymore.
+		/*!
+		 * \note
+		 * Must be called under m_modification_lock.
+		 */
+		void
+		reclaim_retired() noexcept
+			{
+				if( m_retired.empty() )
+					return;
+
+				// Tables are retired in ascending order of epochs.
+				const auto oldest = epoch_reclamation::oldest_reader_epoch();
+				const auto it = std::find_if(
+						m_retired.begin(), m_retired.end(),
+						[oldest]( const retired_table_t & t ) {
+							return t.m_epoch >= oldest;
+						} );
+				m_retired.erase( m_retired.begin(), it );
+
+				m_has_retired.store( !m_retired.empty(), std::memory_order_relaxed );
+			}
+	};
+
 /*!
  * \since
  * v.5.5.9
@@ -703,22 +954,6 @@ struct data_t
 
 		//! Environment for which the mbox is created.
 		environment_t & m_env;
-
-		//! Object lock.
-		default_rw_spinlock_t m_lock;
-
-		/*!
-		 * \since
-		 * v.5.4.0
-		 *
-		 * \brief Map from message type to subscribers.
-		 */
-		using messages_table_t = std::map<
-				std::type_index,
-				subscriber_adaptive_container_t >;
-
-		//! Map of subscribers to messages.
-		messages_table_t m_subscribers;
 	};
 
 } /* namespace local_mbox_details */
@@ -734,8 +969,12 @@ struct data_t
  *
  * \tparam Tracing_Base base class with implementation of message
  * delivery tracing methods.
+ *
+ * \tparam Subscribers_Storage type of storage for the table of
+ * subscribers. Can be local_mbox_details::rw_locked_subscribers_t or
+ * local_mbox_details::cow_subscribers_t (since v.5.6.2).
  */
-template< typename Tracing_Base >
+template< typename Tracing_Base, typename Subscribers_Storage >
 class local_mbox_template
 	:	public abstract_message_box_t
 	,	private local_mbox_details::data_t
@@ -791,6 +1030,59 @@ class local_mbox_template
 						} );
 			}
 
+		void
+		subscribe_event_handlers(
+			const mbox_subscription_info_t * subscriptions,
+			std::size_t count,
+			agent_t & subscriber ) override
+			{
+				auto drop_limit = []( local_mbox_details::subscriber_info_t & info ) {
+					info.drop_limit();
+				};
+
+				// The table of subscribers is modified only once.
+				m_subscribers.modify(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						std::size_t subscribed = 0u;
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								for( ; subscribed != count; ++subscribed )
+								{
+									const auto & s = subscriptions[ subscribed ];
+									auto maker = [&] {
+										return local_mbox_details::subscriber_info_t{
+												&subscriber, s.m_limit };
+									};
+									auto changer = [&](
+											local_mbox_details::subscriber_info_t & info ) {
+										info.set_limit( s.m_limit );
+									};
+
+									insert_or_modify_subscriber_in_table(
+											subscribers,
+											message_type_id( s.m_msg_type ),
+											&subscriber,
+											maker,
+											changer );
+								}
+							},
+							[&] {
+								// Modifications can be made in the current table.
+								// They must be reverted.
+								while( subscribed )
+								{
+									--subscribed;
+									modify_and_remove_subscriber_in_table_if_needed(
+											subscribers,
+											message_type_id(
+													subscriptions[ subscribed ].m_msg_type ),
+											&subscriber,
+											drop_limit );
+								}
+							} );
+					} );
+			}
+
 		std::string
 		query_name() const override
 			{
@@ -827,6 +1119,23 @@ class local_mbox_template
 						overlimit_reaction_deep );
 			}
 
+		void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) override
+			{
+				for( std::size_t i = 0u; i != count; ++i )
+					ensure_immutable_message( msg_type, messages[ i ] );
+
+				do_deliver_messages_impl(
+						msg_type,
+						messages,
+						count,
+						overlimit_reaction_deep );
+			}
+
 		void
 		set_delivery_filter(
 			const std::type_index & msg_type,
@@ -865,6 +1174,13 @@ class local_mbox_template
 			}
 
 	private :
+		//! Table of subscribers.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		Subscribers_Storage m_subscribers;
+
 		template< typename Info_Maker, typename Info_Changer >
 		void
 		insert_or_modify_subscriber(
@@ -873,16 +1189,55 @@ class local_mbox_template
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+				const auto msg_type_id = message_type_id( type_wrapper );
+
+				m_subscribers.modify(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						insert_or_modify_subscriber_in_table(
+								subscribers,
+								msg_type_id,
+								subscriber,
+								maker,
+								changer );
+					} );
+			}
+
+		template< typename Info_Changer >
+		void
+		modify_and_remove_subscriber_if_needed(
+			const std::type_index & type_wrapper,
+			agent_t * subscriber,
+			Info_Changer changer )
+			{
+				const auto msg_type_id = message_type_id( type_wrapper );
+
+				m_subscribers.modify(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						modify_and_remove_subscriber_in_table_if_needed(
+								subscribers,
+								msg_type_id,
+								subscriber,
+								changer );
+					} );
+			}
 
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
+		template< typename Info_Maker, typename Info_Changer >
+		static void
+		insert_or_modify_subscriber_in_table(
+			local_mbox_details::messages_table_t & subscribers,
+			message_type_id_t msg_type_id,
+			agent_t * subscriber,
+			Info_Maker & maker,
+			Info_Changer & changer )
+			{
+				auto it = subscribers.find( msg_type_id );
+				if( it == subscribers.end() )
 				{
 					// There isn't such message type yet.
 					local_mbox_details::subscriber_adaptive_container_t container;
 					container.insert( maker() );
 
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
+					subscribers.emplace( msg_type_id, std::move( container ) );
 				}
 				else
 				{
@@ -903,16 +1258,15 @@ class local_mbox_template
 			}
 
 		template< typename Info_Changer >
-		void
-		modify_and_remove_subscriber_if_needed(
-			const std::type_index & type_wrapper,
+		static void
+		modify_and_remove_subscriber_in_table_if_needed(
+			local_mbox_details::messages_table_t & subscribers,
+			message_type_id_t msg_type_id,
 			agent_t * subscriber,
-			Info_Changer changer )
+			Info_Changer & changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
+				auto it = subscribers.find( msg_type_id );
+				if( it != subscribers.end() )
 				{
 					auto & agents = it->second;
 
@@ -922,14 +1276,14 @@ class local_mbox_template
 						// Subscriber is found and must be modified.
 						changer( *pos );
 
-						// If info about subscriber becomes empty after modification
-						// then subscriber info must be removed.
+						// If info about subscriber becomes empty after
+						// modification then subscriber info must be removed.
 						if( pos->empty() )
 							agents.erase( pos );
 					}
 
 					if( agents.empty() )
-						m_subscribers.erase( it );
+						subscribers.erase( it );
 				}
 			}
 
@@ -940,21 +1294,175 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep )
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+				const auto msg_type_id = message_type_id( msg_type );
+
+				m_subscribers.read(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( msg_type_id );
+						if( it != subscribers.end() )
+							{
+								for( const auto & a : it->second )
+									do_deliver_message_to_subscriber(
+											a,
+											tracer,
+											msg_type,
+											msg_type_id,
+											message,
+											overlimit_reaction_deep );
+							}
+						else
+							tracer.no_subscribers();
+					} );
+			}
 
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
-					{
-						for( const auto & a : it->second )
-							do_deliver_message_to_subscriber(
-									a,
-									tracer,
+		/*!
+		 * \brief Delivery of a batch of messages.
+		 *
+		 * The table of subscribers is accessed only once.
+		 * Messages accepted by delivery filters and message limits
+		 * of a subscriber are pushed to its event queue at once.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		do_deliver_messages_impl(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep )
+			{
+				const auto msg_type_id = message_type_id( msg_type );
+
+				m_subscribers.read(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( msg_type_id );
+						if( it != subscribers.end() )
+							do_deliver_messages_to_subscribers(
+									it->second,
 									msg_type,
-									message,
+									msg_type_id,
+									messages,
+									count,
 									overlimit_reaction_deep );
+						else
+							for( std::size_t i = 0u; i != count; ++i )
+								typename Tracing_Base::deliver_op_tracer{
+										*this, *this, "deliver_message",
+										msg_type, messages[ i ], overlimit_reaction_deep
+									}.no_subscribers();
+					} );
+			}
+
+		/*!
+		 * \brief Delivery of a batch of messages to every subscriber.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		do_deliver_messages_to_subscribers(
+			const local_mbox_details::subscriber_adaptive_container_t & subscribers,
+			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep )
+			{
+				using tracer_t = typename Tracing_Base::deliver_op_tracer;
+
+				// Messages to be pushed to the current subscriber.
+				std::vector< message_ref_t > accepted;
+				accepted.reserve( count );
+
+				for( const auto & a : subscribers )
+					{
+						accepted.clear();
+
+						// Overlimit reactions can throw. Limit counters of
+						// already accepted messages must be restored in that case.
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								for( std::size_t i = 0u; i != count; ++i )
+									{
+										const tracer_t tracer{ *this, *this,
+												"deliver_message",
+												msg_type, messages[ i ],
+												overlimit_reaction_deep };
+
+										collect_message_for_subscriber(
+												a,
+												tracer,
+												msg_type,
+												messages[ i ],
+												overlimit_reaction_deep,
+												accepted );
+									}
+							},
+							[&] {
+								for( std::size_t i = 0u; i != accepted.size(); ++i )
+									so_5::message_limit::control_block_t::decrement(
+											a.limit() );
+							} );
+
+						if( !accepted.empty() )
+							agent_t::call_push_events_batch(
+									a.subscriber_reference(),
+									a.limit(),
+									this->m_id,
+									msg_type,
+									msg_type_id,
+									accepted.data(),
+									accepted.size() );
+					}
+			}
+
+		/*!
+		 * \brief Check a message from a batch for one subscriber.
+		 *
+		 * If the message can be delivered then it is added to \a accepted
+		 * and message limit counter is incremented.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		collect_message_for_subscriber(
+			const local_mbox_details::subscriber_info_t & agent_info,
+			typename Tracing_Base::deliver_op_tracer const & tracer,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep,
+			std::vector< message_ref_t > & accepted ) const
+			{
+				const auto delivery_status =
+						agent_info.must_be_delivered(
+								message,
+								[]( const message_ref_t & m ) -> message_t & {
+									return *m;
+								} );
+
+				if( delivery_possibility_t::must_be_delivered == delivery_status )
+					{
+						using namespace so_5::message_limit::impl;
+
+						try_to_deliver_to_agent(
+								this->m_id,
+								agent_info.subscriber_reference(),
+								agent_info.limit(),
+								msg_type,
+								message,
+								overlimit_reaction_deep,
+								tracer.overlimit_tracer(),
+								[&] {
+									tracer.push_to_queue( agent_info.subscriber_pointer() );
+
+									accepted.push_back( message );
+								} );
 					}
 				else
-					tracer.no_subscribers();
+					tracer.message_rejected(
+							agent_info.subscriber_pointer(), delivery_status );
 			}
 
 		void
@@ -962,6 +1470,7 @@ class local_mbox_template
 			const local_mbox_details::subscriber_info_t & agent_info,
 			typename Tracing_Base::deliver_op_tracer const & tracer,
 			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const
 			{
@@ -992,6 +1501,7 @@ class local_mbox_template
 											agent_info.limit(),
 											this->m_id,
 											msg_type,
+											msg_type_id,
 											message );
 								} );
 					}
@@ -1030,7 +1540,9 @@ class local_mbox_template
  * \brief Alias for local mbox without message delivery tracing.
  */
 using local_mbox_without_tracing =
-	local_mbox_template< msg_tracing_helpers::tracing_disabled_base >;
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::rw_locked_subscribers_t >;
 
 /*!
  * \since
@@ -1039,7 +1551,31 @@ using local_mbox_without_tracing =
  * \brief Alias for local mbox with message delivery tracing.
  */
 using local_mbox_with_tracing =
-	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::rw_locked_subscribers_t >;
+
+/*!
+ * \brief Alias for copy-on-write local mbox without message delivery tracing.
+ *
+ * \since
+ * v.5.6.2
+ */
+using cow_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::cow_subscribers_t >;
+
+/*!
+ * \brief Alias for copy-on-write local mbox with message delivery tracing.
+ *
+ * \since
+ * v.5.6.2
+ */
+using cow_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::cow_subscribers_t >;
 
 } /* namespace impl */
 
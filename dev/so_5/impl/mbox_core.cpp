@@ -24,8 +24,10 @@ namespace impl
 //
 
 mbox_core_t::mbox_core_t(
-	outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff )
+	outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff,
+	local_mbox_kind_t default_local_mbox_kind )
 	:	m_msg_tracing_stuff{ msg_tracing_stuff }
+	,	m_default_local_mbox_kind{ default_local_mbox_kind }
 	,	m_mbox_id_counter{ 1 }
 {
 }
@@ -33,9 +35,28 @@ mbox_core_t::mbox_core_t(
 mbox_t
 mbox_core_t::create_mbox(
 	environment_t & env )
+{
+	return create_mbox( env, m_default_local_mbox_kind );
+}
+
+mbox_t
+mbox_core_t::create_mbox(
+	environment_t & env,
+	local_mbox_kind_t kind )
 {
 	auto id = ++m_mbox_id_counter;
-	if( !m_msg_tracing_stuff.get().is_msg_tracing_enabled() )
+	const bool tracing = m_msg_tracing_stuff.get().is_msg_tracing_enabled();
+
+	if( local_mbox_kind_t::copy_on_write == kind )
+	{
+		if( !tracing )
+			return mbox_t{ new cow_local_mbox_without_tracing{ id, env } };
+		else
+			return mbox_t{
+					new cow_local_mbox_with_tracing{ id, env, m_msg_tracing_stuff } };
+	}
+
+	if( !tracing )
 		return mbox_t{ new local_mbox_without_tracing{ id, env } };
 	else
 		return mbox_t{ new local_mbox_with_tracing{ id, env, m_msg_tracing_stuff } };
@@ -45,10 +66,19 @@ mbox_t
 mbox_core_t::create_mbox(
 	environment_t & env,
 	nonempty_name_t mbox_name )
+{
+	return create_mbox( env, std::move(mbox_name), m_default_local_mbox_kind );
+}
+
+mbox_t
+mbox_core_t::create_mbox(
+	environment_t & env,
+	nonempty_name_t mbox_name,
+	local_mbox_kind_t kind )
 {
 	return create_named_mbox(
 			std::move(mbox_name),
-			[&env, this]() { return create_mbox(env); } );
+			[&env, kind, this]() { return create_mbox(env, kind); } );
 }
 
 namespace {
@@ -70,7 +70,9 @@ class mbox_core_t
 	public:
 		mbox_core_t(
 			//! Message delivery tracing stuff.
-			outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff );
+			outliving_reference_t< so_5::msg_tracing::holder_t > msg_tracing_stuff,
+			//! The kind of local mboxes to be created by default.
+			local_mbox_kind_t default_local_mbox_kind );
 
 		//! Create local anonymous mbox.
 		/*!
@@ -79,6 +81,20 @@ class mbox_core_t
 		mbox_t
 		create_mbox( environment_t & env );
 
+		//! Create local anonymous mbox of the specified kind.
+		/*!
+		 * \note always creates a new mbox.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		mbox_t
+		create_mbox(
+			//! Environment for which the mbox is created.
+			environment_t & env,
+			//! Kind of a new mbox.
+			local_mbox_kind_t kind );
+
 		//! Create local named mbox.
 		/*!
 			\note if mbox with specified name \a mbox_name is present, 
@@ -93,6 +109,23 @@ class mbox_core_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		//! Create local named mbox of the specified kind.
+		/*!
+		 * \note \a kind is ignored if mbox with name \a mbox_name
+		 * already exists.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		mbox_t
+		create_mbox(
+			//! Environment for which the mbox is created.
+			environment_t & env,
+			//! Mbox name.
+			nonempty_name_t mbox_name,
+			//! Kind of a new mbox.
+			local_mbox_kind_t kind );
+
 		/*!
 		 * \since
 		 * v.5.4.0
@@ -164,6 +197,14 @@ class mbox_core_t
 		 */
 		outliving_reference_t< so_5::msg_tracing::holder_t > m_msg_tracing_stuff;
 
+		/*!
+		 * \brief The kind of local mboxes to be created by default.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const local_mbox_kind_t m_default_local_mbox_kind;
+
 		//! Named mbox map's lock.
 		std::mutex m_dictionary_lock;
 
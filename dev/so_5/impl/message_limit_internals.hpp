@@ -12,6 +12,9 @@
 #pragma once
 
 #include <so_5/message_limit.hpp>
+#include <so_5/message_type_id.hpp>
+
+#include <so_5/impl/demand_descriptors.hpp>
 
 #include <vector>
 #include <algorithm>
@@ -42,6 +45,14 @@ struct info_block_t
 		//! Type of the message.
 		std::type_index m_msg_type;
 
+		/*!
+		 * \brief Identifier of the message type.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		message_type_id_t m_msg_type_id;
+
 		//! Run-time data for the message type.
 		control_block_t m_control_block;
 
@@ -54,6 +65,7 @@ struct info_block_t
 			//! Reaction to the limit overflow.
 			action_t action )
 			:	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( message_type_id( m_msg_type ) )
 			,	m_control_block( limit, std::move( action ) )
 			{}
 	};
@@ -90,12 +102,41 @@ class info_storage_t
 			description_container_t && descriptions )
 			:	m_blocks( build_blocks( std::move( descriptions ) ) )
 			,	m_small_container( m_blocks.size() <= 8 )
-			{}
+			,	m_demand_descriptors( new demand_descriptor_t[
+					m_blocks.size() * so_5::impl::message_demand_kinds_count ] )
+			{
+				// Control blocks won't be moved anymore, so descriptors
+				// can refer to them.
+				for( std::size_t i = 0u; i != m_blocks.size(); ++i )
+					{
+						auto & block = m_blocks[ i ];
+						auto * descriptors = &m_demand_descriptors[
+								i * so_5::impl::message_demand_kinds_count ];
+
+						so_5::impl::fill_message_demand_descriptors(
+								&block.m_control_block,
+								block.m_msg_type_id,
+								descriptors );
+						block.m_control_block.m_demand_descriptors = descriptors;
+					}
+			}
 
 		inline const control_block_t *
 		find( const std::type_index & msg_type ) const
 			{
-				auto r = find_block( msg_type );
+				return find( message_type_id( msg_type ) );
+			}
+
+		/*!
+		 * \brief Search by the identifier of the message type.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		inline const control_block_t *
+		find( message_type_id_t msg_type_id ) const noexcept
+			{
+				auto r = find_block( msg_type_id );
 
 				if( r )
 					return &(r->m_control_block);
@@ -119,11 +160,28 @@ class info_storage_t
 
 	private :
 		//! Information about limits.
-		const info_block_container_t m_blocks;
+		/*!
+		 * \note
+		 * It isn't modified after the construction. It is not a const
+		 * since v.5.6.2 because demand descriptors are bound to control
+		 * blocks in the constructor.
+		 */
+		info_block_container_t m_blocks;
 
 		//! Is the container is small and linear search must be used?
 		const bool m_small_container;
 
+		/*!
+		 * \brief Descriptors for demands with messages.
+		 *
+		 * There are so_5::impl::message_demand_kinds_count descriptors
+		 * for every item in m_blocks.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		std::unique_ptr< demand_descriptor_t[] > m_demand_descriptors;
+
 		//! Run-time limit information builder.
 		inline static info_block_container_t
 		build_blocks( description_container_t && descriptions )
@@ -146,13 +204,13 @@ class info_storage_t
 				// Result must be sorted.
 				sort( begin( result ), end( result ),
 						[]( const info_block_t & a, const info_block_t & b ) {
-							return a.m_msg_type < b.m_msg_type;
+							return a.m_msg_type_id < b.m_msg_type_id;
 						} );
 
 				// There must not be duplicates.
 				auto duplicate = adjacent_find( begin( result ), end( result ),
 						[]( const info_block_t & a, const info_block_t & b ) {
-							return a.m_msg_type == b.m_msg_type;
+							return a.m_msg_type_id == b.m_msg_type_id;
 						} );
 				if( duplicate != end( result ) )
 					SO_5_THROW_EXCEPTION( rc_several_limits_for_one_message_type,
@@ -164,19 +222,19 @@ class info_storage_t
 
 		//! Search for info_block.
 		inline const info_block_t *
-		find_block( const std::type_index & msg_type ) const
+		find_block( message_type_id_t msg_type_id ) const noexcept
 			{
 				if( m_small_container )
-					return find_block_in_small_container( msg_type );
+					return find_block_in_small_container( msg_type_id );
 				else
-					return find_block_in_large_container( msg_type );
+					return find_block_in_large_container( msg_type_id );
 			}
 
 
 		//! Search for info_block in the small container.
 		inline const info_block_t *
 		find_block_in_small_container(
-			const std::type_index & msg_type ) const
+			message_type_id_t msg_type_id ) const noexcept
 			{
 				using namespace std;
 
@@ -184,7 +242,7 @@ class info_storage_t
 				// on a small containers.
 				auto r = find_if( begin( m_blocks ), end( m_blocks ),
 						[&]( const info_block_t & blk ) {
-							return blk.m_msg_type == msg_type;
+							return blk.m_msg_type_id == msg_type_id;
 						} );
 				if( r != end( m_blocks ) )
 					return &(*r);
@@ -195,7 +253,7 @@ class info_storage_t
 		//! Search for info_block in the large container.
 		inline const info_block_t *
 		find_block_in_large_container(
-			const std::type_index & msg_type ) const
+			message_type_id_t msg_type_id ) const noexcept
 			{
 				using namespace std;
 
@@ -207,9 +265,9 @@ class info_storage_t
 					{
 						auto step = count / 2;
 						auto middle = left + step;
-						if( middle->m_msg_type == msg_type )
+						if( middle->m_msg_type_id == msg_type_id )
 							return &(*middle);
-						else if( middle->m_msg_type < msg_type )
+						else if( middle->m_msg_type_id < msg_type_id )
 							{
 								left = middle + 1;
 								count -= step + 1;
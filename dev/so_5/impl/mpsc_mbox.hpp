@@ -23,6 +23,10 @@
 #include <so_5/impl/msg_tracing_helpers.hpp>
 #include <so_5/impl/message_limit_internals.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
+#include <vector>
+
 namespace so_5
 {
 
@@ -137,6 +141,38 @@ class limitless_mpsc_mbox_template
 				} );
 			}
 
+		void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) override
+			{
+				using tracer_t = typename Tracing_Base::deliver_op_tracer;
+
+				read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+				for( std::size_t i = 0u; i != count; ++i )
+					{
+						const tracer_t tracer{ *this, *this, "deliver_message",
+								msg_type, messages[ i ], overlimit_reaction_deep };
+
+						if( m_subscriptions_count )
+							tracer.push_to_queue( m_single_consumer );
+						else
+							tracer.no_subscribers();
+					}
+
+				if( m_subscriptions_count )
+					agent_t::call_push_events_batch(
+							*m_single_consumer,
+							message_limit::control_block_t::none(),
+							m_id,
+							msg_type,
+							messages,
+							count );
+			}
+
 		/*!
 		 * \attention Will throw an exception because delivery
 		 * filter is not applicable to MPSC-mboxes.
@@ -292,7 +328,8 @@ class limitful_mpsc_mbox_template
 				this->do_delivery( tracer, [&] {
 					using namespace so_5::message_limit::impl;
 
-					auto limit = m_limits.find( msg_type );
+					const auto msg_type_id = message_type_id( msg_type );
+					auto limit = m_limits.find( msg_type_id );
 
 					try_to_deliver_to_agent(
 							this->m_id,
@@ -310,11 +347,80 @@ class limitful_mpsc_mbox_template
 										limit,
 										this->m_id,
 										msg_type,
+										msg_type_id,
 										message );
 							} );
 				} );
 			}
 
+		void
+		do_deliver_messages(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) override
+			{
+				using namespace so_5::message_limit::impl;
+				using tracer_t = typename Tracing_Base::deliver_op_tracer;
+
+				read_lock_guard_t< default_rw_spinlock_t > lock{ this->m_lock };
+
+				if( !this->m_subscriptions_count )
+					{
+						for( std::size_t i = 0u; i != count; ++i )
+							tracer_t{ *this, *this, "deliver_message",
+									msg_type, messages[ i ], overlimit_reaction_deep
+								}.no_subscribers();
+						return;
+					}
+
+				const auto msg_type_id = message_type_id( msg_type );
+				auto limit = m_limits.find( msg_type_id );
+
+				// Messages which don't exceed the limit.
+				std::vector< message_ref_t > accepted;
+				accepted.reserve( count );
+
+				// Overlimit reactions can throw. Limit counters of
+				// already accepted messages must be restored in that case.
+				so_5::details::do_with_rollback_on_exception(
+					[&] {
+						for( std::size_t i = 0u; i != count; ++i )
+							{
+								const tracer_t tracer{ *this, *this, "deliver_message",
+										msg_type, messages[ i ], overlimit_reaction_deep };
+
+								try_to_deliver_to_agent(
+										this->m_id,
+										*(this->m_single_consumer),
+										limit,
+										msg_type,
+										messages[ i ],
+										overlimit_reaction_deep,
+										tracer.overlimit_tracer(),
+										[&] {
+											tracer.push_to_queue( this->m_single_consumer );
+
+											accepted.push_back( messages[ i ] );
+										} );
+							}
+					},
+					[&] {
+						for( std::size_t i = 0u; i != accepted.size(); ++i )
+							message_limit::control_block_t::decrement( limit );
+					} );
+
+				if( !accepted.empty() )
+					agent_t::call_push_events_batch(
+							*(this->m_single_consumer),
+							limit,
+							this->m_id,
+							msg_type,
+							msg_type_id,
+							accepted.data(),
+							accepted.size() );
+			}
+
 	private :
 		const so_5::message_limit::impl::info_storage_t & m_limits;
 };
@@ -754,7 +754,7 @@ trace_event_handler_search_result(
 			demand.m_receiver,
 			details::composed_action_name{ context_marker, "find_handler" },
 			details::mbox_identification{ demand.m_mbox_id },
-			details::original_msg_type{ demand.m_msg_type },
+			details::original_msg_type{ demand.msg_type() },
 			demand.m_message_ref,
 			&(demand.m_receiver->so_current_state()),
 			search_result );
@@ -777,7 +777,7 @@ trace_deadletter_handler_search_result(
 			demand.m_receiver,
 			details::composed_action_name{ context_marker, "deadletter_handler" },
 			details::mbox_identification{ demand.m_mbox_id },
-			details::original_msg_type{ demand.m_msg_type },
+			details::original_msg_type{ demand.msg_type() },
 			demand.m_message_ref,
 			&(demand.m_receiver->so_current_state()),
 			search_result );
@@ -264,6 +264,13 @@ mt_env_infrastructure_t::query_timer_thread_stats()
 		return m_timer_thread->query_stats();
 	}
 
+void
+mt_env_infrastructure_t::set_timer_thread_exec_stats_collection(
+	bool enabled ) noexcept
+	{
+		m_timer_thread->set_exec_stats_collection( enabled );
+	}
+
 disp_binder_shptr_t
 mt_env_infrastructure_t::make_default_disp_binder()
 	{
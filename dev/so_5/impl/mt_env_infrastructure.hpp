@@ -215,6 +215,9 @@ class mt_env_infrastructure_t
 		virtual timer_thread_stats_t
 		query_timer_thread_stats() override;
 
+		virtual void
+		set_timer_thread_exec_stats_collection( bool enabled ) noexcept override;
+
 		virtual disp_binder_shptr_t
 		make_default_disp_binder() override;
 
@@ -55,6 +55,15 @@ named_local_mbox_t::unsubscribe_event_handlers(
 	return m_mbox->unsubscribe_event_handlers( type_wrapper, subscriber );
 }
 
+void
+named_local_mbox_t::subscribe_event_handlers(
+	const mbox_subscription_info_t * subscriptions,
+	std::size_t count,
+	agent_t & subscriber )
+{
+	m_mbox->subscribe_event_handlers( subscriptions, count, subscriber );
+}
+
 std::string
 named_local_mbox_t::query_name() const
 {
@@ -61,6 +61,12 @@ class named_local_mbox_t
 			const std::type_index & type_wrapper,
 			agent_t & subscriber ) override;
 
+		void
+		subscribe_event_handlers(
+			const mbox_subscription_info_t * subscriptions,
+			std::size_t count,
+			agent_t & subscriber ) override;
+
 		std::string
 		query_name() const override;
 
@@ -577,6 +577,8 @@ class stats_controller_t final
 							// We don't expect exceptions from here.
 							m_status = status_t::on;
 							m_run_id = run_id;
+
+							notify_sources();
 						}
 					} );
 			}
@@ -585,7 +587,12 @@ class stats_controller_t final
 		turn_off() override
 			{
 				this->lock_and_perform( [&] {
-					m_status = status_t::off;
+					if( status_t::on == m_status )
+						{
+							m_status = status_t::off;
+
+							notify_sources();
+						}
 				} );
 			}
 
@@ -608,6 +615,9 @@ class stats_controller_t final
 			{
 				this->lock_and_perform( [&] {
 					source_list_add( what, m_head, m_tail );
+
+					if( status_t::on == m_status )
+						what.on_turn_on();
 				} );
 			}
 
@@ -615,6 +625,9 @@ class stats_controller_t final
 		remove( stats::source_t & what ) noexcept override
 			{
 				this->lock_and_perform( [&] {
+					if( status_t::on == m_status )
+						what.on_turn_off();
+
 					source_list_remove( what, m_head, m_tail );
 				} );
 			}
@@ -690,6 +703,23 @@ class stats_controller_t final
 				return std::chrono::milliseconds{1};
 			}
 
+		//! Notify all data sources about the current status.
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		notify_sources() noexcept
+			{
+				for( auto s = m_head; s; s = source_list_next( *s ) )
+					{
+						if( status_t::on == m_status )
+							s->on_turn_on();
+						else
+							s->on_turn_off();
+					}
+			}
+
 		//! Actual distribution of the current statistics.
 		std::chrono::steady_clock::duration
 		distribute_current_data()
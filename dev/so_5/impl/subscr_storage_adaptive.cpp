@@ -75,7 +75,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -94,6 +94,9 @@ class storage_t : public subscription_storage_t
 		std::size_t
 		query_subscriptions_count() const override;
 
+		void
+		on_agent_started() noexcept override;
+
 	private :
 		const std::size_t m_threshold;
 
@@ -176,12 +179,12 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
 		return m_current_storage->find_handler(
 				mbox_id,
-				msg_type,
+				msg_type_id,
 				current_state );
 	}
 
@@ -222,6 +225,12 @@ storage_t::query_subscriptions_count() const
 		return m_current_storage->query_subscriptions_count();
 	}
 
+void
+storage_t::on_agent_started() noexcept
+	{
+		m_current_storage->on_agent_started();
+	}
+
 void
 storage_t::try_switch_to_smaller_storage()
 	{
@@ -0,0 +1,451 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \file
+ * \brief A storage for agent's subscriptions information which is
+ * frozen after the start of the agent.
+ */
+
+#include <so_5/impl/subscription_storage_iface.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A storage for agent's subscriptions information which is
+ * frozen after the start of the agent.
+ */
+namespace frozen_subscr_storage
+{
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief A storage which builds a read-only index of subscriptions
+ * after the start of the agent.
+ *
+ * All subscriptions are held by an ordinary mutable storage. When
+ * so_evt_start() completes a flat open-addressing table is built for
+ * the current subscriptions. A key of the table is (mbox_id, msg_type_id,
+ * state) and a value is a pointer to event_handler_data_t inside the
+ * mutable storage.
+ *
+ * During the construction of the table several hash seeds and sizes of
+ * the table are tried to find a placement without collisions. If such
+ * placement is found then a search of an event handler is just one probe.
+ * Linear probing is used otherwise.
+ *
+ * Any change of subscriptions after the freezing drops the table and all
+ * searches are delegated to the mutable storage since then.
+ */
+class storage_t : public subscription_storage_t
+	{
+	public :
+		storage_t(
+			agent_t * owner,
+			subscription_storage_unique_ptr_t mutable_storage );
+
+		void
+		create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const message_limit::control_block_t * limit,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety ) override;
+
+		void
+		drop_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const state_t & target_state ) override;
+
+		void
+		drop_subscription_for_all_states(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index ) override;
+
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t & current_state ) const noexcept override;
+
+		void
+		debug_dump( std::ostream & to ) const override;
+
+		void
+		drop_content() override;
+
+		subscription_storage_common::subscr_info_vector_t
+		query_content() const override;
+
+		void
+		setup_content(
+			subscription_storage_common::subscr_info_vector_t && info ) override;
+
+		std::size_t
+		query_subscriptions_count() const override;
+
+		void
+		on_agent_started() noexcept override;
+
+	private :
+		//! An item of the frozen table.
+		struct slot_t
+			{
+				mbox_id_t m_mbox_id;
+				const state_t * m_state;
+				//! Pointer to the handler inside the mutable storage.
+				/*!
+				 * It is nullptr for an empty slot.
+				 */
+				const event_handler_data_t * m_handler;
+				message_type_id_t m_msg_type_id;
+			};
+
+		//! Minimal size of the frozen table as a power of two.
+		static constexpr unsigned int min_bits = 2u;
+
+		//! How many seeds are tried for every size of the table.
+		static constexpr std::uint64_t seeds_to_try = 32u;
+
+		//! How many times the size of the table can be doubled
+		//! in the search for a placement without collisions.
+		static constexpr unsigned int max_extra_doublings = 2u;
+
+		//! The storage which holds all subscriptions.
+		subscription_storage_unique_ptr_t m_mutable_storage;
+
+		//! The frozen table.
+		/*!
+		 * It is empty if the storage isn't frozen.
+		 * Its size is always a power of two.
+		 */
+		std::vector< slot_t > m_slots;
+
+		//! Seed for the hash function for the current table.
+		std::uint64_t m_seed{ 0u };
+
+		//! Shift for getting an index from the hash value.
+		unsigned int m_shift{ 64u };
+
+		//! Is there a placement without collisions?
+		bool m_collision_free{ false };
+
+		static std::uint64_t
+		hash(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			std::uint64_t seed ) noexcept
+			{
+				// Mixing steps from splitmix64.
+				std::uint64_t h = seed ^ ( mbox_id * 0x9e3779b97f4a7c15ull );
+				h ^= ( static_cast< std::uint64_t >( msg_type_id ) << 32 ) ^
+						static_cast< std::uint64_t >(
+								reinterpret_cast< std::uintptr_t >( state ) );
+				h = ( h ^ ( h >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+				h = ( h ^ ( h >> 27 ) ) * 0x94d049bb133111ebull;
+				return h ^ ( h >> 31 );
+			}
+
+		std::size_t
+		index_of(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) const noexcept
+			{
+				return static_cast< std::size_t >(
+						hash( mbox_id, msg_type_id, state, m_seed ) >> m_shift );
+			}
+
+		//! Try to fill the table without collisions.
+		bool
+		try_place_without_collisions(
+			const subscription_storage_common::subscr_info_vector_t & info,
+			const std::vector< const event_handler_data_t * > & handlers ) noexcept;
+
+		//! Fill the table with linear probing.
+		void
+		place_with_linear_probing(
+			const subscription_storage_common::subscr_info_vector_t & info,
+			const std::vector< const event_handler_data_t * > & handlers ) noexcept;
+
+		//! Build the frozen table for the current subscriptions.
+		void
+		freeze();
+
+		//! Drop the frozen table before a modification of subscriptions.
+		void
+		unfreeze() noexcept;
+	};
+
+storage_t::storage_t(
+	agent_t * owner,
+	subscription_storage_unique_ptr_t mutable_storage )
+	:	subscription_storage_t( owner )
+	,	m_mutable_storage( std::move( mutable_storage ) )
+	{}
+
+void
+storage_t::create_event_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const message_limit::control_block_t * limit,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety )
+	{
+		unfreeze();
+		m_mutable_storage->create_event_subscription(
+				mbox,
+				msg_type,
+				limit,
+				target_state,
+				method,
+				thread_safety );
+	}
+
+void
+storage_t::drop_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const state_t & target_state )
+	{
+		unfreeze();
+		m_mutable_storage->drop_subscription( mbox, msg_type, target_state );
+	}
+
+void
+storage_t::drop_subscription_for_all_states(
+	const mbox_t & mbox,
+	const std::type_index & msg_type )
+	{
+		unfreeze();
+		m_mutable_storage->drop_subscription_for_all_states( mbox, msg_type );
+	}
+
+const event_handler_data_t *
+storage_t::find_handler(
+	mbox_id_t mbox_id,
+	message_type_id_t msg_type_id,
+	const state_t & current_state ) const noexcept
+	{
+		if( m_slots.empty() )
+			return m_mutable_storage->find_handler(
+					mbox_id, msg_type_id, current_state );
+
+		const auto mask = m_slots.size() - 1u;
+		auto i = index_of( mbox_id, msg_type_id, &current_state );
+		for(;;)
+			{
+				const auto & s = m_slots[ i ];
+				if( s.m_msg_type_id == msg_type_id &&
+						s.m_state == &current_state &&
+						s.m_mbox_id == mbox_id )
+					return s.m_handler;
+
+				if( m_collision_free || !s.m_handler )
+					return nullptr;
+
+				i = ( i + 1u ) & mask;
+			}
+	}
+
+void
+storage_t::debug_dump( std::ostream & to ) const
+	{
+		m_mutable_storage->debug_dump( to );
+	}
+
+void
+storage_t::drop_content()
+	{
+		unfreeze();
+		m_mutable_storage->drop_content();
+	}
+
+subscription_storage_common::subscr_info_vector_t
+storage_t::query_content() const
+	{
+		return m_mutable_storage->query_content();
+	}
+
+void
+storage_t::setup_content(
+	subscription_storage_common::subscr_info_vector_t && info )
+	{
+		unfreeze();
+		m_mutable_storage->setup_content( std::move( info ) );
+	}
+
+std::size_t
+storage_t::query_subscriptions_count() const
+	{
+		return m_mutable_storage->query_subscriptions_count();
+	}
+
+void
+storage_t::on_agent_started() noexcept
+	{
+		m_mutable_storage->on_agent_started();
+
+		try
+			{
+				freeze();
+			}
+		catch( ... )
+			{
+				// The lack of the frozen table isn't an error.
+				// The mutable storage will be used for searching.
+				unfreeze();
+			}
+	}
+
+bool
+storage_t::try_place_without_collisions(
+	const subscription_storage_common::subscr_info_vector_t & info,
+	const std::vector< const event_handler_data_t * > & handlers ) noexcept
+	{
+		for( std::uint64_t seed = 0u; seed != seeds_to_try; ++seed )
+			{
+				m_seed = seed;
+				std::fill( m_slots.begin(), m_slots.end(), slot_t{} );
+
+				bool collision = false;
+				for( std::size_t n = 0u; n != info.size() && !collision; ++n )
+					{
+						const auto & item = info[ n ];
+						const auto mbox_id = item.m_mbox->id();
+						auto & s = m_slots[
+								index_of( mbox_id, item.m_msg_type_id, item.m_state ) ];
+						if( s.m_handler )
+							collision = true;
+						else
+							s = slot_t{
+									mbox_id,
+									item.m_state,
+									handlers[ n ],
+									item.m_msg_type_id };
+					}
+
+				if( !collision )
+					return true;
+			}
+
+		return false;
+	}
+
+void
+storage_t::place_with_linear_probing(
+	const subscription_storage_common::subscr_info_vector_t & info,
+	const std::vector< const event_handler_data_t * > & handlers ) noexcept
+	{
+		m_seed = 0u;
+		std::fill( m_slots.begin(), m_slots.end(), slot_t{} );
+
+		const auto mask = m_slots.size() - 1u;
+		for( std::size_t n = 0u; n != info.size(); ++n )
+			{
+				const auto & item = info[ n ];
+				const auto mbox_id = item.m_mbox->id();
+				auto i = index_of( mbox_id, item.m_msg_type_id, item.m_state );
+				while( m_slots[ i ].m_handler )
+					i = ( i + 1u ) & mask;
+
+				m_slots[ i ] = slot_t{
+						mbox_id,
+						item.m_state,
+						handlers[ n ],
+						item.m_msg_type_id };
+			}
+	}
+
+void
+storage_t::freeze()
+	{
+		const auto info = m_mutable_storage->query_content();
+
+		// Pointers to actual handlers are taken from the mutable storage.
+		// They remain valid until the next modification of subscriptions.
+		std::vector< const event_handler_data_t * > handlers;
+		handlers.reserve( info.size() );
+		for( const auto & item : info )
+			handlers.push_back( m_mutable_storage->find_handler(
+					item.m_mbox->id(), item.m_msg_type_id, *(item.m_state) ) );
+
+		// The load factor of the table doesn't exceed 1/2.
+		unsigned int bits = min_bits;
+		while( ( std::size_t{ 1u } << bits ) < info.size() * 2u )
+			++bits;
+
+		for( unsigned int extra = 0u; extra <= max_extra_doublings; ++extra )
+			{
+				m_slots.resize( std::size_t{ 1u } << ( bits + extra ) );
+				m_shift = 64u - ( bits + extra );
+				if( try_place_without_collisions( info, handlers ) )
+					{
+						m_collision_free = true;
+						return;
+					}
+			}
+
+		m_slots.resize( std::size_t{ 1u } << bits );
+		m_slots.shrink_to_fit();
+		m_shift = 64u - bits;
+		m_collision_free = false;
+		place_with_linear_probing( info, handlers );
+	}
+
+void
+storage_t::unfreeze() noexcept
+	{
+		if( !m_slots.empty() )
+			{
+				std::vector< slot_t > empty;
+				m_slots.swap( empty );
+			}
+		m_collision_free = false;
+	}
+
+} /* namespace frozen_subscr_storage */
+
+} /* namespace impl */
+
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory()
+	{
+		return frozen_subscription_storage_factory(
+				default_subscription_storage_factory() );
+	}
+
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory(
+	const subscription_storage_factory_t & mutable_storage_factory )
+	{
+		return [mutable_storage_factory]( agent_t * owner ) {
+			return impl::subscription_storage_unique_ptr_t(
+					new impl::frozen_subscr_storage::storage_t(
+							owner,
+							mutable_storage_factory( owner ) ) );
+		};
+	}
+
+} /* namespace so_5 */
@@ -40,14 +40,19 @@ struct key_t
 	//! Unique ID of mbox.
 	mbox_id_t m_mbox_id;
 	//! Message type.
-	std::type_index m_msg_type;
+	/*!
+	 * \note
+	 * Since v.5.6.2 the identifier of message type is used instead
+	 * of std::type_index.
+	 */
+	message_type_id_t m_msg_type_id;
 	//! State of agent.
 	const state_t * m_state;
 
 	//! Default constructor.
 	inline key_t()
 		:	m_mbox_id( null_mbox_id() )
-		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_message_type_id )
 		,	m_state( nullptr )
 		{}
 
@@ -55,19 +60,19 @@ struct key_t
 	//! find all keys with (mbox_id, msg_type) prefix.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type )
+		message_type_id_t msg_type_id )
 		:	m_mbox_id( mbox_id )
-		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( nullptr )
 		{}
 
 	//! Initializing constructor.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type,
+		message_type_id_t msg_type_id,
 		const state_t & state )
 		:	m_mbox_id( mbox_id )
-		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( &state )
 		{}
 
@@ -78,9 +83,9 @@ struct key_t
 				return true;
 			else if( m_mbox_id == o.m_mbox_id )
 				{
-					if( m_msg_type < o.m_msg_type )
+					if( m_msg_type_id < o.m_msg_type_id )
 						return true;
-					else if( m_msg_type == o.m_msg_type )
+					else if( m_msg_type_id == o.m_msg_type_id )
 						return m_state < o.m_state;
 				}
 
@@ -91,7 +96,7 @@ struct key_t
 	operator==( const key_t & o ) const noexcept
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type &&
+					m_msg_type_id == o.m_msg_type_id &&
 					m_state == o.m_state;
 		}
 
@@ -99,10 +104,26 @@ struct key_t
 	is_same_mbox_msg_pair( const key_t & o ) const noexcept
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type;
+					m_msg_type_id == o.m_msg_type_id;
 		}
 };
 
+//! Subscription value type.
+/*!
+ * \since
+ * v.5.6.2
+ */
+struct value_t
+{
+	//! Mbox of the subscription.
+	mbox_t m_mbox;
+	//! Message type.
+	/*!
+	 * It is necessary for interaction with mbox and for diagnostics.
+	 */
+	std::type_index m_msg_type;
+};
+
 //
 // hash_t
 //
@@ -123,7 +144,7 @@ struct hash_t
 				const auto h1 =
 					std::hash< so_5::mbox_id_t >()( ptr->m_mbox_id );
 				const auto h2 = h1 ^
-					(std::hash< std::type_index >()( ptr->m_msg_type ) +
+					(std::hash< message_type_id_t >()( ptr->m_msg_type_id ) +
 					 	0x9e3779b9 + (h1 << 6) + (h1 >> 2));
 
 				return h2 ^ (std::hash< const state_t * >()(
@@ -227,7 +248,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -248,7 +269,7 @@ class storage_t : public subscription_storage_t
 
 	private :
 		//! Type of subscription map.
-		using map_t = std::map< key_t, mbox_t >;
+		using map_t = std::map< key_t, value_t >;
 
 		//! Map of subscriptions.
 		/*!
@@ -292,9 +313,10 @@ storage_t::create_event_subscription(
 	{
 		using namespace subscription_storage_common;
 
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key( mbox_ref->id(), message_type_id( type_index ), target_state );
 
-		auto insertion_result = m_map.emplace( key, mbox_ref );
+		auto insertion_result = m_map.emplace(
+				key, value_t{ mbox_ref, type_index } );
 
 		if( !insertion_result.second )
 			SO_5_THROW_EXCEPTION(
@@ -332,7 +354,7 @@ storage_t::drop_subscription(
 	const std::type_index & type_index,
 	const state_t & target_state )
 	{
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key( mbox_ref->id(), message_type_id( type_index ), target_state );
 
 		auto it = m_map.find( key );
 
@@ -355,7 +377,7 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox_ref,
 	const std::type_index & type_index )
 	{
-		const key_t key( mbox_ref->id(), type_index );
+		const key_t key( mbox_ref->id(), message_type_id( type_index ) );
 
 		auto it = m_map.lower_bound( key );
 		auto need_erase = [&] {
@@ -379,10 +401,10 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
-		key_t k( mbox_id, msg_type, current_state );
+		key_t k( mbox_id, msg_type_id, current_state );
 		auto it = m_hash_table.find( &k );
 		if( it != m_hash_table.end() )
 			return &(it->second);
@@ -395,7 +417,7 @@ storage_t::debug_dump( std::ostream & to ) const
 	{
 		for( const auto & v : m_map )
 			to << "{" << v.first.m_mbox_id << ", "
-					<< v.first.m_msg_type.name() << ", "
+					<< v.second.m_msg_type.name() << ", "
 					<< v.first.m_state->query_name() << "}"
 					<< std::endl;
 	}
@@ -412,8 +434,8 @@ storage_t::destroy_all_subscriptions()
 				// call unsubscribe_event_handlers only once.
 				if( !previous ||
 						!previous->first.is_same_mbox_msg_pair( i.first ) )
-					i.second->unsubscribe_event_handlers(
-						i.first.m_msg_type,
+					i.second.m_mbox->unsubscribe_event_handlers(
+						i.second.m_msg_type,
 						*owner() );
 
 				previous = &i;
@@ -452,8 +474,8 @@ storage_t::query_content() const
 							auto map_item = m_map.find( *(i.first) );
 
 							return subscr_info_t {
-									map_item->second,
-									map_item->first.m_msg_type,
+									map_item->second.m_mbox,
+									map_item->second.m_msg_type,
 									*(map_item->first.m_state),
 									i.second.m_method,
 									i.second.m_thread_safety
@@ -477,9 +499,10 @@ storage_t::setup_content(
 		for_each( begin(info), end(info),
 			[&]( const subscr_info_t & i )
 			{
-				key_t k{ i.m_mbox->id(), i.m_msg_type, *(i.m_state) };
+				key_t k{ i.m_mbox->id(), i.m_msg_type_id, *(i.m_state) };
 
-				auto ins_result = fresh_map.emplace( k, i.m_mbox );
+				auto ins_result = fresh_map.emplace(
+						k, value_t{ i.m_mbox, i.m_msg_type } );
 
 				fresh_table.emplace( &(ins_result.first->first), i.m_handler );
 			} );
@@ -71,7 +71,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept override;
 
 		void
@@ -95,15 +95,15 @@ class storage_t : public subscription_storage_t
 		struct key_t
 			{
 				mbox_id_t m_mbox_id;
-				std::type_index m_msg_type;
+				message_type_id_t m_msg_type_id;
 				const state_t * m_state;
 
 				key_t(
 					mbox_id_t mbox_id,
-					std::type_index msg_type,
+					message_type_id_t msg_type_id,
 					const state_t * state )
 					:	m_mbox_id( mbox_id )
-					,	m_msg_type( std::move( msg_type ) )
+					,	m_msg_type_id( msg_type_id )
 					,	m_state( state )
 					{}
 
@@ -114,9 +114,9 @@ class storage_t : public subscription_storage_t
 							return true;
 						else if( m_mbox_id == o.m_mbox_id )
 							{
-								if( m_msg_type < o.m_msg_type )
+								if( m_msg_type_id < o.m_msg_type_id )
 									return true;
-								else if( m_msg_type == o.m_msg_type )
+								else if( m_msg_type_id == o.m_msg_type_id )
 									return m_state < o.m_state;
 							}
 
@@ -134,6 +134,16 @@ class storage_t : public subscription_storage_t
 				 * subscriptions in destructor.
 				 */
 				const mbox_t m_mbox;
+				//! Type of the message.
+				/*!
+				 * Key contains only the identifier of the message type.
+				 * But std::type_index is necessary for interaction with
+				 * mbox and for diagnostics.
+				 *
+				 * \since
+				 * v.5.6.2
+				 */
+				const std::type_index m_msg_type;
 				const event_handler_data_t m_handler;
 			};
 
@@ -153,23 +163,23 @@ namespace
 	auto
 	find( C & c,
 		const mbox_id_t & mbox_id,
-		const std::type_index & msg_type,
+		message_type_id_t msg_type_id,
 		const state_t & target_state ) -> decltype( c.begin() )
 		{
 			return c.find( typename C::key_type {
-					mbox_id, msg_type, &target_state } );
+					mbox_id, msg_type_id, &target_state } );
 		}
 
 	struct is_same_mbox_msg
 		{
 			const mbox_id_t m_id;
-			const std::type_index & m_type;
+			const message_type_id_t m_type;
 
 			template< class K >
 			bool
 			operator()( const K & k ) const
 				{
-					return m_id == k.m_mbox_id && m_type == k.m_msg_type;
+					return m_id == k.m_mbox_id && m_type == k.m_msg_type_id;
 				}
 		};
 
@@ -177,7 +187,7 @@ namespace
 	bool is_known_mbox_msg_pair( M & s, IT it )
 		{
 			const is_same_mbox_msg predicate{
-					it->first.m_mbox_id, it->first.m_msg_type };
+					it->first.m_mbox_id, it->first.m_msg_type_id };
 
 			if( it != s.begin() )
 				{
@@ -219,10 +229,11 @@ storage_t::create_event_subscription(
 		using namespace subscription_storage_common;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = message_type_id( msg_type );
 
 		// Check that this subscription is new.
 		auto existed_position = find(
-				m_events, mbox_id, msg_type, target_state );
+				m_events, mbox_id, msg_type_id, target_state );
 
 		if( existed_position != m_events.end() )
 			SO_5_THROW_EXCEPTION(
@@ -233,9 +244,10 @@ storage_t::create_event_subscription(
 		// Just add subscription to the end.
 		auto ins_result = m_events.emplace(
 				subscr_map_t::value_type {
-						key_t { mbox_id, msg_type, &target_state },
+						key_t { mbox_id, msg_type_id, &target_state },
 						value_t {
 								mbox,
+								msg_type,
 								event_handler_data_t { method, thread_safety }
 						}
 				} );
@@ -268,7 +280,7 @@ storage_t::drop_subscription(
 	const state_t & target_state )
 	{
 		auto existed_position = find(
-				m_events, mbox->id(), msg_type, target_state );
+				m_events, mbox->id(), message_type_id( msg_type ), target_state );
 		if( existed_position != m_events.end() )
 			{
 				// Note v.5.5.9 unsubscribe_event_handlers is called for
@@ -295,10 +307,11 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox,
 	const std::type_index & msg_type )
 	{
-		const is_same_mbox_msg is_same{ mbox->id(), msg_type };
+		const auto msg_type_id = message_type_id( msg_type );
+		const is_same_mbox_msg is_same{ mbox->id(), msg_type_id };
 
 		auto lower_bound = m_events.lower_bound(
-				key_t{ mbox->id(), msg_type, nullptr } );
+				key_t{ mbox->id(), msg_type_id, nullptr } );
 
 		auto need_erase = [&] {
 				return lower_bound != std::end(m_events) &&
@@ -325,10 +338,10 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const noexcept
 	{
-		auto it = find( m_events, mbox_id, msg_type, current_state );
+		auto it = find( m_events, mbox_id, msg_type_id, current_state );
 
 		if( it != std::end( m_events ) )
 			return &(it->second.m_handler);
@@ -341,7 +354,7 @@ storage_t::debug_dump( std::ostream & to ) const
 	{
 		for( const auto & e : m_events )
 			to << "{" << e.first.m_mbox_id << ", "
-					<< e.first.m_msg_type.name() << ", "
+					<< e.second.m_msg_type.name() << ", "
 					<< e.first.m_state->query_name() << "}"
 					<< std::endl;
 	}
@@ -358,10 +371,10 @@ storage_t::destroy_all_subscriptions()
 
 				if( it == end( m_events ) || !is_same_mbox_msg{
 						cur->first.m_mbox_id,
-						cur->first.m_msg_type }( it->first ) )
+						cur->first.m_msg_type_id }( it->first ) )
 					{
 						cur->second.m_mbox->unsubscribe_event_handlers(
-								cur->first.m_msg_type,
+								cur->second.m_msg_type,
 								*owner() );
 					}
 
@@ -394,7 +407,7 @@ storage_t::query_content() const
 						{
 							return subscr_info_t(
 									e.second.m_mbox,
-									e.first.m_msg_type,
+									e.second.m_msg_type,
 									*(e.first.m_state),
 									e.second.m_handler.m_method,
 									e.second.m_handler.m_thread_safety );
@@ -419,11 +432,12 @@ storage_t::setup_content(
 					return subscr_map_t::value_type {
 							key_t {
 								i.m_mbox->id(),
-								i.m_msg_type,
+								i.m_msg_type_id,
 								i.m_state
 							},
 							value_t {
 								i.m_mbox,
+								i.m_msg_type,
 								i.m_handler
 							} };
 				} );
@@ -12,6 +12,12 @@
 
 #include <so_5/impl/subscription_storage_iface.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+#include <so_5/details/invoke_noexcept_code.hpp>
+
+#include <algorithm>
+#include <tuple>
+
 namespace so_5
 {
 
@@ -28,6 +34,148 @@ subscription_storage_t::owner() const
 		return m_owner;
 	}
 
+namespace
+{
+
+//! Key of a subscription for the detection of duplicates.
+struct subscr_key_t
+	{
+		mbox_id_t m_mbox_id;
+		message_type_id_t m_msg_type_id;
+		const state_t * m_state;
+		//! Index of the subscription in the content of the storage.
+		std::size_t m_index;
+
+		bool
+		same_mbox_and_type( const subscr_key_t & o ) const noexcept
+			{
+				return m_mbox_id == o.m_mbox_id &&
+						m_msg_type_id == o.m_msg_type_id;
+			}
+
+		bool
+		operator<( const subscr_key_t & o ) const noexcept
+			{
+				return std::tie( m_mbox_id, m_msg_type_id, m_state ) <
+						std::tie( o.m_mbox_id, o.m_msg_type_id, o.m_state );
+			}
+	};
+
+//! New message types for one mbox.
+struct mbox_subscriptions_t
+	{
+		mbox_t m_mbox;
+		std::vector< mbox_subscription_info_t > m_infos;
+	};
+
+} /* namespace anonymous */
+
+void
+subscription_storage_t::create_event_subscriptions(
+	subscription_storage_common::pending_subscription_vector_t &&
+			subscriptions )
+	{
+		using namespace subscription_storage_common;
+
+		if( subscriptions.empty() )
+			return;
+
+		// New content is the old content plus all new subscriptions.
+		auto content = query_content();
+		const auto old_size = content.size();
+
+		// The old content must be restored if setup_content() fails.
+		const subscr_info_vector_t backup{ content };
+
+		content.reserve( old_size + subscriptions.size() );
+		for( auto & s : subscriptions )
+			content.push_back( std::move( s.m_info ) );
+
+		std::vector< subscr_key_t > keys;
+		keys.reserve( content.size() );
+		for( std::size_t i = 0u; i != content.size(); ++i )
+			keys.push_back( subscr_key_t{
+					content[ i ].m_mbox->id(),
+					content[ i ].m_msg_type_id,
+					content[ i ].m_state,
+					i } );
+
+		std::sort( keys.begin(), keys.end() );
+
+		std::vector< mbox_subscriptions_t > new_types;
+		for( auto it = keys.begin(); it != keys.end(); )
+			{
+				// All subscriptions for the same mbox and message type.
+				auto last = std::find_if( it, keys.end(),
+						[it]( const subscr_key_t & k ) {
+							return !it->same_mbox_and_type( k );
+						} );
+
+				const auto dup = std::adjacent_find( it, last,
+						[]( const subscr_key_t & a, const subscr_key_t & b ) {
+							return a.m_state == b.m_state;
+						} );
+				if( dup != last )
+					{
+						const auto & info = content[
+								std::max( dup->m_index, std::next( dup )->m_index ) ];
+						SO_5_THROW_EXCEPTION(
+							rc_evt_handler_already_provided,
+							"agent is already subscribed to message, " +
+							make_subscription_description(
+									info.m_mbox, info.m_msg_type, *(info.m_state) ) );
+					}
+
+				// The mbox must be informed only if there were no
+				// subscriptions for that message type.
+				const auto old_subscription = std::find_if( it, last,
+						[old_size]( const subscr_key_t & k ) {
+							return k.m_index < old_size;
+						} );
+				if( old_subscription == last )
+					{
+						const auto & info = content[ it->m_index ];
+						if( new_types.empty() ||
+								new_types.back().m_mbox->id() != it->m_mbox_id )
+							new_types.push_back( mbox_subscriptions_t{ info.m_mbox, {} } );
+
+						new_types.back().m_infos.push_back( mbox_subscription_info_t{
+								info.m_msg_type,
+								subscriptions[ it->m_index - old_size ].m_limit } );
+					}
+
+				it = last;
+			}
+
+		auto unsubscribe = [this]( const mbox_subscriptions_t & m ) {
+				for( const auto & info : m.m_infos )
+					m.m_mbox->unsubscribe_event_handlers( info.m_msg_type, *owner() );
+			};
+
+		std::size_t mboxes_subscribed = 0u;
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				for( ; mboxes_subscribed != new_types.size(); ++mboxes_subscribed )
+					{
+						const auto & m = new_types[ mboxes_subscribed ];
+						m.m_mbox->subscribe_event_handlers(
+								m.m_infos.data(), m.m_infos.size(), *owner() );
+					}
+
+				drop_content();
+				setup_content( std::move( content ) );
+			},
+			[&] {
+				so_5::details::invoke_noexcept_code( [&] {
+					for( std::size_t i = 0u; i != mboxes_subscribed; ++i )
+						unsubscribe( new_types[ i ] );
+
+					drop_content();
+					setup_content( subscr_info_vector_t{ backup } );
+				} );
+			} );
+	}
+
 } /* namespace impl */
 
 } /* namespace so_5 */
@@ -78,6 +78,13 @@ struct subscr_info_t
 		 */
 		mbox_t m_mbox;
 		std::type_index m_msg_type;
+		/*!
+		 * \brief Identifier of the message type.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		message_type_id_t m_msg_type_id;
 		const state_t * m_state;
 		event_handler_data_t m_handler;
 
@@ -89,6 +96,7 @@ struct subscr_info_t
 			thread_safety_t thread_safety )
 			:	m_mbox( std::move( mbox ) )
 			,	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( message_type_id( m_msg_type ) )
 			,	m_state( &state )
 			,	m_handler( method, thread_safety )
 			{}
@@ -102,6 +110,27 @@ struct subscr_info_t
  */
 using subscr_info_vector_t = std::vector< subscr_info_t >;
 
+/*!
+ * \brief An information about a subscription which is not created yet.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct pending_subscription_t
+	{
+		subscr_info_t m_info;
+		//! Optional message limit for the message type.
+		const message_limit::control_block_t * m_limit;
+	};
+
+/*!
+ * \brief Type of vector with pending subscriptions.
+ *
+ * \since
+ * v.5.6.2
+ */
+using pending_subscription_vector_t = std::vector< pending_subscription_t >;
+
 /*!
  * \since
  * v.5.5.3
@@ -124,6 +153,17 @@ make_subscription_description(
 
 } /* namespace subscription_storage_common */
 
+/*!
+ * \brief Subscriptions collected by agent_t::so_bulk_subscribe().
+ *
+ * \since
+ * v.5.6.2
+ */
+struct pending_subscriptions_t
+	{
+		subscription_storage_common::pending_subscription_vector_t m_items;
+	};
+
 /*!
  * \since
  * v.5.5.3
@@ -167,10 +207,15 @@ class subscription_storage_t
 			const mbox_t & mbox,
 			const std::type_index & msg_type ) = 0;
 
+		/*!
+		 * \note
+		 * Since v.5.6.2 the identifier of message type is used instead
+		 * of std::type_index.
+		 */
 		virtual const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const noexcept = 0;
 
 		virtual void
@@ -201,6 +246,40 @@ class subscription_storage_t
 		virtual std::size_t
 		query_subscriptions_count() const = 0;
 
+		/*!
+		 * \brief Create several subscriptions at once.
+		 *
+		 * Either all subscriptions are created or none of them.
+		 * Every mbox receives just one
+		 * abstract_message_box_t::subscribe_event_handlers() call for
+		 * all message types which are new for the owner of the storage.
+		 *
+		 * Default implementation rebuilds the whole content of
+		 * the storage by query_content() and setup_content().
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		create_event_subscriptions(
+			subscription_storage_common::pending_subscription_vector_t &&
+					subscriptions );
+
+		/*!
+		 * \brief A notification about the completion of agent's start.
+		 *
+		 * It is called after the return from so_evt_start(). Subscriptions
+		 * of many agents are not changed after that moment, so a storage
+		 * can prepare itself for faster search of event handlers.
+		 *
+		 * Default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		on_agent_started() noexcept {}
+
 	protected :
 		agent_t *
 		owner() const;
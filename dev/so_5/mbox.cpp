@@ -6,6 +6,8 @@
 
 #include <so_5/ret_code.hpp>
 
+#include <so_5/details/rollback_on_exception.hpp>
+
 namespace so_5
 {
 
@@ -13,6 +15,32 @@ namespace so_5
 // abstract_message_box_t
 //
 
+void
+abstract_message_box_t::subscribe_event_handlers(
+	const mbox_subscription_info_t * subscriptions,
+	std::size_t count,
+	agent_t & subscriber )
+{
+	std::size_t subscribed = 0u;
+	so_5::details::do_with_rollback_on_exception(
+		[&] {
+			for( ; subscribed != count; ++subscribed )
+				this->subscribe_event_handler(
+						subscriptions[ subscribed ].m_msg_type,
+						subscriptions[ subscribed ].m_limit,
+						subscriber );
+		},
+		[&] {
+			while( subscribed )
+			{
+				--subscribed;
+				this->unsubscribe_event_handlers(
+						subscriptions[ subscribed ].m_msg_type,
+						subscriber );
+			}
+		} );
+}
+
 void
 abstract_message_box_t::do_deliver_message_from_timer(
 	const std::type_index & msg_type,
@@ -21,5 +49,17 @@ abstract_message_box_t::do_deliver_message_from_timer(
 	this->do_deliver_message( msg_type, message, 1 );
 }
 
+void
+abstract_message_box_t::do_deliver_messages(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep )
+{
+	for( std::size_t i = 0u; i != count; ++i )
+		this->do_deliver_message(
+				msg_type, messages[ i ], overlimit_reaction_deep );
+}
+
 } /* namespace so_5 */
 
@@ -13,6 +13,7 @@
 #include <memory>
 #include <typeindex>
 #include <utility>
+#include <vector>
 
 #include <so_5/declspec.hpp>
 #include <so_5/compiler_features.hpp>
@@ -115,6 +116,62 @@ enum class mbox_type_t
 		multi_producer_single_consumer
 	};
 
+//
+// local_mbox_kind_t
+//
+/*!
+ * \brief Type of synchronization inside a local MPMC mbox.
+ *
+ * A local mbox holds a table of subscribers. That table is read on
+ * every delivery and modified on every subscription or unsubscription.
+ * This type specifies how the access to the table is synchronized.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class local_mbox_kind_t
+	{
+		//! The table is protected by a reader-writer spinlock.
+		/*!
+		 * Delivery acquires the lock in shared mode. It is cheap if
+		 * there are few senders. But if many threads send messages
+		 * to the same mbox simultaneously then the lock becomes
+		 * a point of contention.
+		 *
+		 * This is the default kind of local mboxes.
+		 */
+		rw_locked,
+		//! The table is an immutable snapshot replaced on every modification.
+		/*!
+		 * Delivery doesn't acquire any lock and doesn't modify any
+		 * shared data. It scales well when many threads send messages
+		 * to the same mbox.
+		 *
+		 * Every modification of subscriptions copies the whole table.
+		 * So this kind should be used for mboxes with a rare change
+		 * of subscriptions.
+		 */
+		copy_on_write
+	};
+
+//
+// mbox_subscription_info_t
+//
+/*!
+ * \brief Description of one subscription for
+ * abstract_message_box_t::subscribe_event_handlers().
+ *
+ * \since
+ * v.5.6.2
+ */
+struct mbox_subscription_info_t
+	{
+		//! Message type.
+		std::type_index m_msg_type;
+		//! Optional message limit for that message type.
+		const message_limit::control_block_t * m_limit;
+	};
+
 //
 // abstract_message_box_t
 //
@@ -178,6 +235,31 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Agent-subcriber.
 			agent_t & subscriber ) = 0;
 
+		/*!
+		 * \brief Add message handlers for several message types at once.
+		 *
+		 * An implementation can use that method to reduce the cost of
+		 * subscription of an agent to many message types: the mbox's
+		 * lock can be acquired only once.
+		 *
+		 * If an exception is thrown then all subscriptions made by
+		 * that call must be removed.
+		 *
+		 * The default implementation calls subscribe_event_handler()
+		 * for every item.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		subscribe_event_handlers(
+			//! Descriptions of subscriptions.
+			const mbox_subscription_info_t * subscriptions,
+			//! Count of descriptions.
+			std::size_t count,
+			//! Agent-subcriber.
+			agent_t & subscriber );
+
 		//! Get the mbox name.
 		virtual std::string
 		query_name() const = 0;
@@ -232,6 +314,33 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int overlimit_reaction_deep ) = 0;
 
+		/*!
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers with respect to message limits.
+		 *
+		 * An implementation can use that method to reduce the cost of
+		 * delivery of a bunch of messages: the mbox's lock can be acquired
+		 * only once, the subscribers can be found only once and demands
+		 * can be pushed to an event queue of a subscriber by one
+		 * event_queue_t::push_batch() call.
+		 *
+		 * The default implementation simply calls do_deliver_message()
+		 * for every message.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		do_deliver_messages(
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Message instances to be delivered.
+			const message_ref_t * messages,
+			//! Count of message instances.
+			std::size_t count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int overlimit_reaction_deep );
+
 		/*!
 		 * \name Methods for working with delivery filters.
 		 * \{
@@ -414,6 +523,33 @@ deliver_message(
 				1u );
 	}
 
+//! Deliver several messages of the same type.
+/*!
+ * \note
+ * This function is a part of low-level SObjectizer's interface.
+ * Because of that this function can be removed or changed in some
+ * future version without prior notice.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline void
+deliver_messages(
+	//! Destination for messages.
+	abstract_message_box_t & target,
+	//! Subscription type for those messages.
+	const std::type_index & subscription_type,
+	//! Messages to be delivered.
+	const std::vector< message_ref_t > & msgs )
+	{
+		if( !msgs.empty() )
+			target.do_deliver_messages(
+					subscription_type,
+					msgs.data(),
+					msgs.size(),
+					1u );
+	}
+
 //! Deliver signal.
 /*!
  * \attention
@@ -12,6 +12,7 @@
 #include <so_5/declspec.hpp>
 #include <so_5/exception.hpp>
 #include <so_5/atomic_refcounted.hpp>
+#include <so_5/message_pool.hpp>
 #include <so_5/types.hpp>
 
 #include <so_5/agent_ref_fwd.hpp>
@@ -862,13 +863,25 @@ struct make_message_instance_impl
 	{
 		using E = typename message_payload_type< Msg >::envelope_type;
 
+		//! Should the instance be allocated via message pool?
+		/*!
+		 * \since
+		 * v.5.6.2
+		 */
+		static constexpr bool use_pool = pooled_message_allocation<
+				typename message_payload_type< Msg >::payload_type >::value;
+
 		template< typename... Args >
 		static std::unique_ptr< E >
 		make( Args &&... args )
 			{
 				ensure_not_signal< Msg >();
 
-				return std::unique_ptr< E >( new E( std::forward< Args >(args)... ) );
+				if constexpr( use_pool )
+					return std::unique_ptr< E >(
+							new pooled_envelope_t< E >( std::forward< Args >(args)... ) );
+				else
+					return std::unique_ptr< E >( new E( std::forward< Args >(args)... ) );
 			}
 	};
 
@@ -902,6 +915,8 @@ make_message_instance( Args &&... args )
 
 } /* namespace details */
 
+struct demand_descriptor_t;
+
 namespace message_limit
 {
 
@@ -1007,6 +1022,22 @@ struct control_block_t
 		//! Limit overflow reaction.
 		action_t m_action;
 
+		//! Descriptors for demands with messages of that type.
+		/*!
+		 * It is an array with a descriptor for every kind of demand
+		 * which can be created for a message. It is filled by the owner
+		 * of the control block.
+		 *
+		 * \note
+		 * This pointer isn't copied by the copy constructor and
+		 * the copy operator because descriptors refer to the
+		 * original control block.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		const demand_descriptor_t * m_demand_descriptors{ nullptr };
+
 		//! Initializing constructor.
 		control_block_t(
 			unsigned int limit,
@@ -0,0 +1,347 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Pooled allocation of message instances.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/message_pool.hpp>
+
+#include <so_5/spinlocks.hpp>
+
+#include <array>
+#include <mutex>
+#include <new>
+
+namespace so_5
+{
+
+namespace message_pool
+{
+
+namespace
+{
+
+/*!
+ * \brief Granularity of size classes.
+ */
+constexpr std::size_t size_class_granularity = 16u;
+
+/*!
+ * \brief Count of size classes.
+ */
+constexpr std::size_t size_classes_count =
+		max_pooled_block_size / size_class_granularity;
+
+/*!
+ * \brief Max count of free blocks of one size class in a thread cache.
+ */
+constexpr std::size_t max_blocks_in_thread_cache = 128u;
+
+/*!
+ * \brief Count of blocks moved between a thread cache and
+ * the global depot at once.
+ */
+constexpr std::size_t transfer_batch_size = max_blocks_in_thread_cache / 2u;
+
+/*!
+ * \brief Max amount of memory of one size class kept in the global depot.
+ */
+constexpr std::size_t max_depot_bytes_per_size_class = 4u * 1024u * 1024u;
+
+inline std::size_t
+size_class_index( std::size_t size ) noexcept
+	{
+		return (size + size_class_granularity - 1u) / size_class_granularity - 1u;
+	}
+
+inline std::size_t
+size_class_block_size( std::size_t index ) noexcept
+	{
+		return (index + 1u) * size_class_granularity;
+	}
+
+inline std::size_t
+max_batches_in_depot( std::size_t index ) noexcept
+	{
+		return max_depot_bytes_per_size_class /
+				(size_class_block_size( index ) * transfer_batch_size);
+	}
+
+//
+// free_block_t
+//
+/*!
+ * \brief Header of a free block.
+ *
+ * The size of any block is not less than size_class_granularity, so
+ * there is enough place for two pointers.
+ */
+struct free_block_t
+	{
+		//! Next block in the same list.
+		free_block_t * m_next;
+		//! Next batch in the global depot.
+		/*!
+		 * Has a value only for the first block of a batch.
+		 */
+		free_block_t * m_next_batch;
+	};
+
+static_assert( sizeof(free_block_t) <= size_class_granularity,
+		"free_block_t must fit into the smallest block" );
+
+void
+free_chain( free_block_t * head, std::size_t block_size ) noexcept
+	{
+		while( head )
+			{
+				auto * next = head->m_next;
+				::operator delete( head, block_size );
+				head = next;
+			}
+	}
+
+//
+// global_depot_t
+//
+/*!
+ * \brief Storage of batches of free blocks shared between all threads.
+ */
+class global_depot_t
+	{
+	public :
+		//! Get a batch of free blocks for the specified size class.
+		/*!
+		 * \return nullptr if there is no free batches.
+		 */
+		free_block_t *
+		take_batch( std::size_t index ) noexcept
+			{
+				auto & c = m_classes[ index ];
+				std::lock_guard< default_spinlock_t > lock{ c.m_lock };
+
+				auto * batch = c.m_head;
+				if( batch )
+					{
+						c.m_head = batch->m_next_batch;
+						--c.m_batches;
+					}
+
+				return batch;
+			}
+
+		//! Store a batch of free blocks for the specified size class.
+		/*!
+		 * If the depot is full then blocks are returned to the global heap.
+		 */
+		void
+		put_batch( std::size_t index, free_block_t * batch ) noexcept
+			{
+				auto & c = m_classes[ index ];
+				{
+					std::lock_guard< default_spinlock_t > lock{ c.m_lock };
+
+					if( c.m_batches < max_batches_in_depot( index ) )
+						{
+							batch->m_next_batch = c.m_head;
+							c.m_head = batch;
+							++c.m_batches;
+							return;
+						}
+				}
+
+				free_chain( batch, size_class_block_size( index ) );
+			}
+
+	private :
+		struct size_class_t
+			{
+				default_spinlock_t m_lock;
+				free_block_t * m_head = nullptr;
+				std::size_t m_batches = 0u;
+			};
+
+		std::array< size_class_t, size_classes_count > m_classes;
+	};
+
+//! Access to the global depot.
+/*!
+ * \note
+ * The depot is never destroyed because thread caches of threads
+ * those are still running at the process shutdown can use it.
+ */
+global_depot_t &
+global_depot()
+	{
+		static global_depot_t * depot = new global_depot_t();
+		return *depot;
+	}
+
+//
+// thread_cache_t
+//
+/*!
+ * \brief Free lists of the current thread.
+ */
+class thread_cache_t
+	{
+	public :
+		thread_cache_t();
+		~thread_cache_t();
+
+		void *
+		allocate( std::size_t index )
+			{
+				auto & b = m_buckets[ index ];
+				if( !b.m_head )
+					{
+						b.m_head = global_depot().take_batch( index );
+						if( !b.m_head )
+							return ::operator new( size_class_block_size( index ) );
+
+						b.m_size = transfer_batch_size;
+					}
+
+				auto * block = b.m_head;
+				b.m_head = block->m_next;
+				--b.m_size;
+
+				return block;
+			}
+
+		void
+		deallocate( std::size_t index, void * ptr ) noexcept
+			{
+				auto & b = m_buckets[ index ];
+
+				auto * block = static_cast< free_block_t * >( ptr );
+				block->m_next = b.m_head;
+				b.m_head = block;
+				++b.m_size;
+
+				if( b.m_size > max_blocks_in_thread_cache )
+					global_depot().put_batch( index, detach_batch( b ) );
+			}
+
+	private :
+		struct bucket_t
+			{
+				free_block_t * m_head = nullptr;
+				std::size_t m_size = 0u;
+			};
+
+		std::array< bucket_t, size_classes_count > m_buckets;
+
+		//! Detach the first transfer_batch_size blocks from a bucket.
+		/*!
+		 * \attention
+		 * The bucket must contain at least transfer_batch_size blocks.
+		 */
+		static free_block_t *
+		detach_batch( bucket_t & b ) noexcept
+			{
+				auto * last = b.m_head;
+				for( std::size_t i = 1u; i != transfer_batch_size; ++i )
+					last = last->m_next;
+
+				auto * batch = b.m_head;
+				b.m_head = last->m_next;
+				b.m_size -= transfer_batch_size;
+				last->m_next = nullptr;
+
+				return batch;
+			}
+	};
+
+//! State of the thread cache for the current thread.
+/*!
+ * It is a trivially destructible object so it can be safely checked
+ * during the destruction of other thread-local objects.
+ */
+enum class thread_cache_state_t : unsigned char
+	{
+		not_created,
+		alive,
+		destroyed
+	};
+
+thread_local thread_cache_state_t g_thread_cache_state =
+		thread_cache_state_t::not_created;
+
+thread_cache_t::thread_cache_t()
+	{
+		g_thread_cache_state = thread_cache_state_t::alive;
+	}
+
+thread_cache_t::~thread_cache_t()
+	{
+		g_thread_cache_state = thread_cache_state_t::destroyed;
+
+		// Only full batches go to the depot. The rest is returned
+		// to the global heap.
+		for( std::size_t i = 0u; i != size_classes_count; ++i )
+			{
+				auto & b = m_buckets[ i ];
+				while( b.m_size >= transfer_batch_size )
+					global_depot().put_batch( i, detach_batch( b ) );
+
+				free_chain( b.m_head, size_class_block_size( i ) );
+			}
+	}
+
+//! Get the thread cache for the current thread.
+/*!
+ * \return nullptr if the thread cache is already destroyed.
+ */
+thread_cache_t *
+current_thread_cache()
+	{
+		if( thread_cache_state_t::destroyed == g_thread_cache_state )
+			return nullptr;
+
+		static thread_local thread_cache_t cache;
+		return &cache;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void *
+allocate( std::size_t size )
+	{
+		if( size > max_pooled_block_size )
+			return ::operator new( size );
+
+		const auto index = size_class_index( size );
+		auto * cache = current_thread_cache();
+		if( cache )
+			return cache->allocate( index );
+		else
+			return ::operator new( size_class_block_size( index ) );
+	}
+
+SO_5_FUNC void
+deallocate( void * ptr, std::size_t size ) noexcept
+	{
+		if( size > max_pooled_block_size )
+			{
+				::operator delete( ptr, size );
+				return;
+			}
+
+		const auto index = size_class_index( size );
+		auto * cache = current_thread_cache();
+		if( cache )
+			cache->deallocate( index, ptr );
+		else
+			::operator delete( ptr, size_class_block_size( index ) );
+	}
+
+} /* namespace message_pool */
+
+} /* namespace so_5 */
@@ -0,0 +1,180 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Pooled allocation of message instances.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace so_5
+{
+
+namespace message_pool
+{
+
+/*!
+ * \brief Max size of a block which can be served by message pool.
+ *
+ * Blocks of bigger sizes are allocated and deallocated by
+ * the global operator new/delete.
+ *
+ * \since
+ * v.5.6.2
+ */
+constexpr std::size_t max_pooled_block_size = 512u;
+
+/*!
+ * \brief Allocate a block for a message instance.
+ *
+ * The block is taken from the free list of the current thread.
+ * If that list is empty a batch of free blocks is taken from
+ * the global depot. The global operator new is used only if
+ * the depot is empty too.
+ *
+ * \attention
+ * This function is part of SObjectizer's implementation.
+ * It can be changed or removed in future versions.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC void *
+allocate( std::size_t size );
+
+/*!
+ * \brief Return a block of a message instance to the pool.
+ *
+ * The block is placed into the free list of the current thread (it is
+ * not necessary the thread which allocated the block). When that list
+ * becomes too long a part of it is moved to the global depot.
+ *
+ * \attention
+ * \a size must be the same value which was passed to allocate().
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC void
+deallocate( void * ptr, std::size_t size ) noexcept;
+
+} /* namespace message_pool */
+
+//
+// pooled_message_allocation
+//
+/*!
+ * \brief A trait for turning on pooled allocation of message instances.
+ *
+ * By default every message instance is allocated by the global
+ * operator new. If a message type is sent at high rate the cost
+ * of malloc/free can be significant. This trait can be specialized
+ * for such types:
+ * \code
+ * struct tick { std::uint64_t m_seq; };
+ * struct data_chunk : public so_5::message_t { ... };
+ *
+ * namespace so_5 {
+ * template<> struct pooled_message_allocation< tick > : public std::true_type {};
+ * template<> struct pooled_message_allocation< data_chunk > : public std::true_type {};
+ * }
+ * \endcode
+ * After that instances of `tick` and `data_chunk` created by send(),
+ * send_delayed(), message_holder_t::make() and so on will be
+ * allocated and deallocated via so_5::message_pool.
+ *
+ * \note
+ * The trait must be specialized for the payload type. It is not
+ * necessary to specialize it for mutable_msg<T> or immutable_msg<T>.
+ *
+ * \note
+ * A type derived from message_t must not be marked as `final` if
+ * pooled allocation is turned on for it.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Msg >
+struct pooled_message_allocation : public std::false_type {};
+
+namespace details
+{
+
+//
+// pooled_envelope_t
+//
+/*!
+ * \brief An envelope type for a message with pooled allocation.
+ *
+ * The instance of that type is used instead of an instance of \a E.
+ * Class-specific operator new/delete redirect allocation to
+ * so_5::message_pool. Because message_t has a virtual destructor the
+ * deletion of the last message_ref_t to the instance goes to
+ * operator delete of that type.
+ *
+ * \note
+ * Blocks from so_5::message_pool have the default alignment of operator
+ * new. Instances of over-aligned types (like `alignas(64)`) are
+ * allocated by the global aligned operator new instead of the pool.
+ *
+ * \tparam E actual envelope type (user_type_message_t<T> or a type
+ * derived from message_t).
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename E >
+class pooled_envelope_t final : public E
+	{
+		static_assert( !std::is_final< E >::value,
+				"pooled allocation can't be used for a final message type" );
+
+	public :
+		template< typename... Args >
+		pooled_envelope_t( Args &&... args )
+			:	E( std::forward< Args >( args )... )
+			{}
+
+		static void *
+		operator new( std::size_t size )
+			{
+				return ::so_5::message_pool::allocate( size );
+			}
+
+		static void
+		operator delete( void * ptr, std::size_t size ) noexcept
+			{
+				::so_5::message_pool::deallocate( ptr, size );
+			}
+
+		static void *
+		operator new( std::size_t size, std::align_val_t alignment )
+			{
+				return ::operator new( size, alignment );
+			}
+
+		static void
+		operator delete(
+			void * ptr,
+			std::size_t size,
+			std::align_val_t alignment ) noexcept
+			{
+				::operator delete( ptr, size, alignment );
+			}
+	};
+
+} /* namespace details */
+
+} /* namespace so_5 */
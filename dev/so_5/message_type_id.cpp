@@ -0,0 +1,311 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Dense integer identifiers of message types.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#include <so_5/message_type_id.hpp>
+
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace so_5
+{
+
+namespace
+{
+
+//
+// alias_table_t
+//
+/*!
+ * \brief A table for fast search of identifiers by pointers to names
+ * of types.
+ *
+ * The pointer to the type name is unique for every std::type_info
+ * object. But there can be several std::type_info objects for the same
+ * type (if the type is used in different shared libraries). So there
+ * can be several aliases for the same identifier.
+ *
+ * It is an open-addressing hash table with linear probing. Items are
+ * only added and never removed. So it can be safely read without any
+ * locks while a new item is being added.
+ */
+class alias_table_t
+	{
+		struct slot_t
+			{
+				std::atomic< const char * > m_name{ nullptr };
+				std::atomic< message_type_id_t > m_id{ null_message_type_id };
+			};
+
+	public :
+		explicit alias_table_t( std::size_t capacity )
+			:	m_mask{ capacity - 1u }
+			,	m_slots{ new slot_t[ capacity ] }
+			{}
+
+		std::size_t
+		capacity() const noexcept { return m_mask + 1u; }
+
+		//! Try to find the identifier by the name.
+		/*!
+		 * \return false if there is no such name.
+		 */
+		bool
+		find( const char * name, message_type_id_t & id ) const noexcept
+			{
+				for( auto i = hash_of( name ) & m_mask; ; i = ( i + 1u ) & m_mask )
+					{
+						const auto * current =
+								m_slots[ i ].m_name.load( std::memory_order_acquire );
+						if( current == name )
+							{
+								id = m_slots[ i ].m_id.load( std::memory_order_relaxed );
+								return true;
+							}
+						else if( !current )
+							return false;
+					}
+			}
+
+		//! Add a new name.
+		/*!
+		 * \attention
+		 * Must be called only by one thread at a time.
+		 * The table must have a free slot.
+		 */
+		void
+		add( const char * name, message_type_id_t id ) noexcept
+			{
+				auto i = hash_of( name ) & m_mask;
+				while( m_slots[ i ].m_name.load( std::memory_order_relaxed ) )
+					i = ( i + 1u ) & m_mask;
+
+				m_slots[ i ].m_id.store( id, std::memory_order_relaxed );
+				m_slots[ i ].m_name.store( name, std::memory_order_release );
+			}
+
+		//! Copy all names into another table.
+		void
+		copy_to( alias_table_t & to ) const noexcept
+			{
+				for( std::size_t i = 0u; i != capacity(); ++i )
+					{
+						const auto * name =
+								m_slots[ i ].m_name.load( std::memory_order_relaxed );
+						if( name )
+							to.add(
+									name,
+									m_slots[ i ].m_id.load( std::memory_order_relaxed ) );
+					}
+			}
+
+	private :
+		const std::size_t m_mask;
+		std::unique_ptr< slot_t[] > m_slots;
+
+		static std::size_t
+		hash_of( const char * name ) noexcept
+			{
+				// Fibonacci hashing of the pointer value.
+				const auto v = static_cast< std::uint64_t >(
+						reinterpret_cast< std::uintptr_t >( name ) );
+				return static_cast< std::size_t >(
+						( v * 0x9E3779B97F4A7C15ull ) >> 32 );
+			}
+	};
+
+//
+// registry_t
+//
+/*!
+ * \brief The registry of message type identifiers.
+ */
+class registry_t
+	{
+	public :
+		registry_t()
+			{
+				std::unique_ptr< alias_table_t > table{
+						new alias_table_t( initial_capacity ) };
+				m_aliases.store( table.get(), std::memory_order_release );
+				m_tables.push_back( std::move(table) );
+
+				// void must receive null_message_type_id.
+				register_type( typeid(void) );
+			}
+
+		message_type_id_t
+		id_of( const std::type_index & type )
+			{
+				message_type_id_t id;
+				if( m_aliases.load( std::memory_order_acquire )->find(
+						type.name(), id ) )
+					return id;
+
+				return register_type( type );
+			}
+
+		bool
+		find( const std::type_index & type, message_type_id_t & id ) noexcept
+			{
+				if( m_aliases.load( std::memory_order_acquire )->find(
+						type.name(), id ) )
+					return true;
+
+				// The type can be registered under another alias.
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				const auto it = m_ids.find( type );
+				if( it == m_ids.end() )
+					return false;
+
+				id = it->second;
+				return true;
+			}
+
+		std::type_index
+		type_of( message_type_id_t id )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( id >= m_types.size() )
+					SO_5_THROW_EXCEPTION(
+							rc_unknown_message_type_id,
+							"unknown message type id: " + std::to_string( id ) );
+
+				return m_types[ id ];
+			}
+
+	private :
+		static constexpr std::size_t initial_capacity = 256u;
+
+		//! The current table for fast search.
+		std::atomic< const alias_table_t * > m_aliases{ nullptr };
+
+		//! Lock for registration of new types.
+		std::mutex m_lock;
+
+		//! Identifiers of registered types.
+		std::map< std::type_index, message_type_id_t > m_ids;
+
+		//! Registered types. Identifier is an index in that vector.
+		std::vector< std::type_index > m_types;
+
+		//! All created tables.
+		/*!
+		 * Old tables can't be destroyed because they can be used by
+		 * readers. The total size of old tables doesn't exceed
+		 * the size of the current table.
+		 */
+		std::vector< std::unique_ptr< alias_table_t > > m_tables;
+
+		//! Count of names in the current table.
+		std::size_t m_aliases_count{ 0u };
+
+		message_type_id_t
+		register_type( const std::type_index & type )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				const char * name = type.name();
+
+				// The name can be added by another thread already.
+				message_type_id_t id;
+				if( m_aliases.load( std::memory_order_acquire )->find( name, id ) )
+					return id;
+
+				auto it = m_ids.find( type );
+				if( it == m_ids.end() )
+					{
+						id = static_cast< message_type_id_t >( m_types.size() );
+						m_types.reserve( m_types.size() + 1u );
+						it = m_ids.emplace( type, id ).first;
+						m_types.push_back( type );
+					}
+				else
+					// It is a new alias for an already registered type.
+					id = it->second;
+
+				add_alias( name, id );
+
+				return id;
+			}
+
+		void
+		add_alias( const char * name, message_type_id_t id )
+			{
+				auto * current = m_tables.back().get();
+
+				// Load factor must not exceed 1/2.
+				if( ( m_aliases_count + 1u ) * 2u > current->capacity() )
+					{
+						std::unique_ptr< alias_table_t > table{
+								new alias_table_t( current->capacity() * 2u ) };
+						current->copy_to( *table );
+
+						m_tables.reserve( m_tables.size() + 1u );
+						current = table.get();
+						current->add( name, id );
+
+						m_aliases.store( current, std::memory_order_release );
+						m_tables.push_back( std::move(table) );
+					}
+				else
+					current->add( name, id );
+
+				++m_aliases_count;
+			}
+	};
+
+//! Access to the registry.
+/*!
+ * \note
+ * The registry is never destroyed because message types can be
+ * used by threads which are still running at the process shutdown.
+ */
+registry_t &
+registry()
+	{
+		static registry_t * r = new registry_t();
+		return *r;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & type )
+	{
+		return registry().id_of( type );
+	}
+
+SO_5_FUNC bool
+find_message_type_id(
+	const std::type_index & type,
+	message_type_id_t & id ) noexcept
+	{
+		return registry().find( type, id );
+	}
+
+SO_5_FUNC std::type_index
+message_type_by_id( message_type_id_t id )
+	{
+		return registry().type_of( id );
+	}
+
+} /* namespace so_5 */
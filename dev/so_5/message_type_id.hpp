@@ -0,0 +1,126 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \file
+ * \brief Dense integer identifiers of message types.
+ *
+ * \since
+ * v.5.6.2
+ */
+
+#pragma once
+
+#include <so_5/declspec.hpp>
+#include <so_5/message.hpp>
+
+#include <cstdint>
+#include <typeindex>
+
+namespace so_5
+{
+
+/*!
+ * \brief Type of the integer identifier of a message type.
+ *
+ * Every message type gets its own identifier at the first use.
+ * Identifiers are dense: they are assigned sequentially starting
+ * from 0. So they can be used as indexes in arrays and as keys for
+ * very cheap hash tables.
+ *
+ * Identifiers are process-wide. The same type gets the same identifier
+ * even if it is used from different shared libraries. But identifiers
+ * can differ from run to run, so they must not be stored outside of
+ * the process.
+ *
+ * \since
+ * v.5.6.2
+ */
+using message_type_id_t = std::uint32_t;
+
+/*!
+ * \brief Identifier for `void` type.
+ *
+ * It is used as an identifier of message type for demands without
+ * messages (like demands for so_evt_start()/so_evt_finish()).
+ *
+ * \since
+ * v.5.6.2
+ */
+constexpr message_type_id_t null_message_type_id = 0u;
+
+/*!
+ * \brief Get the identifier for a message type.
+ *
+ * A new identifier is assigned if \a type is used for the first time.
+ *
+ * \note
+ * After the first call for a particular type this function doesn't
+ * acquire any locks and doesn't calculate the hash of the type name.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & type );
+
+/*!
+ * \brief Find the identifier for a message type without its assignment.
+ *
+ * Unlike message_type_id() this function doesn't assign a new
+ * identifier if \a type isn't used yet.
+ *
+ * \return false if there is no identifier for \a type.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC bool
+find_message_type_id(
+	const std::type_index & type,
+	message_type_id_t & id ) noexcept;
+
+/*!
+ * \brief Get the message type by its identifier.
+ *
+ * Intended to be used for diagnostic purposes only.
+ *
+ * \throw so_5::exception_t if \a id isn't assigned yet.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC std::type_index
+message_type_by_id( message_type_id_t id );
+
+/*!
+ * \brief Get the identifier for a message type known at compile time.
+ *
+ * The identifier is obtained only once and then it is stored
+ * in a static variable.
+ *
+ * \note
+ * The identifier is the same as for the subscription to \a Msg.
+ * So the identifiers for `Msg` and `so_5::immutable_msg<Msg>` are
+ * the same.
+ *
+ * Usage example:
+ * \code
+ * const auto id = so_5::message_type_id_of< my_message >();
+ * \endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Msg >
+message_type_id_t
+message_type_id_of()
+	{
+		static const message_type_id_t id = message_type_id(
+				message_payload_type< Msg >::subscription_type_index() );
+
+		return id;
+	}
+
+} /* namespace so_5 */
@@ -45,6 +45,8 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 
 		# Run-time.
 		cpp_source 'message.cpp'
+		cpp_source 'message_pool.cpp'
+		cpp_source 'message_type_id.cpp'
 		cpp_source 'enveloped_msg.cpp'
 		cpp_source 'handler_makers.cpp'
 
@@ -76,9 +78,12 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 			cpp_source 'subscr_storage_map_based.cpp'
 			cpp_source 'subscr_storage_hash_table_based.cpp'
 			cpp_source 'subscr_storage_adaptive.cpp'
+			cpp_source 'subscr_storage_frozen.cpp'
 
 			cpp_source 'process_unhandled_exception.cpp'
 
+			cpp_source 'epoch_reclamation.cpp'
+			cpp_source 'demand_descriptors.cpp'
 			cpp_source 'named_local_mbox.cpp'
 			cpp_source 'mbox_core.cpp'
 
@@ -113,6 +118,11 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'pub.cpp'
 			}
 
+			sources_root( 'reuse' ) {
+				cpp_source 'thread_affinity.cpp'
+				cpp_source 'local_timer_queue.cpp'
+			}
+
 			sources_root( 'one_thread' ) {
 				cpp_source 'pub.cpp'
 			}
@@ -147,6 +157,18 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 					cpp_source 'pub.cpp'
 				}
 			}
+
+			sources_root( 'reactor' ) {
+				cpp_source 'pub.cpp'
+			}
+
+			sources_root( 'edf' ) {
+				cpp_source 'pub.cpp'
+			}
+
+			sources_root( 'prio_thread_pool' ) {
+				cpp_source 'pub.cpp'
+			}
 		}
 
 		sources_root( 'experimental' ) {
@@ -58,6 +58,27 @@ class manager_for_combined_locks_t
 			}
 	};
 
+//
+// manager_for_lock_free_queues_t
+//
+
+class manager_for_lock_free_queues_t
+	:	public queue_locks_defaults_manager_t
+	{
+	public :
+		virtual so_5::disp::mpsc_queue_traits::lock_factory_t
+		mpsc_queue_lock_factory() override
+			{
+				return so_5::disp::mpsc_queue_traits::lock_free_queue_factory();
+			}
+
+		virtual so_5::disp::mpmc_queue_traits::lock_factory_t
+		mpmc_queue_lock_factory() override
+			{
+				return so_5::disp::mpmc_queue_traits::combined_lock_factory();
+			}
+	};
+
 } /* namespace anonymous */
 
 //
@@ -78,5 +99,14 @@ make_defaults_manager_for_combined_locks()
 		return std::make_unique< manager_for_combined_locks_t >();
 	}
 
+//
+// make_defaults_manager_for_lock_free_queues
+//
+SO_5_FUNC queue_locks_defaults_manager_unique_ptr_t
+make_defaults_manager_for_lock_free_queues()
+	{
+		return std::make_unique< manager_for_lock_free_queues_t >();
+	}
+
 } /* namespace so_5 */
 
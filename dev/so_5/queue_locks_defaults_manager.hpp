@@ -94,5 +94,22 @@ make_defaults_manager_for_simple_locks();
 SO_5_FUNC queue_locks_defaults_manager_unique_ptr_t
 make_defaults_manager_for_combined_locks();
 
+//
+// make_defaults_manager_for_lock_free_queues
+//
+/*!
+ * \brief A factory for queue_locks_defaults_manager with
+ * generators for locks which allow usage of lock-free MPSC queues.
+ *
+ * Combined locks are used for MPMC queues.
+ *
+ * \sa so_5::disp::mpsc_queue_traits::lock_free_queue_factory().
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC queue_locks_defaults_manager_unique_ptr_t
+make_defaults_manager_for_lock_free_queues();
+
 } /* namespace so_5 */
 
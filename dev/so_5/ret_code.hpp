@@ -592,6 +592,56 @@ const int rc_extensible_select_is_active_now = 187;
  */
 const int rc_prepared_select_is_active_now = 188;
 
+/*!
+ * \brief An unknown identifier of message type.
+ *
+ * \since
+ * v.5.6.2
+ */
+const int rc_unknown_message_type_id = 189;
+
+/*!
+ * \brief There are too many message types to be handled.
+ *
+ * \since
+ * v.5.6.2
+ */
+const int rc_too_many_message_types = 190;
+
+/*!
+ * \brief CPU affinity for work threads can't be applied.
+ *
+ * For example, the list of CPUs is empty or there is no
+ * NUMA node with the specified index.
+ *
+ * \since
+ * v.5.6.2
+ */
+const int rc_invalid_thread_affinity = 191;
+
+/*!
+ * \brief A file descriptor can't be watched or unwatched by
+ * reactor dispatcher.
+ *
+ * For example, the agent isn't bound to the dispatcher or the file
+ * descriptor is already watched.
+ *
+ * \since
+ * v.5.6.2
+ */
+const int rc_fd_watching_failed = 192;
+
+/*!
+ * \brief A timer can't be rescheduled.
+ *
+ * For example, the timer_id is empty, the timer is already released or
+ * a new message has different type.
+ *
+ * \since
+ * v.5.6.2
+ */
+const int rc_timer_cannot_be_rescheduled = 193;
+
 //! \name Common error codes.
 //! \{
 
@@ -16,6 +16,9 @@
 
 #include <so_5/compiler_features.hpp>
 
+#include <iterator>
+#include <vector>
+
 namespace so_5
 {
 
@@ -90,6 +93,21 @@ namespace impl
 							pause,
 							period );
 				}
+
+			template< typename... Args >
+			static void
+			reschedule(
+				timer_id_t & timer,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period,
+				Args &&... args )
+				{
+					timer.reschedule(
+							message_payload_type< Message >::subscription_type_index(),
+							message_ref_t{ make_instance( std::forward<Args>(args)... ) },
+							pause,
+							period );
+				}
 		};
 
 	template< class Message >
@@ -130,6 +148,19 @@ namespace impl
 							pause,
 							period );
 				}
+
+			static void
+			reschedule(
+				timer_id_t & timer,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period )
+				{
+					timer.reschedule(
+							message_payload_type< Message >::subscription_type_index(),
+							message_ref_t{},
+							pause,
+							period );
+				}
 		};
 
 	template< class Message >
@@ -345,6 +376,93 @@ send(
 				what.make_reference() );
 	}
 
+/*!
+ * \brief A utility function for creating and delivering several
+ * messages of the same type at once.
+ *
+ * A new instance of \a Message is created for every item in
+ * [\a first, \a last). The item is passed to the Message's
+ * constructor. Then all instances are delivered to \a to as one batch.
+ *
+ * Delivery of a batch is cheaper than a series of send() calls:
+ * the destination mbox acquires its lock and looks for subscribers
+ * only once, and each receiver's event queue is locked only once for
+ * all messages of the batch. Message limits and delivery filters are
+ * applied to every message individually. The order of messages is
+ * preserved for every receiver.
+ *
+ * Usage example:
+ * \code
+	struct price_update { std::string m_ticker; double m_price; };
+
+	std::vector< price_update > updates = collect_updates();
+	so_5::send_batch< price_update >( dest, updates.begin(), updates.end() );
+
+	// Instances can be constructed from values of another type too.
+	std::vector< int > values{ 1, 2, 3 };
+	so_5::send_batch< so_5::mutable_msg< value_msg > >(
+			consumer_agent, values.begin(), values.end() );
+ * \endcode
+ *
+ * \note
+ * Signals can't be sent by this function.
+ *
+ * \tparam Message type of message to be sent (it can be in form of
+ * Msg, so_5::immutable_msg<Msg> or so_5::mutable_msg<Msg>).
+ * \tparam Target can be so_5::mbox_t, so_5::agent_t or so_5::mchain_t.
+ * \tparam Input_It type of iterator for the source items.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename Target, typename Input_It >
+void
+send_batch( Target && to, Input_It first, Input_It last )
+	{
+		static_assert(
+				!is_signal< typename message_payload_type< Message >::payload_type >::value,
+				"send_batch() can't be used for signals" );
+
+		std::vector< message_ref_t > msgs;
+		for(; first != last; ++first )
+			{
+				auto msg_instance =
+						so_5::details::make_message_instance< Message >( *first );
+				so_5::details::mark_as_mutable_if_necessary< Message >(
+						*msg_instance );
+
+				msgs.emplace_back( std::move(msg_instance) );
+			}
+
+		so_5::low_level_api::deliver_messages(
+				*send_functions_details::arg_to_mbox( std::forward<Target>(to) ),
+				message_payload_type< Message >::subscription_type_index(),
+				msgs );
+	}
+
+/*!
+ * \brief A version of %send_batch function for a whole range.
+ *
+ * Usage example:
+ * \code
+	std::vector< price_update > updates = collect_updates();
+	so_5::send_batch< price_update >( dest, updates );
+ * \endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename Target, typename Range >
+void
+send_batch( Target && to, const Range & range )
+	{
+		using std::begin;
+		using std::end;
+
+		send_batch< Message >(
+				std::forward<Target>(to), begin( range ), end( range ) );
+	}
+
 /*!
  * \brief A utility function for creating and delivering a delayed message
  * to the specified destination.
@@ -608,6 +726,96 @@ send_periodic(
 				std::forward< Args >(args)... );
 	}
 
+/*!
+ * \brief A utility function for rescheduling of an existing timer with
+ * a new instance of delayed message.
+ *
+ * The timer is reused: it is deactivated (if it is still active) and
+ * then activated again with the new message. The destination of
+ * the message is not changed.
+ *
+ * Usage example:
+ * \code
+	class connection_handler final : public so_5::agent_t {
+		so_5::timer_id_t m_timeout;
+		...
+		void on_request(mhood_t<request> cmd) {
+			// Timer is started for the first time.
+			if( !m_timeout.is_active() )
+				m_timeout = so_5::send_periodic< request_timeout >(
+						*this, 5s, 0s, cmd->m_id );
+			// Timer is reused.
+			else
+				so_5::reschedule_delayed< request_timeout >(
+						m_timeout, 5s, cmd->m_id );
+		}
+	};
+ * \endcode
+ *
+ * \attention
+ * Message must be of the same type as the message the timer was created for.
+ *
+ * \attention
+ * Value of \a pause should be non-negative.
+ *
+ * \tparam Message type of message or signal to be sent.
+ * \tparam Args list of arguments for Message's constructor.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename... Args >
+void
+reschedule_delayed(
+	//! Timer to be rescheduled.
+	timer_id_t & timer,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Message constructor parameters.
+	Args&&... args )
+	{
+		so_5::impl::instantiator_and_sender< Message >::reschedule(
+				timer,
+				pause,
+				std::chrono::steady_clock::duration::zero(),
+				std::forward< Args >(args)... );
+	}
+
+/*!
+ * \brief A utility function for rescheduling of an existing timer with
+ * a new instance of periodic message.
+ *
+ * \attention
+ * Message must be of the same type as the message the timer was created for.
+ *
+ * \attention
+ * Values of \a pause and \a period should be non-negative.
+ *
+ * \tparam Message type of message or signal to be sent.
+ * \tparam Args list of arguments for Message's constructor.
+ *
+ * \since
+ * v.5.6.2
+ */
+template< typename Message, typename... Args >
+void
+reschedule_periodic(
+	//! Timer to be rescheduled.
+	timer_id_t & timer,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Period of message repetitions.
+	std::chrono::steady_clock::duration period,
+	//! Message constructor parameters.
+	Args&&... args )
+	{
+		so_5::impl::instantiator_and_sender< Message >::reschedule(
+				timer,
+				pause,
+				period,
+				std::forward< Args >(args)... );
+	}
+
 /*!
  * \brief A utility function for delivering a periodic
  * from an existing message hood.
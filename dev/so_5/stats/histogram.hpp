@@ -0,0 +1,128 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.6.2
+ *
+ * \brief A simple histogram for distributions of run-time values.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+/*!
+ * \brief A histogram with power-of-two buckets.
+ *
+ * Bucket 0 holds zero values. Bucket i (i > 0) holds values
+ * in the range [2^(i-1), 2^i). The last bucket also holds all
+ * values which are greater than its upper bound.
+ *
+ * Count, sum and max of all added values are also stored.
+ *
+ * \note The type isn't thread safe.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct histogram_t
+	{
+		//! Count of buckets.
+		static constexpr std::size_t bucket_count = 24u;
+
+		//! Count of values in every bucket.
+		std::array< std::uint_fast64_t, bucket_count > m_buckets{};
+
+		//! Total count of values.
+		std::uint_fast64_t m_count{};
+
+		//! Sum of all values.
+		std::uint_fast64_t m_sum{};
+
+		//! Max value.
+		std::uint_fast64_t m_max{};
+
+		//! Get index of bucket for a value.
+		static std::size_t
+		bucket_index( std::uint_fast64_t value ) noexcept
+			{
+				std::size_t index = 0u;
+				while( value && index != bucket_count - 1u )
+					{
+						value >>= 1u;
+						++index;
+					}
+
+				return index;
+			}
+
+		//! Get the lower bound of bucket's range.
+		static std::uint_fast64_t
+		bucket_lower_bound( std::size_t index ) noexcept
+			{
+				return index ? std::uint_fast64_t{ 1u } << ( index - 1u ) : 0u;
+			}
+
+		//! Add a value.
+		void
+		add( std::uint_fast64_t value ) noexcept
+			{
+				++m_buckets[ bucket_index( value ) ];
+				++m_count;
+				m_sum += value;
+				if( m_max < value )
+					m_max = value;
+			}
+
+		//! Add all values from another histogram.
+		void
+		merge( const histogram_t & other ) noexcept
+			{
+				for( std::size_t i = 0u; i != bucket_count; ++i )
+					m_buckets[ i ] += other.m_buckets[ i ];
+				m_count += other.m_count;
+				m_sum += other.m_sum;
+				if( m_max < other.m_max )
+					m_max = other.m_max;
+			}
+
+		//! Get an approximation of a percentile.
+		/*!
+		 * \return lower bound of the bucket in which the percentile falls.
+		 * Or 0 if the histogram is empty.
+		 */
+		std::uint_fast64_t
+		percentile(
+			//! Percentile in range [0.0, 1.0].
+			double p ) const noexcept
+			{
+				const auto threshold = static_cast< std::uint_fast64_t >(
+						static_cast< double >( m_count ) * p );
+
+				std::uint_fast64_t accumulated = 0u;
+				for( std::size_t i = 0u; i != bucket_count; ++i )
+					{
+						accumulated += m_buckets[ i ];
+						if( accumulated > threshold )
+							return bucket_lower_bound( i );
+					}
+
+				return m_count ? bucket_lower_bound( bucket_count - 1u ) : 0u;
+			}
+	};
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
@@ -46,6 +46,33 @@ ds_timer_thread_stats_t::distribute(
 				prefixes::timer_thread(),
 				suffixes::timer_periodic_count(),
 				stats.m_periodic_count );
+
+		send< messages::histogram >( distribution_mbox,
+				prefixes::timer_thread(),
+				suffixes::timer_lateness(),
+				stats.m_lateness );
+
+		send< messages::histogram >( distribution_mbox,
+				prefixes::timer_thread(),
+				suffixes::timer_delivery_time_per_tick(),
+				stats.m_delivery_time_per_tick );
+
+		send< messages::histogram >( distribution_mbox,
+				prefixes::timer_thread(),
+				suffixes::timer_expired_per_tick(),
+				stats.m_expired_per_tick );
+	}
+
+void
+ds_timer_thread_stats_t::on_turn_on() noexcept
+	{
+		m_what.set_timer_thread_exec_stats_collection( true );
+	}
+
+void
+ds_timer_thread_stats_t::on_turn_off() noexcept
+	{
+		m_what.set_timer_thread_exec_stats_collection( false );
 	}
 
 } /* namespace impl */
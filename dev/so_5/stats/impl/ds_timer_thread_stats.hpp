@@ -44,6 +44,12 @@ class ds_timer_thread_stats_t : public source_t
 		distribute(
 			const mbox_t & distribution_mbox ) override;
 
+		void
+		on_turn_on() noexcept override;
+
+		void
+		on_turn_off() noexcept override;
+
 	private :
 		so_5::environment_infrastructure_t & m_what;
 	};
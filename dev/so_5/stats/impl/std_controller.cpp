@@ -51,6 +51,9 @@ std_controller_t::turn_on()
 				m_shutdown_initiated = false;
 				m_distribution_thread.reset(
 						new std::thread( [this] { body(); } ) );
+
+				std::lock_guard< std::mutex > data_lock{ m_data_lock };
+				notify_sources( true );
 			}
 	}
 
@@ -75,6 +78,9 @@ std_controller_t::turn_off()
 				// Pointer to work thread must be dropped.
 				// This allows to start new working thread.
 				m_distribution_thread.reset();
+
+				std::lock_guard< std::mutex > data_lock{ m_data_lock };
+				notify_sources( false );
 			}
 	}
 
@@ -97,6 +103,9 @@ std_controller_t::add( source_t & what )
 		std::lock_guard< std::mutex > lock{ m_data_lock };
 
 		source_list_add( what, m_head, m_tail );
+
+		if( m_turned_on )
+			what.on_turn_on();
 	}
 
 void
@@ -104,9 +113,26 @@ std_controller_t::remove( source_t & what ) noexcept
 	{
 		std::lock_guard< std::mutex > lock{ m_data_lock };
 
+		if( m_turned_on )
+			what.on_turn_off();
+
 		source_list_remove( what, m_head, m_tail );
 	}
 
+void
+std_controller_t::notify_sources( bool turned_on ) noexcept
+	{
+		m_turned_on = turned_on;
+
+		for( source_t * s = m_head; s; s = source_list_next( *s ) )
+			{
+				if( turned_on )
+					s->on_turn_on();
+				else
+					s->on_turn_off();
+			}
+	}
+
 void
 std_controller_t::body()
 	{
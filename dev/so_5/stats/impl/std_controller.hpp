@@ -93,6 +93,16 @@ class std_controller_t final
 		 */
 		bool m_shutdown_initiated = { false };
 
+		//! Is the distribution turned on?
+		/*!
+		 * It is protected by m_data_lock. Data sources are notified
+		 * about turning on and off when this flag is changed.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		bool m_turned_on = { false };
+
 		/*!
 		 * \name Data sources-related part of controller's data.
 		 * \{
@@ -109,6 +119,16 @@ class std_controller_t final
 		 * \}
 		 */
 
+		//! Set m_turned_on and notify all data sources about that.
+		/*!
+		 * \attention Must be called with m_data_lock acquired.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		notify_sources( bool turned_on ) noexcept;
+
 		//! Main body of data distribution thread.
 		void
 		body();
@@ -0,0 +1,50 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \since
+ * v.5.6.2
+ *
+ * \brief Data types for stats of dispatcher queue locks.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+namespace so_5
+{
+
+namespace stats
+{
+
+/*!
+ * \brief Stats of spin-then-park waiting on a queue lock.
+ *
+ * Only locks which learn their spin budget (see
+ * so_5::disp::mpsc_queue_traits::adaptive_lock_factory() and
+ * so_5::disp::mpmc_queue_traits::adaptive_lock_factory()) provide
+ * these stats.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct lock_stats_t
+	{
+		//! Count of waits finished during the spinning stage.
+		std::uint_fast64_t m_spin_wakeups{};
+
+		//! Count of waits which required parking of a thread.
+		std::uint_fast64_t m_parks{};
+
+		//! Current spin budget.
+		std::chrono::nanoseconds m_spin_budget{};
+	};
+
+} /* namespace stats */
+
+} /* namespace so_5 */
+
@@ -16,6 +16,7 @@
 
 #include <so_5/message.hpp>
 
+#include <so_5/stats/histogram.hpp>
 #include <so_5/stats/prefix.hpp>
 #include <so_5/stats/work_thread_activity.hpp>
 
@@ -119,6 +120,32 @@ struct SO_5_TYPE work_thread_activity : public message_t
 			{}
 	};
 
+/*!
+ * \brief A message with a distribution of some values.
+ *
+ * \since
+ * v.5.6.2
+ */
+struct SO_5_TYPE histogram : public message_t
+	{
+		//! Prefix of data_source name.
+		prefix_t m_prefix;
+		//! Suffix of data_source name.
+		suffix_t m_suffix;
+
+		//! Actual value.
+		histogram_t m_value;
+
+		histogram(
+			const prefix_t & prefix,
+			const suffix_t & suffix,
+			const histogram_t & value )
+			:	m_prefix( prefix )
+			,	m_suffix( suffix )
+			,	m_value( value )
+			{}
+	};
+
 } /* namespace messages */
 
 } /* namespace stats */
@@ -55,6 +55,34 @@ class SO_5_TYPE source_t
 			//! Target mbox for the appropriate message.
 			const mbox_t & /*distribution_mbox*/ ) = 0;
 
+		//! Notification about turning the distribution on.
+		/*!
+		 * It is called by stats controller when the distribution is turned
+		 * on or when the data source is added while the distribution is on.
+		 * It allows a data source to start collection of data which is too
+		 * expensive to be collected all the time.
+		 *
+		 * \note The default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		on_turn_on() noexcept {}
+
+		//! Notification about turning the distribution off.
+		/*!
+		 * It is called by stats controller when the distribution is turned
+		 * off or when the data source is removed while the distribution is on.
+		 *
+		 * \note The default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		on_turn_off() noexcept {}
+
 	private :
 		//! Previous item in the data sources list.
 		source_t * m_prev{};
@@ -110,6 +110,60 @@ demand_quote()
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+lock_spin_wakeup_count()
+	{
+		IMPL_SUFFIX( "/lock.spin_wakeups" )
+	}
+
+SO_5_FUNC suffix_t
+lock_park_count()
+	{
+		IMPL_SUFFIX( "/lock.parks" )
+	}
+
+SO_5_FUNC suffix_t
+lock_spin_budget()
+	{
+		IMPL_SUFFIX( "/lock.spin_budget_us" )
+	}
+
+SO_5_FUNC suffix_t
+watched_fd_count()
+	{
+		IMPL_SUFFIX( "/fds.count" )
+	}
+
+SO_5_FUNC suffix_t
+deadline_miss_count()
+	{
+		IMPL_SUFFIX( "/deadline.misses" )
+	}
+
+SO_5_FUNC suffix_t
+expired_demand_drop_count()
+	{
+		IMPL_SUFFIX( "/deadline.dropped" )
+	}
+
+SO_5_FUNC suffix_t
+timer_lateness()
+	{
+		IMPL_SUFFIX( "/lateness_us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_delivery_time_per_tick()
+	{
+		IMPL_SUFFIX( "/tick.delivery_time_us" )
+	}
+
+SO_5_FUNC suffix_t
+timer_expired_per_tick()
+	{
+		IMPL_SUFFIX( "/tick.expired" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
@@ -157,6 +157,102 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with count of waits on a queue lock
+ * finished during the spinning stage.
+ */
+SO_5_FUNC suffix_t
+lock_spin_wakeup_count();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with count of waits on a queue lock
+ * which required parking of a thread.
+ */
+SO_5_FUNC suffix_t
+lock_park_count();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with the current spin budget of
+ * a queue lock (in microseconds).
+ */
+SO_5_FUNC suffix_t
+lock_spin_budget();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with count of file descriptors
+ * watched by a work thread.
+ *
+ * This suffix is used in reactor dispatcher.
+ */
+SO_5_FUNC suffix_t
+watched_fd_count();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with count of demands which were
+ * started (or dropped) after their deadlines.
+ *
+ * This suffix is used in edf dispatcher.
+ */
+SO_5_FUNC suffix_t
+deadline_miss_count();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with count of demands which were
+ * dropped because of expired deadlines.
+ *
+ * This suffix is used in edf dispatcher.
+ */
+SO_5_FUNC suffix_t
+expired_demand_drop_count();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with histogram of lateness of
+ * expired timers (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_lateness();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with histogram of time spent
+ * in delivery of expired timers per tick (in microseconds).
+ */
+SO_5_FUNC suffix_t
+timer_delivery_time_per_tick();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Suffix for data source with histogram of count of
+ * expired timers per tick.
+ */
+SO_5_FUNC suffix_t
+timer_expired_per_tick();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
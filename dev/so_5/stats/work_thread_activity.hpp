@@ -98,6 +98,16 @@ struct work_thread_activity_stats_t
 
 		//! Stats for waiting periods.
 		activity_stats_t m_waiting_stats{};
+
+		/*!
+		 * \brief Number of CPU on which the work thread ran recently.
+		 *
+		 * Is -1 if it is unknown.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		int m_cpu{ -1 };
 	};
 
 namespace details
@@ -194,5 +194,48 @@ adaptive_subscription_storage_factory(
 	//! A factory for creating large storage.
 	const subscription_storage_factory_t & large_storage_factory );
 
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Factory for subscription storage which is frozen after
+ * the start of an agent.
+ *
+ * \par Description
+ * Subscriptions are held in the storage created by
+ * default_subscription_storage_factory(). When so_evt_start() completes
+ * the current subscriptions are compiled into a flat read-only table.
+ * The search of an event handler in that table usually requires just
+ * one probe.
+ *
+ * If the agent changes its subscriptions later then the table is dropped
+ * and the underlying storage is used for all searches since then.
+ *
+ * This storage is intended for agents which make all subscriptions in
+ * so_define_agent() or so_evt_start() and handle a lot of messages.
+ */
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory();
+
+/*!
+ * \since
+ * v.5.6.2
+ *
+ * \brief Factory for subscription storage which is frozen after
+ * the start of an agent.
+ *
+ * The same as frozen_subscription_storage_factory() but the storage
+ * created by \a mutable_storage_factory holds subscriptions.
+ *
+\code
+so_5::frozen_subscription_storage_factory(
+	so_5::vector_based_subscription_storage_factory(32) );
+\endcode
+ */
+SO_5_FUNC subscription_storage_factory_t
+frozen_subscription_storage_factory(
+	//! A factory for the storage which holds subscriptions.
+	const subscription_storage_factory_t & mutable_storage_factory );
+
 } /* namespace so_5 */
 
@@ -12,18 +12,129 @@
 
 #include <so_5/details/abort_on_fatal_error.hpp>
 
+#include <so_5/exception.hpp>
+#include <so_5/ret_code.hpp>
+
 #include <so_5/impl/mbox_iface_for_timers.hpp>
 
 #include <so_5/timers.hpp>
 
+#include <so_5/spinlocks.hpp>
+
 #include <so_5/3rd_party/timertt/all.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace so_5
 {
 
+//
+// timer_t
+//
+void
+timer_t::reschedule(
+	std::chrono::steady_clock::duration /*pause*/,
+	std::chrono::steady_clock::duration /*period*/ )
+	{
+		SO_5_THROW_EXCEPTION( rc_not_implemented,
+				"reschedule() is not implemented for that timer" );
+	}
+
+void
+timer_t::reschedule(
+	const std::type_index & /*type_index*/,
+	const message_ref_t & /*msg*/,
+	std::chrono::steady_clock::duration /*pause*/,
+	std::chrono::steady_clock::duration /*period*/ )
+	{
+		SO_5_THROW_EXCEPTION( rc_not_implemented,
+				"reschedule() is not implemented for that timer" );
+	}
+
+//
+// timer_id_t
+//
+void
+timer_id_t::reschedule(
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		if( !m_timer )
+			SO_5_THROW_EXCEPTION( rc_timer_cannot_be_rescheduled,
+					"an attempt to reschedule empty timer_id" );
+
+		m_timer->reschedule( pause, period );
+	}
+
+void
+timer_id_t::reschedule(
+	const std::type_index & type_index,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		if( !m_timer )
+			SO_5_THROW_EXCEPTION( rc_timer_cannot_be_rescheduled,
+					"an attempt to reschedule empty timer_id" );
+
+		m_timer->reschedule( type_index, msg, pause, period );
+	}
+
 namespace timers_details
 {
 
+namespace
+{
+
+//
+// ensure_valid_timer_params
+//
+
+/*!
+ * \brief Check parameters for the timer to be rescheduled.
+ *
+ * Checks are the same as for environment_t::so_schedule_timer().
+ *
+ * \since
+ * v.5.6.2
+ */
+void
+ensure_valid_timer_params(
+	const message_ref_t & msg,
+	const mbox_t & mbox,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+	{
+		using duration = std::chrono::steady_clock::duration;
+		if( pause < duration::zero() )
+			SO_5_THROW_EXCEPTION(
+					so_5::rc_negative_value_for_pause,
+					"an attempt to reschedule timer with negative pause value" );
+		if( period < duration::zero() )
+			SO_5_THROW_EXCEPTION(
+					so_5::rc_negative_value_for_period,
+					"an attempt to reschedule timer with negative period value" );
+
+		if( message_mutability_t::mutable_message == message_mutability(msg) )
+		{
+			if( duration::zero() != period )
+				SO_5_THROW_EXCEPTION(
+						so_5::rc_mutable_msg_cannot_be_periodic,
+						"unable to reschedule periodic timer for mutable message" );
+			else if( mbox_type_t::multi_producer_multi_consumer == mbox->type() )
+				SO_5_THROW_EXCEPTION(
+						so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox,
+						"unable to reschedule timer for mutable message and "
+						"MPMC mbox" );
+		}
+	}
+
+} /* namespace anonymous */
+
 //
 // actual_timer_t
 //
@@ -36,6 +147,10 @@ namespace timers_details
  * \note
  * Since v.5.5.19 this template can be used with timer_thread and
  * with timer_manager.
+ *
+ * \note
+ * Since v.5.6.2 the timer holds a copy of timer action. It allows
+ * to reschedule the timer without allocation of new timer objects.
  * 
  * \tparam Timer A type of timertt-based thread/manager which implements timers.
  */
@@ -47,21 +162,29 @@ class actual_timer_t : public timer_t
 		using timer_holder_t = timertt::timer_object_holder<
 				typename Timer::thread_safety >;
 
+		//! The actual type of timer action.
+		using timer_action_t = typename Timer::timer_action;
+
 		//! Initialized constructor.
 		actual_timer_t(
-			Timer * thread )
+			Timer * thread,
+			timer_action_t action )
 			:	m_thread( thread )
 			,	m_timer( thread->allocate() )
+			,	m_action( std::move(action) )
 			{}
 		virtual ~actual_timer_t() noexcept override
 			{
 				release();
 			}
 
-		timer_holder_t &
-		timer_holder() noexcept
+		//! Activate the timer for the first time.
+		void
+		activate(
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period )
 			{
-				return m_timer;
+				m_thread->activate( m_timer, pause, period, timer_action_t{ m_action } );
 			}
 
 		virtual bool
@@ -78,9 +201,55 @@ class actual_timer_t : public timer_t
 					m_thread->deactivate( m_timer );
 					m_thread = nullptr;
 					m_timer.reset();
+					// Message must be destroyed right now.
+					m_action.set_message( message_ref_t{} );
 				}
 			}
 
+		virtual void
+		reschedule(
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				ensure_not_released();
+
+				// A mutable message could be already delivered and
+				// can't be sent again.
+				if( message_mutability_t::mutable_message ==
+						message_mutability( m_action.message() ) )
+					SO_5_THROW_EXCEPTION( rc_timer_cannot_be_rescheduled,
+							"timer with mutable message can be rescheduled "
+							"only with a new message" );
+
+				ensure_valid_timer_params(
+						m_action.message(), m_action.mbox(), pause, period );
+
+				do_reschedule( pause, period );
+			}
+
+		virtual void
+		reschedule(
+			const std::type_index & type_index,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				ensure_not_released();
+
+				if( type_index != m_action.type_index() )
+					SO_5_THROW_EXCEPTION( rc_timer_cannot_be_rescheduled,
+							"timer can't be rescheduled for message of "
+							"another type, timer msg_type=" +
+							std::string( m_action.type_index().name() ) +
+							", new msg_type=" + std::string( type_index.name() ) );
+
+				ensure_valid_timer_params( msg, m_action.mbox(), pause, period );
+
+				m_action.set_message( msg );
+
+				do_reschedule( pause, period );
+			}
+
 	private :
 		//! Timer thread for the timer.
 		/*!
@@ -90,6 +259,33 @@ class actual_timer_t : public timer_t
 
 		//! Underlying timer object reference.
 		timer_holder_t m_timer;
+
+		//! Timer action to be used for (re)activation of the timer.
+		timer_action_t m_action;
+
+		void
+		ensure_not_released() const
+			{
+				if( !m_thread )
+					SO_5_THROW_EXCEPTION( rc_timer_cannot_be_rescheduled,
+							"timer is already released" );
+			}
+
+		void
+		do_reschedule(
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period )
+			{
+				if( !m_thread->try_reschedule(
+						m_timer, pause, period, timer_action_t{ m_action } ) )
+				{
+					// The timer is being processed by timer thread right now.
+					// It can't be reused so a new timer object is necessary.
+					m_thread->deactivate( m_timer );
+					m_timer = m_thread->allocate();
+					activate( pause, period );
+				}
+			}
 	};
 
 //
@@ -124,6 +320,133 @@ class timer_action_for_timer_thread_t
 				::so_5::impl::mbox_iface_for_timers_t{ m_mbox }
 						.deliver_message_from_timer( m_type_index, m_msg );
 			}
+
+		const std::type_index &
+		type_index() const noexcept { return m_type_index; }
+
+		const mbox_t &
+		mbox() const noexcept { return m_mbox; }
+
+		const message_ref_t &
+		message() const noexcept { return m_msg; }
+
+		void
+		set_message( message_ref_t msg ) noexcept { m_msg = std::move(msg); }
+	};
+
+//
+// exec_stats_collector_t
+//
+/*!
+ * \brief A collector of stats about lateness of timers and about
+ * load of a timer thread.
+ *
+ * The collection is turned on and off by set_enabled(). When
+ * the collection is off there is only a check of atomic flag per
+ * processing of expired timers and per execution of timer action.
+ *
+ * \since
+ * v.5.6.2
+ */
+class exec_stats_collector_t final : public timertt::exec_observer
+	{
+	public :
+		void
+		on_processing_started() noexcept override
+			{
+				m_processing_observed = is_enabled();
+				if( m_processing_observed )
+					m_processing_started_at = clock::now();
+			}
+
+		void
+		on_action_exec(
+			timertt::monotonic_clock::time_point expected_time ) noexcept override
+			{
+				if( is_enabled() )
+					{
+						const auto now = clock::now();
+						const auto lateness = now > expected_time ?
+								to_microseconds( now - expected_time ) : 0u;
+
+						std::lock_guard< default_spinlock_t > lock{ m_lock };
+						m_lateness.add( lateness );
+					}
+			}
+
+		void
+		on_processing_finished(
+			std::size_t executed_actions ) noexcept override
+			{
+				if( m_processing_observed && executed_actions )
+					{
+						const auto spent = to_microseconds(
+								clock::now() - m_processing_started_at );
+
+						std::lock_guard< default_spinlock_t > lock{ m_lock };
+						m_delivery_time_per_tick.add( spent );
+						m_expired_per_tick.add( executed_actions );
+					}
+			}
+
+		//! Turn the collection on or off.
+		/*!
+		 * The stats collected before are kept.
+		 */
+		void
+		set_enabled( bool enabled ) noexcept
+			{
+				m_enabled.store( enabled, std::memory_order_relaxed );
+			}
+
+		//! Get the collected stats.
+		void
+		query( timer_thread_stats_t & to )
+			{
+				std::lock_guard< default_spinlock_t > lock{ m_lock };
+				to.m_lateness = m_lateness;
+				to.m_delivery_time_per_tick = m_delivery_time_per_tick;
+				to.m_expired_per_tick = m_expired_per_tick;
+			}
+
+	private :
+		using clock = timertt::monotonic_clock;
+
+		//! Is the collection turned on?
+		std::atomic< bool > m_enabled{ false };
+
+		//! Is the current processing of expired timers observed?
+		/*!
+		 * \note It is used only by the timer thread.
+		 */
+		bool m_processing_observed{ false };
+
+		//! Start time of the current processing of expired timers.
+		/*!
+		 * \note It is used only by the timer thread.
+		 */
+		clock::time_point m_processing_started_at;
+
+		//! Lock for the collected stats.
+		default_spinlock_t m_lock;
+
+		stats::histogram_t m_lateness;
+		stats::histogram_t m_delivery_time_per_tick;
+		stats::histogram_t m_expired_per_tick;
+
+		bool
+		is_enabled() const noexcept
+			{
+				return m_enabled.load( std::memory_order_relaxed );
+			}
+
+		static std::uint_fast64_t
+		to_microseconds( clock::duration d ) noexcept
+			{
+				return static_cast< std::uint_fast64_t >(
+						std::chrono::duration_cast< std::chrono::microseconds >( d )
+								.count() );
+			}
 	};
 
 //
@@ -148,7 +471,9 @@ class actual_thread_t : public timer_thread_t
 			//! Real timer thread.
 			std::unique_ptr< Timer_Thread > thread )
 			:	m_thread( std::move( thread ) )
-			{}
+			{
+				m_thread->set_exec_observer( &m_exec_stats );
+			}
 
 		virtual void
 		start() override
@@ -170,13 +495,12 @@ class actual_thread_t : public timer_thread_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = std::make_unique< timer_demand_t >( m_thread.get() );
-
-				m_thread->activate( timer->timer_holder(),
-						pause,
-						period,
+				auto timer = std::make_unique< timer_demand_t >(
+						m_thread.get(),
 						timer_action_for_timer_thread_t( type_index, mbox, msg ) );
 
+				timer->activate( pause, period );
+
 				return timer_id_t( timer.release() );
 			}
 
@@ -199,13 +523,32 @@ class actual_thread_t : public timer_thread_t
 			{
 				auto d = m_thread->get_timer_quantities();
 
-				return timer_thread_stats_t{
+				timer_thread_stats_t result{
 						d.m_single_shot_count,
 						d.m_periodic_count
 					};
+				m_exec_stats.query( result );
+
+				return result;
+			}
+
+		virtual void
+		set_exec_stats_collection( bool enabled ) noexcept override
+			{
+				m_exec_stats.set_enabled( enabled );
 			}
 
 	private :
+		/*!
+		 * \brief Collector of stats about lateness and load.
+		 *
+		 * \note It must outlive the timer thread.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		exec_stats_collector_t m_exec_stats;
+
 		std::unique_ptr< Timer_Thread > m_thread;
 	};
 
@@ -245,6 +588,18 @@ class timer_action_for_timer_manager_t
 			{
 				m_collector.get().accept( m_type_index, m_mbox, m_msg );
 			}
+
+		const std::type_index &
+		type_index() const noexcept { return m_type_index; }
+
+		const mbox_t &
+		mbox() const noexcept { return m_mbox; }
+
+		const message_ref_t &
+		message() const noexcept { return m_msg; }
+
+		void
+		set_message( message_ref_t msg ) noexcept { m_msg = std::move(msg); }
 	};
 
 //
@@ -296,14 +651,13 @@ class actual_manager_t : public timer_manager_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = std::make_unique< timer_demand_t >( m_manager.get() );
-
-				m_manager->activate( timer->timer_holder(),
-						pause,
-						period,
+				auto timer = std::make_unique< timer_demand_t >(
+						m_manager.get(),
 						timer_action_for_timer_manager_t(
 								m_collector, type_index, mbox, msg ) );
 
+				timer->activate( pause, period );
+
 				return timer_id_t( timer.release() );
 			}
 
@@ -345,6 +699,141 @@ class actual_manager_t : public timer_manager_t
 				m_collector;
 	};
 
+//
+// sharded_thread_t
+//
+/*!
+ * \brief An implementation of sharded timer thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+class sharded_thread_t final : public timer_thread_t
+	{
+	public :
+		//! Initializing constructor.
+		sharded_thread_t(
+			//! Shards to be used.
+			//! Must not be empty.
+			std::vector< timer_thread_unique_ptr_t > shards,
+			//! A way of selection of a shard.
+			timer_shard_selection_t selection )
+			:	m_shards( std::move(shards) )
+			,	m_selection( selection )
+			{}
+
+		virtual void
+		start() override
+			{
+				std::size_t started = 0u;
+				try
+				{
+					for( auto & s : m_shards )
+					{
+						s->start();
+						++started;
+					}
+				}
+				catch( ... )
+				{
+					// Shards which are already started must be stopped.
+					for( std::size_t i = 0u; i != started; ++i )
+						m_shards[ i ]->finish();
+					throw;
+				}
+			}
+
+		virtual void
+		finish() override
+			{
+				for( auto & s : m_shards )
+					s->finish();
+			}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				return select_shard( mbox ).schedule(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				select_shard( mbox ).schedule_anonymous(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				timer_thread_stats_t result{ 0u, 0u };
+				for( auto & s : m_shards )
+				{
+					const auto d = s->query_stats();
+					result.m_single_shot_count += d.m_single_shot_count;
+					result.m_periodic_count += d.m_periodic_count;
+					result.m_lateness.merge( d.m_lateness );
+					result.m_delivery_time_per_tick.merge(
+							d.m_delivery_time_per_tick );
+					result.m_expired_per_tick.merge( d.m_expired_per_tick );
+				}
+
+				return result;
+			}
+
+		virtual void
+		set_exec_stats_collection( bool enabled ) noexcept override
+			{
+				for( auto & s : m_shards )
+					s->set_exec_stats_collection( enabled );
+			}
+
+	private :
+		//! Shards.
+		const std::vector< timer_thread_unique_ptr_t > m_shards;
+
+		//! A way of selection of a shard.
+		const timer_shard_selection_t m_selection;
+
+		//! Index of the current thread.
+		/*!
+		 * Indexes are assigned to threads in order of the first call.
+		 * It gives more even distribution of threads between shards
+		 * than hash of std::thread::id.
+		 */
+		static std::size_t
+		current_thread_index() noexcept
+			{
+				static std::atomic< std::size_t > s_counter{ 0u };
+				static thread_local const std::size_t s_index =
+						s_counter.fetch_add( 1u, std::memory_order_relaxed );
+
+				return s_index;
+			}
+
+		timer_thread_t &
+		select_shard( const mbox_t & mbox ) const noexcept
+			{
+				const std::size_t key =
+						timer_shard_selection_t::by_sender_thread == m_selection ?
+						current_thread_index() :
+						static_cast< std::size_t >( mbox->id() );
+
+				return *(m_shards[ key % m_shards.size() ]);
+			}
+	};
+
 //
 // error_logger_for_timertt_t
 //
@@ -444,6 +933,17 @@ using timer_wheel_thread_t = timertt::timer_wheel_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel thread type.
+/*!
+ * \since
+ * v.5.6.2
+ */
+using timer_hierarchical_wheel_thread_t =
+		timertt::timer_hierarchical_wheel_thread_template<
+				timer_action_for_timer_thread_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
 //! timer_heap thread type.
 using timer_heap_thread_t = timertt::timer_heap_thread_template<
 		timer_action_for_timer_thread_t,
@@ -463,6 +963,18 @@ using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel manager type.
+/*!
+ * \since
+ * v.5.6.2
+ */
+using timer_hierarchical_wheel_manager_t =
+		timertt::timer_hierarchical_wheel_manager_template<
+				timertt::thread_safety::unsafe,
+				timer_action_for_timer_manager_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
 //! timer_heap manager type.
 using timer_heap_manager_t = timertt::timer_heap_manager_template<
 		timertt::thread_safety::unsafe,
@@ -514,6 +1026,43 @@ create_timer_wheel_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+
+		return create_timer_hierarchical_wheel_thread(
+				std::move(logger),
+				timertt_thread_t::default_wheel_size(),
+				timertt_thread_t::default_levels(),
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger,
+	unsigned int wheel_size,
+	unsigned int levels,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						wheel_size,
+						levels,
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
 SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_heap_thread(
 	error_logger_shptr_t logger )
@@ -559,6 +1108,25 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	error_logger_shptr_t logger,
+	std::size_t shards,
+	timer_shard_selection_t selection,
+	const timer_thread_factory_t & shard_factory )
+	{
+		if( !shards )
+			shards = std::max( 1u, std::thread::hardware_concurrency() );
+
+		std::vector< timer_thread_unique_ptr_t > threads;
+		threads.reserve( shards );
+		for( std::size_t i = 0u; i != shards; ++i )
+			threads.push_back( shard_factory( logger ) );
+
+		return std::make_unique< timers_details::sharded_thread_t >(
+				std::move(threads), selection );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_wheel_manager(
 	error_logger_shptr_t logger,
@@ -596,6 +1164,48 @@ create_timer_wheel_manager(
 						collector );
 	}
 
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+
+		return create_timer_hierarchical_wheel_manager(
+				std::move(logger),
+				collector,
+				timertt_manager_t::default_wheel_size(),
+				timertt_manager_t::default_levels(),
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector,
+	unsigned int wheel_size,
+	unsigned int levels,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+		using namespace timers_details;
+
+		auto manager = std::make_unique< timertt_manager_t >(
+				wheel_size,
+				levels,
+				granularity,
+				create_error_logger_for_timertt( logger ),
+				create_exception_handler_for_timertt_manager( logger ) );
+
+		return std::make_unique< actual_manager_t< timertt_manager_t > >(
+				std::move( manager ),
+				collector );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_heap_manager(
 	error_logger_shptr_t logger,
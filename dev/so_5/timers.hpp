@@ -26,6 +26,8 @@
 
 #include <so_5/outliving.hpp>
 
+#include <so_5/stats/histogram.hpp>
+
 namespace so_5
 {
 
@@ -58,6 +60,49 @@ class SO_5_TYPE timer_t
 		//! Release the timer event.
 		virtual void
 		release() noexcept = 0;
+
+		//! Reschedule the timer with the same message.
+		/*!
+		 * The timer is deactivated (if it is active) and then activated
+		 * again with new \a pause and \a period. The timer object itself
+		 * is reused.
+		 *
+		 * \note
+		 * The default implementation throws an exception.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		reschedule(
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period );
+
+		//! Reschedule the timer with a new message.
+		/*!
+		 * The new message must be of the same type as the message the
+		 * timer was created for.
+		 *
+		 * \note
+		 * The default implementation throws an exception.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		reschedule(
+			//! Type of message to be sheduled.
+			const std::type_index & type_index,
+			//! Message to be sent.
+			const message_ref_t & msg,
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period );
 	};
 
 //
@@ -102,6 +147,71 @@ class SO_5_TYPE timer_id_t
 					m_timer->release();
 			}
 
+		//! Reschedule the timer with the same message.
+		/*!
+		 * This method allows to reuse the timer instead of releasing
+		 * it and creating a new one. It is useful for timeouts which
+		 * are restarted very often:
+		 * \code
+		 * class connection_handler final : public so_5::agent_t {
+		 * 	so_5::timer_id_t m_inactivity_timer;
+		 * 	...
+		 * 	void so_evt_start() override {
+		 * 		m_inactivity_timer = so_5::send_periodic< inactivity_timeout >(
+		 * 				*this, 30s, 0s );
+		 * 	}
+		 * 	void on_data(mhood_t<data_received>) {
+		 * 		...
+		 * 		// Inactivity timeout is started again.
+		 * 		m_inactivity_timer.reschedule( 30s );
+		 * 	}
+		 * };
+		 * \endcode
+		 *
+		 * \throw so_5::exception_t if timer_id is empty, the timer is
+		 * released or the timer holds a mutable message.
+		 *
+		 * \attention
+		 * Values of \a pause and \a period should be non-negative.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		reschedule(
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period =
+					std::chrono::steady_clock::duration::zero() );
+
+		//! Reschedule the timer with a new message.
+		/*!
+		 * \note
+		 * This method is a part of low-level SObjectizer's interface.
+		 * Functions so_5::reschedule_delayed() and so_5::reschedule_periodic()
+		 * should be used instead.
+		 *
+		 * \throw so_5::exception_t if timer_id is empty, the timer is
+		 * released or \a type_index differs from the type of message
+		 * the timer was created for.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		void
+		reschedule(
+			//! Type of message to be sheduled.
+			const std::type_index & type_index,
+			//! Message to be sent.
+			const message_ref_t & msg,
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period );
+
 	private :
 		//! Actual timer.
 		so_5::intrusive_ptr_t< timer_t > m_timer;
@@ -123,6 +233,46 @@ struct timer_thread_stats_t
 
 	//! Quantity of periodic timers.
 	std::size_t m_periodic_count;
+
+	/*!
+	 * \brief Lateness of expired timers (in microseconds).
+	 *
+	 * It is the difference between the time of delivery of a timer
+	 * message and the time at which the timer had to be expired.
+	 *
+	 * \note This stats is collected only by timer threads and only
+	 * while run-time monitoring is turned on.
+	 * See timer_thread_t::set_exec_stats_collection().
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	stats::histogram_t m_lateness{};
+
+	/*!
+	 * \brief Time spent in delivery of expired timers per tick
+	 * (in microseconds).
+	 *
+	 * Ticks without expired timers aren't counted.
+	 *
+	 * \note It is collected the same way as m_lateness.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	stats::histogram_t m_delivery_time_per_tick{};
+
+	/*!
+	 * \brief Count of expired timers per tick.
+	 *
+	 * Ticks without expired timers aren't counted.
+	 *
+	 * \note It is collected the same way as m_lateness.
+	 *
+	 * \since
+	 * v.5.6.2
+	 */
+	stats::histogram_t m_expired_per_tick{};
 };
 
 //
@@ -204,6 +354,21 @@ class SO_5_TYPE timer_thread_t
 		 */
 		virtual timer_thread_stats_t
 		query_stats() = 0;
+
+		/*!
+		 * \brief Turn collection of lateness and load stats on or off.
+		 *
+		 * The collection is off by default. It is turned on and off
+		 * by the data source of the timer thread when run-time monitoring
+		 * is turned on and off.
+		 *
+		 * \note The default implementation does nothing.
+		 *
+		 * \since
+		 * v.5.6.2
+		 */
+		virtual void
+		set_exec_stats_collection( bool /*enabled*/ ) noexcept {}
 	};
 
 //! Auxiliary typedef for timer_thread autopointer.
@@ -253,6 +418,42 @@ create_timer_wheel_thread(
 	//! A size of one time step for the wheel.
 	std::chrono::steady_clock::duration granuality );
 
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * The costs of activation, deactivation and processing of a timer
+ * don't depend on the pause of the timer. It makes this mechanism
+ * suitable for big amount of timers with very different pauses.
+ *
+ * \note Default parameters will be used for timer thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of slots on every level of the wheel.
+	unsigned int wheel_size,
+	//! Count of levels of the wheel.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity );
+
 /*!
  * \since
  * v.5.5.0
@@ -289,6 +490,58 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+//
+// timer_shard_selection_t
+//
+/*!
+ * \brief A way of selection of a shard for a new timer in sharded
+ * timer thread.
+ *
+ * \since
+ * v.5.6.2
+ */
+enum class timer_shard_selection_t
+	{
+		//! A shard is selected by the thread which schedules the timer.
+		/*!
+		 * Every thread is bound to one shard. All timers scheduled
+		 * from this thread are handled by that shard.
+		 */
+		by_sender_thread,
+		//! A shard is selected by ID of the destination mbox.
+		/*!
+		 * All timers for the same mbox are handled by the same shard.
+		 * It means that relative order of delayed messages for the
+		 * mbox is the same as for non-sharded timer thread.
+		 */
+		by_mbox
+	};
+
+/*!
+ * \brief Create sharded timer thread.
+ *
+ * Sharded timer thread consists of several independent timer threads
+ * (shards). Every shard has its own lock and its own thread. Elapsed
+ * timers from different shards are handled in parallel.
+ *
+ * A timer_id_t returned by sharded timer thread refers to a timer of
+ * an appropriate shard. So it can be used as usual.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of shards.
+	//! Value 0 means that std::thread::hardware_concurrency() will be used.
+	std::size_t shards,
+	//! A way of selection of a shard for a new timer.
+	timer_shard_selection_t selection,
+	//! Factory for creation of every shard.
+	const timer_thread_factory_t & shard_factory );
 /*!
  * \}
  */
@@ -337,6 +590,53 @@ timer_wheel_factory(
 		return std::bind( f, _1, wheel_size, granularity );
 	}
 
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with default
+ * parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_thread;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory(
+	//! Count of slots on every level of the wheel.
+	unsigned int wheel_size,
+	//! Count of levels of the wheel.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_thread;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, wheel_size, levels, granularity );
+	}
+
 /*!
  * \since
  * v.5.5.0
@@ -383,6 +683,41 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \brief Factory for sharded timer thread.
+ *
+ * Usage example:
+ * \code
+ * so_5::launch( ...,
+ * 	[]( so_5::environment_params_t & params ) {
+ * 		// Four shards based on timer_wheel, a shard is selected by
+ * 		// destination mbox.
+ * 		params.timer_thread( so_5::sharded_timer_factory(
+ * 				4u,
+ * 				so_5::timer_shard_selection_t::by_mbox,
+ * 				so_5::timer_wheel_factory() ) );
+ * 	} );
+ * \endcode
+ *
+ * \since
+ * v.5.6.2
+ */
+inline timer_thread_factory_t
+sharded_timer_factory(
+	//! Count of shards.
+	//! Value 0 means that std::thread::hardware_concurrency() will be used.
+	std::size_t shards = 0u,
+	//! A way of selection of a shard for a new timer.
+	timer_shard_selection_t selection = timer_shard_selection_t::by_mbox,
+	//! Factory for creation of every shard.
+	timer_thread_factory_t shard_factory = timer_wheel_factory() )
+	{
+		return [shards, selection, shard_factory]( error_logger_shptr_t logger ) {
+			return create_sharded_timer_thread(
+					std::move(logger), shards, selection, shard_factory );
+		};
+	}
 /*!
  * \}
  */
@@ -578,6 +913,42 @@ create_timer_wheel_manager(
 	//! A size of one time step for the wheel.
 	std::chrono::steady_clock::duration granuality );
 
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.6.2
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector,
+	//! Count of slots on every level of the wheel.
+	unsigned int wheel_size,
+	//! Count of levels of the wheel.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity );
+
 /*!
  * \since
  * v.5.5.0
@@ -677,6 +1048,59 @@ timer_wheel_manager_factory(
 		return std::bind( f, _1, _2, wheel_size, granularity );
 	}
 
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with default
+ * parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+					error_logger_shptr_t,
+					outliving_reference_t<
+							timer_manager_t::elapsed_timers_collector_t > ) =
+				create_timer_hierarchical_wheel_manager;
+
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.6.2
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory(
+	//! Count of slots on every level of the wheel.
+	unsigned int wheel_size,
+	//! Count of levels of the wheel.
+	unsigned int levels,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t >,
+						unsigned int,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_manager;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, _2, wheel_size, levels, granularity );
+	}
+
 /*!
  * \since
  * v.5.5.0
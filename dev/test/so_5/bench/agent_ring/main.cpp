@@ -23,7 +23,9 @@ enum class dispatcher_type_t
 enum class queue_lock_type_t
 {
 	combined,
-	simple
+	simple,
+	lock_free,
+	adaptive
 };
 
 enum class pool_fifo_t
@@ -73,7 +75,9 @@ try_parse_cmdline(
 							"                     adv_thread_pool,\n"
 							"                     prio_ot_strictly_ordered\n"
 							"-L, --queue-lock     type of queue lock to be used:\n"
-							"                     combined, simple\n"
+							"                     combined, simple, adaptive,\n"
+							"                     lock_free (one_thread and\n"
+							"                     prio_ot_strictly_ordered only)\n"
 							"-f, --fifo           type of fifo for dispatcher with "
 								"thread pool:\n"
 							"                     cooperation, individual (default)\n"
@@ -121,6 +125,10 @@ try_parse_cmdline(
 						tmp_cfg.m_queue_lock_type = queue_lock_type_t::combined;
 					else if( "simple" == name )
 						tmp_cfg.m_queue_lock_type = queue_lock_type_t::simple;
+					else if( "lock_free" == name )
+						tmp_cfg.m_queue_lock_type = queue_lock_type_t::lock_free;
+					else if( "adaptive" == name )
+						tmp_cfg.m_queue_lock_type = queue_lock_type_t::adaptive;
 					else
 						throw std::runtime_error( "unsupported queue lock type: " + name );
 				}
@@ -146,6 +154,12 @@ try_parse_cmdline(
 						std::string( "unknown argument: " ) + *current );
 		}
 
+	if( queue_lock_type_t::lock_free == tmp_cfg.m_queue_lock_type &&
+			( dispatcher_type_t::thread_pool == tmp_cfg.m_dispatcher_type ||
+				dispatcher_type_t::adv_thread_pool == tmp_cfg.m_dispatcher_type ) )
+		throw std::runtime_error( "lock_free queue lock type is not supported "
+				"for thread pool dispatchers" );
+
 	return tmp_cfg;
 }
 
@@ -249,8 +263,12 @@ queue_lock_type_name( queue_lock_type_t t )
 	{
 		if( queue_lock_type_t::combined == t )
 			return "combined";
-		else
+		else if( queue_lock_type_t::simple == t )
 			return "simple";
+		else if( queue_lock_type_t::adaptive == t )
+			return "adaptive";
+		else
+			return "lock_free";
 	}
 
 const char *
@@ -304,6 +322,33 @@ show_result(
 			", throughtput: " << throughtput << std::endl;
 	}
 
+void
+set_lock_free_factory(
+	so_5::disp::mpsc_queue_traits::queue_params_t & p )
+	{
+		p.lock_factory( so_5::disp::mpsc_queue_traits::lock_free_queue_factory() );
+	}
+
+// Lock-free queue is not supported for MPMC queues.
+void
+set_lock_free_factory(
+	so_5::disp::mpmc_queue_traits::queue_params_t & )
+	{}
+
+void
+set_adaptive_factory(
+	so_5::disp::mpsc_queue_traits::queue_params_t & p )
+	{
+		p.lock_factory( so_5::disp::mpsc_queue_traits::adaptive_lock_factory() );
+	}
+
+void
+set_adaptive_factory(
+	so_5::disp::mpmc_queue_traits::queue_params_t & p )
+	{
+		p.lock_factory( so_5::disp::mpmc_queue_traits::adaptive_lock_factory() );
+	}
+
 template<
 	typename Disp_Params,
 	typename Combined_Factory,
@@ -325,6 +370,11 @@ make_disp_params(
 					p.lock_factory( simple_factory() );
 				else
 					p.lock_factory( combined_factory() );
+
+				if( queue_lock_type_t::lock_free == cfg.m_queue_lock_type )
+					set_lock_free_factory( p );
+				else if( queue_lock_type_t::adaptive == cfg.m_queue_lock_type )
+					set_adaptive_factory( p );
 				queue_params_tuner( p );
 			} );
 		return disp_params;
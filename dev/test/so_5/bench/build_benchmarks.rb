@@ -18,4 +18,8 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/skynet1m/prj.rb" 
 	required_prj "#{path}/prepared_receive/prj.rb" 
 	required_prj "#{path}/prepared_select/prj.rb" 
+	required_prj "#{path}/pooled_msgs/prj.rb" 
+	required_prj "#{path}/deep_state_hierarchy/prj.rb" 
+	required_prj "#{path}/coop_reg_subscriptions/prj.rb" 
+	required_prj "#{path}/timer_reschedule/prj.rb" 
 }
@@ -0,0 +1,206 @@
+/*
+ * A benchmark for registration of a coop with many agents where
+ * every agent has many subscriptions.
+ */
+
+#include <iostream>
+#include <array>
+#include <utility>
+
+#include <cstdlib>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/cmd_line_args_helpers.hpp>
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+
+template< int I >
+struct sig final : public so_5::signal_t {};
+
+constexpr unsigned int max_subscriptions = 64u;
+
+enum class mbox_type_t
+{
+	direct,
+	rw_locked,
+	copy_on_write
+};
+
+struct cfg_t
+{
+	unsigned int m_agents = 10000u;
+	unsigned int m_subscriptions = 20u;
+	bool m_bulk = false;
+	mbox_type_t m_mbox_type = mbox_type_t::rw_locked;
+};
+
+cfg_t
+try_parse_cmdline(
+	int argc,
+	char ** argv )
+{
+	cfg_t tmp_cfg;
+
+	for( char ** current = &argv[ 1 ], **last = argv + argc;
+			current != last;
+			++current )
+		{
+			if( is_arg( *current, "-h", "--help" ) )
+				{
+					std::cout << "usage:\n"
+							"_test.bench.so_5.coop_reg_subscriptions <options>\n"
+							"\noptions:\n"
+							"-a, --agents         count of agents in the coop\n"
+							"-s, --subscriptions  count of subscriptions for every "
+									"agent (max 64)\n"
+							"-b, --bulk           use so_bulk_subscribe()\n"
+							"-m, --mbox           type of mbox to subscribe to:\n"
+							"                     direct, rw_locked, copy_on_write\n"
+							"-h, --help           show this help"
+							<< std::endl;
+					std::exit( 1 );
+				}
+			else if( is_arg( *current, "-a", "--agents" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_agents, ++current, last,
+						"-a", "count of agents in the coop" );
+			else if( is_arg( *current, "-s", "--subscriptions" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_subscriptions, ++current, last,
+						"-s", "count of subscriptions for every agent" );
+			else if( is_arg( *current, "-b", "--bulk" ) )
+				tmp_cfg.m_bulk = true;
+			else if( is_arg( *current, "-m", "--mbox" ) )
+				{
+					std::string name;
+					mandatory_arg_to_value(
+							name, ++current, last,
+							"-m", "type of mbox" );
+					if( "direct" == name )
+						tmp_cfg.m_mbox_type = mbox_type_t::direct;
+					else if( "rw_locked" == name )
+						tmp_cfg.m_mbox_type = mbox_type_t::rw_locked;
+					else if( "copy_on_write" == name )
+						tmp_cfg.m_mbox_type = mbox_type_t::copy_on_write;
+					else
+						throw std::runtime_error( "unsupported mbox type: " + name );
+				}
+			else
+				throw std::runtime_error(
+						std::string( "unknown argument: " ) + *current );
+		}
+
+	if( tmp_cfg.m_subscriptions > max_subscriptions )
+		throw std::runtime_error( "too many subscriptions" );
+
+	return tmp_cfg;
+}
+
+using subscriber_t = void(*)( so_5::agent_t &, const so_5::mbox_t & );
+
+template< int I >
+void
+subscribe_to( so_5::agent_t & agent, const so_5::mbox_t & mbox )
+{
+	agent.so_subscribe( mbox ).event( []( so_5::mhood_t< sig< I > > ) {} );
+}
+
+template< int... I >
+constexpr std::array< subscriber_t, sizeof...(I) >
+make_subscribers( std::integer_sequence< int, I... > )
+{
+	return { &subscribe_to< I >... };
+}
+
+const auto subscribers = make_subscribers(
+		std::make_integer_sequence< int, max_subscriptions >{} );
+
+class a_child_t final : public so_5::agent_t
+	{
+	public :
+		a_child_t(
+			context_t ctx,
+			const cfg_t & cfg,
+			so_5::mbox_t mbox )
+			:	so_5::agent_t{ std::move(ctx) }
+			,	m_cfg( cfg )
+			,	m_mbox( mbox ? std::move(mbox) : so_direct_mbox() )
+			{}
+
+		void
+		so_define_agent() override
+			{
+				if( m_cfg.m_bulk )
+					so_bulk_subscribe( [this] { subscribe_all(); } );
+				else
+					subscribe_all();
+			}
+
+	private :
+		const cfg_t & m_cfg;
+		const so_5::mbox_t m_mbox;
+
+		void
+		subscribe_all()
+			{
+				for( unsigned int i = 0u; i != m_cfg.m_subscriptions; ++i )
+					subscribers[ i ]( *this, m_mbox );
+			}
+	};
+
+const char *
+mbox_type_name( mbox_type_t t )
+	{
+		switch( t )
+			{
+			case mbox_type_t::direct: return "direct";
+			case mbox_type_t::rw_locked: return "rw_locked";
+			case mbox_type_t::copy_on_write: return "copy_on_write";
+			}
+
+		return "unknown";
+	}
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const cfg_t cfg = try_parse_cmdline( argc, argv );
+
+		std::cout << "agents: " << cfg.m_agents
+				<< ", subscriptions: " << cfg.m_subscriptions
+				<< ", bulk: " << ( cfg.m_bulk ? "yes" : "no" )
+				<< ", mbox: " << mbox_type_name( cfg.m_mbox_type )
+				<< std::endl;
+
+		so_5::launch( [&cfg]( so_5::environment_t & env ) {
+				so_5::mbox_t mbox;
+				if( mbox_type_t::rw_locked == cfg.m_mbox_type )
+					mbox = env.create_mbox( so_5::local_mbox_kind_t::rw_locked );
+				else if( mbox_type_t::copy_on_write == cfg.m_mbox_type )
+					mbox = env.create_mbox( so_5::local_mbox_kind_t::copy_on_write );
+
+				benchmarker_t reg_bench;
+				reg_bench.start();
+
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						for( unsigned int i = 0u; i != cfg.m_agents; ++i )
+							coop.make_agent< a_child_t >( cfg, mbox );
+					} );
+
+				reg_bench.finish_and_show_stats(
+						cfg.m_agents * cfg.m_subscriptions,
+						"subscriptions" );
+
+				env.stop();
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * A benchmark for searching event handlers in deep hierarchies of states.
+ *
+ * An agent is in the deepest state of a hierarchy. A message is handled
+ * in the root state and another message isn't handled at all.
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+struct msg_tick final : public so_5::signal_t {};
+
+struct msg_ignored final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t(
+			context_t ctx,
+			std::size_t depth,
+			int tick_count )
+			:	so_5::agent_t( ctx )
+			,	m_tick_count( tick_count )
+			{
+				m_states.emplace_back(
+						std::make_unique< state_t >( self_ptr(), "root" ) );
+				for( std::size_t i = 1; i != depth; ++i )
+					m_states.emplace_back( std::make_unique< state_t >(
+							initial_substate_of{ *(m_states.back()) } ) );
+			}
+
+		void
+		so_define_agent() override
+			{
+				this >>= *(m_states.back());
+
+				m_states.front()->event( &a_test_t::evt_tick );
+			}
+
+		void
+		so_evt_start() override
+			{
+				m_benchmarker.start();
+
+				send_next();
+			}
+
+	private :
+		int m_tick_count;
+		std::uint_fast64_t m_messages_sent{ 0 };
+
+		std::vector< std::unique_ptr< state_t > > m_states;
+
+		benchmarker_t m_benchmarker;
+
+		void
+		send_next()
+			{
+				so_5::send< msg_ignored >( *this );
+				so_5::send< msg_tick >( *this );
+				m_messages_sent += 2;
+			}
+
+		void
+		evt_tick( mhood_t< msg_tick > )
+			{
+				if( --m_tick_count > 0 )
+					send_next();
+				else
+				{
+					m_benchmarker.finish_and_show_stats(
+							m_messages_sent,
+							"messages" );
+
+					so_deregister_agent_coop_normally();
+				}
+			}
+	};
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		std::size_t max_depth = 8;
+		int tick_count = 1000000;
+
+		if( 3 == argc )
+		{
+			max_depth = static_cast< std::size_t >(std::atoi( argv[1] ));
+			ensure( max_depth > 0, "max_depth must be >= 1" );
+
+			tick_count = std::atoi( argv[2] );
+			ensure( tick_count > 0, "tick_count must be >= 1" );
+		}
+
+		for( std::size_t depth = 1; depth <= max_depth; ++depth )
+		{
+			std::cout << "*** benchmark for depth " << depth << " ***"
+				<< std::endl;
+
+			so_5::launch(
+				[depth, tick_count]( so_5::environment_t & env )
+				{
+					env.introduce_coop( [&]( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >( depth, tick_count );
+						} );
+				} );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
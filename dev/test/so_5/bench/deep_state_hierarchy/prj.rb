@@ -0,0 +1,10 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj 'so_5/prj.rb'
+
+	target '_test.bench.so_5.deep_state_hierarchy'
+
+	cpp_source 'main.cpp'
+}
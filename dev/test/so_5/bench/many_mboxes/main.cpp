@@ -64,7 +64,11 @@ try_parse_cmdline(
 							"\noptions:\n"
 							"-m, --mboxes           count of mboxes\n"
 							"-a, --agents           count of agents\n"
-							"-t, --types            count of message types\n"
+							"-t, --types            count of message types (max 64)\n"
+							"                       every mbox has subscriptions for\n"
+							"                       all types, so the growth of price\n"
+							"                       per message shows the growth of\n"
+							"                       lookup cost inside a mbox\n"
 							"-i, --iterations       count of iterations for every "
 									"message type\n"
 							"-s, --storage-type     type of subscription storage\n"
@@ -155,6 +159,38 @@ DECLARE_SIGNAL_TYPE(28);
 DECLARE_SIGNAL_TYPE(29);
 DECLARE_SIGNAL_TYPE(30);
 DECLARE_SIGNAL_TYPE(31);
+DECLARE_SIGNAL_TYPE(32);
+DECLARE_SIGNAL_TYPE(33);
+DECLARE_SIGNAL_TYPE(34);
+DECLARE_SIGNAL_TYPE(35);
+DECLARE_SIGNAL_TYPE(36);
+DECLARE_SIGNAL_TYPE(37);
+DECLARE_SIGNAL_TYPE(38);
+DECLARE_SIGNAL_TYPE(39);
+DECLARE_SIGNAL_TYPE(40);
+DECLARE_SIGNAL_TYPE(41);
+DECLARE_SIGNAL_TYPE(42);
+DECLARE_SIGNAL_TYPE(43);
+DECLARE_SIGNAL_TYPE(44);
+DECLARE_SIGNAL_TYPE(45);
+DECLARE_SIGNAL_TYPE(46);
+DECLARE_SIGNAL_TYPE(47);
+DECLARE_SIGNAL_TYPE(48);
+DECLARE_SIGNAL_TYPE(49);
+DECLARE_SIGNAL_TYPE(50);
+DECLARE_SIGNAL_TYPE(51);
+DECLARE_SIGNAL_TYPE(52);
+DECLARE_SIGNAL_TYPE(53);
+DECLARE_SIGNAL_TYPE(54);
+DECLARE_SIGNAL_TYPE(55);
+DECLARE_SIGNAL_TYPE(56);
+DECLARE_SIGNAL_TYPE(57);
+DECLARE_SIGNAL_TYPE(58);
+DECLARE_SIGNAL_TYPE(59);
+DECLARE_SIGNAL_TYPE(60);
+DECLARE_SIGNAL_TYPE(61);
+DECLARE_SIGNAL_TYPE(62);
+DECLARE_SIGNAL_TYPE(63);
 
 #undef DECLARE_SIGNAL_TYPE
 
@@ -274,7 +310,7 @@ class a_starter_stopper_t
 				create_sender_factories();
 			}
 
-		static const std::size_t max_msg_types = 32;
+		static const std::size_t max_msg_types = 64;
 
 		void
 		so_define_agent() override
@@ -391,6 +427,38 @@ class a_starter_stopper_t
 				MAKE_SENDER_FACTORY(29);
 				MAKE_SENDER_FACTORY(30);
 				MAKE_SENDER_FACTORY(31);
+				MAKE_SENDER_FACTORY(32);
+				MAKE_SENDER_FACTORY(33);
+				MAKE_SENDER_FACTORY(34);
+				MAKE_SENDER_FACTORY(35);
+				MAKE_SENDER_FACTORY(36);
+				MAKE_SENDER_FACTORY(37);
+				MAKE_SENDER_FACTORY(38);
+				MAKE_SENDER_FACTORY(39);
+				MAKE_SENDER_FACTORY(40);
+				MAKE_SENDER_FACTORY(41);
+				MAKE_SENDER_FACTORY(42);
+				MAKE_SENDER_FACTORY(43);
+				MAKE_SENDER_FACTORY(44);
+				MAKE_SENDER_FACTORY(45);
+				MAKE_SENDER_FACTORY(46);
+				MAKE_SENDER_FACTORY(47);
+				MAKE_SENDER_FACTORY(48);
+				MAKE_SENDER_FACTORY(49);
+				MAKE_SENDER_FACTORY(50);
+				MAKE_SENDER_FACTORY(51);
+				MAKE_SENDER_FACTORY(52);
+				MAKE_SENDER_FACTORY(53);
+				MAKE_SENDER_FACTORY(54);
+				MAKE_SENDER_FACTORY(55);
+				MAKE_SENDER_FACTORY(56);
+				MAKE_SENDER_FACTORY(57);
+				MAKE_SENDER_FACTORY(58);
+				MAKE_SENDER_FACTORY(59);
+				MAKE_SENDER_FACTORY(60);
+				MAKE_SENDER_FACTORY(61);
+				MAKE_SENDER_FACTORY(62);
+				MAKE_SENDER_FACTORY(63);
 
 #undef MAKE_SENDER_FACTORY
 			}
@@ -9,6 +9,7 @@
 #include <iterator>
 #include <numeric>
 #include <cstdlib>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -73,9 +74,10 @@ void
 init(
 	so_5::environment_t & env,
 	unsigned int agent_count,
-	unsigned int send_count )
+	unsigned int send_count,
+	so_5::local_mbox_kind_t mbox_kind )
 	{
-		auto mbox = env.create_mbox();
+		auto mbox = env.create_mbox( mbox_kind );
 
 		auto coop = env.make_coop(
 				so_5::disp::active_obj::make_dispatcher(
@@ -94,8 +96,11 @@ init(
 void
 print_usage()
 {
-	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count>\n\n"
-			"<agent_count> and <send_count> must not be 0"
+	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count> "
+			"[rw|cow]\n\n"
+			"<agent_count> and <send_count> must not be 0\n"
+			"rw -- mbox with reader-writer lock is used (the default)\n"
+			"cow -- copy-on-write mbox is used"
 			<< std::endl;
 }
 
@@ -114,7 +119,8 @@ main( int argc, char ** argv )
 		auto ensure_args_validity = []( bool p, const char * msg ) {
 			if( !p ) throw cmd_line_exception( msg );
 		};
-		ensure_args_validity( 3 == argc, "wrong number of arguments" );
+		ensure_args_validity( 3 == argc || 4 == argc,
+				"wrong number of arguments" );
 
 		const unsigned int agent_count = static_cast< unsigned int >(std::atoi( argv[1] ));
 		ensure_args_validity( agent_count != 0, "agent_count must not be 0" );
@@ -122,13 +128,23 @@ main( int argc, char ** argv )
 		const unsigned int send_count = static_cast< unsigned int >(std::atoi( argv[2] ));
 		ensure_args_validity( send_count != 0, "send_count must not be 0" );
 
+		auto mbox_kind = so_5::local_mbox_kind_t::rw_locked;
+		if( 4 == argc )
+		{
+			const std::string kind = argv[3];
+			ensure_args_validity( "rw" == kind || "cow" == kind,
+					"mbox kind must be 'rw' or 'cow'" );
+			if( "cow" == kind )
+				mbox_kind = so_5::local_mbox_kind_t::copy_on_write;
+		}
+
 		benchmarker_t benchmark;
 		benchmark.start();
 
 		so_5::launch(
-			[agent_count, send_count]( so_5::environment_t & env )
+			[agent_count, send_count, mbox_kind]( so_5::environment_t & env )
 			{
-				init( env, agent_count, send_count );
+				init( env, agent_count, send_count, mbox_kind );
 			} );
 
 		benchmark.finish_and_show_stats(
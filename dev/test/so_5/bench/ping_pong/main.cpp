@@ -27,6 +27,7 @@ struct	cfg_t
 
 	bool	m_active_objects = false;
 	bool	m_simple_lock = false;
+	bool	m_lock_free = false;
 
 	bool	m_direct_mboxes = false;
 
@@ -58,6 +59,7 @@ try_parse_cmdline(
 							"-d, --direct-mboxes  use direct(mpsc) mboxes for agents\n"
 							"-l, --message-limits use message limits for agents\n"
 							"-s, --simple-lock    use simple lock factory for event queue\n"
+							"-f, --lock-free      use lock-free MPSC event queue\n"
 							"-T, --track-activity turn work thread activity tracking on\n"
 							"-e, --env            environment infrastructure to be used:\n"
 							"                       default_mt (default),\n"
@@ -77,6 +79,8 @@ try_parse_cmdline(
 				tmp_cfg.m_message_limits = true;
 			else if( is_arg( *current, "-s", "--simple-lock" ) )
 				tmp_cfg.m_simple_lock = true;
+			else if( is_arg( *current, "-f", "--lock-free" ) )
+				tmp_cfg.m_lock_free = true;
 			else if( is_arg( *current, "-r", "--requests" ) )
 				mandatory_arg_to_value(
 						tmp_cfg.m_request_count, ++current, last,
@@ -262,7 +266,8 @@ show_cfg(
 			<< "active objects: " << ( cfg.m_active_objects ? "yes" : "no" )
 			<< ", direct mboxes: " << ( cfg.m_direct_mboxes ? "yes" : "no" )
 			<< ", limits: " << ( cfg.m_message_limits ? "yes" : "no" )
-			<< ", locks: " << ( cfg.m_simple_lock ? "simple" : "combined" )
+			<< ", locks: " << ( cfg.m_lock_free ? "lock_free" :
+					( cfg.m_simple_lock ? "simple" : "combined" ) )
 			<< ", requests: " << cfg.m_request_count
 			<< ", activity tracking: " << ( cfg.m_track_activity ? "on" : "off" )
 			<< ", env: " << ( env_type_t::default_mt == cfg.m_env ?
@@ -394,6 +399,9 @@ main( int argc, char ** argv )
 				if( cfg.m_simple_lock )
 					params.queue_locks_defaults_manager(
 							so_5::make_defaults_manager_for_simple_locks() );
+				else if( cfg.m_lock_free )
+					params.queue_locks_defaults_manager(
+							so_5::make_defaults_manager_for_lock_free_queues() );
 			} );
 
 		test_env.process_results();
@@ -0,0 +1,255 @@
+/*
+ * A benchmark for pooled allocation of message instances.
+ *
+ * Several producers send messages to one consumer. Every producer
+ * and the consumer work on different threads. So message instances are
+ * allocated on one thread and deallocated on another.
+ *
+ * The global operator new is replaced to count all allocations made
+ * during the benchmark.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+#include <test/3rd_party/various_helpers/cmd_line_args_helpers.hpp>
+
+namespace allocation_counter
+{
+
+std::atomic< unsigned long long > g_allocations{ 0u };
+
+} /* namespace allocation_counter */
+
+void *
+operator new( std::size_t size )
+{
+	allocation_counter::g_allocations.fetch_add( 1u, std::memory_order_relaxed );
+
+	if( void * p = std::malloc( size ? size : 1u ) )
+		return p;
+
+	throw std::bad_alloc{};
+}
+
+void
+operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+struct cfg_t
+{
+	std::size_t m_producers = 4u;
+	std::size_t m_messages = 1000000u;
+	bool m_pooled = false;
+};
+
+cfg_t
+try_parse_cmdline(
+	int argc,
+	char ** argv )
+{
+	cfg_t tmp_cfg;
+
+	for( char ** current = &argv[ 1 ], **last = argv + argc;
+			current != last;
+			++current )
+		{
+			if( is_arg( *current, "-h", "--help" ) )
+				{
+					std::cout << "usage:\n"
+							"_test.bench.so_5.pooled_msgs <options>\n"
+							"\noptions:\n"
+							"-p, --producers  count of producers\n"
+							"-m, --messages   count of messages from every producer\n"
+							"-P, --pooled     use pooled allocation of messages\n"
+							"-h, --help       show this description\n"
+							<< std::endl;
+					std::exit(1);
+				}
+			else if( is_arg( *current, "-p", "--producers" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_producers, ++current, last,
+						"-p", "count of producers" );
+			else if( is_arg( *current, "-m", "--messages" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_messages, ++current, last,
+						"-m", "count of messages from every producer" );
+			else if( is_arg( *current, "-P", "--pooled" ) )
+				tmp_cfg.m_pooled = true;
+			else
+				throw std::runtime_error(
+						std::string( "unknown argument: " ) + *current );
+		}
+
+	return tmp_cfg;
+}
+
+// Messages of those types have the same layout.
+// But only pooled_data uses pooled allocation.
+struct plain_data
+{
+	std::uint64_t m_seq;
+	std::uint64_t m_value;
+};
+
+struct pooled_data
+{
+	std::uint64_t m_seq;
+	std::uint64_t m_value;
+};
+
+namespace so_5 {
+
+template<> struct pooled_message_allocation< pooled_data > : public std::true_type {};
+
+} /* namespace so_5 */
+
+struct produce final : public so_5::signal_t {};
+
+class a_consumer_t final : public so_5::agent_t
+{
+public :
+	a_consumer_t( context_t ctx, std::size_t expected )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_expected{ expected }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< plain_data > cmd ) {
+					on_data( cmd->m_value );
+				} )
+			.event( [this]( mhood_t< pooled_data > cmd ) {
+					on_data( cmd->m_value );
+				} );
+	}
+
+	void
+	so_evt_finish() override
+	{
+		if( m_sum != m_expected )
+			std::cerr << "unexpected sum: " << m_sum << std::endl;
+	}
+
+private :
+	const std::size_t m_expected;
+	std::size_t m_received{ 0u };
+	std::uint64_t m_sum{ 0u };
+
+	void
+	on_data( std::uint64_t value )
+	{
+		m_sum += value;
+		if( ++m_received == m_expected )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+template< typename Msg >
+class a_producer_t final : public so_5::agent_t
+{
+public :
+	a_producer_t( context_t ctx, so_5::mbox_t dest, std::size_t messages )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_dest{ std::move(dest) }
+		,	m_messages{ messages }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().create_mbox( "produce" ) )
+			.event( &a_producer_t::on_produce );
+	}
+
+private :
+	const so_5::mbox_t m_dest;
+	const std::size_t m_messages;
+
+	void
+	on_produce( mhood_t< produce > )
+	{
+		for( std::size_t i = 0u; i != m_messages; ++i )
+			so_5::send< Msg >( m_dest, std::uint64_t{ i }, std::uint64_t{ 1u } );
+	}
+};
+
+template< typename Msg >
+void
+run_benchmark( const cfg_t & cfg )
+{
+	benchmarker_t benchmarker;
+	unsigned long long allocations_before = 0u;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+		env.introduce_coop(
+			so_5::disp::active_obj::make_dispatcher( env ).binder(),
+			[&]( so_5::coop_t & coop ) {
+				auto consumer = coop.make_agent< a_consumer_t >(
+						cfg.m_producers * cfg.m_messages );
+				for( std::size_t i = 0u; i != cfg.m_producers; ++i )
+					coop.make_agent< a_producer_t< Msg > >(
+							consumer->so_direct_mbox(), cfg.m_messages );
+			} );
+
+		allocations_before = allocation_counter::g_allocations.load();
+		benchmarker.start();
+
+		so_5::send< produce >( env.create_mbox( "produce" ) );
+	} );
+
+	const auto total_messages = static_cast< unsigned long long >(
+			cfg.m_producers * cfg.m_messages );
+	const auto allocations = allocation_counter::g_allocations.load() -
+			allocations_before;
+
+	benchmarker.finish_and_show_stats( total_messages, "messages" );
+
+	benchmarks_details::precision_settings_t precision{ std::cout, 4 };
+	std::cout << "allocations: " << allocations
+			<< ", per message: "
+			<< static_cast< double >( allocations ) / total_messages
+			<< std::endl;
+}
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const cfg_t cfg = try_parse_cmdline( argc, argv );
+
+		std::cout << "producers: " << cfg.m_producers
+				<< ", messages per producer: " << cfg.m_messages
+				<< ", allocation: " << (cfg.m_pooled ? "pooled" : "plain")
+				<< std::endl;
+
+		if( cfg.m_pooled )
+			run_benchmark< pooled_data >( cfg );
+		else
+			run_benchmark< plain_data >( cfg );
+
+		return 0;
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+	}
+
+	return 2;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <chrono>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -82,15 +83,26 @@ size_t pool_size()
 	return c > 1 ? c - 1 : 1;
 }
 
-int main()
+int main( int argc, char ** argv )
 {
+	// Work-stealing scheduling is used if "-w" is specified.
+	const bool work_stealing = 2 == argc && std::string{ "-w" } == argv[ 1 ];
+	std::cout << "scheduling: "
+		<< (work_stealing ? "work_stealing" : "central_queue") << std::endl;
+
 	number result = 0;
 
 	using clock_type = std::chrono::high_resolution_clock;
 	const auto start_at = clock_type::now();
 
-	so_5::launch( [&result]( environment_t & env ) {
-		auto tp_disp = disp::thread_pool::make_dispatcher( env, pool_size() );
+	so_5::launch( [&result, work_stealing]( environment_t & env ) {
+		auto tp_disp = disp::thread_pool::make_dispatcher( env,
+				std::string_view{},
+				disp::thread_pool::disp_params_t{}
+					.thread_count( pool_size() )
+					.scheduling( work_stealing ?
+							disp::thread_pool::scheduling_t::work_stealing :
+							disp::thread_pool::scheduling_t::central_queue ) );
 
 		auto result_ch = env.create_mchain( make_unlimited_mchain_params() );
 
@@ -49,6 +49,8 @@ struct cfg_t
 		std::size_t m_messages_to_send_at_start = 1;
 		lock_type_t m_lock_type = lock_type_t::combined_lock;
 		bool m_track_activity = false;
+		bool m_work_stealing = false;
+		bool m_batch_extraction = false;
 	};
 
 cfg_t
@@ -77,6 +79,8 @@ try_parse_cmdline(
 							"-P, --adv-thread-pool   use adv_thread_pool dispatcher\n"
 							"-s, --simple-lock       use simple_lock_factory for MPMC queue\n"
 							"-T, --track-activity    turn work thread activity tracking on\n"
+							"-w, --work-stealing     use work-stealing scheduling\n"
+							"-b, --batch-extraction  extract demands by batches\n"
 							"-h, --help              show this description\n"
 							<< std::endl;
 					std::exit(1);
@@ -123,6 +127,12 @@ try_parse_cmdline(
 			else if( is_arg( *current, "-T", "--track-activity" ) )
 				tmp_cfg.m_track_activity = true;
 
+			else if( is_arg( *current, "-w", "--work-stealing" ) )
+				tmp_cfg.m_work_stealing = true;
+
+			else if( is_arg( *current, "-b", "--batch-extraction" ) )
+				tmp_cfg.m_batch_extraction = true;
+
 			else
 				throw std::runtime_error(
 						std::string( "unknown argument: " ) + *current );
@@ -301,6 +311,8 @@ class a_contoller_t : public so_5::agent_t
 				const auto disp_params = [&] {
 					disp_params_t params;
 					params.thread_count( threads );
+					if( m_cfg.m_work_stealing )
+						params.use_work_stealing();
 					if( lock_type_t::simple_lock == m_cfg.m_lock_type )
 						params.set_queue_params( queue_traits::queue_params_t{}
 								.lock_factory( queue_traits::simple_lock_factory() ) );
@@ -312,6 +324,8 @@ class a_contoller_t : public so_5::agent_t
 						params.fifo( fifo_t::individual );
 					if( m_cfg.m_demands_at_once )
 						params.max_demands_at_once( m_cfg.m_demands_at_once );
+					if( m_cfg.m_batch_extraction )
+						params.batch_extraction( true );
 					return params;
 				};
 
@@ -326,6 +340,8 @@ class a_contoller_t : public so_5::agent_t
 				const auto disp_params = [&] {
 					disp_params_t params;
 					params.thread_count( threads );
+					if( m_cfg.m_work_stealing )
+						params.use_work_stealing();
 					if( lock_type_t::simple_lock == m_cfg.m_lock_type )
 						params.set_queue_params( queue_traits::queue_params_t{}
 								.lock_factory( queue_traits::simple_lock_factory() ) );
@@ -366,6 +382,9 @@ show_cfg( const cfg_t & cfg )
 			<< (lock_type_t::combined_lock == cfg.m_lock_type ?
 					"combined" : "simple")
 			<< std::endl;
+	std::cout << "  scheduling: "
+			<< (cfg.m_work_stealing ? "work_stealing" : "central_queue")
+			<< std::endl;
 
 	if( dispatcher_t::thread_pool == cfg.m_dispatcher ) 
 	{
@@ -376,6 +395,8 @@ show_cfg( const cfg_t & cfg )
 			std::cout << "default ("
 				<< so_5::disp::thread_pool::bind_params_t().query_max_demands_at_once()
 				<< ")";
+		std::cout << "\n*** batch extraction: "
+				<< (cfg.m_batch_extraction ? "on" : "off");
 	}
 
 	std::cout << "\n*** threads in pool: ";
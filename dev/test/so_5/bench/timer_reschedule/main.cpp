@@ -0,0 +1,240 @@
+/*
+ * A benchmark for restarting of timers.
+ *
+ * There are many timers which imitate inactivity timeouts for
+ * connections. Every timer is restarted many times and almost never fires.
+ * A timer can be restarted by releasing the old timer and creating
+ * a new one or by rescheduling the existing timer.
+ *
+ * The global operator new is replaced to count all allocations made
+ * during the benchmark.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/benchmark_helpers.hpp>
+#include <test/3rd_party/various_helpers/cmd_line_args_helpers.hpp>
+
+namespace allocation_counter
+{
+
+std::atomic< unsigned long long > g_allocations{ 0u };
+
+} /* namespace allocation_counter */
+
+void *
+operator new( std::size_t size )
+{
+	allocation_counter::g_allocations.fetch_add( 1u, std::memory_order_relaxed );
+
+	if( void * p = std::malloc( size ? size : 1u ) )
+		return p;
+
+	throw std::bad_alloc{};
+}
+
+void
+operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+struct cfg_t
+{
+	std::size_t m_timers = 10000u;
+	std::size_t m_restarts = 100u;
+	bool m_reschedule = false;
+	std::string m_timer_type{ "wheel" };
+};
+
+cfg_t
+try_parse_cmdline(
+	int argc,
+	char ** argv )
+{
+	cfg_t tmp_cfg;
+
+	for( char ** current = &argv[ 1 ], **last = argv + argc;
+			current != last;
+			++current )
+		{
+			if( is_arg( *current, "-h", "--help" ) )
+				{
+					std::cout << "usage:\n"
+							"_test.bench.so_5.timer_reschedule <options>\n"
+							"\noptions:\n"
+							"-t, --timers      count of timers\n"
+							"-r, --restarts    count of restarts for every timer\n"
+							"-R, --reschedule  use reschedule() instead of "
+									"recreation of timers\n"
+							"-T, --timer-type  type of timer thread "
+									"(wheel, hwheel, heap, list)\n"
+							"-h, --help        show this description\n"
+							<< std::endl;
+					std::exit(1);
+				}
+			else if( is_arg( *current, "-t", "--timers" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_timers, ++current, last,
+						"-t", "count of timers" );
+			else if( is_arg( *current, "-r", "--restarts" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_restarts, ++current, last,
+						"-r", "count of restarts for every timer" );
+			else if( is_arg( *current, "-R", "--reschedule" ) )
+				tmp_cfg.m_reschedule = true;
+			else if( is_arg( *current, "-T", "--timer-type" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_timer_type, ++current, last,
+						"-T", "type of timer thread" );
+			else
+				throw std::runtime_error(
+						std::string( "unknown argument: " ) + *current );
+		}
+
+	return tmp_cfg;
+}
+
+so_5::timer_thread_factory_t
+make_timer_factory( const std::string & type )
+{
+	if( "wheel" == type )
+		return so_5::timer_wheel_factory();
+	else if( "hwheel" == type )
+		return so_5::timer_hierarchical_wheel_factory();
+	else if( "heap" == type )
+		return so_5::timer_heap_factory();
+	else if( "list" == type )
+		return so_5::timer_list_factory();
+
+	throw std::runtime_error( "unknown timer type: " + type );
+}
+
+struct inactivity_timeout final : public so_5::signal_t {};
+
+class a_restarter_t final : public so_5::agent_t
+{
+public :
+	a_restarter_t(
+		context_t ctx,
+		const cfg_t & cfg,
+		benchmarker_t & benchmarker,
+		unsigned long long & allocations )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_cfg{ cfg }
+		,	m_benchmarker{ benchmarker }
+		,	m_allocations{ allocations }
+		,	m_timers( cfg.m_timers )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( []( mhood_t< inactivity_timeout > ) {} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		for( auto & t : m_timers )
+			t = start_timer();
+
+		const auto allocations_before = allocation_counter::g_allocations.load();
+		m_benchmarker.start();
+
+		for( std::size_t i = 0u; i != m_cfg.m_restarts; ++i )
+			for( auto & t : m_timers )
+			{
+				if( m_cfg.m_reschedule )
+					t.reschedule( timeout() );
+				else
+				{
+					t.release();
+					t = start_timer();
+				}
+			}
+
+		m_benchmarker.finish_and_show_stats(
+				static_cast< unsigned long long >(
+						m_cfg.m_timers * m_cfg.m_restarts ),
+				"restarts" );
+		m_allocations = allocation_counter::g_allocations.load() -
+				allocations_before;
+
+		so_deregister_agent_coop_normally();
+	}
+
+private :
+	const cfg_t & m_cfg;
+	benchmarker_t & m_benchmarker;
+	unsigned long long & m_allocations;
+
+	std::vector< so_5::timer_id_t > m_timers;
+
+	static std::chrono::steady_clock::duration
+	timeout() { return std::chrono::seconds{ 30 }; }
+
+	so_5::timer_id_t
+	start_timer()
+	{
+		return so_5::send_periodic< inactivity_timeout >(
+				*this, timeout(), std::chrono::seconds::zero() );
+	}
+};
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const cfg_t cfg = try_parse_cmdline( argc, argv );
+
+		std::cout << "timer: " << cfg.m_timer_type
+				<< ", timers: " << cfg.m_timers
+				<< ", restarts: " << cfg.m_restarts
+				<< ", mode: " << (cfg.m_reschedule ? "reschedule" : "recreate")
+				<< std::endl;
+
+		benchmarker_t benchmarker;
+		unsigned long long allocations = 0u;
+
+		so_5::launch(
+			[&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_restarter_t >(
+								cfg, benchmarker, allocations );
+					} );
+			},
+			[&]( so_5::environment_params_t & params ) {
+				params.timer_thread( make_timer_factory( cfg.m_timer_type ) );
+			} );
+
+		benchmarks_details::precision_settings_t precision{ std::cout, 4 };
+		std::cout << "allocations: " << allocations
+				<< ", per restart: "
+				<< static_cast< double >( allocations ) /
+						static_cast< double >( cfg.m_timers * cfg.m_restarts )
+				<< std::endl;
+
+		return 0;
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+	}
+
+	return 2;
+}
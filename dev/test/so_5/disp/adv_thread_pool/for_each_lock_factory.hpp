@@ -31,5 +31,9 @@ for_each_lock_factory( L && action )
 		run_with_lock_factory( "simple_lock",
 				simple_lock_factory(),
 				std::forward<L>(action) );
+
+		run_with_lock_factory( "adaptive_lock()",
+				adaptive_lock_factory(),
+				std::forward<L>(action) );
 	}
 
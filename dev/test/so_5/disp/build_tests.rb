@@ -16,6 +16,17 @@ MxxRu::Cpp::composite_target {
 	add_test[ 'prio_ot_quoted_round_robin/build_tests.rb' ]
 
 	add_test[ 'prio_dt_one_per_prio/build_tests.rb' ]
+
+	add_test[ 'no_demand_allocations/prj.ut.rb' ]
+
+	add_test[ 'thread_affinity/prj.ut.rb' ]
+
+	add_test[ 'lock_stats/prj.ut.rb' ]
+
+	add_test[ 'reactor/prj.ut.rb' ]
+
+	add_test[ 'edf/prj.ut.rb' ]
+	add_test[ 'prio_thread_pool/prj.ut.rb' ]
 }
 
 
@@ -0,0 +1,241 @@
+/*
+ * A test for edf dispatcher.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+namespace edf = so_5::disp::edf;
+
+using clock_type = std::chrono::steady_clock;
+
+struct msg_value final : public so_5::message_t
+{
+	std::string m_value;
+
+	msg_value( std::string value ) : m_value( std::move(value) ) {}
+};
+
+struct msg_signal final : public so_5::signal_t {};
+
+// Demands must be handled in the order of their deadlines.
+class a_ordering_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_value > cmd ) {
+					handle( cmd->m_value );
+				} )
+			.event( [this]( mutable_mhood_t< msg_value > cmd ) {
+					handle( "mutable-" + cmd->m_value );
+				} )
+			.event( [this]( mhood_t< msg_signal > ) {
+					handle( "signal" );
+				} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		using namespace std::chrono;
+
+		// All messages are stored in the queue until the return
+		// from so_evt_start.
+		const auto now = clock_type::now();
+
+		so_5::send< msg_value >( *this, "plain" );
+		edf::send_with_deadline< msg_value >( *this, now + milliseconds(500), "c" );
+		edf::send_with_deadline< msg_value >( *this, now + milliseconds(100), "a" );
+		edf::send_with_deadline< so_5::mutable_msg< msg_value > >(
+				*this, now + milliseconds(400), "d" );
+		edf::send_with_deadline< msg_value >( *this, milliseconds(300), "b" );
+		edf::send_with_deadline< msg_signal >( *this, now + milliseconds(200) );
+	}
+
+private :
+	std::string m_trace;
+
+	void
+	handle( const std::string & what )
+	{
+		m_trace += what + ";";
+
+		if( 6u == ++m_handled )
+		{
+			ensure_or_die( "a;signal;b;mutable-d;c;plain;" == m_trace,
+					"unexpected order: " + m_trace );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+
+	unsigned int m_handled{ 0u };
+};
+
+void
+check_ordering()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			env.introduce_coop(
+				edf::make_dispatcher( env, "ordering",
+						edf::disp_params_t{}.default_timeout(
+								std::chrono::seconds(1) ) ).binder(),
+				[]( so_5::coop_t & coop ) {
+					coop.make_agent< a_ordering_t >();
+				} );
+		} );
+}
+
+// Expired messages must be dropped.
+class a_dropping_t final : public so_5::agent_t
+{
+	struct msg_check final : public so_5::signal_t {};
+
+public :
+	a_dropping_t( context_t ctx, std::atomic< bool > & done )
+		:	so_5::agent_t{ ctx
+				+ limit_then_drop< msg_value >( 1u )
+				+ limit_then_abort< msg_check >( 1u ) }
+		,	m_done{ done }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_dropping_t::evt_value )
+			.event( &a_dropping_t::evt_check );
+	}
+
+	void
+	so_evt_start() override
+	{
+		edf::send_with_deadline< msg_value >(
+				*this, std::chrono::milliseconds(1), "expired" );
+		so_5::send< msg_check >( *this );
+
+		// The deadline of the first message will be missed.
+		std::this_thread::sleep_for( std::chrono::milliseconds(20) );
+	}
+
+private :
+	std::atomic< bool > & m_done;
+
+	void
+	evt_value( mhood_t< msg_value > cmd )
+	{
+		ensure_or_die( "expired" != cmd->m_value,
+				"expired message must be dropped" );
+
+		m_done = true;
+	}
+
+	void
+	evt_check( mhood_t< msg_check > )
+	{
+		// The limit for msg_value must be released by the dropped message.
+		so_5::send< msg_value >( *this, "actual" );
+	}
+};
+
+class a_monitor_t final : public so_5::agent_t
+{
+public :
+	a_monitor_t( context_t ctx, std::atomic< bool > & done )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_done{ done }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 50 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	std::atomic< bool > & m_done;
+
+	std::size_t m_misses{ 0u };
+	std::size_t m_drops{ 0u };
+
+	void
+	evt_quantity( const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		const std::string prefix = evt.m_prefix.c_str();
+		if( std::string::npos == prefix.find( "/edf/dropping" ) )
+			return;
+
+		if( so_5::stats::suffixes::deadline_miss_count() == evt.m_suffix )
+			m_misses = evt.m_value;
+		else if( so_5::stats::suffixes::expired_demand_drop_count() == evt.m_suffix )
+			m_drops = evt.m_value;
+
+		if( m_done && m_misses && m_drops )
+		{
+			ensure_or_die( 1u == m_misses && 1u == m_drops,
+					"unexpected stats: misses=" + std::to_string( m_misses ) +
+					", drops=" + std::to_string( m_drops ) );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+check_dropping()
+{
+	std::atomic< bool > done{ false };
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_monitor_t >( done );
+
+					coop.make_agent_with_binder< a_dropping_t >(
+							edf::make_dispatcher( env, "dropping",
+									edf::disp_params_t{}
+										.default_timeout( std::chrono::seconds(1) )
+										.drop_expired( true ) ).binder(),
+							done );
+				} );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( check_ordering, 20, "ordering by deadlines" );
+
+		run_with_time_limit( check_dropping, 20, "dropping of expired demands" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * A test for adaptive queue locks and distribution of their stats.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+namespace mpsc = so_5::disp::mpsc_queue_traits;
+
+// Makes a serie of waits on the lock. Every wait is finished
+// by a notification after the specified pause.
+void
+wait_for_notifies(
+	mpsc::lock_t & lock,
+	unsigned int waits,
+	std::chrono::microseconds pause )
+{
+	std::atomic< unsigned int > completed{ 0u };
+
+	mpsc::unique_lock_t consumer{ lock };
+
+	std::thread producer{ [&] {
+			for( unsigned int i = 0; i != waits; ++i )
+			{
+				// The previous notification must be handled.
+				while( completed.load( std::memory_order_acquire ) != i )
+					std::this_thread::yield();
+
+				std::this_thread::sleep_for( pause );
+
+				// The lock can be acquired only when the consumer is waiting.
+				mpsc::lock_guard_t guard{ lock };
+				guard.notify_one();
+			}
+		} };
+
+	for( unsigned int i = 0; i != waits; ++i )
+	{
+		consumer.wait_for_notify();
+		completed.store( i + 1u, std::memory_order_release );
+	}
+
+	producer.join();
+}
+
+so_5::stats::lock_stats_t
+stats_of( const mpsc::lock_t & lock )
+{
+	so_5::stats::lock_stats_t result;
+	ensure_or_die( lock.query_stats( result ),
+			"adaptive lock must provide stats" );
+	return result;
+}
+
+void
+check_learning()
+{
+	const std::chrono::microseconds max_budget{ 20000 };
+
+	auto lock = mpsc::adaptive_lock_factory( max_budget )();
+
+	const auto initial = stats_of( *lock );
+	ensure_or_die( initial.m_spin_budget > std::chrono::nanoseconds::zero() &&
+			initial.m_spin_budget <= max_budget,
+			"initial spin budget is out of range" );
+
+	// Notifications come after max_budget. Spinning is useless.
+	wait_for_notifies( *lock, 10u, std::chrono::microseconds{ 40000 } );
+
+	const auto after_long = stats_of( *lock );
+	std::cout << "long pauses: parks=" << after_long.m_parks
+			<< ", spin_wakeups=" << after_long.m_spin_wakeups
+			<< ", budget=" << after_long.m_spin_budget.count() << "ns" << std::endl;
+
+	ensure_or_die( 10u == after_long.m_parks + after_long.m_spin_wakeups,
+			"every wait must be counted" );
+	ensure_or_die( after_long.m_spin_budget < initial.m_spin_budget,
+			"spin budget must be decreased" );
+
+	// Notifications come a bit later than spinning stage.
+	// A longer spinning would avoid parking.
+	wait_for_notifies( *lock, 20u, std::chrono::microseconds{ 5000 } );
+
+	const auto after_short = stats_of( *lock );
+	std::cout << "short pauses: parks=" << after_short.m_parks
+			<< ", spin_wakeups=" << after_short.m_spin_wakeups
+			<< ", budget=" << after_short.m_spin_budget.count() << "ns" << std::endl;
+
+	ensure_or_die( 30u == after_short.m_parks + after_short.m_spin_wakeups,
+			"every wait must be counted" );
+	ensure_or_die( after_short.m_spin_budget > after_long.m_spin_budget,
+			"spin budget must be increased" );
+	ensure_or_die( after_short.m_spin_budget <= max_budget,
+			"spin budget must not exceed the limit" );
+
+	// Ordinary locks don't collect stats.
+	so_5::stats::lock_stats_t dummy;
+	ensure_or_die( !mpsc::combined_lock_factory()()->query_stats( dummy ),
+			"combined lock must not provide stats" );
+	ensure_or_die(
+			!so_5::disp::mpmc_queue_traits::simple_lock_factory()()->query_stats(
+					dummy ),
+			"simple lock must not provide stats" );
+}
+
+class a_busy_t final : public so_5::agent_t
+{
+	struct tick final : public so_5::signal_t {};
+
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< tick > ) {
+				so_5::send_delayed< tick >( *this, std::chrono::milliseconds(2) );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< tick >( *this );
+	}
+};
+
+class a_monitor_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 100 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	bool m_one_thread_seen{ false };
+	bool m_thread_pool_seen{ false };
+
+	void
+	evt_quantity( const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		if( so_5::stats::suffixes::lock_park_count() != evt.m_suffix || !evt.m_value )
+			return;
+
+		const std::string prefix = evt.m_prefix.c_str();
+		std::cout << prefix << " -> parks " << evt.m_value << std::endl;
+
+		ensure_or_die( std::string::npos != prefix.find( "adaptive" ),
+				"lock stats from unexpected dispatcher: " + prefix );
+
+		if( std::string::npos != prefix.find( "/ot/" ) )
+			m_one_thread_seen = true;
+		else if( std::string::npos != prefix.find( "/tp/" ) )
+			m_thread_pool_seen = true;
+
+		if( m_one_thread_seen && m_thread_pool_seen )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+void
+check_distribution()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_monitor_t >();
+
+					using namespace so_5::disp;
+
+					coop.make_agent_with_binder< a_busy_t >(
+							one_thread::make_dispatcher( env, "adaptive",
+									one_thread::disp_params_t{}
+										.tune_queue_params(
+											[]( one_thread::queue_traits::queue_params_t & p ) {
+												p.lock_factory(
+														one_thread::queue_traits::adaptive_lock_factory() );
+											} ) ).binder() );
+
+					auto tp = thread_pool::make_dispatcher( env, "adaptive",
+							thread_pool::disp_params_t{}
+								.thread_count( 2 )
+								.tune_queue_params(
+									[]( thread_pool::queue_traits::queue_params_t & p ) {
+										p.lock_factory(
+												thread_pool::queue_traits::adaptive_lock_factory() );
+									} ) );
+					for( int i = 0; i != 2; ++i )
+						coop.make_agent_with_binder< a_busy_t >(
+								tp.binder( thread_pool::bind_params_t{}
+										.fifo( thread_pool::fifo_t::individual ) ) );
+
+					// A dispatcher with an ordinary lock doesn't distribute lock stats.
+					coop.make_agent_with_binder< a_busy_t >(
+							one_thread::make_dispatcher( env, "ordinary" ).binder() );
+				} );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( check_learning, 20, "learning of spin budget" );
+
+		run_with_time_limit( check_distribution, 20,
+				"distribution of lock stats" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,9 @@
+require 'mxx_ru/binary_unittest'
+
+path = 'test/so_5/disp/lock_stats'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"#{path}/prj.ut.rb",
+		"#{path}/prj.rb" )
+)
@@ -0,0 +1,190 @@
+/*
+ * A test for absence of allocations for demands in the steady state
+ * for queues of thread_pool and prio_one_thread dispatchers.
+ *
+ * Demands are pushed to and popped from a queue directly. Only
+ * allocations made by the current thread inside push() and pop() are
+ * counted. There must be no such allocations after the warm-up.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+
+#include <so_5/all.hpp>
+
+#include <so_5/disp/thread_pool/impl/disp.hpp>
+#include <so_5/disp/prio_one_thread/strictly_ordered/impl/demand_queue.hpp>
+#include <so_5/disp/prio_one_thread/quoted_round_robin/impl/demand_queue.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+// Allocations are counted only when this flag is set for the thread.
+thread_local bool g_counting{ false };
+thread_local std::size_t g_allocations{ 0u };
+
+void *
+operator new( std::size_t size )
+{
+	if( g_counting )
+		++g_allocations;
+
+	void * p = std::malloc( size ? size : 1u );
+	if( !p )
+		throw std::bad_alloc{};
+	return p;
+}
+
+void
+operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+// Counts allocations made by the current thread inside a lambda.
+template< typename Lambda >
+std::size_t
+allocations_inside( Lambda && lambda )
+{
+	const auto before = g_allocations;
+
+	g_counting = true;
+	lambda();
+	g_counting = false;
+
+	return g_allocations - before;
+}
+
+const unsigned int demands_per_round = 32;
+const unsigned int measured_rounds = 1000;
+
+void
+check_allocations(
+	const std::string & case_name,
+	std::size_t allocations )
+{
+	std::cout << case_name << ": " << allocations << " allocation(s)"
+			<< std::endl;
+
+	ensure( 0u == allocations,
+			case_name + ": unexpected allocations in the steady state: " +
+			std::to_string( allocations ) );
+}
+
+// A dispatcher queue which doesn't schedule agent queues anywhere.
+template< typename Agent_Queue >
+struct dummy_disp_queue_t
+{
+	void
+	schedule( Agent_Queue * ) noexcept {}
+};
+
+void
+check_thread_pool_agent_queue()
+{
+	using agent_queue_t = so_5::disp::thread_pool::impl::agent_queue_template_t<
+			dummy_disp_queue_t >;
+
+	agent_queue_t::dispatcher_queue_t disp_queue;
+	agent_queue_t queue{
+			disp_queue,
+			so_5::disp::thread_pool::bind_params_t{},
+			so_5::prio::p0 };
+
+	const auto round = [&queue]( unsigned int demands ) {
+			for( unsigned int i = 0; i != demands; ++i )
+				queue.push( so_5::execution_demand_t{} );
+			for( unsigned int i = 0; i != demands; ++i )
+				queue.pop( i );
+		};
+
+	round( demands_per_round );
+
+	check_allocations( "thread_pool",
+			allocations_inside( [&] {
+				for( unsigned int i = 0; i != measured_rounds; ++i )
+					round( demands_per_round );
+			} ) );
+
+	so_5::execution_demand_t batch[ demands_per_round ];
+	check_allocations( "thread_pool(batch)",
+			allocations_inside( [&] {
+				for( unsigned int i = 0; i != measured_rounds; ++i )
+				{
+					queue.push_batch( batch, demands_per_round );
+					for( unsigned int j = 0; j != demands_per_round; ++j )
+						queue.pop( j );
+				}
+			} ) );
+}
+
+template< typename Demand_Queue, typename... Args >
+void
+check_prio_one_thread_queue(
+	const std::string & case_name,
+	Args && ...args )
+{
+	Demand_Queue queue{
+			so_5::disp::mpsc_queue_traits::simple_lock_factory()(),
+			std::forward< Args >( args )... };
+
+	// The last extracted demand is kept until the next call to pop().
+	typename Demand_Queue::demand_ptr_t processed;
+
+	const auto round = [&]( unsigned int demands ) {
+			for( unsigned int i = 0; i != demands; ++i )
+				queue.event_queue_by_priority(
+						so_5::to_priority_t( i % so_5::prio::total_priorities_count ) )
+					.push( so_5::execution_demand_t{} );
+			for( unsigned int i = 0; i != demands; ++i )
+				processed = queue.pop( std::move( processed ) );
+		};
+
+	// One more item is necessary because of the kept demand.
+	round( demands_per_round + 1u );
+
+	check_allocations( case_name,
+			allocations_inside( [&] {
+				for( unsigned int i = 0; i != measured_rounds; ++i )
+					round( demands_per_round );
+			} ) );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				check_thread_pool_agent_queue();
+
+				check_prio_one_thread_queue<
+						so_5::disp::prio_one_thread::strictly_ordered::impl::
+								demand_queue_t >(
+						"prio_one_thread::strictly_ordered" );
+
+				check_prio_one_thread_queue<
+						so_5::disp::prio_one_thread::quoted_round_robin::impl::
+								demand_queue_t >(
+						"prio_one_thread::quoted_round_robin",
+						so_5::disp::prio_one_thread::quoted_round_robin::
+								quotes_t{ 10 } );
+			},
+			20,
+			"no_demand_allocations" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * A test for prio_thread_pool dispatcher.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+namespace ptp = so_5::disp::prio_thread_pool;
+
+struct msg_go final : public so_5::signal_t {};
+
+struct msg_hello final : public so_5::signal_t {};
+
+// Agent queues must be processed in the order of priorities.
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::priority_t priority,
+		std::string & trace )
+		:	so_5::agent_t{ ctx + priority }
+		,	m_trace{ trace }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_hello > ) {
+				m_trace += std::to_string( so_5::to_size_t( so_priority() ) ) + ";";
+				// All three receivers have handled their messages.
+				if( 6u == m_trace.size() )
+				{
+					ensure_or_die( "7;3;0;" == m_trace,
+							"unexpected order: " + m_trace );
+
+					so_deregister_agent_coop_normally();
+				}
+			} );
+	}
+
+private :
+	std::string & m_trace;
+};
+
+class a_blocker_t final : public so_5::agent_t
+{
+public :
+	a_blocker_t( context_t ctx, std::vector< so_5::mbox_t > receivers )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_receivers{ std::move(receivers) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		// The only working thread is busy while messages are sent.
+		// So all receivers are waiting in the ready queue.
+		so_subscribe_self().event( [this]( mhood_t< msg_go > ) {
+				for( const auto & r : m_receivers )
+					so_5::send< msg_hello >( r );
+			} );
+	}
+
+private :
+	const std::vector< so_5::mbox_t > m_receivers;
+};
+
+void
+check_ordering()
+{
+	std::string trace;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			so_5::mbox_t blocker;
+
+			env.introduce_coop(
+				ptp::make_dispatcher( env, "ordering", 1u ).binder(
+					[]( auto & p ) { p.fifo( ptp::fifo_t::individual ); } ),
+				[&]( so_5::coop_t & coop ) {
+					std::vector< so_5::mbox_t > receivers;
+					for( auto p : { so_5::prio::p0, so_5::prio::p3, so_5::prio::p7 } )
+						receivers.push_back(
+								coop.make_agent< a_receiver_t >( p, trace )->so_direct_mbox() );
+
+					blocker = coop.make_agent< a_blocker_t >(
+							std::move(receivers) )->so_direct_mbox();
+				} );
+
+			so_5::send< msg_go >( blocker );
+		} );
+}
+
+// Agents with low priority must not be starved if there are quotes.
+class a_spinner_t final : public so_5::agent_t
+{
+	struct msg_tick final : public so_5::signal_t {};
+
+public :
+	a_spinner_t( context_t ctx, so_5::mbox_t victim )
+		:	so_5::agent_t{ ctx + so_5::prio::p7 }
+		,	m_victim{ std::move(victim) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_tick > ) {
+				if( 100u == ++m_ticks )
+					so_5::send< msg_hello >( m_victim );
+
+				so_5::send< msg_tick >( *this );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_tick >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_victim;
+
+	unsigned int m_ticks{ 0u };
+};
+
+class a_victim_t final : public so_5::agent_t
+{
+public :
+	a_victim_t( context_t ctx )
+		:	so_5::agent_t{ ctx + so_5::prio::p0 }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_hello > ) {
+				so_deregister_agent_coop_normally();
+			} );
+	}
+};
+
+void
+check_quotes()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			env.introduce_coop(
+				ptp::make_dispatcher( env, "quotes",
+						ptp::disp_params_t{}
+							.thread_count( 1u )
+							.quotes( ptp::quotes_t{ 1u }.set( so_5::prio::p7, 5u ) ) )
+					.binder( []( auto & p ) { p.fifo( ptp::fifo_t::individual ); } ),
+				[]( so_5::coop_t & coop ) {
+					auto victim = coop.make_agent< a_victim_t >();
+					coop.make_agent< a_spinner_t >( victim->so_direct_mbox() );
+				} );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( check_ordering, 20, "ordering by priorities" );
+
+		run_with_time_limit( check_quotes, 20, "quotes for priorities" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,293 @@
+/*
+ * A test for reactor dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace reactor = so_5::disp::reactor;
+
+template< typename Lambda >
+void
+ensure_watching_failed( Lambda && lambda, const std::string & what )
+{
+	try
+	{
+		lambda();
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		ensure_or_die( so_5::rc_fd_watching_failed == ex.error_code(),
+				what + ": unexpected error code" );
+		return;
+	}
+
+	throw std::runtime_error( what + ": exception expected" );
+}
+
+// Reads data from a pipe until the write end is closed.
+class a_reader_t final : public so_5::agent_t
+{
+public :
+	a_reader_t( context_t ctx, reactor::dispatcher_handle_t disp )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_disp{ std::move(disp) }
+	{
+		int fds[ 2 ];
+		ensure_or_die( 0 == ::pipe2( fds, O_NONBLOCK | O_CLOEXEC ),
+				"pipe2 failed" );
+		m_read_fd = fds[ 0 ];
+		m_write_fd = fds[ 1 ];
+	}
+
+	~a_reader_t() override
+	{
+		::close( m_read_fd );
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_reader_t::evt_ready );
+
+		m_disp.watch( *this, m_read_fd, reactor::watch_mode_t::read );
+
+		ensure_watching_failed( [this] {
+				m_disp.watch( *this, m_read_fd, reactor::watch_mode_t::read );
+			},
+			"double watch" );
+		ensure_watching_failed( [this] { m_disp.unwatch( *this, m_write_fd ); },
+			"unwatch of unknown fd" );
+	}
+
+	void
+	so_evt_start() override
+	{
+		m_thread_id = std::this_thread::get_id();
+
+		m_writer = std::thread{ [fd = m_write_fd] {
+				for( int i = 0; i != chunks; ++i )
+				{
+					std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+					ensure_or_die( 3 == ::write( fd, "abc", 3 ), "write failed" );
+				}
+				::close( fd );
+			} };
+	}
+
+	void
+	so_evt_finish() override
+	{
+		m_writer.join();
+	}
+
+private :
+	static constexpr int chunks = 10;
+
+	const reactor::dispatcher_handle_t m_disp;
+	int m_read_fd;
+	int m_write_fd;
+
+	std::thread::id m_thread_id;
+	std::thread m_writer;
+
+	std::size_t m_received{ 0u };
+
+	void
+	evt_ready( mhood_t< reactor::msg_fd_ready > cmd )
+	{
+		ensure_or_die( m_read_fd == cmd->m_fd, "unexpected fd" );
+		ensure_or_die( std::this_thread::get_id() == m_thread_id,
+				"notification must be handled on the agent's thread" );
+
+		char buf[ 16 ];
+		for(;;)
+		{
+			const auto r = ::read( m_read_fd, buf, sizeof(buf) );
+			if( r > 0 )
+				m_received += static_cast< std::size_t >( r );
+			else if( 0 == r )
+			{
+				ensure_or_die( cmd->m_hangup, "hangup flag expected" );
+				ensure_or_die( chunks * 3u == m_received,
+						"unexpected amount of data: " +
+						std::to_string( m_received ) );
+
+				m_disp.unwatch( *this, m_read_fd );
+				so_deregister_agent_coop_normally();
+				return;
+			}
+			else
+			{
+				ensure_or_die( EAGAIN == errno, "read failed" );
+				return;
+			}
+		}
+	}
+};
+
+// Keeps its work thread busy and watches an eventfd.
+// Readiness must be delivered even if the queue is never empty.
+class a_busy_t final : public so_5::agent_t
+{
+	struct tick final : public so_5::signal_t {};
+
+public :
+	a_busy_t( context_t ctx, reactor::dispatcher_handle_t disp )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_disp{ std::move(disp) }
+		,	m_fd{ ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC ) }
+	{
+		ensure_or_die( -1 != m_fd, "eventfd failed" );
+	}
+
+	~a_busy_t() override
+	{
+		::close( m_fd );
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_busy_t::evt_tick )
+			.event( &a_busy_t::evt_ready );
+
+		m_disp.watch( *this, m_fd, reactor::watch_mode_t::read );
+	}
+
+	void
+	so_evt_start() override
+	{
+		// Several ticks to be sure that the queue is not empty.
+		for( int i = 0; i != 4; ++i )
+			so_5::send< tick >( *this );
+
+		m_writer = std::thread{ [fd = m_fd] {
+				std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+				const std::uint64_t value = 1u;
+				ensure_or_die( sizeof(value) == ::write( fd, &value, sizeof(value) ),
+						"write to eventfd failed" );
+			} };
+	}
+
+	void
+	so_evt_finish() override
+	{
+		m_writer.join();
+	}
+
+private :
+	const reactor::dispatcher_handle_t m_disp;
+	const int m_fd;
+
+	std::thread m_writer;
+
+	void
+	evt_tick( mhood_t< tick > )
+	{
+		std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+		so_5::send< tick >( *this );
+	}
+
+	void
+	evt_ready( mhood_t< reactor::msg_fd_ready > cmd )
+	{
+		ensure_or_die( m_fd == cmd->m_fd, "unexpected fd" );
+		ensure_or_die( cmd->m_readable, "readable flag expected" );
+
+		std::uint64_t value;
+		ensure_or_die( sizeof(value) == ::read( m_fd, &value, sizeof(value) ),
+				"read from eventfd failed" );
+		ensure_or_die( 1u == value, "unexpected eventfd value" );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+// An agent bound to another dispatcher can't watch fds.
+class a_stranger_t final : public so_5::agent_t
+{
+public :
+	a_stranger_t( context_t ctx, reactor::dispatcher_handle_t disp )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_disp{ std::move(disp) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		const int fd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+		ensure_watching_failed( [&] {
+				m_disp.watch( *this, fd, reactor::watch_mode_t::read );
+			},
+			"watch by unbound agent" );
+		::close( fd );
+
+		so_deregister_agent_coop_normally();
+	}
+
+private :
+	const reactor::dispatcher_handle_t m_disp;
+};
+
+void
+do_test()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			auto disp = reactor::make_dispatcher( env, "reactor",
+					reactor::disp_params_t{}.thread_count( 2 ) );
+
+			env.introduce_coop( disp.binder(), [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_reader_t >( disp );
+				} );
+			env.introduce_coop( disp.binder(), [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_busy_t >( disp );
+				} );
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_stranger_t >( disp );
+				} );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( do_test, 20, "reactor dispatcher" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+#else
+
+int
+main()
+{
+	// Reactor dispatcher isn't supported on this platform.
+	return 0;
+}
+
+#endif
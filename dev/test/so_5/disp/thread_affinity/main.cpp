@@ -0,0 +1,245 @@
+/*
+ * A test for CPU affinity of dispatchers' work threads.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using so_5::disp::thread_affinity_t;
+using so_5::disp::reuse::cpu_list_t;
+using so_5::disp::reuse::cpus_for_work_thread;
+
+template< typename Lambda >
+void
+ensure_invalid_affinity( Lambda && lambda, const char * what )
+{
+	try
+	{
+		lambda();
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure_or_die(
+				so_5::rc_invalid_thread_affinity == x.error_code(),
+				std::string( "unexpected error code for " ) + what );
+		return;
+	}
+
+	ensure_or_die( false, std::string( "exception expected for " ) + what );
+}
+
+void
+check_policies()
+{
+	ensure_or_die(
+			cpus_for_work_thread( thread_affinity_t::none(), 0u ).empty(),
+			"none: empty list expected" );
+
+	// Only CPUs available for the process can be used in cpu_set.
+	const auto first = cpus_for_work_thread(
+			thread_affinity_t::compact(), 0u ).front();
+	const auto second = cpus_for_work_thread(
+			thread_affinity_t::compact(), 1u ).front();
+
+	const auto cpus = thread_affinity_t::cpu_set( { first, second } );
+	ensure_or_die( cpu_list_t{ first } == cpus_for_work_thread( cpus, 0u ),
+			"cpu_set: the first CPU expected for thread 0" );
+	ensure_or_die( cpu_list_t{ second } == cpus_for_work_thread( cpus, 1u ),
+			"cpu_set: the second CPU expected for thread 1" );
+	ensure_or_die( cpu_list_t{ first } == cpus_for_work_thread( cpus, 2u ),
+			"cpu_set: the first CPU expected for thread 2" );
+
+	ensure_or_die(
+			1u == cpus_for_work_thread( thread_affinity_t::compact(), 0u ).size(),
+			"compact: one CPU expected" );
+	ensure_or_die(
+			1u == cpus_for_work_thread( thread_affinity_t::scatter(), 7u ).size(),
+			"scatter: one CPU expected" );
+
+	ensure_invalid_affinity( [] {
+			cpus_for_work_thread( thread_affinity_t::cpu_set( {} ), 0u );
+		},
+		"empty cpu_set" );
+	ensure_invalid_affinity( [] {
+			cpus_for_work_thread( thread_affinity_t::numa_node( 100000u ), 0u );
+		},
+		"unknown NUMA node" );
+	ensure_invalid_affinity( [] {
+			cpus_for_work_thread( thread_affinity_t::cpu_set( { 100000u } ), 0u );
+		},
+		"CPU out of range" );
+}
+
+void
+check_dispatcher_creation()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			const auto affinity = thread_affinity_t::cpu_set( { 100000u } );
+
+			// Work threads for active_obj and active_group are created
+			// only when agents are bound. But an invalid affinity must be
+			// detected when the dispatcher is created.
+			ensure_invalid_affinity( [&] {
+					(void)so_5::disp::active_obj::make_dispatcher(
+							env, "invalid",
+							so_5::disp::active_obj::disp_params_t{}
+								.thread_affinity( affinity ) );
+				},
+				"active_obj dispatcher" );
+			ensure_invalid_affinity( [&] {
+					(void)so_5::disp::active_group::make_dispatcher(
+							env, "invalid",
+							so_5::disp::active_group::disp_params_t{}
+								.thread_affinity( affinity ) );
+				},
+				"active_group dispatcher" );
+			ensure_invalid_affinity( [&] {
+					(void)so_5::disp::one_thread::make_dispatcher(
+							env, "invalid",
+							so_5::disp::one_thread::disp_params_t{}
+								.thread_affinity( affinity ) );
+				},
+				"one_thread dispatcher" );
+
+			env.stop();
+		} );
+}
+
+class a_busy_t final : public so_5::agent_t
+{
+	struct tick final : public so_5::signal_t {};
+
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< tick > ) {
+				so_5::send_delayed< tick >( *this, std::chrono::milliseconds(5) );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< tick >( *this );
+	}
+};
+
+class a_monitor_t final : public so_5::agent_t
+{
+public :
+	a_monitor_t( context_t ctx, int expected_cpu )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_expected_cpu{ expected_cpu }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_activity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 100 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	const int m_expected_cpu;
+
+	unsigned int m_one_thread_values{ 0u };
+	unsigned int m_thread_pool_values{ 0u };
+
+	void
+	evt_activity( const so_5::stats::messages::work_thread_activity & evt )
+	{
+		const std::string prefix = evt.m_prefix.c_str();
+		if( std::string::npos == prefix.find( "pinned" ) ||
+				-1 == evt.m_stats.m_cpu )
+			return;
+
+		std::cout << prefix << " -> cpu " << evt.m_stats.m_cpu << std::endl;
+
+#if defined(__linux__)
+		ensure_or_die( m_expected_cpu == evt.m_stats.m_cpu,
+				prefix + ": unexpected CPU " +
+				std::to_string( evt.m_stats.m_cpu ) + ", expected: " +
+				std::to_string( m_expected_cpu ) );
+#endif
+
+		if( std::string::npos != prefix.find( "/ot/" ) )
+			++m_one_thread_values;
+		else
+			++m_thread_pool_values;
+
+		if( 2u <= m_one_thread_values && 4u <= m_thread_pool_values )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_pinned_dispatchers()
+{
+	// The first available CPU is used for all threads.
+	const auto cpu = cpus_for_work_thread(
+			thread_affinity_t::compact(), 0u ).front();
+	const auto affinity = thread_affinity_t::cpu_set( { cpu } );
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+					coop.make_agent< a_monitor_t >( static_cast< int >(cpu) );
+
+					coop.make_agent_with_binder< a_busy_t >(
+							so_5::disp::one_thread::make_dispatcher(
+									env, "pinned",
+									so_5::disp::one_thread::disp_params_t{}
+										.thread_affinity( affinity ) ).binder() );
+
+					auto tp = so_5::disp::thread_pool::make_dispatcher(
+							env, "pinned",
+							so_5::disp::thread_pool::disp_params_t{}
+								.thread_count( 2 )
+								.thread_affinity( affinity ) );
+					for( int i = 0; i != 4; ++i )
+						coop.make_agent_with_binder< a_busy_t >(
+								tp.binder( so_5::disp::thread_pool::bind_params_t{}
+										.fifo( so_5::disp::thread_pool::fifo_t::individual ) ) );
+				} );
+		},
+		[]( so_5::environment_params_t & params ) {
+			params.turn_work_thread_activity_tracking_on();
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		check_policies();
+
+		run_with_time_limit( check_dispatcher_creation, 20,
+				"creation of dispatchers with invalid CPU affinity" );
+
+		run_with_time_limit( run_pinned_dispatchers, 20,
+				"dispatchers with CPU affinity" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
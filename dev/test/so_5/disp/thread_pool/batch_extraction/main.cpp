@@ -0,0 +1,224 @@
+/*
+ * A test for thread_pool dispatcher with extraction of demands by batches.
+ */
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+const unsigned int sender_count = 16;
+const unsigned int messages_per_sender = 2000;
+const unsigned int external_messages = 10000;
+
+struct msg_value final : public so_5::message_t
+{
+	unsigned int m_sender;
+	unsigned int m_value;
+
+	msg_value( unsigned int sender, unsigned int value )
+		:	m_sender{ sender }, m_value{ value }
+	{}
+};
+
+struct msg_next final : public so_5::signal_t {};
+
+struct msg_external final : public so_5::signal_t {};
+
+struct msg_done final : public so_5::signal_t {};
+
+class a_sender_t final : public so_5::agent_t
+{
+public :
+	a_sender_t(
+		context_t ctx,
+		unsigned int id,
+		so_5::mbox_t receiver )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_id{ id }
+		,	m_receiver{ std::move(receiver) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_next > ) {
+				// Several messages at once to fill the receiver's queue.
+				for( unsigned int i = 0; i != 8u && m_sent != messages_per_sender;
+						++i )
+					so_5::send< msg_value >( m_receiver, m_id, m_sent++ );
+
+				if( m_sent != messages_per_sender )
+					so_5::send< msg_next >( *this );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_next >( *this );
+	}
+
+private :
+	const unsigned int m_id;
+	const so_5::mbox_t m_receiver;
+	unsigned int m_sent{ 0u };
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx, so_5::mbox_t controller )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_controller{ std::move(controller) }
+		,	m_expected( sender_count, 0u )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_value > cmd ) {
+				auto & expected = m_expected.at( cmd->m_sender );
+				ensure_or_die( expected == cmd->m_value,
+						"unexpected value from sender " +
+						std::to_string( cmd->m_sender ) + ": " +
+						std::to_string( cmd->m_value ) + ", expected: " +
+						std::to_string( expected ) );
+				++expected;
+
+				if( sender_count * messages_per_sender == ++m_received )
+					so_5::send< msg_done >( m_controller );
+			} )
+			.event( [this]( mhood_t< msg_external > ) {
+				if( external_messages == ++m_external_received )
+					so_5::send< msg_done >( m_controller );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_controller;
+	std::vector< unsigned int > m_expected;
+	unsigned int m_received{ 0u };
+	unsigned int m_external_received{ 0u };
+};
+
+class a_controller_t final : public so_5::agent_t
+{
+public :
+	a_controller_t(
+		context_t ctx,
+		so_5::disp::thread_pool::queue_traits::lock_factory_t factory,
+		so_5::disp::thread_pool::fifo_t fifo,
+		so_5::disp::thread_pool_scheduling_t scheduling )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_factory{ std::move(factory) }
+		,	m_fifo{ fifo }
+		,	m_scheduling{ scheduling }
+	{}
+
+	~a_controller_t() override
+	{
+		if( m_sender.joinable() )
+			m_sender.join();
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+				// Messages from agents and from external thread.
+				if( 2u == ++m_done )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		using namespace so_5::disp::thread_pool;
+
+		auto disp = make_dispatcher(
+				so_environment(),
+				std::string_view{},
+				disp_params_t{}
+					.thread_count( 4 )
+					.scheduling( m_scheduling )
+					.set_queue_params( queue_traits::queue_params_t{}
+							.lock_factory( m_factory ) ) );
+
+		so_5::mbox_t receiver;
+
+		so_5::introduce_child_coop( *this,
+			disp.binder( bind_params_t{}
+					.fifo( m_fifo )
+					.max_demands_at_once( 16 )
+					.batch_extraction( true ) ),
+			[&]( so_5::coop_t & coop ) {
+				receiver = coop.make_agent< a_receiver_t >( so_direct_mbox() )
+						->so_direct_mbox();
+
+				for( unsigned int i = 0; i != sender_count; ++i )
+					coop.make_agent< a_sender_t >( i, receiver );
+			} );
+
+		// Messages from a thread which doesn't belong to the dispatcher.
+		m_sender = std::thread{ [receiver] {
+				for( unsigned int i = 0; i != external_messages; ++i )
+					so_5::send< msg_external >( receiver );
+			} };
+	}
+
+private :
+	const so_5::disp::thread_pool::queue_traits::lock_factory_t m_factory;
+	const so_5::disp::thread_pool::fifo_t m_fifo;
+	const so_5::disp::thread_pool_scheduling_t m_scheduling;
+
+	std::thread m_sender;
+	unsigned int m_done{ 0u };
+};
+
+void
+do_test()
+{
+	using namespace so_5::disp::thread_pool;
+	for_each_lock_factory( []( queue_traits::lock_factory_t factory ) {
+		for( auto fifo : { fifo_t::cooperation, fifo_t::individual } )
+			for( auto scheduling : {
+					so_5::disp::thread_pool_scheduling_t::central_queue,
+					so_5::disp::thread_pool_scheduling_t::work_stealing } )
+				run_with_time_limit( [&]()
+					{
+						so_5::launch( [&]( so_5::environment_t & env ) {
+								env.introduce_coop( [&]( so_5::coop_t & coop ) {
+										coop.make_agent< a_controller_t >(
+												factory, fifo, scheduling );
+									} );
+							} );
+					},
+					60,
+					"thread_pool dispatcher with batch extraction" );
+	} );
+}
+
+int
+main()
+{
+	try
+	{
+		do_test();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
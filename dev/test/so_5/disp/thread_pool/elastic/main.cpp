@@ -0,0 +1,215 @@
+/*
+ * A test for elastic mode of thread_pool dispatcher.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+const unsigned int individual_agents = 8;
+const unsigned int coop_fifo_agents = 4;
+const unsigned int messages_per_agent = 20;
+
+struct msg_work final : public so_5::signal_t {};
+
+struct msg_done final : public so_5::signal_t {};
+
+class a_worker_t final : public so_5::agent_t
+{
+public :
+	a_worker_t(
+		context_t ctx,
+		so_5::mbox_t controller,
+		std::atomic< int > * active_in_coop )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_controller{ std::move(controller) }
+		,	m_active_in_coop{ active_in_coop }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_work > ) {
+				if( m_active_in_coop )
+					ensure_or_die( 0 == (*m_active_in_coop)++,
+							"agents with cooperation FIFO are working "
+							"at the same time" );
+
+				std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+				if( m_active_in_coop )
+					--(*m_active_in_coop);
+
+				if( messages_per_agent == ++m_received )
+					so_5::send< msg_done >( m_controller );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		for( unsigned int i = 0; i != messages_per_agent; ++i )
+			so_5::send< msg_work >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_controller;
+	std::atomic< int > * m_active_in_coop;
+	unsigned int m_received{ 0u };
+};
+
+class a_controller_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+				++m_done;
+				try_finish();
+			} );
+
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_controller_t::evt_quantity );
+	}
+
+	void
+	so_evt_start() override
+	{
+		using namespace so_5::disp::thread_pool;
+
+		auto disp = make_dispatcher(
+				so_environment(),
+				"elastic",
+				disp_params_t{}.elastic( elastic_params_t{ 1, 4 }
+						.idle_timeout( std::chrono::milliseconds( 100 ) ) ) );
+
+		so_5::introduce_child_coop( *this,
+			disp.binder( bind_params_t{}.fifo( fifo_t::individual ) ),
+			[&]( so_5::coop_t & coop ) {
+				for( unsigned int i = 0; i != individual_agents; ++i )
+					coop.make_agent< a_worker_t >(
+							so_direct_mbox(), nullptr );
+			} );
+
+		so_5::introduce_child_coop( *this,
+			disp.binder( bind_params_t{}.fifo( fifo_t::cooperation ) ),
+			[&]( so_5::coop_t & coop ) {
+				for( unsigned int i = 0; i != coop_fifo_agents; ++i )
+					coop.make_agent< a_worker_t >(
+							so_direct_mbox(), &m_active_in_coop );
+			} );
+
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 50 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	std::atomic< int > m_active_in_coop{ 0 };
+
+	unsigned int m_done{ 0u };
+	std::size_t m_max_threads{ 0u };
+	std::size_t m_current_threads{ 0u };
+
+	void
+	evt_quantity( const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		if( std::string::npos == std::string{ evt.m_prefix.c_str() }.find(
+					"/tp/elastic" ) ||
+				so_5::stats::suffixes::disp_thread_count() != evt.m_suffix )
+			return;
+
+		m_current_threads = evt.m_value;
+		ensure_or_die( m_current_threads <= 4u,
+				"too many threads: " + std::to_string( m_current_threads ) );
+		if( m_max_threads < m_current_threads )
+			m_max_threads = m_current_threads;
+
+		try_finish();
+	}
+
+	void
+	try_finish()
+	{
+		// All work must be done and all extra threads must be stopped.
+		if( individual_agents + coop_fifo_agents == m_done &&
+				1u == m_current_threads )
+		{
+			ensure_or_die( 1u < m_max_threads,
+					"the count of threads hasn't been increased" );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+check_invalid_params()
+{
+	using namespace so_5::disp::thread_pool;
+
+	const auto ensure_failure = []( disp_params_t params, const char * what ) {
+		bool thrown = false;
+		try
+		{
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					[[maybe_unused]] auto disp =
+							make_dispatcher( env, std::string_view{}, params );
+				} );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			thrown = so_5::rc_disp_create_failed == x.error_code();
+		}
+
+		ensure_or_die( thrown, std::string( "exception expected for " ) + what );
+	};
+
+	ensure_failure(
+			disp_params_t{}.elastic( elastic_params_t{ 0, 4 } ),
+			"zero min threads" );
+	ensure_failure(
+			disp_params_t{}.elastic( elastic_params_t{ 4, 2 } ),
+			"max threads less than min threads" );
+	ensure_failure(
+			disp_params_t{}
+				.use_work_stealing()
+				.elastic( elastic_params_t{ 1, 4 } ),
+			"work-stealing scheduling" );
+}
+
+int
+main()
+{
+	try
+	{
+		check_invalid_params();
+
+		run_with_time_limit( [] {
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_controller_t >();
+							} );
+					} );
+			},
+			20,
+			"elastic thread_pool dispatcher" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
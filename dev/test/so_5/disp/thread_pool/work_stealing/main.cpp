@@ -0,0 +1,195 @@
+/*
+ * A test for thread_pool dispatcher with work-stealing scheduling.
+ */
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+const unsigned int pair_count = 64;
+const unsigned int exchanges = 1000;
+const unsigned int external_messages = 10000;
+
+struct msg_ping final : public so_5::message_t
+{
+	unsigned int m_remaining;
+
+	msg_ping( unsigned int remaining ) : m_remaining{ remaining } {}
+};
+
+struct msg_external final : public so_5::signal_t {};
+
+struct msg_done final : public so_5::signal_t {};
+
+class a_player_t final : public so_5::agent_t
+{
+public :
+	a_player_t( context_t ctx, so_5::mbox_t controller )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_controller{ std::move(controller) }
+	{}
+
+	void
+	set_partner( const so_5::mbox_t & partner ) { m_partner = partner; }
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_ping > cmd ) {
+				if( cmd->m_remaining )
+					so_5::send< msg_ping >( m_partner, cmd->m_remaining - 1u );
+				else
+					so_5::send< msg_done >( m_controller );
+			} );
+	}
+
+	void
+	start() { so_5::send< msg_ping >( *this, exchanges ); }
+
+private :
+	const so_5::mbox_t m_controller;
+	so_5::mbox_t m_partner;
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx, so_5::mbox_t controller )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_controller{ std::move(controller) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_external > ) {
+				if( external_messages == ++m_received )
+					so_5::send< msg_done >( m_controller );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_controller;
+	unsigned int m_received{ 0u };
+};
+
+class a_controller_t final : public so_5::agent_t
+{
+public :
+	a_controller_t(
+		context_t ctx,
+		so_5::disp::thread_pool::queue_traits::lock_factory_t factory,
+		so_5::disp::thread_pool::fifo_t fifo )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_factory{ std::move(factory) }
+		,	m_fifo{ fifo }
+	{}
+
+	~a_controller_t() override
+	{
+		if( m_sender.joinable() )
+			m_sender.join();
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+				// All pairs and the receiver must finish their work.
+				if( pair_count + 1u == ++m_done )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		using namespace so_5::disp::thread_pool;
+
+		auto disp = make_dispatcher(
+				so_environment(),
+				std::string_view{},
+				disp_params_t{}
+					.thread_count( 4 )
+					.use_work_stealing()
+					.set_queue_params( queue_traits::queue_params_t{}
+							.lock_factory( m_factory ) ) );
+
+		std::vector< a_player_t * > players;
+		so_5::mbox_t receiver;
+
+		so_5::introduce_child_coop( *this,
+			disp.binder( bind_params_t{}.fifo( m_fifo ) ),
+			[&]( so_5::coop_t & coop ) {
+				for( unsigned int i = 0; i != pair_count * 2u; ++i )
+					players.push_back(
+							coop.make_agent< a_player_t >( so_direct_mbox() ) );
+
+				for( unsigned int i = 0; i != pair_count * 2u; i += 2u )
+				{
+					players[ i ]->set_partner( players[ i + 1u ]->so_direct_mbox() );
+					players[ i + 1u ]->set_partner( players[ i ]->so_direct_mbox() );
+				}
+
+				receiver = coop.make_agent< a_receiver_t >( so_direct_mbox() )
+						->so_direct_mbox();
+			} );
+
+		for( unsigned int i = 0; i != pair_count * 2u; i += 2u )
+			players[ i ]->start();
+
+		// Messages from a thread which doesn't belong to the dispatcher.
+		m_sender = std::thread{ [receiver] {
+				for( unsigned int i = 0; i != external_messages; ++i )
+					so_5::send< msg_external >( receiver );
+			} };
+	}
+
+private :
+	const so_5::disp::thread_pool::queue_traits::lock_factory_t m_factory;
+	const so_5::disp::thread_pool::fifo_t m_fifo;
+
+	std::thread m_sender;
+	unsigned int m_done{ 0u };
+};
+
+void
+do_test()
+{
+	using namespace so_5::disp::thread_pool;
+	for_each_lock_factory( []( queue_traits::lock_factory_t factory ) {
+		for( auto fifo : { fifo_t::cooperation, fifo_t::individual } )
+			run_with_time_limit( [&]()
+				{
+					so_5::launch( [&]( so_5::environment_t & env ) {
+							env.introduce_coop( [&]( so_5::coop_t & coop ) {
+									coop.make_agent< a_controller_t >( factory, fifo );
+								} );
+						} );
+				},
+				60,
+				"thread_pool dispatcher with work stealing" );
+	} );
+}
+
+int
+main()
+{
+	try
+	{
+		do_test();
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
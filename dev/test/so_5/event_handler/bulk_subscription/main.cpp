@@ -0,0 +1,305 @@
+/*
+ * A test for so_bulk_subscribe().
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+class test_mbox_t final : public so_5::abstract_message_box_t
+	{
+	private :
+		const so_5::mbox_t m_actual_mbox;
+
+	public :
+		unsigned int m_single_subscriptions = 0;
+		unsigned int m_bulk_subscriptions = 0;
+		std::size_t m_bulk_items = 0;
+
+		test_mbox_t( so_5::environment_t & env )
+			:	m_actual_mbox( env.create_mbox() )
+			{}
+
+		so_5::mbox_id_t
+		id() const override
+			{
+				return m_actual_mbox->id();
+			}
+
+		void
+		do_deliver_message(
+			const std::type_index & type_index,
+			const so_5::message_ref_t & message_ref,
+			unsigned int overlimit_reaction_deep ) override
+			{
+				m_actual_mbox->do_deliver_message(
+						type_index, message_ref, overlimit_reaction_deep );
+			}
+
+		void
+		subscribe_event_handler(
+			const std::type_index & type_index,
+			const so_5::message_limit::control_block_t * limit,
+			so_5::agent_t & subscriber ) override
+			{
+				++m_single_subscriptions;
+				m_actual_mbox->subscribe_event_handler( type_index, limit, subscriber );
+			}
+
+		void
+		subscribe_event_handlers(
+			const so_5::mbox_subscription_info_t * subscriptions,
+			std::size_t count,
+			so_5::agent_t & subscriber ) override
+			{
+				++m_bulk_subscriptions;
+				m_bulk_items += count;
+				m_actual_mbox->subscribe_event_handlers(
+						subscriptions, count, subscriber );
+			}
+
+		void
+		unsubscribe_event_handlers(
+			const std::type_index & type_index,
+			so_5::agent_t & subscriber ) override
+			{
+				m_actual_mbox->unsubscribe_event_handlers( type_index, subscriber );
+			}
+
+		std::string
+		query_name() const override { return m_actual_mbox->query_name(); }
+
+		so_5::mbox_type_t
+		type() const override
+			{
+				return m_actual_mbox->type();
+			}
+
+		void
+		set_delivery_filter(
+			const std::type_index & msg_type,
+			const so_5::delivery_filter_t & filter,
+			so_5::agent_t & subscriber ) override
+			{
+				m_actual_mbox->set_delivery_filter( msg_type, filter, subscriber );
+			}
+
+		void
+		drop_delivery_filter(
+			const std::type_index & msg_type,
+			so_5::agent_t & subscriber ) noexcept override
+			{
+				m_actual_mbox->drop_delivery_filter( msg_type, subscriber );
+			}
+
+		so_5::environment_t &
+		environment() const noexcept override
+			{
+				return m_actual_mbox->environment();
+			}
+	};
+
+struct msg_1 final : public so_5::signal_t {};
+struct msg_2 final : public so_5::signal_t {};
+struct msg_3 final : public so_5::signal_t {};
+struct msg_4 final : public so_5::signal_t {};
+
+struct finish final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+	state_t st_one{ this, "one" };
+	state_t st_two{ this, "two" };
+
+public :
+	a_test_t( context_t ctx, std::string & trace )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_trace( trace )
+		,	m_mbox_owner( new test_mbox_t( so_environment() ) )
+		,	m_mbox( so_5::mbox_t{ m_mbox_owner } )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		this >>= st_one;
+
+		check_duplicate_in_bulk();
+		check_exception_from_lambda();
+
+		so_bulk_subscribe( [this] {
+			st_one
+				.event( m_mbox, [this]( mhood_t< msg_1 > ) { m_trace += "1;"; } )
+				.event( m_mbox, [this]( mhood_t< msg_2 > ) { m_trace += "2;"; } )
+				.event( [this]( mhood_t< msg_1 > ) { m_trace += "s1;"; } )
+				.event( [this]( mhood_t< finish > ) {
+						so_deregister_agent_coop_normally();
+					} );
+
+			// Nested call must not create subscriptions by itself.
+			so_bulk_subscribe( [this] {
+				st_two.event( m_mbox, [this]( mhood_t< msg_1 > ) {
+						m_trace += "two:1;";
+					} );
+
+				ensure( !so_has_subscription< msg_1 >( m_mbox, st_two ),
+						"subscription must not be created by nested call" );
+			} );
+
+			so_subscribe_deadletter_handler( m_mbox,
+					[this]( mhood_t< msg_3 > ) { m_trace += "d3;"; } );
+
+			ensure( !so_has_subscription< msg_1 >( m_mbox, st_one ),
+					"subscription must not be created inside lambda" );
+		} );
+
+		// msg_1, msg_2 and msg_3 for m_mbox must be passed by one call.
+		ensure( 0u == m_mbox_owner->m_single_subscriptions,
+				"unexpected count of single subscriptions: " +
+				std::to_string( m_mbox_owner->m_single_subscriptions ) );
+		ensure( 1u == m_mbox_owner->m_bulk_subscriptions,
+				"unexpected count of bulk subscriptions: " +
+				std::to_string( m_mbox_owner->m_bulk_subscriptions ) );
+		ensure( 3u == m_mbox_owner->m_bulk_items,
+				"unexpected count of bulk items: " +
+				std::to_string( m_mbox_owner->m_bulk_items ) );
+
+		ensure( so_has_subscription< msg_1 >( m_mbox, st_one ),
+				"msg_1 in st_one must be subscribed" );
+		ensure( so_has_subscription< msg_1 >( m_mbox, st_two ),
+				"msg_1 in st_two must be subscribed" );
+		ensure( so_has_deadletter_handler< msg_3 >( m_mbox ),
+				"deadletter handler for msg_3 must be subscribed" );
+
+		check_duplicate_of_existing();
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< msg_1 >( m_mbox );
+		so_5::send< msg_2 >( m_mbox );
+		so_5::send< msg_3 >( m_mbox );
+		so_5::send< msg_4 >( m_mbox );
+		so_5::send< msg_1 >( *this );
+		so_5::send< finish >( *this );
+	}
+
+private :
+	std::string & m_trace;
+
+	// The lifetime of that object is controlled by m_mbox.
+	test_mbox_t * const m_mbox_owner;
+	const so_5::mbox_t m_mbox;
+
+	void
+	ensure_nothing_subscribed()
+	{
+		ensure( !so_has_subscription< msg_1 >( m_mbox, st_one ) &&
+				!so_has_subscription< msg_2 >( m_mbox, st_one ) &&
+				!so_has_subscription< msg_1 >( m_mbox, st_two ) &&
+				!so_has_subscription< msg_4 >( m_mbox, st_one ),
+				"there must be no subscriptions" );
+	}
+
+	void
+	check_duplicate_in_bulk()
+	{
+		try
+		{
+			so_bulk_subscribe( [this] {
+				st_one
+					.event( m_mbox, []( mhood_t< msg_1 > ) {} )
+					.event( m_mbox, []( mhood_t< msg_2 > ) {} );
+				st_two
+					.event( m_mbox, []( mhood_t< msg_1 > ) {} );
+				st_one
+					.event( m_mbox, []( mhood_t< msg_1 > ) {} );
+			} );
+
+			throw std::runtime_error( "an exception expected for a duplicate" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			ensure( so_5::rc_evt_handler_already_provided == x.error_code(),
+					"unexpected error code: " + std::to_string( x.error_code() ) );
+		}
+
+		ensure_nothing_subscribed();
+	}
+
+	void
+	check_exception_from_lambda()
+	{
+		try
+		{
+			so_bulk_subscribe( [this] {
+				st_one.event( m_mbox, []( mhood_t< msg_1 > ) {} );
+				throw std::runtime_error( "exception from lambda" );
+			} );
+
+			throw std::logic_error( "an exception expected from lambda" );
+		}
+		catch( const std::runtime_error & ) {}
+
+		ensure_nothing_subscribed();
+	}
+
+	void
+	check_duplicate_of_existing()
+	{
+		try
+		{
+			so_bulk_subscribe( [this] {
+				st_one
+					.event( m_mbox, []( mhood_t< msg_4 > ) {} )
+					.event( m_mbox, []( mhood_t< msg_2 > ) {} );
+			} );
+
+			throw std::runtime_error( "an exception expected for a duplicate" );
+		}
+		catch( const so_5::exception_t & x )
+		{
+			ensure( so_5::rc_evt_handler_already_provided == x.error_code(),
+					"unexpected error code: " + std::to_string( x.error_code() ) );
+		}
+
+		ensure( !so_has_subscription< msg_4 >( m_mbox, st_one ),
+				"msg_4 must not be subscribed" );
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				std::string trace;
+
+				so_5::launch( [&]( so_5::environment_t & env ) {
+						env.introduce_coop( [&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >( trace );
+							} );
+					} );
+
+				const std::string expected = "1;2;d3;s1;";
+
+				ensure( expected == trace,
+						"unexpected trace: '" + trace + "', expected: '" +
+						expected + "'" );
+			},
+			20,
+			"bulk subscription test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
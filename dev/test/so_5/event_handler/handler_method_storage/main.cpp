@@ -0,0 +1,180 @@
+/*
+ * A test for storage of event handlers without memory allocations.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic< std::size_t > g_allocations{ 0u };
+
+} /* namespace anonymous */
+
+void *
+operator new( std::size_t size )
+{
+	++g_allocations;
+	if( void * p = std::malloc( size ? size : 1u ) )
+		return p;
+	throw std::bad_alloc{};
+}
+
+void
+operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+template< typename Lambda >
+std::size_t
+allocations_during( Lambda && lambda )
+{
+	const auto before = g_allocations.load();
+	lambda();
+	return g_allocations.load() - before;
+}
+
+struct msg final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	evt_signal( mhood_t< msg > )
+	{
+		++m_calls;
+	}
+
+	unsigned int m_calls{ 0u };
+};
+
+void
+check_small_handlers()
+{
+	int calls = 0;
+	so_5::message_ref_t dummy;
+
+	std::size_t allocations = allocations_during( [&] {
+			so_5::event_handler_method_t h1{
+					[&calls]( so_5::message_ref_t & ) { ++calls; } };
+			so_5::event_handler_method_t h2{ h1 };
+			so_5::event_handler_method_t h3{ std::move( h1 ) };
+			h1 = h2;
+			h2.swap( h3 );
+
+			h1( dummy );
+			h2( dummy );
+			h3( dummy );
+		} );
+
+	ensure( 0u == allocations, "no allocations expected for small lambda, "
+			"allocations: " + std::to_string( allocations ) );
+	ensure( 3 == calls, "handler must be called 3 times" );
+}
+
+void
+check_handlers_from_makers()
+{
+	so_5::wrapped_env_t sobj;
+	a_test_t agent{ sobj.environment() };
+
+	so_5::message_ref_t dummy;
+
+	std::size_t allocations = allocations_during( [&] {
+			auto pair = so_5::details::event_subscription_helpers::
+					make_handler_with_arg_for_agent(
+							&agent, &a_test_t::evt_signal );
+			auto copy = pair.m_handler;
+			copy( dummy );
+			pair.m_handler( dummy );
+		} );
+
+	ensure( 0u == allocations, "no allocations expected for agent's method, "
+			"allocations: " + std::to_string( allocations ) );
+	ensure( 2u == agent.m_calls, "handler must be called 2 times" );
+}
+
+void
+check_large_handlers()
+{
+	std::array< int, 64 > data{};
+	data[ 10 ] = 42;
+	int result = 0;
+
+	so_5::event_handler_method_t h1{
+			[data, &result]( so_5::message_ref_t & ) mutable {
+				result += data[ 10 ]++;
+			} };
+	so_5::event_handler_method_t h2{ h1 };
+
+	so_5::message_ref_t dummy;
+	h1( dummy );
+	h1( dummy );
+	h2( dummy );
+
+	ensure( 42 + 43 + 42 == result, "unexpected result for large lambda: " +
+			std::to_string( result ) );
+
+	h2 = std::move( h1 );
+	ensure( !h1 && h2, "handler must be moved" );
+	h2( dummy );
+	ensure( 42 + 43 + 42 + 44 == result, "unexpected result after move: " +
+			std::to_string( result ) );
+}
+
+void
+check_empty_handler()
+{
+	so_5::event_handler_method_t h;
+	ensure( !h, "handler must be empty" );
+
+	so_5::message_ref_t dummy;
+	try
+	{
+		h( dummy );
+		ensure( false, "an exception is expected for empty handler" );
+	}
+	catch( const std::bad_function_call & ) {}
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_small_handlers();
+				check_handlers_from_makers();
+				check_large_handlers();
+				check_empty_handler();
+			},
+			20,
+			"handler method storage test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -68,13 +68,15 @@ UT_UNIT_TEST( no_handlers )
 	a_test_t agent( env );
 
 	{
+		const demand_descriptor_t descriptor{
+				agent_t::get_demand_handler_on_message_ptr(),
+				message_limit::control_block_t::none(),
+				message_type_id( typeid(msg_signal) ) };
 		execution_demand_t demand(
 				&agent,
-				message_limit::control_block_t::none(),
+				&descriptor,
 				0,
-				typeid(msg_signal),
-				message_ref_t(),
-				agent_t::get_demand_handler_on_message_ptr() );
+				message_ref_t() );
 
 		auto hint = agent_t::so_create_execution_hint( demand );
 
@@ -82,13 +84,15 @@ UT_UNIT_TEST( no_handlers )
 	}
 
 	{
+		const demand_descriptor_t descriptor{
+				agent_t::get_demand_handler_on_start_ptr(),
+				message_limit::control_block_t::none(),
+				message_type_id( typeid(msg_signal) ) };
 		execution_demand_t demand(
 				&agent,
-				message_limit::control_block_t::none(),
+				&descriptor,
 				0,
-				typeid(msg_signal),
-				message_ref_t(),
-				agent_t::get_demand_handler_on_start_ptr() );
+				message_ref_t() );
 
 		auto hint = agent_t::so_create_execution_hint( demand );
 
@@ -96,13 +100,15 @@ UT_UNIT_TEST( no_handlers )
 	}
 
 	{
+		const demand_descriptor_t descriptor{
+				agent_t::get_demand_handler_on_finish_ptr(),
+				message_limit::control_block_t::none(),
+				message_type_id( typeid(msg_signal) ) };
 		execution_demand_t demand(
 				&agent,
-				message_limit::control_block_t::none(),
+				&descriptor,
 				0,
-				typeid(msg_signal),
-				message_ref_t(),
-				agent_t::get_demand_handler_on_finish_ptr() );
+				message_ref_t() );
 
 		auto hint = agent_t::so_create_execution_hint( demand );
 
@@ -123,13 +129,15 @@ UT_UNIT_TEST( event_handler )
 			.event( &a_test_t::evt_thread_safe_signal, thread_safe );
 
 	{
+		const demand_descriptor_t descriptor{
+				agent_t::get_demand_handler_on_message_ptr(),
+				message_limit::control_block_t::none(),
+				message_type_id( typeid(msg_signal) ) };
 		execution_demand_t demand(
 				&agent,
-				message_limit::control_block_t::none(),
+				&descriptor,
 				agent.so_direct_mbox()->id(),
-				typeid(msg_signal),
-				message_ref_t(),
-				agent_t::get_demand_handler_on_message_ptr() );
+				message_ref_t() );
 
 		auto hint = agent_t::so_create_execution_hint( demand );
 
@@ -144,13 +152,15 @@ UT_UNIT_TEST( event_handler )
 	}
 
 	{
+		const demand_descriptor_t descriptor{
+				agent_t::get_demand_handler_on_message_ptr(),
+				message_limit::control_block_t::none(),
+				message_type_id( typeid(msg_thread_safe_signal) ) };
 		execution_demand_t demand(
 				&agent,
-				message_limit::control_block_t::none(),
+				&descriptor,
 				agent.so_direct_mbox()->id(),
-				typeid(msg_thread_safe_signal),
-				message_ref_t(),
-				agent_t::get_demand_handler_on_message_ptr() );
+				message_ref_t() );
 
 		auto hint = agent_t::so_create_execution_hint( demand );
 
@@ -0,0 +1,142 @@
+/*
+ * A test for stats about lateness of timers and load of timer thread.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+constexpr std::uint_fast64_t delayed_messages = 10u;
+
+void
+ensure_consistent( const so_5::stats::histogram_t & h, const char * name )
+	{
+		std::uint_fast64_t count = 0u;
+		for( auto c : h.m_buckets )
+			count += c;
+
+		ensure_or_die( count == h.m_count,
+				std::string( "sum of buckets isn't equal to count for " ) + name );
+		ensure_or_die( h.m_max <= h.m_sum,
+				std::string( "max is greater than sum for " ) + name );
+	}
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		struct msg_delayed final : public so_5::signal_t {};
+
+		a_test_t( context_t ctx ) : so_5::agent_t{ std::move(ctx) }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				const auto stats_mbox = so_environment().stats_controller().mbox();
+
+				so_subscribe( stats_mbox )
+					.event( &a_test_t::evt_histogram )
+					.event( &a_test_t::evt_distribution_finished );
+
+				so_subscribe_self().event( [this]( mhood_t< msg_delayed > ) {
+						++m_received;
+					} );
+			}
+
+		void
+		so_evt_start() override
+			{
+				auto & controller = so_environment().stats_controller();
+				controller.set_distribution_period( 50ms );
+				controller.turn_on();
+			}
+
+	private :
+		bool m_sent{ false };
+		std::uint_fast64_t m_received{ 0u };
+
+		so_5::stats::histogram_t m_lateness;
+		so_5::stats::histogram_t m_delivery_time;
+		so_5::stats::histogram_t m_expired;
+
+		void
+		evt_histogram( mhood_t< so_5::stats::messages::histogram > evt )
+			{
+				namespace stats = so_5::stats;
+
+				if( stats::prefixes::timer_thread() != evt->m_prefix )
+					return;
+
+				if( stats::suffixes::timer_lateness() == evt->m_suffix )
+					m_lateness = evt->m_value;
+				else if( stats::suffixes::timer_delivery_time_per_tick() ==
+						evt->m_suffix )
+					m_delivery_time = evt->m_value;
+				else if( stats::suffixes::timer_expired_per_tick() == evt->m_suffix )
+					m_expired = evt->m_value;
+			}
+
+		void
+		evt_distribution_finished(
+			mhood_t< so_5::stats::messages::distribution_finished > )
+			{
+				if( !m_sent )
+					{
+						// Collection of stats is started by the first distribution.
+						m_sent = true;
+						for( std::uint_fast64_t i = 0u; i != delayed_messages; ++i )
+							so_5::send_delayed< msg_delayed >( *this, 20ms );
+					}
+				else if( delayed_messages == m_received &&
+						delayed_messages == m_expired.m_sum )
+					{
+						ensure_consistent( m_lateness, "lateness" );
+						ensure_consistent( m_delivery_time, "delivery time" );
+						ensure_consistent( m_expired, "expired timers" );
+
+						ensure_or_die( delayed_messages == m_lateness.m_count,
+								"unexpected count of lateness values: " +
+								std::to_string( m_lateness.m_count ) );
+						ensure_or_die( m_expired.m_count == m_delivery_time.m_count,
+								"counts of ticks are different" );
+						ensure_or_die( 0u != m_expired.m_count,
+								"no ticks with expired timers" );
+
+						so_deregister_agent_coop_normally();
+					}
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								env.make_agent< a_test_t >() );
+					} );
+			},
+			20,
+			"timer thread lateness monitoring test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -17,4 +17,8 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/local_mbox_growth/prj.ut.rb" )
 	required_prj( "#{path}/custom_mbox_simple/prj.ut.rb" )
 	required_prj( "#{path}/make_new_direct_mbox/prj.ut.rb" )
+	required_prj( "#{path}/send_batch/prj.ut.rb" )
+	required_prj( "#{path}/cow_local_mbox/prj.ut.rb" )
+	required_prj( "#{path}/many_msg_types/prj.ut.rb" )
+	required_prj( "#{path}/frozen_subscr_storage/prj.ut.rb" )
 }
@@ -0,0 +1,253 @@
+/*
+ * A test for copy-on-write local mboxes.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+struct value
+{
+	unsigned int m_v;
+};
+
+constexpr unsigned int senders = 4u;
+constexpr unsigned int values_per_sender = 20000u;
+
+struct receiver_finished final : public so_5::signal_t {};
+
+// Sends values to the mbox from its own thread.
+class a_sender_t final : public so_5::agent_t
+{
+public :
+	a_sender_t( context_t ctx, so_5::mbox_t dest )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_dest{ std::move(dest) }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		for( unsigned int i = 0u; i != values_per_sender; ++i )
+			so_5::send< value >( m_dest, i );
+	}
+
+private :
+	const so_5::mbox_t m_dest;
+};
+
+// Receives all values (or only even values if filter is used).
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t source,
+		so_5::mbox_t coordinator,
+		bool only_even )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_source{ std::move(source) }
+		,	m_coordinator{ std::move(coordinator) }
+		,	m_only_even{ only_even }
+		,	m_expected{ only_even ?
+				senders * values_per_sender / 2u : senders * values_per_sender }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		if( m_only_even )
+			so_set_delivery_filter( m_source, []( const value & v ) {
+					return 0u == v.m_v % 2u;
+				} );
+
+		so_subscribe( m_source ).event( [this]( mhood_t< value > cmd ) {
+				if( m_only_even )
+					ensure( 0u == cmd->m_v % 2u, "delivery filter must be applied" );
+
+				if( ++m_received == m_expected )
+					so_5::send< receiver_finished >( m_coordinator );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+	const so_5::mbox_t m_coordinator;
+	const bool m_only_even;
+	const unsigned int m_expected;
+
+	unsigned int m_received{ 0u };
+};
+
+// Changes its subscriptions all the time while values are being sent.
+class a_flapper_t final : public so_5::agent_t
+{
+	struct flip final : public so_5::signal_t {};
+
+public :
+	a_flapper_t( context_t ctx, so_5::mbox_t source )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_source{ std::move(source) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< flip > ) {
+				switch( ++m_step % 4u )
+				{
+				case 0u:
+					so_subscribe( m_source ).event( []( mhood_t< value > ) {} );
+				break;
+				case 1u:
+					so_set_delivery_filter( m_source, []( const value & v ) {
+							return 0u == v.m_v % 3u;
+						} );
+				break;
+				case 2u:
+					so_drop_subscription< value >( m_source );
+				break;
+				case 3u:
+					so_drop_delivery_filter< value >( m_source );
+				break;
+				}
+
+				so_5::send< flip >( *this );
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		so_5::send< flip >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+
+	unsigned int m_step{ 0u };
+};
+
+class a_coordinator_t final : public so_5::agent_t
+{
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< receiver_finished > ) {
+				if( 2u == ++m_finished )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		// Mbox of the default kind is created. The default kind
+		// is set in environment's params.
+		const auto source = so_environment().create_mbox();
+
+		so_5::introduce_child_coop( *this,
+			so_5::disp::active_obj::make_dispatcher(
+					so_environment() ).binder(),
+			[&]( so_5::coop_t & coop ) {
+				coop.make_agent< a_receiver_t >( source, so_direct_mbox(), false );
+				coop.make_agent< a_receiver_t >( source, so_direct_mbox(), true );
+				coop.make_agent< a_flapper_t >( source );
+
+				for( unsigned int i = 0u; i != senders; ++i )
+					coop.make_agent< a_sender_t >( source );
+			} );
+	}
+
+private :
+	unsigned int m_finished{ 0u };
+};
+
+// Checks a named mbox created with the explicit kind.
+class a_named_mbox_checker_t final : public so_5::agent_t
+{
+	struct finish final : public so_5::signal_t {};
+
+public :
+	a_named_mbox_checker_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_mbox{ so_environment().create_mbox(
+				"named", so_5::local_mbox_kind_t::copy_on_write ) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( m_mbox ).event( [this]( mhood_t< value > cmd ) {
+				ensure( cmd->m_v == m_received, "unexpected value" );
+				if( 3u == ++m_received )
+				{
+					so_drop_subscription< value >( m_mbox );
+
+					// This value must not be received.
+					so_5::send< value >( m_mbox, 100u );
+					so_5::send< finish >( *this );
+				}
+			} );
+
+		so_subscribe_self().event( [this]( mhood_t< finish > ) {
+				ensure( 3u == m_received, "all values must be received" );
+				so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		// Another reference to the same named mbox.
+		const auto same = so_environment().create_mbox( "named" );
+		ensure( same->id() == m_mbox->id(), "the same mbox is expected" );
+
+		for( unsigned int i = 0u; i != 3u; ++i )
+			so_5::send< value >( same, i );
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+
+	unsigned int m_received{ 0u };
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch(
+					[]( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								env.make_agent< a_coordinator_t >() );
+					},
+					[]( so_5::environment_params_t & params ) {
+						params.default_local_mbox_kind(
+								so_5::local_mbox_kind_t::copy_on_write );
+					} );
+
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								env.make_agent< a_named_mbox_checker_t >() );
+					} );
+			},
+			60,
+			"copy-on-write local mbox test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
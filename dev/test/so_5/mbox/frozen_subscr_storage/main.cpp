@@ -0,0 +1,192 @@
+/*
+ * A test for frozen subscription storage.
+ */
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+template< int I >
+struct sig final : public so_5::signal_t {};
+
+struct phase_two final : public so_5::signal_t {};
+struct phase_three final : public so_5::signal_t {};
+struct finish final : public so_5::signal_t {};
+
+constexpr int types_count = 40;
+
+using indexes_t = std::make_integer_sequence< int, types_count >;
+
+class a_test_t final : public so_5::agent_t
+	{
+		state_t st_first{ this, "first" };
+		state_t st_second{ this, "second" };
+
+	public :
+		a_test_t(
+			context_t ctx,
+			so_5::subscription_storage_factory_t factory )
+			:	so_5::agent_t{ ctx + factory }
+			,	m_other{ so_environment().create_mbox() }
+			{}
+
+		void
+		so_define_agent() override
+			{
+				this >>= st_first;
+
+				subscribe_all( indexes_t{} );
+
+				st_first.event( &a_test_t::on_phase_two );
+				st_second.event( &a_test_t::on_phase_three );
+			}
+
+		void
+		so_evt_start() override
+			{
+				send_all( so_direct_mbox(), indexes_t{} );
+				send_all( m_other, indexes_t{} );
+				so_5::send< phase_two >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_other;
+
+		unsigned int m_first_received{ 0u };
+		unsigned int m_second_received{ 0u };
+		unsigned int m_other_received{ 0u };
+		unsigned int m_resubscribed_received{ 0u };
+
+		template< int... I >
+		void
+		subscribe_all( std::integer_sequence< int, I... > )
+			{
+				( subscribe_one< I >(), ... );
+			}
+
+		template< int I >
+		void
+		subscribe_one()
+			{
+				so_subscribe_self().in( st_first ).event(
+						[this]( mhood_t< sig< I > > ) { ++m_first_received; } );
+				so_subscribe_self().in( st_second ).event(
+						[this]( mhood_t< sig< I > > ) { ++m_second_received; } );
+				so_subscribe( m_other ).in( st_first ).event(
+						[this]( mhood_t< sig< I > > ) { ++m_other_received; } );
+			}
+
+		template< int... I >
+		static void
+		send_all(
+			const so_5::mbox_t & to,
+			std::integer_sequence< int, I... > )
+			{
+				( so_5::send< sig< I > >( to ), ... );
+			}
+
+		void
+		on_phase_two( mhood_t< phase_two > )
+			{
+				ensure( types_count == static_cast<int>(m_first_received),
+						"all signals must be received in st_first, received: " +
+						std::to_string( m_first_received ) );
+				ensure( types_count == static_cast<int>(m_other_received),
+						"all signals from other mbox must be received, received: " +
+						std::to_string( m_other_received ) );
+
+				this >>= st_second;
+
+				send_all( so_direct_mbox(), indexes_t{} );
+				// There are no subscriptions for those signals in st_second.
+				send_all( m_other, indexes_t{} );
+				so_5::send< phase_three >( *this );
+			}
+
+		void
+		on_phase_three( mhood_t< phase_three > )
+			{
+				ensure( types_count == static_cast<int>(m_first_received),
+						"no more signals must be received in st_first" );
+				ensure( types_count == static_cast<int>(m_second_received),
+						"all signals must be received in st_second, received: " +
+						std::to_string( m_second_received ) );
+				ensure( types_count == static_cast<int>(m_other_received),
+						"signals from other mbox must be ignored in st_second" );
+
+				// Subscriptions are changed after the start of the agent.
+				so_drop_subscription< sig< 0 > >( so_direct_mbox(), st_second );
+				so_subscribe_self().in( st_second ).event(
+						[this]( mhood_t< sig< 0 > > ) { ++m_resubscribed_received; } );
+				st_second.event( &a_test_t::on_finish );
+
+				so_5::send< sig< 0 > >( *this );
+				so_5::send< sig< 1 > >( *this );
+				so_5::send< finish >( *this );
+			}
+
+		void
+		on_finish( mhood_t< finish > )
+			{
+				ensure( 1u == m_resubscribed_received,
+						"new subscription must be used" );
+				ensure( types_count + 1 == static_cast<int>(m_second_received),
+						"old subscriptions must be used, received: " +
+						std::to_string( m_second_received ) );
+
+				so_deregister_agent_coop_normally();
+			}
+	};
+
+int
+main()
+{
+	try
+	{
+		using factory_info_t =
+				std::pair< std::string, so_5::subscription_storage_factory_t >;
+
+		factory_info_t factories[] = {
+			{ "frozen", so_5::frozen_subscription_storage_factory() }
+		,	{ "frozen(vector[4])", so_5::frozen_subscription_storage_factory(
+					so_5::vector_based_subscription_storage_factory( 4 ) ) }
+		,	{ "frozen(map)", so_5::frozen_subscription_storage_factory(
+					so_5::map_based_subscription_storage_factory() ) }
+		,	{ "adaptive(frozen)", so_5::adaptive_subscription_storage_factory(
+					8,
+					so_5::vector_based_subscription_storage_factory( 8 ),
+					so_5::frozen_subscription_storage_factory() ) }
+		};
+
+		for( const auto & f : factories )
+		{
+			std::cout << "checking factory: " << f.first << " -> " << std::flush;
+
+			run_with_time_limit(
+				[&f]()
+				{
+					so_5::launch( [&f]( so_5::environment_t & env ) {
+							env.introduce_coop( [&f]( so_5::coop_t & coop ) {
+									coop.make_agent< a_test_t >( f.second );
+								} );
+						} );
+				},
+				20,
+				"checking factory " + f.first );
+
+			std::cout << "OK" << std::endl;
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
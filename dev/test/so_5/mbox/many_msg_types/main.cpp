@@ -0,0 +1,170 @@
+/*
+ * A test for local mbox with many message types.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <array>
+#include <string>
+#include <utility>
+
+constexpr std::size_t types_count = 48u;
+
+template< std::size_t I >
+struct msg final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+	using indexes_t = std::make_index_sequence< types_count >;
+
+	struct check_all_subscribed final : public so_5::signal_t {};
+	struct check_even_subscribed final : public so_5::signal_t {};
+	struct check_odd_subscribed final : public so_5::signal_t {};
+	struct check_nothing_subscribed final : public so_5::signal_t {};
+
+public :
+	using so_5::agent_t::agent_t;
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< check_all_subscribed > ) {
+					check( 1u, 1u );
+
+					drop_odd( indexes_t{} );
+					send_all( indexes_t{} );
+					so_5::send< check_even_subscribed >( *this );
+				} )
+			.event( [this]( mhood_t< check_even_subscribed > ) {
+					check( 2u, 1u );
+
+					drop_even( indexes_t{} );
+					subscribe_odd( indexes_t{} );
+					send_all( indexes_t{} );
+					so_5::send< check_odd_subscribed >( *this );
+				} )
+			.event( [this]( mhood_t< check_odd_subscribed > ) {
+					check( 2u, 2u );
+
+					drop_odd( indexes_t{} );
+					send_all( indexes_t{} );
+					so_5::send< check_nothing_subscribed >( *this );
+				} )
+			.event( [this]( mhood_t< check_nothing_subscribed > ) {
+					check( 2u, 2u );
+
+					so_deregister_agent_coop_normally();
+				} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		subscribe_all( indexes_t{} );
+		send_all( indexes_t{} );
+		so_5::send< check_all_subscribed >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_mbox{ so_environment().create_mbox() };
+
+	std::array< unsigned int, types_count > m_received{};
+
+	template< std::size_t I >
+	void
+	subscribe_one()
+	{
+		so_subscribe( m_mbox ).event( [this]( mhood_t< msg< I > > ) {
+				++m_received[ I ];
+			} );
+	}
+
+	template< std::size_t... I >
+	void
+	subscribe_all( std::index_sequence< I... > )
+	{
+		( subscribe_one< I >(), ... );
+	}
+
+	template< std::size_t... I >
+	void
+	subscribe_odd( std::index_sequence< I... > )
+	{
+		( ( 1u == I % 2u ? subscribe_one< I >() : void() ), ... );
+	}
+
+	template< std::size_t... I >
+	void
+	drop_odd( std::index_sequence< I... > )
+	{
+		( ( 1u == I % 2u ?
+				so_drop_subscription< msg< I > >( m_mbox ) : void() ), ... );
+	}
+
+	template< std::size_t... I >
+	void
+	drop_even( std::index_sequence< I... > )
+	{
+		( ( 0u == I % 2u ?
+				so_drop_subscription< msg< I > >( m_mbox ) : void() ), ... );
+	}
+
+	template< std::size_t... I >
+	void
+	send_all( std::index_sequence< I... > )
+	{
+		( so_5::send< msg< I > >( m_mbox ), ... );
+	}
+
+	void
+	check( unsigned int expected_even, unsigned int expected_odd ) const
+	{
+		for( std::size_t i = 0u; i != types_count; ++i )
+		{
+			const auto expected = 0u == i % 2u ? expected_even : expected_odd;
+			ensure( expected == m_received[ i ],
+					"unexpected count of messages of type #" + std::to_string( i ) +
+					": " + std::to_string( m_received[ i ] ) +
+					", expected: " + std::to_string( expected ) );
+		}
+	}
+};
+
+void
+run_test( so_5::local_mbox_kind_t kind )
+{
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			env.register_agent_as_coop( env.make_agent< a_test_t >() );
+		},
+		[kind]( so_5::environment_params_t & params ) {
+			params.default_local_mbox_kind( kind );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				run_test( so_5::local_mbox_kind_t::rw_locked );
+				run_test( so_5::local_mbox_kind_t::copy_on_write );
+			},
+			20,
+			"local mbox with many message types test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * A test for so_5::send_batch().
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <vector>
+
+struct value
+{
+	int m_v;
+};
+
+struct receiver_finished final : public so_5::signal_t {};
+
+constexpr int values_count = 100;
+constexpr std::size_t drop_limit = 10u;
+
+// Receiver checks that messages are received in the order of sending.
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t(
+		context_t ctx,
+		so_5::mbox_t source,
+		so_5::mbox_t coordinator,
+		bool only_even,
+		std::size_t expected )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_source{ std::move(source) }
+		,	m_coordinator{ std::move(coordinator) }
+		,	m_only_even{ only_even }
+		,	m_expected{ expected }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		if( m_only_even )
+			so_set_delivery_filter( m_source, []( const value & v ) {
+					return 0 == v.m_v % 2;
+				} );
+
+		so_subscribe( m_source ).event( &a_receiver_t::on_value );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+	const so_5::mbox_t m_coordinator;
+	const bool m_only_even;
+	const std::size_t m_expected;
+
+	int m_last{ -1 };
+	std::size_t m_received{ 0u };
+
+	void
+	on_value( mhood_t< value > cmd )
+	{
+		ensure( cmd->m_v > m_last, "messages must be received in order" );
+		if( m_only_even )
+			ensure( 0 == cmd->m_v % 2, "delivery filter must be applied" );
+
+		m_last = cmd->m_v;
+		if( ++m_received == m_expected )
+			so_5::send< receiver_finished >( m_coordinator );
+	}
+};
+
+// Receiver with a message limit. All messages are delivered by one
+// batch so only drop_limit messages must be received.
+class a_limited_receiver_t final : public so_5::agent_t
+{
+public :
+	a_limited_receiver_t(
+		context_t ctx,
+		so_5::mbox_t source,
+		so_5::mbox_t coordinator )
+		:	so_5::agent_t{ ctx + limit_then_drop< value >( drop_limit ) }
+		,	m_source{ std::move(source) }
+		,	m_coordinator{ std::move(coordinator) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe( m_source ).event( [this]( mhood_t< value > cmd ) {
+				ensure( cmd->m_v == static_cast< int >( m_received ),
+						"first messages of the batch must be received" );
+
+				if( ++m_received == drop_limit )
+					so_5::send< receiver_finished >( m_coordinator );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+	const so_5::mbox_t m_coordinator;
+
+	std::size_t m_received{ 0u };
+};
+
+// Receiver of mutable messages via the direct mbox.
+class a_direct_receiver_t final : public so_5::agent_t
+{
+public :
+	a_direct_receiver_t( context_t ctx, so_5::mbox_t coordinator )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_coordinator{ std::move(coordinator) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event(
+			[this]( mutable_mhood_t< value > cmd ) {
+				ensure( cmd->m_v == m_received, "unexpected mutable message" );
+				if( ++m_received == values_count )
+					so_5::send< receiver_finished >( m_coordinator );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_coordinator;
+
+	int m_received{ 0 };
+};
+
+class a_coordinator_t final : public so_5::agent_t
+{
+public :
+	a_coordinator_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_source{ so_environment().create_mbox() }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< receiver_finished > ) {
+				if( ++m_finished == m_receivers )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		auto & env = so_environment();
+
+		so_5::mbox_t direct;
+
+		so_5::introduce_child_coop( *this, [&]( so_5::coop_t & coop ) {
+				const auto & self = so_direct_mbox();
+
+				coop.make_agent_with_binder< a_receiver_t >(
+						so_5::disp::one_thread::make_dispatcher( env ).binder(),
+						m_source, self, false,
+						static_cast< std::size_t >( values_count ) );
+				coop.make_agent_with_binder< a_receiver_t >(
+						so_5::disp::thread_pool::make_dispatcher( env, 2u ).binder(
+								so_5::disp::thread_pool::bind_params_t{} ),
+						m_source, self, true,
+						static_cast< std::size_t >( values_count / 2 ) );
+				coop.make_agent_with_binder< a_receiver_t >(
+						so_5::disp::adv_thread_pool::make_dispatcher( env, 2u ).binder(
+								so_5::disp::adv_thread_pool::bind_params_t{} ),
+						m_source, self, false,
+						static_cast< std::size_t >( values_count ) );
+				coop.make_agent< a_limited_receiver_t >( m_source, self );
+
+				direct = coop.make_agent< a_direct_receiver_t >( self )->
+						so_direct_mbox();
+			} );
+		m_receivers = 5u;
+
+		std::vector< value > values;
+		for( int i = 0; i != values_count; ++i )
+			values.push_back( value{ i } );
+
+		so_5::send_batch< value >( m_source, values );
+		so_5::send_batch< so_5::mutable_msg< value > >(
+				direct, values.begin(), values.end() );
+	}
+
+private :
+	const so_5::mbox_t m_source;
+
+	std::size_t m_receivers{ 0u };
+	std::size_t m_finished{ 0u };
+};
+
+void
+check_mchain()
+{
+	so_5::wrapped_env_t sobj;
+
+	auto ch = so_5::create_mchain( sobj );
+
+	const std::vector< int > values{ 1, 2, 3, 4, 5 };
+	so_5::send_batch< value >( ch, values );
+
+	int expected = 1;
+	const auto r = so_5::receive(
+			so_5::from( ch ).handle_all().no_wait_on_empty(),
+			[&expected]( so_5::mhood_t< value > cmd ) {
+				ensure( cmd->m_v == expected, "unexpected value from mchain" );
+				++expected;
+			} );
+
+	ensure( 5u == r.handled(), "all messages must be received from mchain" );
+}
+
+void
+check_empty_batch()
+{
+	so_5::wrapped_env_t sobj;
+
+	auto mbox = sobj.environment().create_mbox();
+
+	const std::vector< value > values;
+	so_5::send_batch< value >( mbox, values );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop(
+								env.make_agent< a_coordinator_t >() );
+					} );
+
+				check_mchain();
+				check_empty_batch();
+			},
+			20,
+			"send_batch() test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
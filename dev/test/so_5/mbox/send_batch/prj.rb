@@ -0,0 +1,10 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj "so_5/prj.rb"
+
+	target "_unit.test.mbox.send_batch"
+
+	cpp_source "main.cpp"
+}
@@ -13,6 +13,8 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/resend_message_as_mutable_2/prj.ut.rb" )
 	required_prj( "#{path}/store_and_resend_later/prj.ut.rb" )
 	required_prj( "#{path}/lambda_handlers/prj.ut.rb" )
+	required_prj( "#{path}/pooled_allocation/prj.ut.rb" )
+	required_prj( "#{path}/message_type_id/prj.ut.rb" )
 
 	required_prj( "#{path}/user_type_msgs/build_tests.rb" )
 }
@@ -0,0 +1,146 @@
+/*
+ * A test for identifiers of message types.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+struct classical_msg final : public so_5::message_t {};
+
+struct user_msg
+{
+	int m_a;
+};
+
+struct signal_msg final : public so_5::signal_t {};
+
+struct unused_msg final : public so_5::signal_t {};
+
+template< int I >
+struct many final : public so_5::signal_t {};
+
+void
+check_basic_properties()
+{
+	ensure( so_5::null_message_type_id == so_5::message_type_id( typeid(void) ),
+			"void must have null_message_type_id" );
+
+	const auto classical = so_5::message_type_id_of< classical_msg >();
+	const auto user = so_5::message_type_id_of< user_msg >();
+	const auto signal = so_5::message_type_id_of< signal_msg >();
+
+	ensure( classical != user && user != signal && classical != signal,
+			"different types must have different ids" );
+
+	ensure( classical == so_5::message_type_id( typeid(classical_msg) ),
+			"ids must be the same for template and run-time versions" );
+	ensure( user == so_5::message_type_id_of< so_5::immutable_msg< user_msg > >(),
+			"immutable_msg<T> must have the same id as T" );
+	ensure( user != so_5::message_type_id_of< so_5::mutable_msg< user_msg > >(),
+			"mutable_msg<T> must have its own id" );
+
+	ensure( std::type_index{ typeid(user_msg) } ==
+			so_5::message_type_by_id( user ),
+			"message_type_by_id must return the original type" );
+}
+
+void
+check_unknown_id()
+{
+	try
+	{
+		so_5::message_type_by_id( 0xFFFFFFFFu );
+		ensure( false, "an exception is expected for unknown id" );
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		ensure( so_5::rc_unknown_message_type_id == ex.error_code(),
+				"rc_unknown_message_type_id is expected" );
+	}
+}
+
+void
+check_find_without_registration()
+{
+	so_5::message_type_id_t id;
+
+	ensure( !so_5::find_message_type_id( typeid(unused_msg), id ),
+			"unused_msg must not have an id" );
+	ensure( !so_5::find_message_type_id( typeid(unused_msg), id ),
+			"find_message_type_id must not assign an id" );
+
+	const auto expected = so_5::message_type_id_of< classical_msg >();
+	ensure( so_5::find_message_type_id( typeid(classical_msg), id ) &&
+			expected == id,
+			"find_message_type_id must return the assigned id" );
+}
+
+template< int... I >
+std::vector< so_5::message_type_id_t >
+register_many( std::integer_sequence< int, I... > )
+{
+	return { so_5::message_type_id( typeid(many< I >) )... };
+}
+
+void
+check_concurrent_registration()
+{
+	using indexes_t = std::make_integer_sequence< int, 300 >;
+
+	constexpr std::size_t threads_count = 4u;
+
+	std::vector< std::vector< so_5::message_type_id_t > > results(
+			threads_count );
+	std::vector< std::thread > threads;
+	for( std::size_t i = 0u; i != threads_count; ++i )
+		threads.emplace_back( [&results, i] {
+				results[ i ] = register_many( indexes_t{} );
+			} );
+
+	for( auto & t : threads )
+		t.join();
+
+	for( std::size_t i = 1u; i != threads_count; ++i )
+		ensure( results[ 0 ] == results[ i ],
+				"all threads must receive the same ids" );
+
+	const std::set< so_5::message_type_id_t > unique(
+			results[ 0 ].begin(), results[ 0 ].end() );
+	ensure( unique.size() == results[ 0 ].size(),
+			"every type must have its own id" );
+
+	// Ids must be dense.
+	for( const auto id : results[ 0 ] )
+		ensure( id < 1000u, "ids must be dense" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				check_basic_properties();
+				check_unknown_id();
+				check_find_without_registration();
+				check_concurrent_registration();
+			},
+			20,
+			"message_type_id test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
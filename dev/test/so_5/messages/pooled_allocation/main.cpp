@@ -0,0 +1,194 @@
+/*
+ * A test for pooled allocation of message instances.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+struct user_msg
+{
+	int m_a;
+	std::string m_b;
+};
+
+struct classical_msg : public so_5::message_t
+{
+	int m_a;
+	std::string m_b;
+
+	classical_msg( int a, std::string b )
+		:	m_a{ a }, m_b{ std::move(b) }
+	{}
+};
+
+struct big_msg
+{
+	char m_data[ so_5::message_pool::max_pooled_block_size * 2 ];
+	int m_value;
+};
+
+struct alignas(64) aligned_msg
+{
+	int m_value;
+};
+
+struct not_pooled_msg
+{
+	int m_a;
+};
+
+namespace so_5 {
+
+template<> struct pooled_message_allocation< user_msg > : public std::true_type {};
+template<> struct pooled_message_allocation< classical_msg > : public std::true_type {};
+template<> struct pooled_message_allocation< big_msg > : public std::true_type {};
+template<> struct pooled_message_allocation< aligned_msg > : public std::true_type {};
+
+} /* namespace so_5 */
+
+template< typename Envelope >
+bool
+is_pooled( const so_5::intrusive_ptr_t< Envelope > & ref )
+{
+	return nullptr != dynamic_cast<
+			so_5::details::pooled_envelope_t< Envelope > * >( ref.get() );
+}
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx, std::size_t expected )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_expected{ expected }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< user_msg > cmd ) {
+					ensure( is_pooled( cmd.make_reference() ),
+							"user_msg must be allocated from pool" );
+					ensure( cmd->m_b == std::to_string( cmd->m_a ),
+							"unexpected user_msg content" );
+					on_message();
+				} )
+			.event( [this]( mutable_mhood_t< user_msg > cmd ) {
+					ensure( is_pooled( cmd.make_reference() ),
+							"mutable user_msg must be allocated from pool" );
+					on_message();
+				} )
+			.event( [this]( mhood_t< classical_msg > cmd ) {
+					ensure( is_pooled( cmd.make_reference() ),
+							"classical_msg must be allocated from pool" );
+					ensure( cmd->m_b == std::to_string( cmd->m_a ),
+							"unexpected classical_msg content" );
+					on_message();
+				} )
+			.event( [this]( mutable_mhood_t< big_msg > cmd ) {
+					ensure( cmd->m_value == 42, "unexpected big_msg content" );
+					// NOTE: make_reference() takes the ownership of mutable message.
+					ensure( is_pooled( cmd.make_reference() ),
+							"big_msg must be allocated from pool" );
+					on_message();
+				} )
+			.event( [this]( mhood_t< aligned_msg > cmd ) {
+					ensure( 0u == reinterpret_cast< std::uintptr_t >(
+									&(*cmd) ) % alignof( aligned_msg ),
+							"aligned_msg must be properly aligned" );
+					ensure( cmd->m_value == 42, "unexpected aligned_msg content" );
+					on_message();
+				} )
+			.event( [this]( mhood_t< not_pooled_msg > cmd ) {
+					ensure( !is_pooled( cmd.make_reference() ),
+							"not_pooled_msg must not be allocated from pool" );
+					on_message();
+				} );
+	}
+
+private :
+	const std::size_t m_expected;
+	std::size_t m_received{ 0u };
+
+	void
+	on_message()
+	{
+		if( ++m_received == m_expected )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+class a_sender_t final : public so_5::agent_t
+{
+public :
+	a_sender_t( context_t ctx, so_5::mbox_t dest, std::size_t iterations )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_dest{ std::move(dest) }
+		,	m_iterations{ iterations }
+	{}
+
+	void
+	so_evt_start() override
+	{
+		for( std::size_t i = 0u; i != m_iterations; ++i )
+		{
+			const int v = static_cast< int >( i );
+			so_5::send< user_msg >( m_dest, v, std::to_string( v ) );
+			so_5::send< so_5::mutable_msg< user_msg > >(
+					m_dest, v, std::to_string( v ) );
+			so_5::send< classical_msg >( m_dest, v, std::to_string( v ) );
+
+			auto big = so_5::message_holder_t< so_5::mutable_msg< big_msg > >::make();
+			big->m_value = 42;
+			so_5::send( m_dest, std::move(big) );
+
+			so_5::send< aligned_msg >( m_dest, 42 );
+
+			so_5::send< not_pooled_msg >( m_dest, v );
+		}
+	}
+
+	static constexpr std::size_t messages_per_iteration = 6u;
+
+private :
+	const so_5::mbox_t m_dest;
+	const std::size_t m_iterations;
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+					constexpr std::size_t iterations = 10000u;
+					constexpr std::size_t senders = 4u;
+
+					env.introduce_coop(
+						so_5::disp::active_obj::make_dispatcher( env ).binder(),
+						[&]( so_5::coop_t & coop ) {
+							auto receiver = coop.make_agent< a_receiver_t >(
+									iterations * senders *
+											a_sender_t::messages_per_iteration );
+							for( std::size_t i = 0u; i != senders; ++i )
+								coop.make_agent< a_sender_t >(
+										receiver->so_direct_mbox(), iterations );
+						} );
+				} );
+			},
+			20,
+			"pooled allocation of messages" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -450,6 +450,13 @@ do_test()
 		factories.push_back( lock_factory_info_t{
 				"simple_lock",
 				so_5::disp::mpsc_queue_traits::simple_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"lock_free_queue",
+				so_5::disp::mpsc_queue_traits::lock_free_queue_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"lock_free_queue(1us)",
+				so_5::disp::mpsc_queue_traits::lock_free_queue_factory(
+						std::chrono::microseconds(1) ) } );
 
 		for( const auto & c : cases )
 			for( const auto & f : factories )
@@ -0,0 +1,147 @@
+/*
+ * A test for lock-free MPSC demand queue of work threads.
+ *
+ * Several external threads send messages to one agent.
+ * The agent checks that all messages are received and the order
+ * of messages from every sender is preserved.
+ */
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+const unsigned int senders = 4;
+const unsigned int messages_per_sender = 20000;
+
+struct msg_data final : public so_5::message_t
+{
+	unsigned int m_sender;
+	unsigned int m_seq;
+
+	msg_data( unsigned int sender, unsigned int seq )
+		:	m_sender{ sender }, m_seq{ seq }
+	{}
+};
+
+class a_receiver_t final : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_expected( senders, 0u )
+	{}
+
+	~a_receiver_t() override
+	{
+		for( auto & t : m_threads )
+			t.join();
+	}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_data > cmd ) {
+				ensure( m_expected[ cmd->m_sender ] == cmd->m_seq,
+						"unexpected seq from sender " +
+						std::to_string( cmd->m_sender ) + ": " +
+						std::to_string( cmd->m_seq ) + ", expected: " +
+						std::to_string( m_expected[ cmd->m_sender ] ) );
+
+				++m_expected[ cmd->m_sender ];
+
+				if( senders * messages_per_sender == ++m_received )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		const so_5::mbox_t dest = so_direct_mbox();
+		for( unsigned int i = 0; i != senders; ++i )
+			m_threads.emplace_back( [dest, i] {
+					for( unsigned int seq = 0; seq != messages_per_sender; ++seq )
+					{
+						so_5::send< msg_data >( dest, i, seq );
+						// Give the receiver a chance to fall asleep.
+						if( 0u == seq % 5000u )
+							std::this_thread::sleep_for(
+									std::chrono::milliseconds( 5 ) );
+					}
+				} );
+	}
+
+private :
+	std::vector< unsigned int > m_expected;
+	unsigned int m_received{ 0u };
+
+	std::vector< std::thread > m_threads;
+};
+
+using lock_factory_t = so_5::disp::mpsc_queue_traits::lock_factory_t;
+
+void
+run_case(
+	const std::string & case_name,
+	lock_factory_t factory,
+	bool track_activity )
+{
+	std::cout << "--- " << case_name << " ---" << std::endl;
+
+	run_with_time_limit( [&] {
+			so_5::launch(
+				[&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+						so_5::disp::active_obj::make_dispatcher(
+							env,
+							std::string_view{},
+							so_5::disp::active_obj::disp_params_t{}
+								.tune_queue_params(
+									[&]( so_5::disp::mpsc_queue_traits::queue_params_t & p ) {
+										p.lock_factory( factory );
+									} ) ).binder(),
+						[]( so_5::coop_t & coop ) {
+							coop.make_agent< a_receiver_t >();
+						} );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					if( track_activity )
+						params.turn_work_thread_activity_tracking_on();
+				} );
+		},
+		60,
+		case_name );
+}
+
+int
+main()
+{
+	try
+	{
+		using namespace so_5::disp::mpsc_queue_traits;
+
+		for( bool track_activity : { false, true } )
+		{
+			const std::string suffix = track_activity ? " (tracking)" : "";
+
+			run_case( "lock_free_queue" + suffix,
+					lock_free_queue_factory(),
+					track_activity );
+			run_case( "lock_free_queue(1us)" + suffix,
+					lock_free_queue_factory( std::chrono::microseconds(1) ),
+					track_activity );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -151,6 +151,8 @@ main()
 		cases.push_back( case_info_t{ "combined_lock(1us)",
 				combined_lock_factory( std::chrono::microseconds(1) ) } );
 		cases.push_back( case_info_t{ "simple_lock", simple_lock_factory() } );
+		cases.push_back( case_info_t{ "lock_free_queue", lock_free_queue_factory() } );
+		cases.push_back( case_info_t{ "adaptive_lock", adaptive_lock_factory() } );
 
 		for( const auto & c : cases )
 		{
@@ -22,5 +22,6 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/transfer_to_state_loop/prj.ut.rb"
 	required_prj "#{path}/just_switch_to/prj.ut.rb"
 	required_prj "#{path}/state_switch_guard/prj.ut.rb"
+	required_prj "#{path}/handler_cache/prj.ut.rb"
 	required_prj "#{path}/time_limit/build_tests.rb"
 }
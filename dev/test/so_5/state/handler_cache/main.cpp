@@ -0,0 +1,134 @@
+/*
+ * A test for changes of subscriptions for an agent with hierarchical
+ * states. Results of handler searches must not be reused after
+ * a change of subscriptions.
+ */
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+struct msg final : public so_5::signal_t {};
+
+struct step final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+	state_t st_root{ this, "root" };
+	state_t st_mid{ initial_substate_of{ st_root }, "mid" };
+	state_t st_leaf{ initial_substate_of{ st_mid }, "leaf" };
+
+public :
+	a_test_t( context_t ctx, std::string & trace )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_trace( trace )
+	{}
+
+	void
+	so_define_agent() override
+	{
+		this >>= st_leaf;
+
+		st_root
+			.event( &a_test_t::on_step )
+			.event( [this]( mhood_t< msg > ) { m_trace += "root;"; } );
+	}
+
+	void
+	so_evt_start() override
+	{
+		send_msg_and_step();
+	}
+
+private :
+	std::string & m_trace;
+
+	int m_step{ 0 };
+
+	void
+	send_msg_and_step()
+	{
+		// Two messages to use a result of the previous search.
+		so_5::send< msg >( *this );
+		so_5::send< msg >( *this );
+		so_5::send< step >( *this );
+	}
+
+	void
+	on_step( mhood_t< step > )
+	{
+		m_trace += "|";
+
+		switch( ++m_step )
+		{
+		case 1:
+			st_leaf.event( [this]( mhood_t< msg > ) { m_trace += "leaf;"; } );
+		break;
+
+		case 2:
+			so_drop_subscription< msg >( so_direct_mbox(), st_leaf );
+		break;
+
+		case 3:
+			so_drop_subscription< msg >( so_direct_mbox(), st_root );
+		break;
+
+		case 4:
+			so_subscribe_deadletter_handler( so_direct_mbox(),
+					[this]( mhood_t< msg > ) { m_trace += "deadletter;"; } );
+		break;
+
+		case 5:
+			this >>= st_mid;
+		break;
+
+		case 6:
+			st_mid.event( [this]( mhood_t< msg > ) { m_trace += "mid;"; } );
+		break;
+
+		default:
+			so_deregister_agent_coop_normally();
+			return;
+		}
+
+		send_msg_and_step();
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				std::string trace;
+
+				so_5::launch( [&]( so_5::environment_t & env ) {
+						env.introduce_coop( [&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >( trace );
+							} );
+					} );
+
+				const std::string expected =
+						"root;root;|leaf;leaf;|root;root;||"
+						"deadletter;deadletter;|deadletter;deadletter;|"
+						"mid;mid;|";
+
+				ensure( expected == trace,
+						"unexpected trace: '" + trace + "', expected: '" +
+						expected + "'" );
+			},
+			20,
+			"handler cache test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
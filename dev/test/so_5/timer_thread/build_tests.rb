@@ -15,4 +15,9 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/resend_periodic_via_mhood_to_mchain/prj.ut.rb" 
 	required_prj "#{path}/resend_delayed_via_mhood_to_mchain/prj.ut.rb" 
 	required_prj "#{path}/negative_args/prj.ut.rb" 
+	required_prj "#{path}/hierarchical_wheel/prj.ut.rb" 
+	required_prj "#{path}/hierarchical_wheel_idle/prj.ut.rb" 
+	required_prj "#{path}/reschedule/prj.ut.rb" 
+	required_prj "#{path}/sharded/prj.ut.rb" 
+	required_prj "#{path}/local_timer_queue/prj.ut.rb" 
 }
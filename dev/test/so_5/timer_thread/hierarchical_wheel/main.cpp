@@ -0,0 +1,121 @@
+/*
+ * A test for hierarchical timer wheel with timers on different levels.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+// Wheel with 4 slots, 3 levels and 5ms step can hold timers
+// up to 63 steps (315ms). Longer timers must be rescheduled.
+constexpr unsigned int wheel_size = 4u;
+constexpr unsigned int levels = 3u;
+constexpr auto granularity = 5ms;
+
+struct msg_delayed final : public so_5::message_t
+{
+	std::chrono::milliseconds m_delay;
+
+	msg_delayed( std::chrono::milliseconds delay ) : m_delay{ delay } {}
+};
+
+struct msg_periodic final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, std::string & trace )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_trace{ trace }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_delayed )
+			.event( [this]( mhood_t< msg_periodic > ) { ++m_ticks; } );
+	}
+
+	void
+	so_evt_start() override
+	{
+		m_started_at = std::chrono::steady_clock::now();
+
+		// Timers are sent in the reverse order of their delays.
+		for( auto d : { 400ms, 200ms, 50ms, 10ms } )
+			so_5::send_delayed< msg_delayed >( *this, d, d );
+
+		m_periodic = so_5::send_periodic< msg_periodic >( *this, 30ms, 30ms );
+	}
+
+private :
+	std::string & m_trace;
+
+	std::chrono::steady_clock::time_point m_started_at;
+
+	so_5::timer_id_t m_periodic;
+
+	unsigned int m_ticks{ 0u };
+
+	void
+	evt_delayed( mhood_t< msg_delayed > cmd )
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - m_started_at;
+		ensure_or_die( elapsed + granularity >= cmd->m_delay,
+				"timer with delay " + std::to_string( cmd->m_delay.count() ) +
+				"ms is fired too early" );
+
+		m_trace += std::to_string( cmd->m_delay.count() ) + ";";
+
+		if( 400ms == cmd->m_delay )
+		{
+			ensure_or_die( m_ticks >= 3u,
+					"periodic timer is fired too rarely: " +
+					std::to_string( m_ticks ) );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				std::string trace;
+
+				so_5::launch(
+					[&trace]( so_5::environment_t & env ) {
+						env.introduce_coop( [&trace]( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >( trace );
+							} );
+					},
+					[]( so_5::environment_params_t & params ) {
+						params.timer_thread(
+								so_5::timer_hierarchical_wheel_factory(
+										wheel_size, levels, granularity ) );
+					} );
+
+				ensure_or_die( "10;50;200;400;" == trace,
+						"unexpected order of timers: " + trace );
+			},
+			20,
+			"hierarchical timer wheel" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+	required_prj( "so_5/prj.rb" )
+
+	target( "_unit.test.timer_thread.hierarchical_wheel" )
+
+	cpp_source( "main.cpp" )
+}
+
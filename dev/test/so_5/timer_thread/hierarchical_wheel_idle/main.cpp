@@ -0,0 +1,112 @@
+/*
+ * A test for hierarchical timer wheel after a period without timers.
+ *
+ * Ticks aren't processed while the wheel is empty. A timer added
+ * after such period must not be expired earlier than its pause.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+constexpr unsigned int wheel_size = 4u;
+constexpr unsigned int levels = 3u;
+constexpr auto granularity = 10ms;
+
+// The wheel stays empty for several ticks before every attempt.
+constexpr auto idle_period = 100ms;
+
+// The pause is a multiple of granularity. A timer with such pause
+// is never expired earlier than the pause.
+constexpr auto pause = 50ms;
+
+constexpr unsigned int attempts = 3u;
+
+class a_test_t final : public so_5::agent_t
+{
+	struct msg_timer final : public so_5::signal_t {};
+
+public :
+	a_test_t( context_t ctx ) : so_5::agent_t{ std::move(ctx) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_test_t::evt_timer );
+	}
+
+	void
+	so_evt_start() override
+	{
+		start_attempt();
+	}
+
+private :
+	std::chrono::steady_clock::time_point m_started_at;
+
+	unsigned int m_attempts{ 0u };
+
+	void
+	start_attempt()
+	{
+		std::this_thread::sleep_for( idle_period );
+
+		m_started_at = std::chrono::steady_clock::now();
+		so_5::send_delayed< msg_timer >( *this, pause );
+	}
+
+	void
+	evt_timer( mhood_t< msg_timer > )
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - m_started_at;
+		ensure_or_die( elapsed >= pause,
+				"timer is fired too early, attempt: " +
+				std::to_string( m_attempts ) + ", elapsed: " +
+				std::to_string( std::chrono::duration_cast<
+						std::chrono::microseconds >( elapsed ).count() ) + "us" );
+
+		if( attempts == ++m_attempts )
+			so_deregister_agent_coop_normally();
+		else
+			start_attempt();
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				so_5::launch(
+					[]( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >();
+							} );
+					},
+					[]( so_5::environment_params_t & params ) {
+						params.timer_thread(
+								so_5::timer_hierarchical_wheel_factory(
+										wheel_size, levels, granularity ) );
+					} );
+			},
+			20,
+			"hierarchical timer wheel after idle period" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
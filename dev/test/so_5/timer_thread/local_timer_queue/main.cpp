@@ -0,0 +1,317 @@
+/*
+ * A test for short delayed messages handled by work threads.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+// Count of delayed messages which were passed to the timer thread.
+std::atomic< unsigned int > g_timer_thread_messages{ 0u };
+
+class counting_timer_thread_t final : public so_5::timer_thread_t
+{
+public :
+	counting_timer_thread_t( so_5::timer_thread_unique_ptr_t actual )
+		:	m_actual{ std::move(actual) }
+	{}
+
+	void
+	start() override { m_actual->start(); }
+
+	void
+	finish() override { m_actual->finish(); }
+
+	so_5::timer_id_t
+	schedule(
+		const std::type_index & type_index,
+		const so_5::mbox_t & mbox,
+		const so_5::message_ref_t & msg,
+		std::chrono::steady_clock::duration pause,
+		std::chrono::steady_clock::duration period ) override
+	{
+		return m_actual->schedule( type_index, mbox, msg, pause, period );
+	}
+
+	void
+	schedule_anonymous(
+		const std::type_index & type_index,
+		const so_5::mbox_t & mbox,
+		const so_5::message_ref_t & msg,
+		std::chrono::steady_clock::duration pause,
+		std::chrono::steady_clock::duration period ) override
+	{
+		++g_timer_thread_messages;
+		m_actual->schedule_anonymous( type_index, mbox, msg, pause, period );
+	}
+
+	so_5::timer_thread_stats_t
+	query_stats() override { return m_actual->query_stats(); }
+
+private :
+	const so_5::timer_thread_unique_ptr_t m_actual;
+};
+
+struct msg_delayed final : public so_5::message_t
+{
+	unsigned int m_index;
+
+	msg_delayed( unsigned int index ) : m_index{ index } {}
+};
+
+struct msg_long_delayed final : public so_5::signal_t {};
+
+struct msg_chain final : public so_5::signal_t {};
+
+struct msg_echo final : public so_5::signal_t {};
+
+constexpr unsigned int chain_length = 20u;
+
+// Count of messages passed to the timer thread when local timers are used:
+// the long delayed message and the message to another agent.
+constexpr unsigned int with_local_timers = 2u;
+
+// Count of messages passed to the timer thread when local timers
+// are not used.
+constexpr unsigned int without_local_timers = 3u + 1u + chain_length + 1u;
+
+class a_echo_t final : public so_5::agent_t
+{
+public :
+	a_echo_t( context_t ctx, so_5::mbox_t reply_to )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_reply_to{ std::move(reply_to) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_echo > ) {
+				so_5::send< msg_echo >( m_reply_to );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_reply_to;
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, bool local_timers )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_local_timers{ local_timers }
+	{}
+
+	void
+	set_echo( so_5::mbox_t echo ) { m_echo = std::move(echo); }
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_delayed )
+			.event( &a_test_t::evt_long_delayed )
+			.event( &a_test_t::evt_chain )
+			.event( &a_test_t::evt_echo );
+	}
+
+	void
+	so_evt_start() override
+	{
+		m_started_at = std::chrono::steady_clock::now();
+
+		so_5::send_delayed< msg_delayed >( *this, 6ms, 0u );
+		so_5::send_delayed< msg_delayed >( *this, 2ms, 1u );
+		so_5::send_delayed< msg_delayed >( *this, 6ms, 2u );
+
+		// Long delays are handled by the timer thread.
+		so_5::send_delayed< msg_long_delayed >( *this, 50ms );
+	}
+
+private :
+	// The timer thread rounds pauses to its granularity. So the order
+	// and the timing of delayed messages are checked only for local timers.
+	const bool m_local_timers;
+
+	so_5::mbox_t m_echo;
+
+	std::chrono::steady_clock::time_point m_started_at;
+
+	std::string m_trace;
+
+	unsigned int m_chain{ 0u };
+
+	void
+	evt_delayed( mhood_t< msg_delayed > cmd )
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - m_started_at;
+		ensure_or_die( !m_local_timers ||
+				elapsed >= ( 1u == cmd->m_index ? 2ms : 6ms ),
+				"delayed message is delivered too early, index: " +
+				std::to_string( cmd->m_index ) );
+
+		m_trace += std::to_string( cmd->m_index ) + ";";
+	}
+
+	void
+	evt_long_delayed( mhood_t< msg_long_delayed > )
+	{
+		ensure_or_die( !m_local_timers || "1;0;2;" == m_trace,
+				"unexpected order of delayed messages: " + m_trace );
+
+		m_started_at = std::chrono::steady_clock::now();
+		so_5::send_delayed< msg_chain >( *this, 1ms );
+	}
+
+	void
+	evt_chain( mhood_t< msg_chain > )
+	{
+		if( ++m_chain < chain_length )
+			so_5::send_delayed< msg_chain >( *this, 1ms );
+		else
+		{
+			ensure_or_die( !m_local_timers ||
+					std::chrono::steady_clock::now() - m_started_at >=
+							chain_length * 1ms,
+					"chain of delayed messages is too fast" );
+
+			// A message to another agent is handled by the timer thread.
+			so_5::send_delayed< msg_echo >( m_echo, 1ms );
+		}
+	}
+
+	void
+	evt_echo( mhood_t< msg_echo > )
+	{
+		so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_test(
+	const std::string & case_name,
+	unsigned int expected_timer_thread_messages,
+	std::function< so_5::disp_binder_shptr_t( so_5::environment_t & ) >
+		binder_maker,
+	std::function< void( so_5::environment_params_t & ) > params_tuner = {} )
+{
+	run_with_time_limit( [&] {
+			g_timer_thread_messages = 0u;
+
+			so_5::launch(
+				[&]( so_5::environment_t & env ) {
+					env.introduce_coop( binder_maker( env ),
+						[&]( so_5::coop_t & coop ) {
+							auto test = coop.make_agent< a_test_t >(
+									with_local_timers == expected_timer_thread_messages );
+							test->set_echo( coop.make_agent< a_echo_t >(
+									test->so_direct_mbox() )->so_direct_mbox() );
+						} );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					if( params_tuner )
+						params_tuner( params );
+
+					params.timer_thread(
+						[]( so_5::error_logger_shptr_t logger ) {
+							return so_5::timer_thread_unique_ptr_t{
+									new counting_timer_thread_t{
+											so_5::create_timer_wheel_thread(
+													std::move(logger) ) } };
+						} );
+				} );
+
+			ensure_or_die(
+					expected_timer_thread_messages == g_timer_thread_messages,
+					"unexpected count of messages passed to the timer thread: " +
+					std::to_string( g_timer_thread_messages.load() ) );
+		},
+		20,
+		case_name );
+}
+
+int
+main()
+{
+	try
+	{
+		// Local timers are turned off by default.
+		run_test( "default dispatcher", without_local_timers,
+				[]( so_5::environment_t & env ) {
+					return env.so_make_default_disp_binder();
+				} );
+
+		run_test( "default dispatcher with local timers", with_local_timers,
+				[]( so_5::environment_t & env ) {
+					return env.so_make_default_disp_binder();
+				},
+				[]( so_5::environment_params_t & params ) {
+					params.default_disp_params(
+							so_5::disp::one_thread::disp_params_t{}
+								.local_timers( true ) );
+				} );
+
+		run_test( "one_thread with simple_lock", with_local_timers,
+				[]( so_5::environment_t & env ) {
+					namespace ot = so_5::disp::one_thread;
+					return ot::make_dispatcher( env, std::string_view{},
+							ot::disp_params_t{}
+								.local_timers( true )
+								.tune_queue_params(
+									[]( ot::queue_traits::queue_params_t & p ) {
+										p.lock_factory(
+												ot::queue_traits::simple_lock_factory() );
+									} ) ).binder();
+				} );
+
+		run_test( "one_thread with lock-free queue", with_local_timers,
+				[]( so_5::environment_t & env ) {
+					namespace ot = so_5::disp::one_thread;
+					return ot::make_dispatcher( env, std::string_view{},
+							ot::disp_params_t{}
+								.local_timers( true )
+								.tune_queue_params(
+									[]( ot::queue_traits::queue_params_t & p ) {
+										p.lock_factory(
+												ot::queue_traits::lock_free_queue_factory() );
+									} ) ).binder();
+				} );
+
+		run_test( "active_obj", with_local_timers,
+				[]( so_5::environment_t & env ) {
+					namespace ao = so_5::disp::active_obj;
+					return ao::make_dispatcher( env, std::string_view{},
+							ao::disp_params_t{}.local_timers( true ) ).binder();
+				} );
+
+		run_test( "active_group", with_local_timers,
+				[]( so_5::environment_t & env ) {
+					namespace ag = so_5::disp::active_group;
+					return ag::make_dispatcher( env, std::string_view{},
+							ag::disp_params_t{}.local_timers( true ) )
+							.binder( "test" );
+				} );
+
+		// Delayed messages aren't bound to a work thread of thread_pool.
+		run_test( "thread_pool", without_local_timers,
+				[]( so_5::environment_t & env ) {
+					return so_5::disp::thread_pool::make_dispatcher( env, 2u )
+							.binder();
+				} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
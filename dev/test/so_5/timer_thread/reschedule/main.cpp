@@ -0,0 +1,203 @@
+/*
+ * A test for rescheduling of timers.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+struct msg_activity final : public so_5::signal_t {};
+
+struct msg_timeout final : public so_5::signal_t {};
+
+struct msg_value final : public so_5::message_t
+{
+	int m_value;
+
+	msg_value( int value ) : m_value{ value } {}
+};
+
+template< typename Lambda >
+void
+ensure_rescheduling_fails( int expected_error, Lambda && lambda )
+{
+	try
+	{
+		lambda();
+		ensure_or_die( false, "an exception must be thrown!" );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		ensure_or_die( expected_error == x.error_code(),
+				"unexpected error code: " + std::to_string( x.error_code() ) );
+	}
+}
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx ) : so_5::agent_t{ std::move(ctx) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_activity )
+			.event( &a_test_t::evt_timeout )
+			.event( &a_test_t::evt_value );
+	}
+
+	void
+	so_evt_start() override
+	{
+		ensure_rescheduling_fails( so_5::rc_timer_cannot_be_rescheduled,
+				[] {
+					so_5::timer_id_t empty;
+					empty.reschedule( 10ms );
+				} );
+
+		ensure_rescheduling_fails( so_5::rc_timer_cannot_be_rescheduled,
+				[this] {
+					auto id = so_5::send_periodic< msg_timeout >( *this, 1s, 0s );
+					id.release();
+					id.reschedule( 10ms );
+				} );
+
+		m_timeout = so_5::send_periodic< msg_timeout >( *this, 200ms, 0s );
+
+		ensure_rescheduling_fails( so_5::rc_timer_cannot_be_rescheduled,
+				[this] {
+					so_5::reschedule_delayed< msg_value >( m_timeout, 10ms, 0 );
+				} );
+		ensure_rescheduling_fails( so_5::rc_negative_value_for_pause,
+				[this] { m_timeout.reschedule( -10ms ); } );
+
+		m_activity = so_5::send_periodic< msg_activity >( *this, 20ms, 20ms );
+	}
+
+private :
+	so_5::timer_id_t m_activity;
+	so_5::timer_id_t m_timeout;
+	so_5::timer_id_t m_value;
+
+	unsigned int m_activities{ 0u };
+	unsigned int m_timeouts{ 0u };
+
+	void
+	evt_activity( mhood_t< msg_activity > )
+	{
+		if( ++m_activities < 10u )
+			// Timeout is started again on every activity.
+			m_timeout.reschedule( 200ms );
+		else
+			m_activity.release();
+	}
+
+	void
+	evt_timeout( mhood_t< msg_timeout > )
+	{
+		ensure_or_die( 10u == m_activities,
+				"timeout must be fired after all activities, activities: " +
+				std::to_string( m_activities ) );
+		ensure_or_die( 0u == m_timeouts++, "timeout must be fired only once" );
+
+		// Timer can be reused after firing too.
+		m_value = so_5::send_periodic< msg_value >( *this, 1s, 0s, 1 );
+		so_5::reschedule_delayed< msg_value >( m_value, 10ms, 2 );
+	}
+
+	void
+	evt_value( mhood_t< msg_value > cmd )
+	{
+		if( 2 == cmd->m_value )
+			so_5::reschedule_periodic< msg_value >( m_value, 10ms, 10ms, 3 );
+		else if( 3 == cmd->m_value )
+		{
+			m_value.release();
+			so_deregister_agent_coop_normally();
+		}
+		else
+			ensure_or_die( false,
+					"unexpected value: " + std::to_string( cmd->m_value ) );
+	}
+};
+
+void
+run_test( std::function< void( so_5::environment_params_t & ) > tuner )
+{
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			env.introduce_coop( []( so_5::coop_t & coop ) {
+					coop.make_agent< a_test_t >();
+				} );
+		},
+		std::move(tuner) );
+}
+
+int
+main()
+{
+	try
+	{
+		struct thread_info_t {
+			std::string m_name;
+			so_5::timer_thread_factory_t m_factory;
+		};
+
+		thread_info_t threads[] = {
+			{ "timer_wheel", so_5::timer_wheel_factory() },
+			{ "timer_hierarchical_wheel", so_5::timer_hierarchical_wheel_factory() },
+			{ "timer_heap", so_5::timer_heap_factory() },
+			{ "timer_list", so_5::timer_list_factory() }
+		};
+
+		for( const auto & t : threads )
+			run_with_time_limit( [&t] {
+					run_test( [&t]( so_5::environment_params_t & params ) {
+							params.timer_thread( t.m_factory );
+						} );
+				},
+				20,
+				t.m_name );
+
+		struct manager_info_t {
+			std::string m_name;
+			so_5::timer_manager_factory_t m_factory;
+		};
+
+		manager_info_t managers[] = {
+			{ "timer_wheel_manager", so_5::timer_wheel_manager_factory() },
+			{ "timer_hierarchical_wheel_manager",
+					so_5::timer_hierarchical_wheel_manager_factory() },
+			{ "timer_heap_manager", so_5::timer_heap_manager_factory() },
+			{ "timer_list_manager", so_5::timer_list_manager_factory() }
+		};
+
+		for( const auto & m : managers )
+			run_with_time_limit( [&m] {
+					run_test( [&m]( so_5::environment_params_t & params ) {
+							so_5::env_infrastructures::simple_not_mtsafe::params_t p;
+							p.timer_manager( m.m_factory );
+							params.infrastructure_factory(
+									so_5::env_infrastructures::simple_not_mtsafe::factory(
+											std::move(p) ) );
+						} );
+				},
+				20,
+				m.m_name );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * A test for sharded timer thread.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <test/3rd_party/various_helpers/time_limited_execution.hpp>
+#include <test/3rd_party/various_helpers/ensure.hpp>
+
+using namespace std::chrono_literals;
+
+struct msg_delayed final : public so_5::message_t
+{
+	unsigned int m_index;
+
+	msg_delayed( unsigned int index ) : m_index{ index } {}
+};
+
+struct msg_periodic final : public so_5::signal_t {};
+
+struct msg_done final : public so_5::signal_t {};
+
+constexpr unsigned int agents = 16u;
+constexpr unsigned int delayed_messages = 100u;
+
+class a_worker_t final : public so_5::agent_t
+{
+public :
+	a_worker_t( context_t ctx, so_5::mbox_t manager )
+		:	so_5::agent_t{ std::move(ctx) }
+		,	m_manager{ std::move(manager) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( mhood_t< msg_delayed > cmd ) {
+					// Messages with the same delay are delivered in FIFO order.
+					ensure_or_die( m_received == cmd->m_index,
+							"unexpected index: " + std::to_string( cmd->m_index ) +
+							", expected: " + std::to_string( m_received ) );
+					++m_received;
+					check_completion();
+				} )
+			.event( [this]( mhood_t< msg_periodic > ) {
+					if( 3u == ++m_ticks )
+						m_periodic.release();
+					check_completion();
+				} );
+	}
+
+	void
+	so_evt_start() override
+	{
+		for( unsigned int i = 0u; i != delayed_messages; ++i )
+			so_5::send_delayed< msg_delayed >( *this, 25ms, i );
+
+		m_periodic = so_5::send_periodic< msg_periodic >( *this, 10ms, 10ms );
+	}
+
+private :
+	const so_5::mbox_t m_manager;
+
+	so_5::timer_id_t m_periodic;
+
+	unsigned int m_received{ 0u };
+	unsigned int m_ticks{ 0u };
+
+	void
+	check_completion()
+	{
+		if( delayed_messages == m_received && !m_periodic.is_active() )
+		{
+			so_5::send< msg_done >( m_manager );
+			// Extra periodic messages must not be handled.
+			so_drop_subscription< msg_periodic >( so_direct_mbox() );
+			m_received = 0u;
+		}
+	}
+};
+
+class a_manager_t final : public so_5::agent_t
+{
+public :
+	a_manager_t( context_t ctx ) : so_5::agent_t{ std::move(ctx) }
+	{}
+
+	void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( mhood_t< msg_done > ) {
+				if( agents == ++m_done )
+					so_deregister_agent_coop_normally();
+			} );
+	}
+
+private :
+	unsigned int m_done{ 0u };
+};
+
+void
+run_test( so_5::timer_shard_selection_t selection )
+{
+	so_5::launch(
+		[]( so_5::environment_t & env ) {
+			namespace tp = so_5::disp::thread_pool;
+
+			env.introduce_coop(
+				tp::make_dispatcher( env, 4u ).binder(
+						[]( auto & p ) { p.fifo( tp::fifo_t::individual ); } ),
+				[]( so_5::coop_t & coop ) {
+					auto manager = coop.make_agent< a_manager_t >();
+					for( unsigned int i = 0u; i != agents; ++i )
+						coop.make_agent< a_worker_t >( manager->so_direct_mbox() );
+				} );
+		},
+		[selection]( so_5::environment_params_t & params ) {
+			params.timer_thread(
+					so_5::sharded_timer_factory( 3u, selection ) );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				run_test( so_5::timer_shard_selection_t::by_mbox );
+			},
+			20,
+			"shard selection by mbox" );
+
+		run_with_time_limit( [] {
+				run_test( so_5::timer_shard_selection_t::by_sender_thread );
+			},
+			20,
+			"shard selection by sender thread" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}